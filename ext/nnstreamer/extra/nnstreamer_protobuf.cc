@@ -24,26 +24,92 @@
  * protobuf-compiler17
  */
 
+#include <google/protobuf/io/coded_stream.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
+#include <vector>
 #include "nnstreamer.pb.h" /* Generated by `protoc` */
 #include "nnstreamer_protobuf.h"
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+
+/**
+ * @brief Field numbers of Tensors and Tensor in nnstreamer.proto
+ */
+enum {
+  PB_TENSORS_NUM_TENSOR = 1,
+  PB_TENSORS_FR = 2,
+  PB_TENSORS_TENSOR = 3,
+  PB_TENSORS_FORMAT = 4,
+  PB_FR_RATE_N = 1,
+  PB_FR_RATE_D = 2,
+  PB_TENSOR_NAME = 1,
+  PB_TENSOR_TYPE = 2,
+  PB_TENSOR_DIMENSION = 3,
+  PB_TENSOR_DATA = 4,
+};
+
+/**
+ * @brief Wire types of the protobuf encoding.
+ * @note WireFormatLite of libprotobuf is an internal API, the tags are handled here with the public CodedStream API.
+ */
+enum {
+  PB_WIRETYPE_VARINT = 0,
+  PB_WIRETYPE_FIXED64 = 1,
+  PB_WIRETYPE_LENGTH_DELIMITED = 2,
+  PB_WIRETYPE_FIXED32 = 5,
+};
+
+#define PB_MAKE_TAG(field, type) (((uint32_t) (field) << 3) | (uint32_t) (type))
+#define PB_TAG_FIELD(tag) ((tag) >> 3)
+#define PB_TAG_WIRETYPE(tag) ((tag) & 0x7U)
+
+/**
+ * @brief Get the size of the length-delimited field.
+ */
+static inline size_t
+_pb_field_size (uint32_t field, size_t size)
+{
+  return CodedOutputStream::VarintSize32 (
+             PB_MAKE_TAG (field, PB_WIRETYPE_LENGTH_DELIMITED))
+         + CodedOutputStream::VarintSize32 ((uint32_t) size) + size;
+}
+
+/**
+ * @brief Write the tag and the length of the length-delimited field.
+ */
+static inline uint8_t *
+_pb_write_field_header (uint32_t field, size_t size, uint8_t *target)
+{
+  target = CodedOutputStream::WriteTagToArray (
+      PB_MAKE_TAG (field, PB_WIRETYPE_LENGTH_DELIMITED), target);
+  return CodedOutputStream::WriteVarint32ToArray ((uint32_t) size, target);
+}
+
+/**
+ * @brief tensordec-plugin's GstTensorDecoderDef callback
+ * @details The message is serialized directly in the output memory, without copying the data to the message.
+ * The fields are written in the order of the field number, so the output is the same as SerializeToArray.
+ */
 GstFlowReturn
 gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     const GstTensorMemory *input, GstBuffer *outbuf)
 {
   GstMapInfo out_info;
   GstMemory *out_mem;
-  size_t size, outbuf_size;
+  size_t size;
+  uint8_t *target;
   nnstreamer::protobuf::Tensors tensors;
   nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
+  std::vector<nnstreamer::protobuf::Tensor> meta_tensors;
+  std::vector<size_t> tensor_size;
   guint num_tensors;
   gboolean is_flexible;
   GstTensorMetaInfo meta;
   GstTensorInfo *_info;
+  uint32_t format;
 
   if (!config || !input || !outbuf) {
     ml_loge ("NULL parameter is passed to tensor_decoder::protobuf");
@@ -59,6 +125,8 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
         NNS_TENSOR_SIZE_LIMIT_STR);
     return GST_FLOW_ERROR;
   }
+
+  /* num_tensor and fr, the fields before the tensors */
   tensors.set_num_tensor (num_tensors);
 
   fr = tensors.mutable_fr ();
@@ -70,11 +138,14 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
   fr->set_rate_n (config->rate_n);
   fr->set_rate_d (config->rate_d);
 
-  tensors.set_format (
-      (nnstreamer::protobuf::Tensors::Tensor_format) config->info.format);
+  size = tensors.ByteSizeLong ();
 
+  meta_tensors.resize (num_tensors);
+  tensor_size.resize (num_tensors);
+
+  /* the tensors without data, the data is written after the other fields */
   for (unsigned int i = 0; i < num_tensors; ++i) {
-    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
+    nnstreamer::protobuf::Tensor *tensor = &meta_tensors[i];
 
     _info = gst_tensors_info_get_nth_info ((GstTensorsInfo *) &config->info, i);
 
@@ -90,51 +161,210 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
       tensor->add_dimension (_info->dimension[j]);
     }
 
-    tensor->set_data (input[i].data, (int) input[i].size);
-  }
+    tensor_size[i] = tensor->ByteSizeLong ();
+    if (input[i].size > 0)
+      tensor_size[i] += _pb_field_size (PB_TENSOR_DATA, input[i].size);
 
-  size = tensors.ByteSizeLong ();
-  outbuf_size = gst_buffer_get_size (outbuf);
+    size += _pb_field_size (PB_TENSORS_TENSOR, tensor_size[i]);
+  }
 
-  if (outbuf_size == 0) {
-    out_mem = gst_allocator_alloc (NULL, size, NULL);
-  } else {
-    if (outbuf_size < size) {
-      gst_buffer_set_size (outbuf, size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+  format = (uint32_t) config->info.format;
+  if (format != 0) {
+    size += CodedOutputStream::VarintSize32 (
+                PB_MAKE_TAG (PB_TENSORS_FORMAT, PB_WIRETYPE_VARINT))
+            + CodedOutputStream::VarintSize32 (format);
   }
 
+  out_mem = gst_allocator_alloc (NULL, size, NULL);
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     nns_loge ("Cannot map output memory / tensordec-protobuf");
     gst_memory_unref (out_mem);
     return GST_FLOW_ERROR;
   }
 
-  tensors.SerializeToArray (out_info.data, size);
+  target = tensors.SerializeWithCachedSizesToArray (out_info.data);
+
+  for (unsigned int i = 0; i < num_tensors; ++i) {
+    target = _pb_write_field_header (PB_TENSORS_TENSOR, tensor_size[i], target);
+    target = meta_tensors[i].SerializeWithCachedSizesToArray (target);
+
+    if (input[i].size > 0) {
+      target = _pb_write_field_header (PB_TENSOR_DATA, input[i].size, target);
+      memcpy (target, input[i].data, input[i].size);
+      target += input[i].size;
+    }
+  }
+
+  if (format != 0) {
+    target = CodedOutputStream::WriteTagToArray (
+        PB_MAKE_TAG (PB_TENSORS_FORMAT, PB_WIRETYPE_VARINT), target);
+    target = CodedOutputStream::WriteVarint32ToArray (format, target);
+  }
 
+  g_assert ((size_t) (target - out_info.data) == size);
   gst_memory_unmap (out_mem, &out_info);
 
-  if (outbuf_size == 0)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  if (gst_buffer_get_size (outbuf) > 0)
+    gst_buffer_remove_all_memory (outbuf);
+
+  gst_buffer_append_memory (outbuf, out_mem);
 
   return GST_FLOW_OK;
 }
 
-/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+/**
+ * @brief Skip the unknown field in the protobuf wire format.
+ * @note Groups are deprecated and not used in nnstreamer.proto, the message with a group is not parsed.
+ */
+static gboolean
+_pb_skip_field (CodedInputStream *input, uint32_t tag)
+{
+  uint64_t value64;
+  uint32_t value32;
+
+  switch (PB_TAG_WIRETYPE (tag)) {
+    case PB_WIRETYPE_VARINT:
+      return input->ReadVarint64 (&value64);
+    case PB_WIRETYPE_FIXED64:
+      return input->ReadLittleEndian64 (&value64);
+    case PB_WIRETYPE_LENGTH_DELIMITED:
+      return input->ReadVarint32 (&value32) && input->Skip ((int) value32);
+    case PB_WIRETYPE_FIXED32:
+      return input->ReadLittleEndian32 (&value32);
+    default:
+      return FALSE;
+  }
+}
+
+/**
+ * @brief Parse the frame rate in the protobuf wire format.
+ */
+static gboolean
+_pb_parse_frame_rate (CodedInputStream *input, GstTensorsConfig *config)
+{
+  uint32_t tag;
+  uint64_t value;
+
+  while ((tag = input->ReadTag ()) != 0) {
+    switch (PB_TAG_FIELD (tag)) {
+      case PB_FR_RATE_N:
+      case PB_FR_RATE_D:
+        if (PB_TAG_WIRETYPE (tag) != PB_WIRETYPE_VARINT)
+          return FALSE;
+        if (!input->ReadVarint64 (&value))
+          return FALSE;
+
+        if (PB_TAG_FIELD (tag) == PB_FR_RATE_N)
+          config->rate_n = (int) (int32_t) value;
+        else
+          config->rate_d = (int) (int32_t) value;
+        break;
+      default:
+        if (!_pb_skip_field (input, tag))
+          return FALSE;
+        break;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Parse the tensor in the protobuf wire format, without copying the data.
+ * @param[out] offset The offset of the data in the message.
+ * @param[out] size The size of the data.
+ */
+static gboolean
+_pb_parse_tensor (CodedInputStream *input, GstTensorInfo *info, gsize *offset, gsize *size)
+{
+  uint32_t tag, value, length;
+  guint rank = 0;
+  std::string name;
+
+  *offset = 0;
+  *size = 0;
+
+  while ((tag = input->ReadTag ()) != 0) {
+    uint32_t wire_type = PB_TAG_WIRETYPE (tag);
+
+    switch (PB_TAG_FIELD (tag)) {
+      case PB_TENSOR_NAME:
+        if (wire_type != PB_WIRETYPE_LENGTH_DELIMITED)
+          return FALSE;
+        if (!input->ReadVarint32 (&length) || !input->ReadString (&name, (int) length))
+          return FALSE;
+
+        g_free (info->name);
+        info->name = (name.length () > 0) ? g_strdup (name.c_str ()) : NULL;
+        break;
+      case PB_TENSOR_TYPE:
+        if (wire_type != PB_WIRETYPE_VARINT || !input->ReadVarint32 (&value))
+          return FALSE;
+
+        info->type = (tensor_type) value;
+        break;
+      case PB_TENSOR_DIMENSION:
+        if (wire_type == PB_WIRETYPE_LENGTH_DELIMITED) {
+          /* packed */
+          CodedInputStream::Limit limit;
+
+          if (!input->ReadVarint32 (&length))
+            return FALSE;
+
+          limit = input->PushLimit ((int) length);
+          while (input->BytesUntilLimit () > 0) {
+            if (!input->ReadVarint32 (&value))
+              return FALSE;
+            if (rank < NNS_TENSOR_RANK_LIMIT)
+              info->dimension[rank++] = value;
+          }
+          input->PopLimit (limit);
+        } else if (wire_type == PB_WIRETYPE_VARINT) {
+          if (!input->ReadVarint32 (&value))
+            return FALSE;
+          if (rank < NNS_TENSOR_RANK_LIMIT)
+            info->dimension[rank++] = value;
+        } else {
+          return FALSE;
+        }
+        break;
+      case PB_TENSOR_DATA:
+        if (wire_type != PB_WIRETYPE_LENGTH_DELIMITED)
+          return FALSE;
+        if (!input->ReadVarint32 (&length))
+          return FALSE;
+
+        *offset = (gsize) input->CurrentPosition ();
+        *size = length;
+        if (!input->Skip ((int) length))
+          return FALSE;
+        break;
+      default:
+        if (!_pb_skip_field (input, tag))
+          return FALSE;
+        break;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief tensor converter plugin's NNStreamerExternalConverter callback
+ * @details The message is parsed in place and the data of each tensor shares the input memory.
+ */
 GstBuffer *
 gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void *priv_data)
 {
-  nnstreamer::protobuf::Tensors tensors;
-  nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   GstTensorInfo *_info;
   GstMemory *in_mem, *out_mem;
   GstMapInfo in_info;
-  GstBuffer *out_buf;
-  gsize mem_size;
-  gpointer mem_data;
+  GstBuffer *out_buf = NULL;
+  gsize offset[NNS_TENSOR_SIZE_LIMIT];
+  gsize size[NNS_TENSOR_SIZE_LIMIT];
+  guint num_tensors = 0, parsed = 0;
+  uint32_t tag, value, length;
+  gboolean valid = TRUE;
   UNUSED (priv_data);
 
   if (!in_buf || !config) {
@@ -149,39 +379,87 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
     return NULL;
   }
 
-  tensors.ParseFromArray (in_info.data, in_info.size);
-
-  config->info.num_tensors = tensors.num_tensor ();
-  config->info.format = (tensor_format) tensors.format ();
-  fr = tensors.mutable_fr ();
-  config->rate_n = fr->rate_n ();
-  config->rate_d = fr->rate_d ();
-  out_buf = gst_buffer_new ();
+  config->info.format = _NNS_TENSOR_FORMAT_STATIC;
+  config->rate_n = config->rate_d = 0;
+
+  CodedInputStream input (in_info.data, (int) in_info.size);
+
+  while (valid && (tag = input.ReadTag ()) != 0) {
+    uint32_t wire_type = PB_TAG_WIRETYPE (tag);
+    CodedInputStream::Limit limit;
+
+    switch (PB_TAG_FIELD (tag)) {
+      case PB_TENSORS_NUM_TENSOR:
+        valid = (wire_type == PB_WIRETYPE_VARINT
+                 && input.ReadVarint32 (&num_tensors));
+        break;
+      case PB_TENSORS_FR:
+        valid = (wire_type == PB_WIRETYPE_LENGTH_DELIMITED
+                 && input.ReadVarint32 (&length));
+        if (valid) {
+          limit = input.PushLimit ((int) length);
+          valid = _pb_parse_frame_rate (&input, config);
+          input.PopLimit (limit);
+        }
+        break;
+      case PB_TENSORS_TENSOR:
+        if (parsed >= NNS_TENSOR_SIZE_LIMIT) {
+          nns_loge ("The number of tensors is limited to %d", NNS_TENSOR_SIZE_LIMIT);
+          valid = FALSE;
+          break;
+        }
+
+        valid = (wire_type == PB_WIRETYPE_LENGTH_DELIMITED
+                 && input.ReadVarint32 (&length));
+        if (valid) {
+          _info = gst_tensors_info_get_nth_info (&config->info, parsed);
+          gst_tensor_info_free (_info);
+          gst_tensor_info_init (_info);
+
+          limit = input.PushLimit ((int) length);
+          valid = _pb_parse_tensor (&input, _info, &offset[parsed], &size[parsed]);
+          input.PopLimit (limit);
+          parsed++;
+        }
+        break;
+      case PB_TENSORS_FORMAT:
+        valid = (wire_type == PB_WIRETYPE_VARINT
+                 && input.ReadVarint32 (&value));
+        if (valid)
+          config->info.format = (tensor_format) value;
+        break;
+      default:
+        valid = _pb_skip_field (&input, tag);
+        break;
+    }
+  }
 
-  for (guint i = 0; i < config->info.num_tensors; i++) {
-    const nnstreamer::protobuf::Tensor *tensor = &tensors.tensor (i);
-    std::string _name = tensor->name ();
-    const gchar *name = _name.c_str ();
+  if (!valid || input.CurrentPosition () != (int) in_info.size) {
+    nns_loge ("Failed to parse the protobuf message / tensor_converter_protobuf");
+    goto done;
+  }
 
-    _info = gst_tensors_info_get_nth_info (&config->info, i);
+  if (num_tensors > parsed) {
+    nns_loge ("The number of tensors %u is larger than the tensors in the message (%u)",
+        num_tensors, parsed);
+    goto done;
+  }
 
-    _info->name = (name && strlen (name) > 0) ? g_strdup (name) : NULL;
-    _info->type = (tensor_type) tensor->type ();
-    for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++) {
-      _info->dimension[j] = tensor->dimension (j);
-    }
-    mem_size = tensor->data ().length ();
-    mem_data = _g_memdup (tensor->data ().c_str (), mem_size);
+  config->info.num_tensors = num_tensors;
+  out_buf = gst_buffer_new ();
 
-    out_mem = gst_memory_new_wrapped (
-        (GstMemoryFlags) 0, mem_data, mem_size, 0, mem_size, mem_data, g_free);
+  for (guint i = 0; i < num_tensors; i++) {
+    _info = gst_tensors_info_get_nth_info (&config->info, i);
 
+    out_mem = gst_memory_share (in_mem, offset[i], size[i]);
     gst_tensor_buffer_append_memory (out_buf, out_mem, _info);
   }
 
   /** copy timestamps */
   gst_buffer_copy_into (
       out_buf, in_buf, (GstBufferCopyFlags) GST_BUFFER_COPY_METADATA, 0, -1);
+
+done:
   gst_memory_unmap (in_mem, &in_info);
   gst_memory_unref (in_mem);
 
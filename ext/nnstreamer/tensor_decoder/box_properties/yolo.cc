@@ -39,6 +39,10 @@ class YoloV5 : public BoxProperties
   int scaled_output;
   gfloat conf_threshold;
   gfloat iou_threshold;
+  /* From option3, whether to suppress the boxes of the same class only */
+  gboolean class_aware_nms;
+  /* From option3, the number of candidates for nms (0 for all) */
+  guint nms_top_k;
 };
 
 /**
@@ -58,6 +62,10 @@ class YoloV8 : public BoxProperties
   int scaled_output;
   gfloat conf_threshold;
   gfloat iou_threshold;
+  /* From option3, whether to suppress the boxes of the same class only */
+  gboolean class_aware_nms;
+  /* From option3, the number of candidates for nms (0 for all) */
+  guint nms_top_k;
 };
 
 static BoxProperties *yolo5 = nullptr;
@@ -81,6 +89,8 @@ YoloV5::YoloV5 ()
   scaled_output = 0;
   conf_threshold = YOLO_DETECTION_CONF_THRESHOLD;
   iou_threshold = YOLO_DETECTION_IOU_THRESHOLD;
+  class_aware_nms = FALSE;
+  nms_top_k = 0;
   name = g_strdup_printf ("yolov5");
 }
 
@@ -107,9 +117,13 @@ YoloV5::setOptionInternal (const char *param)
     conf_threshold = (gfloat) g_ascii_strtod (options[1], NULL);
   if (noptions > 2)
     iou_threshold = (gfloat) g_ascii_strtod (options[2], NULL);
+  if (noptions > 3)
+    class_aware_nms = (g_ascii_strtoll (options[3], NULL, 10) != 0);
+  if (noptions > 4)
+    nms_top_k = (guint) g_ascii_strtoull (options[4], NULL, 10);
 
-  nns_logi ("Setting YOLOV5/YOLOV8 decoder as scaled_output: %d, conf_threshold: %.2f, iou_threshold: %.2f",
-      scaled_output, conf_threshold, iou_threshold);
+  nns_logi ("Setting YOLOV5/YOLOV8 decoder as scaled_output: %d, conf_threshold: %.2f, iou_threshold: %.2f, class_aware_nms: %d, nms_top_k: %u",
+      scaled_output, conf_threshold, iou_threshold, class_aware_nms, nms_top_k);
 
   g_strfreev (options);
   return TRUE;
@@ -203,7 +217,8 @@ YoloV5::decode (const GstTensorsConfig *config, const GstTensorMemory *input)
     }
   }
 
-  nms (results, iou_threshold);
+  nmsOptions nms_options = { iou_threshold, class_aware_nms, nms_top_k };
+  nms (results, &nms_options);
   return results;
 }
 
@@ -213,6 +228,8 @@ YoloV8::YoloV8 ()
   scaled_output = 0;
   conf_threshold = YOLO_DETECTION_CONF_THRESHOLD;
   iou_threshold = YOLO_DETECTION_IOU_THRESHOLD;
+  class_aware_nms = FALSE;
+  nms_top_k = 0;
   name = g_strdup_printf ("yolov8");
 }
 
@@ -237,9 +254,13 @@ YoloV8::setOptionInternal (const char *param)
     conf_threshold = (gfloat) g_ascii_strtod (options[1], NULL);
   if (noptions > 2)
     iou_threshold = (gfloat) g_ascii_strtod (options[2], NULL);
+  if (noptions > 3)
+    class_aware_nms = (g_ascii_strtoll (options[3], NULL, 10) != 0);
+  if (noptions > 4)
+    nms_top_k = (guint) g_ascii_strtoull (options[4], NULL, 10);
 
-  nns_logi ("Setting YOLOV5/YOLOV8 decoder as scaled_output: %d, conf_threshold: %.2f, iou_threshold: %.2f",
-      scaled_output, conf_threshold, iou_threshold);
+  nns_logi ("Setting YOLOV5/YOLOV8 decoder as scaled_output: %d, conf_threshold: %.2f, iou_threshold: %.2f, class_aware_nms: %d, nms_top_k: %u",
+      scaled_output, conf_threshold, iou_threshold, class_aware_nms, nms_top_k);
 
   g_strfreev (options);
   return TRUE;
@@ -349,7 +370,8 @@ YoloV8::decode (const GstTensorsConfig *config, const GstTensorMemory *input)
     }
   }
 
-  nms (results, iou_threshold);
+  nmsOptions nms_options = { iou_threshold, class_aware_nms, nms_top_k };
+  nms (results, &nms_options);
   return results;
 }
 
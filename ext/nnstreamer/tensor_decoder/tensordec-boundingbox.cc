@@ -40,8 +40,15 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <gst/video/gstvideometa.h>
 #include "tensordec-boundingbox.h"
 
+/** @brief The number of values for a box in tensor output (x, y, width, height, score, class id) */
+#define BB_TENSOR_INFO_SIZE (6)
+
+/** @brief The maximum number of output memories cached for dirty-rect overlay */
+#define BB_MAX_CANVASES (4)
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -82,6 +89,16 @@ static const char *bb_modes[] = {
   NULL,
 };
 
+/**
+ * @brief List of output types in string
+ */
+static const char *bb_output_types[] = {
+  [BB_OUTPUT_OVERLAY] = "overlay",
+  [BB_OUTPUT_DIRTY_RECT] = "dirty-rect",
+  [BB_OUTPUT_TENSOR] = "tensor",
+  NULL,
+};
+
 /**
  * @brief Change deprecated mode name
  */
@@ -221,11 +238,14 @@ init_bb (void)
         "Location of the label file. This is independent from option1.", "option3",
         "Sub-option values that depend on option1;\n"
         "\tfor yolov5 and yolov8 mode:\n"
-        "\t\tThe option3 requires up to 3 numbers, which tell\n"
+        "\t\tThe option3 requires up to 5 numbers, which tell\n"
         "\t\t- whether the output values are scaled or not\n"
         "\t\t   0: not scaled (default), 1: scaled (e.g., 0.0 ~ 1.0)\n"
         "\t\t- the threshold of confidence (optional, default set to 0.25)\n"
         "\t\t- the threshold of IOU (optional, default set to 0.45)\n"
+        "\t\t- whether NMS suppresses the boxes of the same class only\n"
+        "\t\t   0: all classes (default), 1: same class\n"
+        "\t\t- the number of candidates for NMS (optional, default set to 0, all)\n"
         "\t\tAn example of option3 is option3 = 0: 0.65:0.6 \n"
         "\tfor mobilenet-ssd mode:\n"
         "\t\tThe option3 definition scheme is, in order, as follows\n"
@@ -270,7 +290,12 @@ init_bb (void)
         "\t\t 0 (default, do not log)\n"
         "\t\t 1 (log result bounding boxes)"
         "\tThis is independent from option1",
-        "option8", "Box Style (NYI)", NULL);
+        "option8", "Box Style (NYI)", "option9",
+        "Output type\n"
+        "\t\t overlay (default, RGBA video with the boxes drawn on transparent background)\n"
+        "\t\t dirty-rect (RGBA video, clear and redraw the regions of the boxes only)\n"
+        "\t\t tensor (flexible float32 tensor of 6:N, x:y:width:height:score:class-id of each box, with GstVideoRegionOfInterestMeta)",
+        NULL);
   }
 }
 
@@ -297,75 +322,15 @@ distance_compare (const void *a, const void *b)
   return 0;
 }
 
-/**
- * @brief Compare Function for g_array_sort with detectedObject.
- */
-static gint
-compare_detection (gconstpointer _a, gconstpointer _b)
-{
-  const detectedObject *a = static_cast<const detectedObject *> (_a);
-  const detectedObject *b = static_cast<const detectedObject *> (_b);
-
-  /* Larger comes first */
-  return (a->prob > b->prob) ? -1 : ((a->prob == b->prob) ? 0 : 1);
-}
-
-/**
- * @brief Calculate the intersected surface
- */
-static gfloat
-iou (detectedObject *a, detectedObject *b)
-{
-  int x1 = MAX (a->x, b->x);
-  int y1 = MAX (a->y, b->y);
-  int x2 = MIN (a->x + a->width, b->x + b->width);
-  int y2 = MIN (a->y + a->height, b->y + b->height);
-  int w = MAX (0, (x2 - x1 + 1));
-  int h = MAX (0, (y2 - y1 + 1));
-  float inter = w * h;
-  float areaA = a->width * a->height;
-  float areaB = b->width * b->height;
-  float o = inter / (areaA + areaB - inter);
-  return (o >= 0) ? o : 0;
-}
-
-/**
- * @brief Apply NMS to the given results (objects[DETECTION_MAX])
- */
-void
-nms (GArray *results, gfloat threshold)
+/** @brief Free the cached output memory of dirty-rect overlay. */
+static void
+free_canvas (gpointer data)
 {
-  guint boxes_size;
-  guint i, j;
-
-  boxes_size = results->len;
-  if (boxes_size == 0U)
-    return;
+  boxCanvas *canvas = (boxCanvas *) data;
 
-  g_array_sort (results, compare_detection);
-
-  for (i = 0; i < boxes_size; i++) {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
-    if (a->valid == TRUE) {
-      for (j = i + 1; j < boxes_size; j++) {
-        detectedObject *b = &g_array_index (results, detectedObject, j);
-        if (b->valid == TRUE) {
-          if (iou (a, b) > threshold) {
-            b->valid = FALSE;
-          }
-        }
-      }
-    }
-  }
-
-  i = 0;
-  do {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
-    if (a->valid == FALSE)
-      g_array_remove_index (results, i);
-    else
-      i++;
-  } while (i < results->len);
+  gst_memory_unref (canvas->mem);
+  g_array_free (canvas->dirty, TRUE);
+  g_free (canvas);
 }
 
 /**
@@ -398,6 +363,8 @@ BoundingBox::BoundingBox ()
   height = 0;
   flag_use_label = FALSE;
   do_log = 0;
+  output_type = BB_OUTPUT_OVERLAY;
+  canvases = g_ptr_array_new_with_free_func (free_canvas);
 
   /* for track */
   is_track = 0;
@@ -412,6 +379,7 @@ BoundingBox::BoundingBox ()
   labeldata.labels = nullptr;
   labeldata.max_word_length = 0;
   labeldata.total_labels = 0;
+  labeldata.table = nullptr;
   bdata = nullptr;
 }
 
@@ -423,6 +391,8 @@ BoundingBox::~BoundingBox ()
   if (label_path)
     g_free (label_path);
 
+  g_ptr_array_free (canvases, TRUE);
+
   G_LOCK (box_properties_table);
   g_hash_table_destroy (properties_table);
   properties_table = nullptr;
@@ -589,9 +559,10 @@ BoundingBox::updateCentroids (GArray *boxes)
  * @param[out] out_info The output buffer (RGBA plain)
  * @param[in] bdata The bounding-box internal data.
  * @param[in] results The final results to be drawn.
+ * @param[out] dirty The regions to be drawn are appended if given.
  */
 void
-BoundingBox::draw (GstMapInfo *out_info, GArray *results)
+BoundingBox::draw (GstMapInfo *out_info, GArray *results, GArray *dirty)
 {
   uint32_t *frame = (uint32_t *) out_info->data; /* Let's draw per pixel (4bytes) */
   unsigned int i;
@@ -619,6 +590,13 @@ BoundingBox::draw (GstMapInfo *out_info, GArray *results)
     y1 = (height * a->y) / i_height;
     y2 = MIN (height - 1, (height * (a->y + a->height)) / i_height);
 
+    if (dirty) {
+      dirtyRect lines[] = { { x1, y1, x2 - x1 + 1, 1 }, { x1, y2, x2 - x1 + 1, 1 },
+        { x1, y1 + 1, 1, y2 - y1 - 1 }, { x2, y1 + 1, 1, y2 - y1 - 1 } };
+
+      g_array_append_vals (dirty, lines, G_N_ELEMENTS (lines));
+    }
+
     /* 1-1. Horizontal */
     pos1 = &frame[y1 * width + x1];
     pos2 = &frame[y2 * width + x1];
@@ -644,6 +622,7 @@ BoundingBox::draw (GstMapInfo *out_info, GArray *results)
       g_autofree gchar *label = NULL;
       guint j;
       gsize label_len = 0;
+      int label_x = x1;
 
       if (is_track != 0) {
         label = g_strdup_printf ("%s-%d", labeldata.labels[a->class_id], a->tracking_id);
@@ -673,10 +652,41 @@ BoundingBox::draw (GstMapInfo *out_info, GArray *results)
         x1 += 9;
         pos1 += 9; /* charater width + 1px */
       }
+
+      if (dirty && x1 > label_x) {
+        dirtyRect rect = { label_x, y1, x1 - label_x, 13 };
+        g_array_append_val (dirty, rect);
+      }
     }
   }
 }
 
+/**
+ * @brief Clear the regions drawn in the output buffer
+ * @param[out] out_info The output buffer (RGBA plain)
+ * @param[in] dirty The regions to be cleared.
+ */
+void
+BoundingBox::clearDirty (GstMapInfo *out_info, GArray *dirty)
+{
+  uint32_t *frame = (uint32_t *) out_info->data;
+  guint i;
+  int x1, x2, y, y2;
+
+  for (i = 0; i < dirty->len; i++) {
+    dirtyRect *r = &g_array_index (dirty, dirtyRect, i);
+
+    x1 = CLAMP (r->x, 0, (int) width);
+    x2 = CLAMP (r->x + r->width, 0, (int) width);
+    y2 = MIN ((int) height, r->y + r->height);
+    if (x2 <= x1)
+      continue;
+
+    for (y = MAX (0, r->y); y < y2; y++)
+      memset (&frame[y * width + x1], 0, (x2 - x1) * sizeof (uint32_t));
+  }
+}
+
 /**
  * @brief Log the given results
  */
@@ -812,6 +822,29 @@ BoundingBox::setInputModelSize (const char *param)
   return TRUE;
 }
 
+/**
+ * @brief Set output type of bounding box
+ */
+int
+BoundingBox::setOutputType (const char *param)
+{
+  int type;
+
+  if (param == NULL || *param == '\0') {
+    output_type = BB_OUTPUT_OVERLAY;
+    return TRUE;
+  }
+
+  type = find_key_strv (bb_output_types, param);
+  if (type < 0) {
+    nns_loge ("Unknown output type of bounding box: %s", param);
+    return FALSE;
+  }
+
+  output_type = static_cast<bounding_box_output_types> (type);
+  return TRUE;
+}
+
 /**
  * @brief Set option of bounding box
  */
@@ -835,6 +868,8 @@ BoundingBox::setOption (BoundingBoxOption option, const char *param)
   } else if (option == BoundingBoxOption::LOG) {
     do_log = (int) g_ascii_strtoll (param, NULL, 10);
     return TRUE;
+  } else if (option == BoundingBoxOption::OUTPUT_TYPE) {
+    return setOutputType (param);
   }
 
   /**
@@ -857,6 +892,12 @@ BoundingBox::getOutCaps (const GstTensorsConfig *config)
   if (!ret)
     return NULL;
 
+  if (output_type == BB_OUTPUT_TENSOR) {
+    caps = gst_caps_from_string ("other/tensors,format=flexible");
+    setFramerateFromConfig (caps, config);
+    return caps;
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, " /* Use alpha channel to make the background transparent */
                          "width = %u, height = %u",
       width, height);
@@ -867,6 +908,122 @@ BoundingBox::getOutCaps (const GstTensorsConfig *config)
   return caps;
 }
 
+/**
+ * @brief Get the output memory not used by downstream for dirty-rect overlay
+ * @return The canvas to be reused, or NULL if all cached memories are in use.
+ */
+boxCanvas *
+BoundingBox::getCanvas (size_t size)
+{
+  boxCanvas *canvas;
+  guint i = 0;
+
+  while (i < canvases->len) {
+    canvas = (boxCanvas *) g_ptr_array_index (canvases, i);
+
+    if (gst_memory_get_sizes (canvas->mem, NULL, NULL) != size) {
+      /* output dimension is changed */
+      g_ptr_array_remove_index_fast (canvases, i);
+      continue;
+    }
+
+    /* downstream has released the buffer */
+    if (GST_MINI_OBJECT_REFCOUNT_VALUE (canvas->mem) == 1)
+      return canvas;
+    i++;
+  }
+
+  if (canvases->len >= BB_MAX_CANVASES)
+    return NULL;
+
+  canvas = g_new0 (boxCanvas, 1);
+  canvas->mem = gst_allocator_alloc (NULL, size, NULL);
+  canvas->dirty = g_array_new (FALSE, FALSE, sizeof (dirtyRect));
+
+  /* new memory should be cleared entirely */
+  {
+    dirtyRect all = { 0, 0, (int) width, (int) height };
+    g_array_append_val (canvas->dirty, all);
+  }
+
+  g_ptr_array_add (canvases, canvas);
+  return canvas;
+}
+
+/**
+ * @brief Write the results to out buffer as a tensor without drawing a frame
+ * @param[in] results The final results.
+ * @param[out] outbuf The output buffer.
+ */
+GstFlowReturn
+BoundingBox::decodeTensor (GArray *results, GstBuffer *outbuf)
+{
+  GstTensorMetaInfo meta;
+  GstMapInfo out_info;
+  GstMemory *out_mem;
+  gfloat *boxes;
+  gsize hsize, dsize;
+  guint i;
+
+  gst_tensor_meta_info_init (&meta);
+  meta.type = _NNS_FLOAT32;
+  meta.dimension[0] = BB_TENSOR_INFO_SIZE;
+  meta.dimension[1] = MAX (results->len, 1U);
+  meta.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta.media_type = _NNS_TENSOR;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  dsize = gst_tensor_meta_info_get_data_size (&meta);
+
+  out_mem = gst_allocator_alloc (NULL, hsize + dsize, NULL);
+  if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
+    ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
+    gst_memory_unref (out_mem);
+    return GST_FLOW_ERROR;
+  }
+
+  gst_tensor_meta_info_update_header (&meta, out_info.data);
+  boxes = (gfloat *) (out_info.data + hsize);
+
+  if (results->len == 0U) {
+    /* no object, a row with invalid class */
+    memset (boxes, 0, dsize);
+    boxes[5] = -1.f;
+  }
+
+  for (i = 0; i < results->len; i++) {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    gfloat *row = boxes + i * BB_TENSOR_INFO_SIZE;
+    const gchar *label = "object";
+    GstVideoRegionOfInterestMeta *roi;
+
+    row[0] = (gfloat) a->x;
+    row[1] = (gfloat) a->y;
+    row[2] = (gfloat) a->width;
+    row[3] = (gfloat) a->height;
+    row[4] = a->prob;
+    row[5] = (gfloat) a->class_id;
+
+    if (flag_use_label && a->class_id >= 0 && a->class_id < (int) labeldata.total_labels)
+      label = labeldata.labels[a->class_id];
+
+    roi = gst_buffer_add_video_region_of_interest_meta (outbuf, label,
+        MAX (0, a->x), MAX (0, a->y), MAX (0, a->width), MAX (0, a->height));
+    if (roi)
+      roi->id = a->tracking_id;
+  }
+
+  gst_memory_unmap (out_mem, &out_info);
+
+  if (gst_buffer_get_size (outbuf) == 0) {
+    gst_buffer_append_memory (outbuf, out_mem);
+  } else {
+    gst_buffer_replace_all_memory (outbuf, out_mem);
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Decode input memory to out buffer
  * @param[in] config The structure of input tensor info.
@@ -881,7 +1038,9 @@ BoundingBox::decode (const GstTensorsConfig *config,
   GstMapInfo out_info;
   GstMemory *out_mem;
   GArray *results = NULL;
+  boxCanvas *canvas = NULL;
   gboolean need_output_alloc;
+  GstFlowReturn ret;
 
   g_assert (outbuf);
   need_output_alloc = gst_buffer_get_size (outbuf) == 0;
@@ -891,9 +1050,35 @@ BoundingBox::decode (const GstTensorsConfig *config,
   else
     flag_use_label = FALSE;
 
+  results = bdata->decode (config, input);
+  if (results == NULL) {
+    GST_ERROR ("Failed to get output buffer, unknown mode %d.", mode);
+    return GST_FLOW_ERROR;
+  }
+
+  if (do_log != 0) {
+    logBoxes (results);
+  }
+
+  if (is_track != 0) {
+    updateCentroids (results);
+  }
+
+  if (output_type == BB_OUTPUT_TENSOR) {
+    ret = decodeTensor (results, outbuf);
+    g_array_free (results, TRUE);
+    return ret;
+  }
+
   /* Ensure we have outbuf properly allocated */
   if (need_output_alloc) {
-    out_mem = gst_allocator_alloc (NULL, size, NULL);
+    if (output_type == BB_OUTPUT_DIRTY_RECT)
+      canvas = getCanvas (size);
+
+    if (canvas)
+      out_mem = gst_memory_ref (canvas->mem);
+    else
+      out_mem = gst_allocator_alloc (NULL, size, NULL);
   } else {
     if (gst_buffer_get_size (outbuf) < size) {
       gst_buffer_set_size (outbuf, size);
@@ -905,24 +1090,16 @@ BoundingBox::decode (const GstTensorsConfig *config,
     goto error_free;
   }
 
-  /* reset the buffer with alpha 0 / black */
-  memset (out_info.data, 0, size);
-
-  results = bdata->decode (config, input);
-  if (results == NULL) {
-    GST_ERROR ("Failed to get output buffer, unknown mode %d.", mode);
-    goto error_unmap;
-  }
-
-  if (do_log != 0) {
-    logBoxes (results);
-  }
-
-  if (is_track != 0) {
-    updateCentroids (results);
+  if (canvas) {
+    /* clear the regions drawn in the previous frame only */
+    clearDirty (&out_info, canvas->dirty);
+    g_array_set_size (canvas->dirty, 0);
+  } else {
+    /* reset the buffer with alpha 0 / black */
+    memset (out_info.data, 0, size);
   }
 
-  draw (&out_info, results);
+  draw (&out_info, results, canvas ? canvas->dirty : nullptr);
   g_array_free (results, TRUE);
 
   gst_memory_unmap (out_mem, &out_info);
@@ -934,9 +1111,8 @@ BoundingBox::decode (const GstTensorsConfig *config,
 
   return GST_FLOW_OK;
 
-error_unmap:
-  gst_memory_unmap (out_mem, &out_info);
 error_free:
+  g_array_free (results, TRUE);
   gst_memory_unref (out_mem);
 
   return GST_FLOW_ERROR;
@@ -39,12 +39,16 @@
  * option3: Any option1-dependent values
  *          !!This depends on option1 values!!
  *          for yolov5 and yolov8 mode:
- *            The option3 requires up to 3 numbers, which tell
+ *            The option3 requires up to 5 numbers, which tell
  *              - whether the output values are scaled or not
  *                0: not scaled (default), 1: scaled (e.g., 0.0 ~ 1.0)
  *              - the threshold of confidence (optional, default set to 0.25)
  *              - the threshold of IOU (optional, default set to 0.45)
- *            An example of option3 is "option3=0:0.65:0.6"
+ *              - whether NMS suppresses the boxes of the same class only
+ *                0: all classes (default), 1: same class
+ *              - the number of candidates with the highest confidence for NMS
+ *                (optional, default set to 0, all candidates)
+ *            An example of option3 is "option3=0:0.65:0.6" or "option3=0:0.25:0.45:1:1000"
  *          for mobilenet-ssd mode:
  *            The option3 definition scheme is, in order, the following:
  *                - box priors location file (mandatory)
@@ -97,6 +101,15 @@
  *          0 (default, do not log)
  *          1 (log result bounding boxes)
  * option8: Box Style (NYI)
+ * option9: Output type
+ *          overlay (default, RGBA video with the boxes drawn on transparent background)
+ *          dirty-rect (RGBA video, clear and redraw the regions of the boxes only)
+ *          tensor (other/tensors of the boxes, no video frame is drawn)
+ *          With tensor, the output is a flexible float32 tensor of 6:N, a row of
+ *          x, y, width, height, score and class id for each box in the input
+ *          dimension (option5). If no object is detected, the tensor has a row
+ *          of zero with class id -1. GstVideoRegionOfInterestMeta of each box
+ *          is attached to the output buffer as well.
  *
  * MAJOR TODO: Support other colorspaces natively from _decode for performance gain
  * (e.g., BGRA, ARGB, ...)
@@ -124,6 +137,7 @@ enum class BoundingBoxOption {
   INPUT_MODEL_SIZE = 4,
   TRACK = 5,
   LOG = 6,
+  OUTPUT_TYPE = 8,
   UNKNOWN,
 };
 
@@ -149,6 +163,35 @@ typedef enum {
   BOUNDING_BOX_UNKNOWN,
 } bounding_box_modes;
 
+/**
+ * @brief Output types of bounding boxes.
+ */
+typedef enum {
+  BB_OUTPUT_OVERLAY = 0,
+  BB_OUTPUT_DIRTY_RECT = 1,
+  BB_OUTPUT_TENSOR = 2,
+
+  BB_OUTPUT_UNKNOWN,
+} bounding_box_output_types;
+
+/**
+ * @brief Region drawn in the output video frame.
+ */
+typedef struct {
+  int x;
+  int y;
+  int width;
+  int height;
+} dirtyRect;
+
+/**
+ * @brief Output memory reused by dirty-rect overlay.
+ */
+typedef struct {
+  GstMemory *mem;
+  GArray *dirty; /**< The regions drawn in the memory (dirtyRect) */
+} boxCanvas;
+
 /**
  * @brief Structure for object centroid tracking.
  */
@@ -193,12 +236,28 @@ typedef struct {
 } detectedObject;
 
 
+/**
+ * @brief Options of non-maximum suppression
+ */
+typedef struct {
+  gfloat iou_threshold; /**< A box is suppressed if IoU with a box of higher score is larger than this */
+  gboolean class_aware; /**< If TRUE, a box is suppressed by the boxes of the same class only */
+  guint top_k; /**< The number of candidates with the highest scores to be kept before suppression (0 for all) */
+} nmsOptions;
+
 /**
  * @brief Apply NMS to the given results (objects[DETECTION_MAX])
  * @param[in/out] results The results to be filtered with nms
  */
 void nms (GArray *results, gfloat threshold);
 
+/**
+ * @brief Apply NMS to the given results with the options.
+ * @param[in/out] results The results to be filtered with nms, sorted by the score after nms.
+ * @param[in] options The options of nms.
+ */
+void nms (GArray *results, const nmsOptions *options);
+
 /**
  * @brief check the num_tensors is valid
  * @param[in] config The structure of tensors info to check.
@@ -265,7 +324,9 @@ class BoundingBox
   int setLabelPath (const char *param);
   int setVideoSize (const char *param);
   int setInputModelSize (const char *param);
-  void draw (GstMapInfo *out_info, GArray *results);
+  int setOutputType (const char *param);
+  void draw (GstMapInfo *out_info, GArray *results, GArray *dirty = nullptr);
+  void clearDirty (GstMapInfo *out_info, GArray *dirty);
   void logBoxes (GArray *results);
   void updateCentroids (GArray *boxes);
 
@@ -278,6 +339,9 @@ class BoundingBox
   static gboolean addProperties (BoxProperties *boxProperties);
 
   private:
+  GstFlowReturn decodeTensor (GArray *results, GstBuffer *outbuf);
+  boxCanvas *getCanvas (size_t size);
+
   bounding_box_modes mode;
   BoxProperties *bdata;
 
@@ -303,6 +367,10 @@ class BoundingBox
 
   gboolean flag_use_label;
 
+  /* From option9 (output type) */
+  bounding_box_output_types output_type;
+  GPtrArray *canvases; /**< Cached output memories for dirty-rect overlay (boxCanvas) */
+
   /* Table for box properties data */
   inline static GHashTable *properties_table;
 };
@@ -9,6 +9,9 @@
  * @brief       NNStreamer tensor-decoder subplugin, "flatbuffer",
  *              which converts tensor or tensors to flatbuffer byte stream.
  *
+ * The flatbuffer is built in a GstMemory pre-sized from the tensor info,
+ * which is pushed downstream without copying the finished buffer.
+ *
  * @see         https://github.com/nnstreamer/nnstreamer
  * @author      Gichan Jang <gichan2.jang@samsung.com>
  * @bug         No known bugs except for NYI items
@@ -18,12 +21,14 @@
 #include <glib.h>
 #include <gst/gstinfo.h>
 #include <iostream>
+#include <new>
 #include <nnstreamer_generated.h> /* Generated by `flatc`. */
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_util.h>
 #include <typeinfo>
+#include <vector>
 #include "../extra/nnstreamer_flatbuf.h"
 #include "tensordecutil.h"
 
@@ -41,6 +46,90 @@ void fini_fbd (void) __attribute__ ((destructor));
 }
 #endif /* __cplusplus */
 
+/**
+ * @brief The extra size of the flatbuffer for a tensor (table, vectors and alignment)
+ */
+#define FBD_TENSOR_EXTRA_SIZE (128U)
+
+/**
+ * @brief Allocator of the flatbuffer builder, building the buffer in GstMemory.
+ */
+class GstMemoryAllocator : public flatbuffers::Allocator
+{
+  public:
+  /**
+   * @brief The memory block allocated for the builder.
+   */
+  typedef struct {
+    GstMemory *mem; /**< The memory */
+    GstMapInfo info; /**< The mapped info of the memory */
+  } block;
+
+  /**
+   * @brief Destructor of the allocator.
+   */
+  ~GstMemoryAllocator ()
+  {
+    for (auto &b : blocks) {
+      gst_memory_unmap (b.mem, &b.info);
+      gst_memory_unref (b.mem);
+    }
+  }
+
+  /**
+   * @brief Allocate the memory block.
+   */
+  uint8_t *allocate (size_t size) override
+  {
+    block b;
+
+    b.mem = gst_allocator_alloc (NULL, size, NULL);
+    if (!b.mem)
+      throw std::bad_alloc ();
+
+    if (!gst_memory_map (b.mem, &b.info, GST_MAP_WRITE)) {
+      gst_memory_unref (b.mem);
+      throw std::bad_alloc ();
+    }
+
+    blocks.push_back (b);
+    return b.info.data;
+  }
+
+  /**
+   * @brief Free the memory block, called when the builder grows the buffer.
+   */
+  void deallocate (uint8_t *p, size_t size) override
+  {
+    UNUSED (size);
+
+    for (auto it = blocks.begin (); it != blocks.end (); ++it) {
+      if (it->info.data == p) {
+        gst_memory_unmap (it->mem, &it->info);
+        gst_memory_unref (it->mem);
+        blocks.erase (it);
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the memory of the finished buffer, sharing the memory block.
+   */
+  GstMemory *share (const uint8_t *p, size_t size)
+  {
+    for (auto &b : blocks) {
+      if (p >= b.info.data && p + size <= b.info.data + b.info.size)
+        return gst_memory_share (b.mem, p - b.info.data, size);
+    }
+
+    return NULL;
+  }
+
+  private:
+  std::vector<block> blocks; /**< The allocated memory blocks */
+};
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static int
 fbd_init (void **pdata)
@@ -79,18 +168,15 @@ fbd_getOutCaps (void **pdata, const GstTensorsConfig *config)
   return caps;
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
-static GstFlowReturn
-fbd_decode (void **pdata, const GstTensorsConfig *config,
-    const GstTensorMemory *input, GstBuffer *outbuf)
+/**
+ * @brief Build the flatbuffer with the builder and get the memory of the buffer.
+ */
+static GstMemory *
+fbd_build (const GstTensorsConfig *config, const GstTensorMemory *input)
 {
   Tensor_type type;
   Tensor_format format;
-  GstMapInfo out_info;
-  GstMemory *out_mem;
   guint i, num_tensors;
-  flatbuffers::uoffset_t fb_size;
-  flatbuffers::FlatBufferBuilder builder;
   std::vector<flatbuffers::Offset<Tensor>> tensor_vector;
   flatbuffers::Offset<flatbuffers::Vector<uint32_t>> dim;
   flatbuffers::Offset<flatbuffers::String> tensor_name;
@@ -101,19 +187,28 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   gboolean is_flexible;
   GstTensorMetaInfo meta;
   GstTensorInfo *_info;
-
-  UNUSED (pdata);
-
-  if (!config || !input || !outbuf) {
-    ml_loge ("NULL parameter is passed to tensor_decoder::flatbuf");
-    return GST_FLOW_ERROR;
-  }
+  gsize estimated_size = FBD_TENSOR_EXTRA_SIZE;
 
   is_flexible = gst_tensors_config_is_flexible (config);
 
   num_tensors = config->info.num_tensors;
   fr = frame_rate (config->rate_n, config->rate_d);
   format = (Tensor_format) config->info.format;
+
+  /* The buffer is not grown (copied) if the size is enough */
+  for (i = 0; i < num_tensors; i++) {
+    _info = gst_tensors_info_get_nth_info ((GstTensorsInfo *) &config->info, i);
+
+    estimated_size += input[i].size + FBD_TENSOR_EXTRA_SIZE;
+    estimated_size += sizeof (uint32_t) * NNS_TENSOR_RANK_LIMIT;
+    if (_info->name)
+      estimated_size += strlen (_info->name);
+  }
+
+  /* The builder is freed before the allocator */
+  GstMemoryAllocator allocator;
+  flatbuffers::FlatBufferBuilder builder (estimated_size, &allocator, false);
+
   /* Fill the info in tensor and puth to tensor vector */
   for (i = 0; i < num_tensors; i++) {
     unsigned char *tmp_buf;
@@ -135,7 +230,6 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
     type = (Tensor_type) _info->type;
 
     /* Create the vector first, and fill in data later */
-    /** @todo Consider to remove memcpy */
     input_vector = builder.CreateUninitializedVector<unsigned char> (input[i].size, &tmp_buf);
     memcpy (tmp_buf, input[i].data, input[i].size);
 
@@ -148,31 +242,40 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
 
   /* Serialize the data.*/
   builder.Finish (tensors);
-  fb_size = builder.GetSize ();
 
-  if (gst_buffer_get_size (outbuf) == 0) {
-    out_mem = gst_allocator_alloc (NULL, fb_size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < fb_size) {
-      gst_buffer_set_size (outbuf, fb_size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+  return allocator.share (builder.GetBufferPointer (), builder.GetSize ());
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+fbd_decode (void **pdata, const GstTensorsConfig *config,
+    const GstTensorMemory *input, GstBuffer *outbuf)
+{
+  GstMemory *out_mem = NULL;
+
+  UNUSED (pdata);
+
+  if (!config || !input || !outbuf) {
+    ml_loge ("NULL parameter is passed to tensor_decoder::flatbuf");
+    return GST_FLOW_ERROR;
   }
 
-  if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
-    gst_memory_unref (out_mem);
-    nns_loge ("Cannot map gst memory (tensor decoder flatbuf)\n");
+  try {
+    out_mem = fbd_build (config, input);
+  } catch (const std::bad_alloc &e) {
+    nns_loge ("Cannot allocate gst memory (tensor decoder flatbuf): %s", e.what ());
     return GST_FLOW_ERROR;
   }
 
-  memcpy (out_info.data, builder.GetBufferPointer (), fb_size);
+  if (!out_mem) {
+    nns_loge ("Cannot get the flatbuffer memory (tensor decoder flatbuf)\n");
+    return GST_FLOW_ERROR;
+  }
 
-  gst_memory_unmap (out_mem, &out_info);
+  if (gst_buffer_get_size (outbuf) > 0)
+    gst_buffer_remove_all_memory (outbuf);
 
-  if (gst_buffer_get_size (outbuf) == 0)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  gst_buffer_append_memory (outbuf, out_mem);
 
   return GST_FLOW_OK;
 }
@@ -20,6 +20,12 @@
  * @brief       NNStreamer tensor-decoder subplugin, "image labeling",
  *              which converts image label tensors to text stream.
  *
+ * The labels of the top-k scores are found in a single pass, keeping the
+ * k indices in descending order. For float32 and uint8 scores, a block of
+ * 16 elements is compared with the k-th score at once and skipped if no
+ * element is larger. The label file is loaded once and shared by the
+ * decoders with the same file (see loadImageLabels).
+ *
  * @see         https://github.com/nnstreamer/nnstreamer
  * @author      MyungJoo Ham <myungjoo.ham@samsung.com>
  * @bug         No known bugs except for NYI items
@@ -37,17 +43,41 @@
 #include <nnstreamer_util.h>
 #include "tensordecutil.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define IL_NEON64_ENABLED
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define IL_SSE2_ENABLED
+#endif
+
 void init_il (void) __attribute__ ((constructor));
 void fini_il (void) __attribute__ ((destructor));
 
 #define DECODER_IL_TEXT_CAPS_STR \
     "text/x-raw, format = (string) utf8"
 
+/** @brief The number of elements compared at once to skip the block */
+#define IL_BLOCK_SIZE (16)
+
+/** @brief Output type of image labeling */
+typedef enum
+{
+  IL_OUTPUT_TEXT = 0,
+  IL_OUTPUT_TENSOR,
+} il_output_type;
+
 /** @brief Internal data structure for image labeling */
 typedef struct
 {
   imglabel_t labels;
   char *label_path;
+  guint top_k; /**< The number of labels to be decoded (option2) */
+  il_output_type output_type; /**< The output type (option3) */
+  gboolean dequantize; /**< Apply the scale and zero point to the scores (option4) */
+  gdouble scale; /**< The scale of the quantized scores */
+  gdouble zero_point; /**< The zero point of the quantized scores */
+  guint *top; /**< The indices of the top-k scores in descending order */
 } ImageLabelData;
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -55,12 +85,20 @@ static int
 il_init (void **pdata)
 {
   /** @todo check if we need to ensure plugin_data is not yet allocated */
-  *pdata = g_new0 (ImageLabelData, 1);
+  ImageLabelData *data;
+
+  data = *pdata = g_new0 (ImageLabelData, 1);
   if (*pdata == NULL) {
     GST_ERROR ("Failed to allocate memory for decoder subplugin.");
     return FALSE;
   }
 
+  data->top_k = 1U;
+  data->output_type = IL_OUTPUT_TEXT;
+  data->dequantize = FALSE;
+  data->scale = 1.0;
+  data->zero_point = 0.0;
+
   return TRUE;
 }
 
@@ -75,6 +113,7 @@ il_exit (void **pdata)
   if (data->label_path)
     g_free (data->label_path);
 
+  g_free (data->top);
   g_free (*pdata);
   *pdata = NULL;
 }
@@ -100,6 +139,76 @@ il_setOption (void **pdata, int opNum, const char *param)
       return FALSE;
   }
 
+  /* opNum 2 = the number of labels with the highest scores */
+  if (opNum == 1) {
+    guint64 k;
+    gchar *end = NULL;
+
+    k = param ? g_ascii_strtoull (param, &end, 10) : 0;
+    if (k == 0 || k > G_MAXUINT || end == param || *end != '\0') {
+      ml_loge ("Invalid top-k %s. It should be a positive integer.",
+          GST_STR_NULL (param));
+      return FALSE;
+    }
+
+    data->top_k = (guint) k;
+    return TRUE;
+  }
+
+  /* opNum 3 = output type */
+  if (opNum == 2) {
+    if (param && g_ascii_strcasecmp (param, "text") == 0) {
+      data->output_type = IL_OUTPUT_TEXT;
+    } else if (param && g_ascii_strcasecmp (param, "tensor") == 0) {
+      data->output_type = IL_OUTPUT_TENSOR;
+    } else {
+      ml_loge ("Invalid output type %s. It should be text or tensor.",
+          GST_STR_NULL (param));
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
+  /* opNum 4 = scale and zero point of the quantized scores */
+  if (opNum == 3) {
+    gchar **strv;
+    gchar *end = NULL;
+    gdouble scale, zero_point = 0.0;
+    gboolean valid;
+
+    if (param == NULL || param[0] == '\0') {
+      data->dequantize = FALSE;
+      return TRUE;
+    }
+
+    strv = g_strsplit (param, ":", -1);
+    valid = (g_strv_length (strv) <= 2);
+
+    if (valid) {
+      scale = g_ascii_strtod (strv[0], &end);
+      valid = (end != strv[0] && *end == '\0' && scale > 0.0);
+    }
+
+    if (valid && strv[1] != NULL) {
+      zero_point = g_ascii_strtod (strv[1], &end);
+      valid = (end != strv[1] && *end == '\0');
+    }
+
+    g_strfreev (strv);
+
+    if (!valid) {
+      ml_loge ("Invalid scale and zero point %s. It should be SCALE[:ZERO_POINT] with positive scale.",
+          param);
+      return FALSE;
+    }
+
+    data->dequantize = TRUE;
+    data->scale = scale;
+    data->zero_point = zero_point;
+    return TRUE;
+  }
+
   GST_INFO ("Property mode-option-%d is ignored", opNum + 1);
   return TRUE;
 }
@@ -108,10 +217,10 @@ il_setOption (void **pdata, int opNum, const char *param)
 static GstCaps *
 il_getOutCaps (void **pdata, const GstTensorsConfig * config)
 {
+  ImageLabelData *data = *pdata;
   const uint32_t *dim;
   GstCaps *caps;
   int i;
-  UNUSED (pdata);
 
   g_return_val_if_fail (config != NULL, NULL);
   g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
@@ -123,6 +232,27 @@ il_getOutCaps (void **pdata, const GstTensorsConfig * config)
   for (i = 2; i < NNS_TENSOR_RANK_LIMIT; i++)
     g_return_val_if_fail (dim[i] == 0, NULL);
 
+  if (data->output_type == IL_OUTPUT_TENSOR) {
+    GstTensorsConfig out_config;
+    guint k = MIN (data->top_k, dim[0]);
+
+    /* indices and scores of the top-k labels */
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 2;
+    out_config.info.info[0].type = _NNS_UINT32;
+    out_config.info.info[0].dimension[0] = k;
+    out_config.info.info[0].dimension[1] = 1;
+    out_config.info.info[1].type = _NNS_FLOAT32;
+    out_config.info.info[1].dimension[0] = k;
+    out_config.info.info[1].dimension[1] = 1;
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    caps = gst_tensors_caps_from_config (&out_config);
+    gst_tensors_config_free (&out_config);
+    return caps;
+  }
+
   caps = gst_caps_from_string (DECODER_IL_TEXT_CAPS_STR);
   setFramerateFromConfig (caps, config);
   return caps;
@@ -144,27 +274,241 @@ il_getTransformSize (void **pdata, const GstTensorsConfig * config,
   /** @todo Use max_word_length if that's appropriate */
 }
 
-/** @brief Search for max. Macro for tensor_element union */
-#define search_max(type, i, max_index, max_val, bpe, data, num_data) \
-do {\
-  unsigned int i;\
-  type *cursor = (type *) (data);\
-  max_val = cursor[0];\
-  max_index = 0;\
-  for (i = 1; i < (num_data); i++) {\
-    if (cursor[i] > (max_val)) {\
-      max_val = cursor[i];\
-      max_index = i;\
-    }\
-  }\
-} while (0);
-
-/** @brief Shorter case statement for search_max */
-#define search_max_case(type, typename) \
+/**
+ * @brief Insert the index to the top-k list if the value is larger than the k-th value.
+ * @note The earlier index is kept among the same values, as the argmax does.
+ */
+#define topk_insert(cursor, idx, top, count, k) do { \
+  guint _p = (count); \
+  if (_p == (k)) { \
+    if (!((cursor)[idx] > (cursor)[(top)[_p - 1]])) \
+      break; \
+    _p--; \
+  } else { \
+    (count)++; \
+  } \
+  while (_p > 0 && (cursor)[idx] > (cursor)[(top)[_p - 1]]) { \
+    (top)[_p] = (top)[_p - 1]; \
+    _p--; \
+  } \
+  (top)[_p] = (guint) (idx); \
+} while (0)
+
+/** @brief Define the function to get the top-k indices of the given type */
+#define define_topk(type) \
+static guint \
+il_topk_##type (const type * cursor, gsize num, guint * top, guint k) \
+{ \
+  guint count = 0; \
+  gsize i; \
+  for (i = 0; i < num; i++) \
+    topk_insert (cursor, i, top, count, k); \
+  return count; \
+}
+
+define_topk (int8_t)
+define_topk (int16_t)
+define_topk (uint16_t)
+define_topk (int32_t)
+define_topk (uint32_t)
+define_topk (int64_t)
+define_topk (uint64_t)
+define_topk (double)
+
+/** @brief Get the top-k indices of float32 scores */
+static guint
+il_topk_float (const float *cursor, gsize num, guint * top, guint k)
+{
+  guint count = 0;
+  gsize i = 0, j;
+
+  for (; i + IL_BLOCK_SIZE <= num; i += IL_BLOCK_SIZE) {
+    if (count == k) {
+      /* skip the block if no element is larger than the k-th score */
+#if defined(IL_NEON64_ENABLED)
+      const float32x4_t kth = vdupq_n_f32 (cursor[top[k - 1]]);
+      uint32x4_t gt;
+
+      gt = vorrq_u32 (vcgtq_f32 (vld1q_f32 (cursor + i), kth),
+          vcgtq_f32 (vld1q_f32 (cursor + i + 4), kth));
+      gt = vorrq_u32 (gt, vcgtq_f32 (vld1q_f32 (cursor + i + 8), kth));
+      gt = vorrq_u32 (gt, vcgtq_f32 (vld1q_f32 (cursor + i + 12), kth));
+      if (vmaxvq_u32 (gt) == 0)
+        continue;
+#elif defined(IL_SSE2_ENABLED)
+      const __m128 kth = _mm_set1_ps (cursor[top[k - 1]]);
+      __m128 gt;
+
+      gt = _mm_or_ps (_mm_cmpgt_ps (_mm_loadu_ps (cursor + i), kth),
+          _mm_cmpgt_ps (_mm_loadu_ps (cursor + i + 4), kth));
+      gt = _mm_or_ps (gt, _mm_cmpgt_ps (_mm_loadu_ps (cursor + i + 8), kth));
+      gt = _mm_or_ps (gt, _mm_cmpgt_ps (_mm_loadu_ps (cursor + i + 12), kth));
+      if (_mm_movemask_ps (gt) == 0)
+        continue;
+#endif
+    }
+
+    for (j = i; j < i + IL_BLOCK_SIZE; j++)
+      topk_insert (cursor, j, top, count, k);
+  }
+
+  for (; i < num; i++)
+    topk_insert (cursor, i, top, count, k);
+
+  return count;
+}
+
+/** @brief Get the top-k indices of uint8 (quantized) scores */
+static guint
+il_topk_uint8 (const uint8_t * cursor, gsize num, guint * top, guint k)
+{
+  guint count = 0;
+  gsize i = 0, j;
+
+  for (; i + IL_BLOCK_SIZE <= num; i += IL_BLOCK_SIZE) {
+    if (count == k) {
+      /* skip the block if no element is larger than the k-th score */
+#if defined(IL_NEON64_ENABLED)
+      const uint8x16_t kth = vdupq_n_u8 (cursor[top[k - 1]]);
+
+      if (vmaxvq_u8 (vcgtq_u8 (vld1q_u8 (cursor + i), kth)) == 0)
+        continue;
+#elif defined(IL_SSE2_ENABLED)
+      const __m128i kth = _mm_set1_epi8 ((char) cursor[top[k - 1]]);
+      const __m128i v = _mm_loadu_si128 ((const __m128i *) (cursor + i));
+
+      /* max (v, kth) equals to kth if v is not larger */
+      if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_max_epu8 (v, kth), kth)) == 0xFFFF)
+        continue;
+#endif
+    }
+
+    for (j = i; j < i + IL_BLOCK_SIZE; j++)
+      topk_insert (cursor, j, top, count, k);
+  }
+
+  for (; i < num; i++)
+    topk_insert (cursor, i, top, count, k);
+
+  return count;
+}
+
+/** @brief Shorter case statement for top-k */
+#define topk_case(type, typename, func) \
+case typename:\
+  count = func ((const type *) input_data, num_data, top, k);\
+  break;
+
+/** @brief Shorter case statement to get the score */
+#define score_case(type, typename) \
 case typename:\
-  search_max(type, i, max_index, max_val._##type, bpe, input_data, num_data);\
+  val = (gdouble) ((const type *) input_data)[index];\
   break;
 
+/** @brief Get the score of the index */
+static gfloat
+il_get_score (ImageLabelData * data, tensor_type type,
+    const void *input_data, guint index)
+{
+  gdouble val = 0.0;
+
+  switch (type) {
+      score_case (int32_t, _NNS_INT32);
+      score_case (uint32_t, _NNS_UINT32);
+      score_case (int16_t, _NNS_INT16);
+      score_case (uint16_t, _NNS_UINT16);
+      score_case (int8_t, _NNS_INT8);
+      score_case (uint8_t, _NNS_UINT8);
+      score_case (double, _NNS_FLOAT64);
+      score_case (float, _NNS_FLOAT32);
+      score_case (int64_t, _NNS_INT64);
+      score_case (uint64_t, _NNS_UINT64);
+    default:
+      break;
+  }
+
+  if (data->dequantize)
+    val = (val - data->zero_point) * data->scale;
+
+  return (gfloat) val;
+}
+
+/** @brief Write the indices and scores of the top-k labels to the output tensors */
+static GstFlowReturn
+il_decode_tensor (ImageLabelData * data, const GstTensorsConfig * config,
+    const void *input_data, guint count, GstBuffer * outbuf)
+{
+  GstMemory *mem[2];
+  GstMapInfo map[2];
+  guint32 *indices;
+  gfloat *scores;
+  guint i;
+
+  mem[0] = gst_allocator_alloc (NULL, count * sizeof (guint32), NULL);
+  mem[1] = gst_allocator_alloc (NULL, count * sizeof (gfloat), NULL);
+
+  if (!gst_memory_map (mem[0], &map[0], GST_MAP_WRITE)) {
+    ml_loge ("Cannot map output memory / tensordec-imagelabel.\n");
+    goto error;
+  }
+
+  if (!gst_memory_map (mem[1], &map[1], GST_MAP_WRITE)) {
+    ml_loge ("Cannot map output memory / tensordec-imagelabel.\n");
+    gst_memory_unmap (mem[0], &map[0]);
+    goto error;
+  }
+
+  indices = (guint32 *) map[0].data;
+  scores = (gfloat *) map[1].data;
+
+  for (i = 0; i < count; i++) {
+    indices[i] = data->top[i];
+    scores[i] = il_get_score (data, config->info.info[0].type, input_data,
+        data->top[i]);
+  }
+
+  gst_memory_unmap (mem[0], &map[0]);
+  gst_memory_unmap (mem[1], &map[1]);
+
+  if (gst_buffer_get_size (outbuf) > 0)
+    gst_buffer_remove_all_memory (outbuf);
+
+  gst_buffer_append_memory (outbuf, mem[0]);
+  gst_buffer_append_memory (outbuf, mem[1]);
+
+  return GST_FLOW_OK;
+
+error:
+  gst_memory_unref (mem[0]);
+  gst_memory_unref (mem[1]);
+  return GST_FLOW_ERROR;
+}
+
+/** @brief Make the text of the top-k labels */
+static gchar *
+il_get_text (ImageLabelData * data, const GstTensorsConfig * config,
+    const void *input_data, guint count)
+{
+  GString *text;
+  gchar score[G_ASCII_DTOSTR_BUF_SIZE];
+  guint i;
+
+  /* the label only with top-1, as the previous output */
+  if (data->top_k == 1U)
+    return g_strdup (data->labels.labels[data->top[0]]);
+
+  text = g_string_new (NULL);
+  for (i = 0; i < count; i++) {
+    g_ascii_formatd (score, sizeof (score), "%.6f",
+        il_get_score (data, config->info.info[0].type, input_data,
+            data->top[i]));
+
+    g_string_append_printf (text, "%s%s\t%s", (i > 0) ? "\n" : "",
+        data->labels.labels[data->top[i]], score);
+  }
+
+  return g_string_free (text, FALSE);
+}
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
@@ -176,42 +520,58 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   GstMemory *out_mem;
 
   gsize bpe = gst_tensor_get_element_size (config->info.info[0].type);
-  tensor_element max_val;
-  guint max_index = 0;
   gsize num_data;               /* Size / bpe */
   void *input_data;
+  guint *top;
+  guint i, k, count = 0;
 
   gsize size;
-  char *str;
+  gchar *str;
 
   g_assert (bpe > 0);
   g_assert (outbuf);
 
   input_data = input->data;
   num_data = gst_tensor_info_get_size (&config->info.info[0]) / bpe;
+  k = (guint) MIN ((gsize) data->top_k, num_data);
+
+  if (k == 0)
+    return GST_FLOW_ERROR;
+
+  data->top = g_renew (guint, data->top, data->top_k);
+  top = data->top;
 
   switch (config->info.info[0].type) {
-      search_max_case (int32_t, _NNS_INT32);
-      search_max_case (uint32_t, _NNS_UINT32);
-      search_max_case (int16_t, _NNS_INT16);
-      search_max_case (uint16_t, _NNS_UINT16);
-      search_max_case (int8_t, _NNS_INT8);
-      search_max_case (uint8_t, _NNS_UINT8);
-      search_max_case (double, _NNS_FLOAT64);
-      search_max_case (float, _NNS_FLOAT32);
-      search_max_case (int64_t, _NNS_INT64);
-      search_max_case (uint64_t, _NNS_UINT64);
+      topk_case (int32_t, _NNS_INT32, il_topk_int32_t);
+      topk_case (uint32_t, _NNS_UINT32, il_topk_uint32_t);
+      topk_case (int16_t, _NNS_INT16, il_topk_int16_t);
+      topk_case (uint16_t, _NNS_UINT16, il_topk_uint16_t);
+      topk_case (int8_t, _NNS_INT8, il_topk_int8_t);
+      topk_case (uint8_t, _NNS_UINT8, il_topk_uint8);
+      topk_case (double, _NNS_FLOAT64, il_topk_double);
+      topk_case (float, _NNS_FLOAT32, il_topk_float);
+      topk_case (int64_t, _NNS_INT64, il_topk_int64_t);
+      topk_case (uint64_t, _NNS_UINT64, il_topk_uint64_t);
     default:
       return GST_FLOW_NOT_SUPPORTED;
   }
 
-  g_assert (max_index < data->labels.total_labels);
+  if (data->output_type == IL_OUTPUT_TENSOR)
+    return il_decode_tensor (data, config, input_data, count, outbuf);
+
+  for (i = 0; i < count; i++) {
+    if (top[i] >= data->labels.total_labels) {
+      ml_loge ("The index %u is out of the labels (%u). Please check the label data.",
+          top[i], data->labels.total_labels);
+      return GST_FLOW_ERROR;
+    }
+  }
 
-  /** @todo With option-2, allow to change output format */
-  str = data->labels.labels[max_index];
+  str = il_get_text (data, config, input_data, count);
 
   if (!str || (size = strlen (str)) == 0) {
     ml_loge ("Invalid labels. Please check the label data.");
+    g_free (str);
     return GST_FLOW_ERROR;
   }
 
@@ -228,12 +588,14 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     ml_loge ("Cannot map output memory / tensordec-imagelabel.\n");
     gst_memory_unref (out_mem);
+    g_free (str);
     return GST_FLOW_ERROR;
   }
 
   memcpy (out_info.data, str, size);
 
   gst_memory_unmap (out_mem, &out_info);
+  g_free (str);
 
   if (gst_buffer_get_size (outbuf) == 0)
     gst_buffer_append_memory (outbuf, out_mem);
@@ -263,6 +625,9 @@ init_il (void)
   nnstreamer_decoder_probe (&imageLabeling);
   nnstreamer_decoder_set_custom_property_desc (
       decoder_subplugin_image_labeling, "option1", "The path to the label file",
+      "option2", "The number of labels with the highest scores (top-k). Default is 1. The labels and scores are written line by line if it is larger than 1.",
+      "option3", "The output type, 'text' (default) for the labels or 'tensor' for the indices (uint32) and scores (float32) of the top-k labels.",
+      "option4", "The scale and zero point of the quantized scores, SCALE[:ZERO_POINT]. The score is (value - ZERO_POINT) * SCALE.",
       NULL);
 }
 
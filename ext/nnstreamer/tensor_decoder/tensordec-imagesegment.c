@@ -34,6 +34,8 @@
  *
  * option2: Maximum number of class labels (except background), default is 20 (Pascal)
  *
+ * option3: Number of threads to find the labels of tflite-deeplab, default is 1
+ *
  * expected models
  * - tflite-deeplab : deeplabv3_257_mv_gpu.tflite (designed for embedded devices)
  * - snpe-deeplab   : deeplabv3_mnv2_pascal_train_aug.dlc (converted from a TF model)
@@ -64,6 +66,11 @@
  * - Resize image into 257:257 at the first videoscale.
  * - Transfrom RGB value into float32 in range [0,1] at tensor_transform.
  *
+ * For tflite-deeplab, the label of each pixel (the channel of the max
+ * probability) and its color are found in a single pass over the
+ * probabilities, 4 channels at a time with NEON or SSE2. The pixels are
+ * split into the tiles, which are decoded in parallel if option3 is given.
+ *
  * gst-launch-1.0 -v \
  *    filesrc location=cat.png ! decodebin ! videoconvert ! videoscale ! imagefreeze !\
  *    video/x-raw,format=RGB,width=257,height=257,framerate=10/1 ! tee name=t \
@@ -90,11 +97,17 @@
 #define NEON64_ENABLED
 #define GRAYSCALE_HEX (0x00010101)
 #define ALPHA_HEX     (0xFF000000)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+
+#define SSE2_ENABLED
 #endif
 
 #define DEFAULT_LABELS  (20)
 #define RGBA_CHANNEL    (4)
 #define MAX_RGB         (255)
+#define MAX_THREADS     (64)
+#define TILE_PIXELS     (16384)
 
 void init_is (void) __attribute__ ((constructor));
 void fini_is (void) __attribute__ ((destructor));
@@ -138,6 +151,10 @@ typedef struct
 
   GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
+
+  guint num_threads;        /**< The number of threads to find the labels */
+  guint pool_threads;       /**< The number of threads of the thread pool */
+  GThreadPool *thread_pool; /**< The thread pool to decode the tiles, used only in the streaming thread */
 } image_segments;
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -160,6 +177,9 @@ is_init (void **pdata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
+  idata->num_threads = 1;
+  idata->pool_threads = 1;
+  idata->thread_pool = NULL;
 
   return TRUE;
 }
@@ -168,6 +188,8 @@ is_init (void **pdata)
 static void
 _free_resources (image_segments * idata)
 {
+  gst_tensor_tile_pool_free (idata->thread_pool);
+
   g_free (idata->segment_map);
   g_free (idata->color_map);
   g_rand_free (idata->rand);
@@ -175,6 +197,7 @@ _free_resources (image_segments * idata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rand = NULL;
+  idata->thread_pool = NULL;
 }
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -237,6 +260,18 @@ is_setOption (void **pdata, int op_num, const char *param)
     guint64 max_labels_64 = g_ascii_strtoll (param, NULL, 10);
     if (max_labels_64 != 0 && max_labels_64 <= UINT_MAX)
       idata->max_labels = (guint) max_labels_64;
+  } else if (op_num == 2) {
+    guint64 num_threads = param ? g_ascii_strtoull (param, NULL, 10) : 0;
+
+    if (num_threads == 0 || num_threads > MAX_THREADS) {
+      GST_ERROR ("Invalid number of threads %s, it should be 1 ~ %d.",
+          GST_STR_NULL (param), MAX_THREADS);
+      return FALSE;
+    }
+
+    /* the thread pool is replaced in the streaming thread, see set_label_color() */
+    idata->num_threads = (guint) num_threads;
+    return TRUE;
   }
 
   GST_WARNING ("mode-option-\"%d\" is not definded.", op_num);
@@ -248,10 +283,7 @@ static gboolean
 _init_modes (image_segments * idata)
 {
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    /* init image segments if seg map is null */
-    if (idata->segment_map == NULL)
-      idata->segment_map = g_new0 (float, idata->height * idata->width);
-
+    /* the labels are not stored, the colors are set in the same pass */
     if (idata->color_map == NULL) {
       idata->color_map = g_new (guint, idata->max_labels + 1);
       _fill_color_map (idata);
@@ -507,36 +539,108 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
   }
 }
 
-/** @brief Set label index according to each pixel's label probabilities */
+/**
+ * @brief Find the label of a pixel, the first channel of the max probability.
+ * @return The label, or 0 (background) if the max probability is not larger than the threshold.
+ * @note NaN in the probabilities is ignored unless it is in the first channel.
+ */
+static inline guint
+find_pixel_label (const float *prob, guint total_labels)
+{
+  float max_prob = prob[0];
+  guint idx = 1;
+
+  /* NaN, regarded as background */
+  if (G_UNLIKELY (max_prob != max_prob))
+    return 0;
+
+#if defined (NEON64_ENABLED)
+  {
+    float32x4_t v_max = vdupq_n_f32 (max_prob);
+
+    for (; idx + 4 <= total_labels; idx += 4)
+      v_max = vmaxnmq_f32 (v_max, vld1q_f32 (prob + idx));
+
+    max_prob = vmaxnmvq_f32 (v_max);
+  }
+#elif defined (SSE2_ENABLED)
+  {
+    __m128 v_max = _mm_set1_ps (max_prob);
+
+    /* the second operand is returned if either is NaN */
+    for (; idx + 4 <= total_labels; idx += 4)
+      v_max = _mm_max_ps (_mm_loadu_ps (prob + idx), v_max);
+
+    v_max = _mm_max_ps (v_max, _mm_shuffle_ps (v_max, v_max,
+            _MM_SHUFFLE (2, 3, 0, 1)));
+    v_max = _mm_max_ps (v_max, _mm_shuffle_ps (v_max, v_max,
+            _MM_SHUFFLE (1, 0, 3, 2)));
+    max_prob = _mm_cvtss_f32 (v_max);
+  }
+#endif
+  for (; idx < total_labels; idx++) {
+    if (prob[idx] > max_prob)
+      max_prob = prob[idx];
+  }
+
+  if (!(max_prob > DETECTION_THRESHOLD))
+    return 0;
+
+  /* the first channel of the max probability */
+  idx = 0;
+  while (prob[idx] != max_prob)
+    idx++;
+
+  return idx;
+}
+
+/**
+ * @brief Data structure of the output frame, shared with the threads.
+ */
+typedef struct
+{
+  image_segments *idata;    /**< The decoder */
+  const float *prob_map;    /**< The label probabilities */
+  uint32_t *output;         /**< The RGBA output */
+} label_job;
+
+/** @brief Set the label color of the pixels in [start, end) */
 static void
-set_label_index (image_segments * idata, void *data)
+set_label_color_part (gsize start, gsize end, gpointer user_data)
 {
-  float *prob_map = (float *) data;
-  guint idx, i, j;
-  int max_idx;
-  float max_prob;
-  guint total_labels = idata->max_labels + 1;
-
-  memset (idata->segment_map, '\x00',
-      (size_t) idata->width * idata->height * sizeof (float));
-
-  for (i = 0; i < idata->height; i++) {
-    for (j = 0; j < idata->width; j++) {
-      max_idx = 0;
-      max_prob = prob_map[i * idata->width * total_labels + j * total_labels];
-      for (idx = 1; idx < total_labels; idx++) {
-        float prob = prob_map[i * idata->width * total_labels
-            + j * total_labels + idx];
-        if (prob > max_prob) {
-          max_prob = prob;
-          max_idx = idx;
-        }
-      }
-      if (max_prob > DETECTION_THRESHOLD) {
-        idata->segment_map[i * idata->width + j] = (float) max_idx;
-      }                         /* otherwise, regarded as background */
-    }
+  label_job *job = (label_job *) user_data;
+  guint total_labels = job->idata->max_labels + 1;
+  const float *prob = job->prob_map + start * total_labels;
+  gsize idx;
+
+  for (idx = start; idx < end; idx++, prob += total_labels)
+    job->output[idx] =
+        job->idata->color_map[find_pixel_label (prob, total_labels)];
+}
+
+/**
+ * @brief Set the color of each pixel's label from the label probabilities (RGBA)
+ * Each tile writes the disjoint pixels, thus the result does not depend on the number of threads.
+ */
+static void
+set_label_color (image_segments * idata, void *data, GstMapInfo * out_info)
+{
+  label_job job;
+  guint num_threads = idata->num_threads;
+
+  /* option3 may be changed while decoding, the pool is replaced only here */
+  if (idata->pool_threads != num_threads) {
+    gst_tensor_tile_pool_free (idata->thread_pool);
+    idata->thread_pool = gst_tensor_tile_pool_new (num_threads);
+    idata->pool_threads = num_threads;
   }
+
+  job.idata = idata;
+  job.prob_map = (const float *) data;
+  job.output = (uint32_t *) out_info->data;
+
+  gst_tensor_tile_run (idata->thread_pool, set_label_color_part,
+      (gsize) idata->height * idata->width, TILE_PIXELS, &job);
 }
 
 /** @brief set color to output buffer depending on each mode */
@@ -545,8 +649,7 @@ set_color (image_segments * idata, void *data, GstMapInfo * out_info)
 {
   /* tflite-deeplab needs to perform extra post-processing to set labels */
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    set_label_index (idata, data);
-    set_color_according_to_label (idata, out_info);
+    set_label_color (idata, data, out_info);
     return;
   }
 
@@ -606,7 +709,9 @@ is_decode (void **pdata, const GstTensorsConfig * config,
     goto error_free;
   }
 
-  memset (out_info.data, '\x00', size);
+  /* tflite-deeplab sets all pixels */
+  if (idata->mode != MODE_TFLITE_DEEPLAB)
+    memset (out_info.data, '\x00', size);
 
   if (!check_sanity (idata, config)) {
     ml_loge ("Invalid input data format detected.\n");
@@ -654,6 +759,7 @@ init_is (void)
       "option1",
       "Mode of image segmentation. { tflite-deeplab (input: #labels x width x height (float32, label probability). e.g., deeplabv3_257_mv_gpu.tflite), snpe-deeplab (input: width x height x 1 (float32, label index) e.g., deeplabv3_mnv2_pascal_train_aug.dlc), snpe-depth (input: 1 x width x height (float32, grayscale) e.g., .dlc snpe models producing grayscale images) }",
       "option2", "Maximum number of labels. 20 is applied if not specified.",
+      "option3", "Number of threads to find the labels of tflite-deeplab (1 ~ 64). 1 is applied if not specified.",
       NULL);
 }
 
@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer / NNStreamer tensor_decoder subplugin, "bounding boxes"
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file        tensordec-nms.cc
+ * @date        16 Oct 2026
+ * @brief       Non-maximum suppression of the bounding box decoder.
+ *
+ * The candidates are sorted by the score once, optionally limited to the
+ * top-k and grouped by the class. The boxes of each group are copied into
+ * a structure-of-arrays, so IoU of a box with the following boxes is
+ * evaluated 4 lanes at a time, and the survivors are compacted in a
+ * single pass.
+ *
+ * @see         https://github.com/nnstreamer/nnstreamer
+ * @author      MyungJoo Ham <myungjoo.ham@samsung.com>
+ * @bug         No known bugs except for NYI items
+ */
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+#include "tensordec-boundingbox.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define NMS_NEON64_ENABLED
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define NMS_SSE2_ENABLED
+#endif
+
+/**
+ * @brief Boxes of the candidates in structure-of-arrays layout.
+ */
+typedef struct {
+  std::vector<gfloat> x1; /**< left */
+  std::vector<gfloat> y1; /**< top */
+  std::vector<gfloat> x2; /**< right (x + width) */
+  std::vector<gfloat> y2; /**< bottom (y + height) */
+  std::vector<gfloat> area; /**< width * height */
+  std::vector<guint32> suppressed; /**< All bits set if suppressed */
+} nmsBoxes;
+
+/**
+ * @brief Suppress the boxes in [from, to) overlapping with the box idx.
+ * @note The operations are the same as iou() of the old implementation in
+ *       float, so the result does not depend on the vector path.
+ */
+static void
+nms_suppress (nmsBoxes &boxes, guint idx, guint from, guint to, gfloat threshold)
+{
+  const gfloat ax1 = boxes.x1[idx];
+  const gfloat ay1 = boxes.y1[idx];
+  const gfloat ax2 = boxes.x2[idx];
+  const gfloat ay2 = boxes.y2[idx];
+  const gfloat aarea = boxes.area[idx];
+  guint j = from;
+
+#if defined(NMS_NEON64_ENABLED)
+  const float32x4_t v_ax1 = vdupq_n_f32 (ax1);
+  const float32x4_t v_ay1 = vdupq_n_f32 (ay1);
+  const float32x4_t v_ax2 = vdupq_n_f32 (ax2);
+  const float32x4_t v_ay2 = vdupq_n_f32 (ay2);
+  const float32x4_t v_aarea = vdupq_n_f32 (aarea);
+  const float32x4_t v_one = vdupq_n_f32 (1.f);
+  const float32x4_t v_zero = vdupq_n_f32 (0.f);
+  const float32x4_t v_threshold = vdupq_n_f32 (threshold);
+
+  for (; j + 4 <= to; j += 4) {
+    float32x4_t w, h, inter, o;
+    uint32x4_t mask;
+
+    w = vaddq_f32 (vsubq_f32 (vminq_f32 (v_ax2, vld1q_f32 (&boxes.x2[j])),
+                       vmaxq_f32 (v_ax1, vld1q_f32 (&boxes.x1[j]))),
+        v_one);
+    h = vaddq_f32 (vsubq_f32 (vminq_f32 (v_ay2, vld1q_f32 (&boxes.y2[j])),
+                       vmaxq_f32 (v_ay1, vld1q_f32 (&boxes.y1[j]))),
+        v_one);
+    w = vmaxq_f32 (w, v_zero);
+    h = vmaxq_f32 (h, v_zero);
+    inter = vmulq_f32 (w, h);
+    o = vdivq_f32 (inter,
+        vsubq_f32 (vaddq_f32 (v_aarea, vld1q_f32 (&boxes.area[j])), inter));
+
+    /* negative or NaN IoU is 0 */
+    o = vbslq_f32 (vcgeq_f32 (o, v_zero), o, v_zero);
+    mask = vcgtq_f32 (o, v_threshold);
+    vst1q_u32 (&boxes.suppressed[j], vorrq_u32 (vld1q_u32 (&boxes.suppressed[j]), mask));
+  }
+#elif defined(NMS_SSE2_ENABLED)
+  const __m128 v_ax1 = _mm_set1_ps (ax1);
+  const __m128 v_ay1 = _mm_set1_ps (ay1);
+  const __m128 v_ax2 = _mm_set1_ps (ax2);
+  const __m128 v_ay2 = _mm_set1_ps (ay2);
+  const __m128 v_aarea = _mm_set1_ps (aarea);
+  const __m128 v_one = _mm_set1_ps (1.f);
+  const __m128 v_zero = _mm_setzero_ps ();
+  const __m128 v_threshold = _mm_set1_ps (threshold);
+
+  for (; j + 4 <= to; j += 4) {
+    __m128 w, h, inter, o, mask;
+    __m128i sup;
+
+    w = _mm_add_ps (_mm_sub_ps (_mm_min_ps (v_ax2, _mm_loadu_ps (&boxes.x2[j])),
+                        _mm_max_ps (v_ax1, _mm_loadu_ps (&boxes.x1[j]))),
+        v_one);
+    h = _mm_add_ps (_mm_sub_ps (_mm_min_ps (v_ay2, _mm_loadu_ps (&boxes.y2[j])),
+                        _mm_max_ps (v_ay1, _mm_loadu_ps (&boxes.y1[j]))),
+        v_one);
+    w = _mm_max_ps (w, v_zero);
+    h = _mm_max_ps (h, v_zero);
+    inter = _mm_mul_ps (w, h);
+    o = _mm_div_ps (inter,
+        _mm_sub_ps (_mm_add_ps (v_aarea, _mm_loadu_ps (&boxes.area[j])), inter));
+
+    /* negative or NaN IoU is 0 */
+    o = _mm_and_ps (o, _mm_cmpge_ps (o, v_zero));
+    mask = _mm_cmpgt_ps (o, v_threshold);
+
+    sup = _mm_loadu_si128 ((const __m128i *) &boxes.suppressed[j]);
+    sup = _mm_or_si128 (sup, _mm_castps_si128 (mask));
+    _mm_storeu_si128 ((__m128i *) &boxes.suppressed[j], sup);
+  }
+#endif
+
+  for (; j < to; j++) {
+    gfloat w = MAX (0.f, MIN (ax2, boxes.x2[j]) - MAX (ax1, boxes.x1[j]) + 1.f);
+    gfloat h = MAX (0.f, MIN (ay2, boxes.y2[j]) - MAX (ay1, boxes.y1[j]) + 1.f);
+    gfloat inter = w * h;
+    gfloat o = inter / (aarea + boxes.area[j] - inter);
+
+    o = (o >= 0.f) ? o : 0.f;
+    if (o > threshold)
+      boxes.suppressed[j] = G_MAXUINT32;
+  }
+}
+
+/**
+ * @brief Apply NMS to the given results with the options.
+ */
+void
+nms (GArray *results, const nmsOptions *options)
+{
+  detectedObject *objects;
+  std::vector<guint> order;
+  std::vector<guint> group;
+  std::vector<guint8> keep;
+  std::vector<detectedObject> survivors;
+  nmsBoxes boxes;
+  guint i, num, start;
+
+  g_return_if_fail (results != NULL);
+  g_return_if_fail (options != NULL);
+
+  if (results->len == 0U)
+    return;
+
+  objects = &g_array_index (results, detectedObject, 0);
+
+  order.reserve (results->len);
+  for (i = 0; i < results->len; i++) {
+    if (objects[i].valid == TRUE)
+      order.push_back (i);
+  }
+
+  /* larger score first, the earlier one first if the scores are the same */
+  auto by_score = [objects] (guint a, guint b) {
+    if (objects[a].prob != objects[b].prob)
+      return objects[a].prob > objects[b].prob;
+    return a < b;
+  };
+
+  if (options->top_k > 0U && order.size () > options->top_k) {
+    std::nth_element (order.begin (), order.begin () + options->top_k,
+        order.end (), by_score);
+    order.resize (options->top_k);
+  }
+  std::sort (order.begin (), order.end (), by_score);
+
+  /* boxes of the same class are contiguous in the group order */
+  group = order;
+  if (options->class_aware) {
+    std::stable_sort (group.begin (), group.end (), [objects] (guint a, guint b) {
+      return objects[a].class_id < objects[b].class_id;
+    });
+  }
+
+  num = group.size ();
+  boxes.x1.resize (num);
+  boxes.y1.resize (num);
+  boxes.x2.resize (num);
+  boxes.y2.resize (num);
+  boxes.area.resize (num);
+  boxes.suppressed.assign (num, 0U);
+
+  for (i = 0; i < num; i++) {
+    const detectedObject *o = &objects[group[i]];
+
+    boxes.x1[i] = (gfloat) o->x;
+    boxes.y1[i] = (gfloat) o->y;
+    boxes.x2[i] = (gfloat) (o->x + o->width);
+    boxes.y2[i] = (gfloat) (o->y + o->height);
+    boxes.area[i] = (gfloat) (o->width * o->height);
+  }
+
+  keep.assign (results->len, FALSE);
+
+  for (start = 0; start < num;) {
+    guint end = start + 1;
+
+    if (options->class_aware) {
+      while (end < num && objects[group[end]].class_id == objects[group[start]].class_id)
+        end++;
+    } else {
+      end = num;
+    }
+
+    for (i = start; i < end; i++) {
+      if (boxes.suppressed[i])
+        continue;
+
+      keep[group[i]] = TRUE;
+      nms_suppress (boxes, i, i + 1, end, options->iou_threshold);
+    }
+
+    start = end;
+  }
+
+  /* single compaction pass in the order of the score */
+  survivors.reserve (num);
+  for (i = 0; i < order.size (); i++) {
+    if (keep[order[i]])
+      survivors.push_back (objects[order[i]]);
+  }
+
+  if (!survivors.empty ())
+    memcpy (objects, survivors.data (), survivors.size () * sizeof (detectedObject));
+  g_array_set_size (results, survivors.size ());
+}
+
+/**
+ * @brief Apply NMS to the given results (objects[DETECTION_MAX])
+ */
+void
+nms (GArray *results, gfloat threshold)
+{
+  nmsOptions options = { threshold, FALSE, 0U };
+
+  nms (results, &options);
+}
@@ -13,63 +13,148 @@
  */
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <string.h>
 #include <nnstreamer_log.h>
 #include "tensordecutil.h"
 #include <gst/gstvalue.h>
 
 /**
- * @brief Load label file into the internal data
- * @param[in/out] l The given ImageLabelData struct.
+ * @brief Label table loaded once and shared by the decoders with the same label file.
  */
-void
-loadImageLabels (const char *label_path, imglabel_t * l)
+typedef struct
+{
+  gchar *path; /**< The path of the label file, the key of the table */
+  gint64 mtime; /**< The modification time of the file when loaded */
+  goffset size; /**< The size of the file when loaded */
+  guint refcount; /**< The number of decoders using the table */
+  gchar *contents; /**< The contents of the file, each label is null-terminated */
+  char **labels; /**< The list of labels, pointing to the contents */
+  guint total_labels; /**< The number of labels */
+  gsize max_word_length; /**< The max size of labels */
+} imglabel_table_t;
+
+G_LOCK_DEFINE_STATIC (label_tables_lock);
+static GHashTable *label_tables = NULL;
+
+/**
+ * @brief Free the label table.
+ */
+static void
+_free_label_table (imglabel_table_t * table)
+{
+  g_free (table->path);
+  g_free (table->contents);
+  g_free (table->labels);
+  g_free (table);
+}
+
+/**
+ * @brief Read the label file and make the label table.
+ */
+static imglabel_table_t *
+_load_label_table (const char *label_path, const GStatBuf * st)
 {
   GError *err = NULL;
-  gchar **_labels;
+  imglabel_table_t *table;
   gchar *contents = NULL;
+  gchar *pos, *end, *next;
   gsize len;
   guint i;
 
-  _free_labels (l);
-
   /* Read file contents */
   if (!g_file_get_contents (label_path, &contents, &len, &err)) {
     ml_loge ("Unable to read file %s with error %s.", label_path, err->message);
     g_clear_error (&err);
-    return;
+    return NULL;
+  }
+
+  if (len == 0) {
+    ml_loge ("The label file %s is empty.", label_path);
+    g_free (contents);
+    return NULL;
   }
 
   if (contents[len - 1] == '\n')
-    contents[len - 1] = '\0';
-
-  _labels = g_strsplit (contents, "\n", -1);
-  l->total_labels = g_strv_length (_labels);
-  l->labels = g_new0 (char *, l->total_labels);
-  if (l->labels == NULL) {
-    ml_loge ("Failed to allocate memory for label data.");
-    l->total_labels = 0;
-    goto error;
+    contents[--len] = '\0';
+
+  table = g_new0 (imglabel_table_t, 1);
+  table->path = g_strdup (label_path);
+  table->mtime = (gint64) st->st_mtime;
+  table->size = (goffset) st->st_size;
+  table->refcount = 1;
+  table->contents = contents;
+
+  end = contents + len;
+  table->total_labels = 1;
+  for (pos = contents; (pos = memchr (pos, '\n', end - pos)) != NULL; pos++)
+    table->total_labels++;
+
+  /* labels point to the contents, newline is replaced with null */
+  table->labels = g_new (char *, table->total_labels);
+  pos = contents;
+  for (i = 0; i < table->total_labels; i++) {
+    next = memchr (pos, '\n', end - pos);
+    if (next == NULL)
+      next = end;
+
+    *next = '\0';
+    table->labels[i] = pos;
+    table->max_word_length = MAX (table->max_word_length, (gsize) (next - pos));
+    pos = next + 1;
   }
 
-  for (i = 0; i < l->total_labels; i++) {
-    l->labels[i] = g_strdup (_labels[i]);
+  ml_logi ("Loaded image label file successfully. %u labels loaded.",
+      table->total_labels);
+  return table;
+}
 
-    len = strlen (_labels[i]);
-    if (len > l->max_word_length) {
-      l->max_word_length = len;
-    }
+/**
+ * @brief Load label file into the internal data
+ * @details The labels are loaded once and shared by the decoders with the same file.
+ *          The file is loaded again if it is modified.
+ * @param[in/out] l The given ImageLabelData struct.
+ */
+void
+loadImageLabels (const char *label_path, imglabel_t * l)
+{
+  imglabel_table_t *table;
+  GStatBuf st;
+
+  _free_labels (l);
+
+  if (label_path == NULL || g_stat (label_path, &st) != 0) {
+    ml_loge ("Unable to read file %s.", GST_STR_NULL (label_path));
+    return;
   }
 
-error:
-  g_strfreev (_labels);
-  g_free (contents);
+  G_LOCK (label_tables_lock);
+
+  if (label_tables == NULL)
+    label_tables = g_hash_table_new (g_str_hash, g_str_equal);
+
+  table = (imglabel_table_t *) g_hash_table_lookup (label_tables, label_path);
+  if (table && table->mtime == (gint64) st.st_mtime &&
+      table->size == (goffset) st.st_size) {
+    table->refcount++;
+  } else {
+    /* the old table is freed when the decoders using it release it */
+    if (table)
+      g_hash_table_remove (label_tables, label_path);
 
-  if (l->labels != NULL) {
-    ml_logi ("Loaded image label file successfully. %u labels loaded.",
-        l->total_labels);
+    table = _load_label_table (label_path, &st);
+    if (table)
+      g_hash_table_insert (label_tables, table->path, table);
+  }
+
+  G_UNLOCK (label_tables_lock);
+
+  if (table) {
+    l->labels = table->labels;
+    l->total_labels = table->total_labels;
+    l->max_word_length = table->max_word_length;
+    l->table = table;
   }
-  return;
 }
 
 /**
@@ -110,13 +195,22 @@ initSingleLineSprite (singleLineSprite_t v, rasters_t r, uint32_t pv)
 void
 _free_labels (imglabel_t * data)
 {
-  guint i;
+  imglabel_table_t *table = (imglabel_table_t *) data->table;
 
-  if (data->labels) {
-    for (i = 0; i < data->total_labels; i++)
-      g_free (data->labels[i]);
-    g_free (data->labels);
+  if (table) {
+    G_LOCK (label_tables_lock);
+
+    if (--table->refcount == 0) {
+      if (g_hash_table_lookup (label_tables, table->path) == table)
+        g_hash_table_remove (label_tables, table->path);
+
+      _free_label_table (table);
+    }
+
+    G_UNLOCK (label_tables_lock);
   }
+
+  data->table = NULL;
   data->labels = NULL;
   data->total_labels = 0;
   data->max_word_length = 0;
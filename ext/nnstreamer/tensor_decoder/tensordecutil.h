@@ -25,9 +25,10 @@ typedef uint32_t singleLineSprite_t[256][13][8];
 typedef uint8_t rasters_t[][13];
 
 typedef struct {
-  char **labels; /**< The list of loaded labels. Null if not loaded */
+  char **labels; /**< The list of loaded labels. Null if not loaded. Shared with other decoders, do not modify */
   guint total_labels; /**< The number of loaded labels */
   gsize max_word_length; /**< The max size of labels */
+  gpointer table; /**< The label table shared by the decoders loading the same file */
 } imglabel_t;
 
 extern void
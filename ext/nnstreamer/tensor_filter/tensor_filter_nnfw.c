@@ -733,7 +733,7 @@ nnfw_invoke_internal (const nnfw_pdata * pdata,
     const nnfw_tinfo_s * in_info, const nnfw_tinfo_s * out_info,
     const GstTensorMemory * input, GstTensorMemory * output)
 {
-  int64_t start_time, stop_time;
+  int64_t start_time, stop_time, overhead;
   int err;
   NNFW_STATUS status;
 
@@ -748,7 +748,7 @@ nnfw_invoke_internal (const nnfw_pdata * pdata,
     return err;
 
   stop_time = g_get_monotonic_time ();
-  nnfw_internal_stats.total_overhead_latency += stop_time - start_time;
+  overhead = stop_time - start_time;
 
   start_time = g_get_monotonic_time ();
   status = nnfw_run (pdata->session);
@@ -759,8 +759,8 @@ nnfw_invoke_internal (const nnfw_pdata * pdata,
     err = (status == NNFW_STATUS_INSUFFICIENT_OUTPUT_SIZE) ? -EAGAIN : -EINVAL;
   }
 
-  nnfw_internal_stats.total_invoke_latency += stop_time - start_time;
-  nnfw_internal_stats.total_invoke_num += 1;
+  nnstreamer_filter_statistics_add (&nnfw_internal_stats,
+      stop_time - start_time, overhead);
 
 #if (DBG)
   g_message ("Invoke() is finished: %" G_GINT64_FORMAT "ms, model path: %s", (stop_time - start_time) / 1000, pdata->model_file);
@@ -18,9 +18,13 @@
  * @todo Only CPU is supported. GPU and other hardware support is NYI.
  */
 
+#include <functional>
 #include <iostream>
+#include <sys/utsname.h>
+#include <unistd.h>
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <nnstreamer_cppplugin_api_filter.hh>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api_util.h>
@@ -51,8 +55,22 @@ class onnxruntime_subplugin final : public tensor_filter_subplugin
     std::vector<std::vector<int64_t>> shapes;
     std::vector<ONNXTensorElementDataType> types;
     std::vector<Ort::Value> tensors;
+    std::vector<void *> bound; /**< The buffers bound to the tensors */
   } onnx_node_info_s;
 
+  /**
+   * @brief Session options given by custom properties.
+   */
+  typedef struct {
+    int intra_op_threads; /**< 0 for the default of onnxruntime */
+    int inter_op_threads; /**< 0 for the default of onnxruntime */
+    GraphOptimizationLevel opt_level;
+    ExecutionMode exec_mode;
+    bool cpu_mem_arena;
+    bool mem_pattern;
+    std::string cache_dir; /**< directory to store the optimized models */
+  } onnx_option_s;
+
   bool configured;
   char *model_path; /**< The model *.onnx file */
 
@@ -60,6 +78,7 @@ class onnxruntime_subplugin final : public tensor_filter_subplugin
   Ort::SessionOptions sessionOptions;
   Ort::Env env;
   Ort::MemoryInfo memInfo;
+  Ort::IoBinding ioBinding;
 
   onnx_node_info_s inputNode;
   onnx_node_info_s outputNode;
@@ -68,6 +87,12 @@ class onnxruntime_subplugin final : public tensor_filter_subplugin
   static onnxruntime_subplugin *registeredRepresentation;
 
   void cleanup ();
+  void parseCustomProperties (const GstTensorFilterProperties *prop, onnx_option_s &option);
+  void setSessionOptions (const onnx_option_s &option);
+  static std::string getCpuFeatures ();
+  std::string getOptimizedModelPath (const onnx_option_s &option);
+  void createSession (const onnx_option_s &option);
+  void bindTensor (onnx_node_info_s &node, size_t idx, void *data, size_t size, bool is_input);
   void clearNodeInfo (onnx_node_info_s &node);
   void convertTensorInfo (onnx_node_info_s &node, GstTensorsInfo &info);
   int convertTensorDim (std::vector<int64_t> &shapes, tensor_dim &dim);
@@ -93,7 +118,7 @@ class onnxruntime_subplugin final : public tensor_filter_subplugin
  */
 onnxruntime_subplugin::onnxruntime_subplugin ()
     : configured{ false }, model_path{ nullptr }, session{ nullptr },
-      sessionOptions{ nullptr }, env{ nullptr }, memInfo{ nullptr }
+      sessionOptions{ nullptr }, env{ nullptr }, memInfo{ nullptr }, ioBinding{ nullptr }
 {
 }
 
@@ -112,6 +137,7 @@ onnxruntime_subplugin::cleanup ()
   if (!configured)
     return; /* Nothing to do if it is an empty model */
 
+  ioBinding = Ort::IoBinding{ nullptr };
   session = Ort::Session{ nullptr };
   sessionOptions = Ort::SessionOptions{ nullptr };
   env = Ort::Env{ nullptr };
@@ -137,6 +163,256 @@ onnxruntime_subplugin::clearNodeInfo (onnx_node_info_s &node)
   node.shapes.clear ();
   node.types.clear ();
   node.tensors.clear ();
+  node.bound.clear ();
+}
+
+/**
+ * @brief Parse the custom properties to set the session options.
+ */
+void
+onnxruntime_subplugin::parseCustomProperties (
+    const GstTensorFilterProperties *prop, onnx_option_s &option)
+{
+  using uniq_g_strv = std::unique_ptr<gchar *, std::function<void (gchar **)>>;
+  const char *custom_props = prop->custom_properties;
+
+  /* set default values */
+  option.intra_op_threads = 0;
+  option.inter_op_threads = 0;
+  option.opt_level = GraphOptimizationLevel::ORT_ENABLE_ALL;
+  option.exec_mode = ExecutionMode::ORT_SEQUENTIAL;
+  option.cpu_mem_arena = true;
+  option.mem_pattern = true;
+  option.cache_dir.clear ();
+
+  if (!custom_props)
+    return;
+
+  /* split with , to parse options */
+  uniq_g_strv options (g_strsplit (custom_props, ",", -1), g_strfreev);
+  guint len = g_strv_length (options.get ());
+
+  for (guint i = 0; i < len; i++) {
+    /* split with : to parse single option, the path may contain ':' */
+    uniq_g_strv pair (g_strsplit (options.get ()[i], ":", 2), g_strfreev);
+
+    if (g_strv_length (pair.get ()) != 2) {
+      nns_logw ("Invalid custom property '%s' (KEY:VALUE), ignored.", options.get ()[i]);
+      continue;
+    }
+
+    gchar *key = g_strstrip (pair.get ()[0]);
+    gchar *value = g_strstrip (pair.get ()[1]);
+
+    if (g_ascii_strcasecmp (key, "NumThreads") == 0) {
+      option.intra_op_threads = (int) g_ascii_strtoll (value, NULL, 10);
+    } else if (g_ascii_strcasecmp (key, "InterOpNumThreads") == 0) {
+      option.inter_op_threads = (int) g_ascii_strtoll (value, NULL, 10);
+    } else if (g_ascii_strcasecmp (key, "GraphOptimizationLevel") == 0) {
+      if (g_ascii_strcasecmp (value, "disable") == 0)
+        option.opt_level = GraphOptimizationLevel::ORT_DISABLE_ALL;
+      else if (g_ascii_strcasecmp (value, "basic") == 0)
+        option.opt_level = GraphOptimizationLevel::ORT_ENABLE_BASIC;
+      else if (g_ascii_strcasecmp (value, "extended") == 0)
+        option.opt_level = GraphOptimizationLevel::ORT_ENABLE_EXTENDED;
+      else if (g_ascii_strcasecmp (value, "all") == 0)
+        option.opt_level = GraphOptimizationLevel::ORT_ENABLE_ALL;
+      else
+        nns_logw ("Invalid option for GraphOptimizationLevel: %s, ignored.", value);
+    } else if (g_ascii_strcasecmp (key, "ExecutionMode") == 0) {
+      if (g_ascii_strcasecmp (value, "sequential") == 0)
+        option.exec_mode = ExecutionMode::ORT_SEQUENTIAL;
+      else if (g_ascii_strcasecmp (value, "parallel") == 0)
+        option.exec_mode = ExecutionMode::ORT_PARALLEL;
+      else
+        nns_logw ("Invalid option for ExecutionMode: %s, ignored.", value);
+    } else if (g_ascii_strcasecmp (key, "CpuMemArena") == 0) {
+      option.cpu_mem_arena = (g_ascii_strcasecmp (value, "false") != 0);
+    } else if (g_ascii_strcasecmp (key, "MemPattern") == 0) {
+      option.mem_pattern = (g_ascii_strcasecmp (value, "false") != 0);
+    } else if (g_ascii_strcasecmp (key, "OptimizedModelCache") == 0) {
+      if (g_file_test (value, G_FILE_TEST_IS_DIR))
+        option.cache_dir = value;
+      else
+        nns_logw ("Invalid directory for OptimizedModelCache: %s, the model is not cached.", value);
+    } else {
+      nns_logw ("Unsupported custom property: %s, ignored.", key);
+    }
+  }
+}
+
+/**
+ * @brief Set the session options given by custom properties.
+ */
+void
+onnxruntime_subplugin::setSessionOptions (const onnx_option_s &option)
+{
+  sessionOptions = Ort::SessionOptions ();
+
+  if (option.intra_op_threads > 0)
+    sessionOptions.SetIntraOpNumThreads (option.intra_op_threads);
+  if (option.inter_op_threads > 0)
+    sessionOptions.SetInterOpNumThreads (option.inter_op_threads);
+
+  sessionOptions.SetGraphOptimizationLevel (option.opt_level);
+  sessionOptions.SetExecutionMode (option.exec_mode);
+
+  if (option.cpu_mem_arena)
+    sessionOptions.EnableCpuMemArena ();
+  else
+    sessionOptions.DisableCpuMemArena ();
+
+  if (option.mem_pattern)
+    sessionOptions.EnableMemPattern ();
+  else
+    sessionOptions.DisableMemPattern ();
+}
+
+/**
+ * @brief Get the architecture and the features of the CPU.
+ * @details The optimized model with extended or all level may use the kernels
+ *          for the CPU features, it cannot be shared with other machines.
+ */
+std::string
+onnxruntime_subplugin::getCpuFeatures ()
+{
+  std::string features;
+  struct utsname uts;
+  g_autofree gchar *cpuinfo = NULL;
+
+  if (uname (&uts) == 0)
+    features = uts.machine;
+
+  /* the first 'flags' (x86) or 'Features' (arm) line of the cpuinfo */
+  if (g_file_get_contents ("/proc/cpuinfo", &cpuinfo, NULL, NULL)) {
+    g_auto (GStrv) lines = g_strsplit (cpuinfo, "\n", -1);
+
+    for (guint i = 0; lines[i] != NULL; i++) {
+      if (g_str_has_prefix (lines[i], "flags") || g_str_has_prefix (lines[i], "Features")) {
+        features += lines[i];
+        break;
+      }
+    }
+  }
+
+  return features;
+}
+
+/**
+ * @brief Get the path of the optimized model in the cache directory.
+ * @details The name is the hash of the model, the optimization level, the
+ *          version and the execution providers of onnxruntime and the CPU
+ *          features, so that a changed model or machine optimizes the model again.
+ */
+std::string
+onnxruntime_subplugin::getOptimizedModelPath (const onnx_option_s &option)
+{
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GMappedFile) mapped = g_mapped_file_new (model_path, FALSE, &error);
+
+  if (!mapped) {
+    nns_logw ("Failed to read the model to cache: %s", error ? error->message : "unknown");
+    return std::string ();
+  }
+
+  g_autoptr (GChecksum) checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) g_mapped_file_get_contents (mapped),
+      g_mapped_file_get_length (mapped));
+  g_checksum_update (checksum, (const guchar *) &option.opt_level, sizeof (option.opt_level));
+  g_checksum_update (checksum, (const guchar *) OrtGetApiBase ()->GetVersionString (), -1);
+
+  for (const std::string &provider : Ort::GetAvailableProviders ())
+    g_checksum_update (checksum, (const guchar *) provider.c_str (), provider.size () + 1);
+
+  std::string features = getCpuFeatures ();
+  g_checksum_update (checksum, (const guchar *) features.c_str (), features.size ());
+
+  g_autofree gchar *filename = g_strdup_printf ("%s.onnx", g_checksum_get_string (checksum));
+  g_autofree gchar *path = g_build_filename (option.cache_dir.c_str (), filename, NULL);
+
+  return std::string (path);
+}
+
+/**
+ * @brief Create the session, load the optimized model from the cache if possible.
+ */
+void
+onnxruntime_subplugin::createSession (const onnx_option_s &option)
+{
+  std::string cache_path;
+
+  setSessionOptions (option);
+
+  if (!option.cache_dir.empty () && option.opt_level != GraphOptimizationLevel::ORT_DISABLE_ALL)
+    cache_path = getOptimizedModelPath (option);
+
+  if (cache_path.empty ()) {
+    session = Ort::Session (env, model_path, sessionOptions);
+    return;
+  }
+
+  if (g_file_test (cache_path.c_str (), G_FILE_TEST_IS_REGULAR)) {
+    /* the cached model is already optimized */
+    try {
+      sessionOptions.SetGraphOptimizationLevel (GraphOptimizationLevel::ORT_DISABLE_ALL);
+      session = Ort::Session (env, cache_path.c_str (), sessionOptions);
+      nns_logi ("Loaded the optimized model from %s", cache_path.c_str ());
+      return;
+    } catch (const Ort::Exception &exception) {
+      nns_logw ("Failed to load the cached model %s (%s), optimize the model again.",
+          cache_path.c_str (), exception.what ());
+      g_remove (cache_path.c_str ());
+      sessionOptions.SetGraphOptimizationLevel (option.opt_level);
+    }
+  }
+
+  /**
+   * Write the optimized model to a unique temporary file in the cache directory,
+   * other pipelines (or threads) may read or write the cache at the same time.
+   */
+  g_autofree gchar *tmp_path = g_strdup_printf ("%s.XXXXXX", cache_path.c_str ());
+  int fd = g_mkstemp (tmp_path);
+
+  if (fd < 0) {
+    nns_logw ("Failed to create a temporary file to cache the optimized model in %s",
+        option.cache_dir.c_str ());
+    session = Ort::Session (env, model_path, sessionOptions);
+    return;
+  }
+  close (fd);
+
+  try {
+    sessionOptions.SetOptimizedModelFilePath (tmp_path);
+    session = Ort::Session (env, model_path, sessionOptions);
+  } catch (...) {
+    g_remove (tmp_path);
+    throw;
+  }
+
+  if (g_rename (tmp_path, cache_path.c_str ()) != 0) {
+    nns_logw ("Failed to store the optimized model to %s", cache_path.c_str ());
+    g_remove (tmp_path);
+  }
+}
+
+/**
+ * @brief Bind the buffer to the tensor, the binding is kept until the buffer is changed.
+ */
+void
+onnxruntime_subplugin::bindTensor (
+    onnx_node_info_s &node, size_t idx, void *data, size_t size, bool is_input)
+{
+  if (node.bound[idx] == data)
+    return;
+
+  node.tensors[idx] = Ort::Value::CreateTensor (memInfo, data, size,
+      node.shapes[idx].data (), node.shapes[idx].size (), node.types[idx]);
+  node.bound[idx] = data;
+
+  if (is_input)
+    ioBinding.BindInput (node.names[idx], node.tensors[idx]);
+  else
+    ioBinding.BindOutput (node.names[idx], node.tensors[idx]);
 }
 
 /**
@@ -260,6 +536,7 @@ void
 onnxruntime_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 {
   size_t i, num_inputs, num_outputs;
+  onnx_option_s option;
 
   if (configured) {
     /* Already opened */
@@ -276,11 +553,13 @@ onnxruntime_subplugin::configure_instance (const GstTensorFilterProperties *prop
     throw std::runtime_error (err_msg);
   }
 
+  parseCustomProperties (prop, option);
+
   model_path = g_strdup (prop->model_files[0]);
 
   /* Read a model */
   env = Ort::Env (ORT_LOGGING_LEVEL_WARNING, "nnstreamer_onnxruntime");
-  session = Ort::Session (env, model_path, sessionOptions);
+  createSession (option);
 
   num_inputs = session.GetInputCount ();
   if (num_inputs <= 0 || num_inputs > NNS_TENSOR_SIZE_LIMIT) {
@@ -335,6 +614,13 @@ onnxruntime_subplugin::configure_instance (const GstTensorFilterProperties *prop
   memInfo = Ort::MemoryInfo::CreateCpu (
       OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
 
+  /* The binding is re-pointed only when the buffer of the tensor is changed. */
+  ioBinding = Ort::IoBinding (session);
+  inputNode.tensors.resize (num_inputs);
+  inputNode.bound.assign (num_inputs, nullptr);
+  outputNode.tensors.resize (num_outputs);
+  outputNode.bound.assign (num_outputs, nullptr);
+
   configured = true;
   allocator = Ort::AllocatorWithDefaultOptions{ nullptr }; /* delete unique_ptr */
 }
@@ -348,33 +634,21 @@ onnxruntime_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *ou
   size_t i;
   g_assert (configured);
 
-  inputNode.tensors.clear ();
-  outputNode.tensors.clear ();
-
   if (!input)
     throw std::runtime_error ("Invalid input buffer, it is NULL.");
   if (!output)
     throw std::runtime_error ("Invalid output buffer, it is NULL.");
 
-  /* Set input to tensor */
-  for (i = 0; i < inputNode.count; ++i) {
-    inputNode.tensors.emplace_back (Ort::Value::CreateTensor (memInfo,
-        input[i].data, input[i].size, inputNode.shapes[i].data (),
-        inputNode.shapes[i].size (), inputNode.types[i]));
-  }
+  try {
+    /* Set input and output buffers to the binding */
+    for (i = 0; i < inputNode.count; ++i)
+      bindTensor (inputNode, i, input[i].data, input[i].size, true);
 
-  /* Set output to tensor */
-  for (i = 0; i < outputNode.count; ++i) {
-    outputNode.tensors.emplace_back (Ort::Value::CreateTensor (memInfo,
-        output[i].data, output[i].size, outputNode.shapes[i].data (),
-        outputNode.shapes[i].size (), outputNode.types[i]));
-  }
+    for (i = 0; i < outputNode.count; ++i)
+      bindTensor (outputNode, i, output[i].data, output[i].size, false);
 
-  try {
     /* call Run() to fill in the GstTensorMemory *output data with the probabilities of each */
-    session.Run (Ort::RunOptions{ nullptr }, inputNode.names.data (),
-        inputNode.tensors.data (), inputNode.count, outputNode.names.data (),
-        outputNode.tensors.data (), outputNode.count);
+    session.Run (Ort::RunOptions{ nullptr }, ioBinding);
   } catch (const Ort::Exception &exception) {
     const std::string err_msg
         = "ERROR running model inference: " + (std::string) exception.what ();
@@ -438,6 +712,15 @@ onnxruntime_subplugin::init_filter_onnxruntime ()
 {
   registeredRepresentation
       = tensor_filter_subplugin::register_subplugin<onnxruntime_subplugin> ();
+  nnstreamer_filter_set_custom_property_desc (name, "NumThreads",
+      "The number of threads to run an operator. Set 0 for default behaviors.",
+      "InterOpNumThreads", "The number of threads to run operators in parallel (ExecutionMode:parallel).",
+      "GraphOptimizationLevel", "Graph optimization level {'disable', 'basic', 'extended', 'all' (default)}",
+      "ExecutionMode", "Execution mode of the graph {'sequential' (default), 'parallel'}",
+      "CpuMemArena", "Use the memory arena on CPU {'true' (default), 'false'}",
+      "MemPattern", "Pre-allocate the memory with the pattern of the previous run {'true' (default), 'false'}",
+      "OptimizedModelCache", "Directory to store the optimized model, so the model is not optimized again.",
+      NULL);
 }
 
 /** @brief Destruct the sub-plugin for onnxruntime. */
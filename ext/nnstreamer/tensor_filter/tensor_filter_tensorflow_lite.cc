@@ -131,6 +131,7 @@ typedef struct {
   gint num_threads; /**< the number of threads */
   const gchar *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  gboolean zero_copy; /**< push the interpreter-owned output buffers downstream */
 } tflite_option_s;
 
 /**
@@ -161,8 +162,10 @@ class TFLiteInterpreter
   TFLiteInterpreter ();
   ~TFLiteInterpreter ();
 
-  int invoke (const GstTensorMemory *input, GstTensorMemory *output);
+  int invoke (const GstTensorMemory *input, GstTensorMemory *output,
+      bool bind_output = false);
   int loadModel (int num_threads, tflite_delegate_e delegate);
+  bool releaseOutput (void *data);
 
   int setInputTensorProp ();
   int setOutputTensorProp ();
@@ -213,11 +216,25 @@ class TFLiteInterpreter
     return delegate_ptr.get ();
   }
 
+  /** @brief check if XNNPACK delegate is used */
+  bool isXnnpackDelegated ()
+  {
+    return is_xnnpack_delegated;
+  }
+
+  /** @brief check if the output buffers are still used by downstream */
+  bool isOutputInFlight ()
+  {
+    return g_atomic_int_get (&outputs_in_flight) > 0;
+  }
+
   private:
   GMutex mutex;
   char *model_path;
   bool is_cached_after_first_invoke; /**< To cache again after first invoke */
   bool is_xnnpack_delegated; /**< To check if XNNPACK delegate is used */
+  gint outputs_in_flight; /**< The number of output buffers pushed downstream */
+  void *bound_output[NNS_TENSOR_SIZE_LIMIT]; /**< The output buffers pushed downstream */
   char *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
 
@@ -254,6 +271,28 @@ class TFLiteCore
   int setInputTensorDim (const GstTensorsInfo *info);
   int reloadModel (const char *model_path);
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
+  void releaseOutput (void *data);
+  /** @brief check if the output buffers of the interpreter are pushed downstream */
+  gboolean isZeroCopy ()
+  {
+    return interpreter_pair != nullptr;
+  }
+  /** @brief check if downstream still holds the output buffers of the interpreters */
+  gboolean isOutputInFlight ()
+  {
+    return interpreter->isOutputInFlight ()
+           || (interpreter_pair && interpreter_pair->isOutputInFlight ());
+  }
+  /** @brief mark the core closed, to be deleted when the last output buffer is released */
+  void setClosed ()
+  {
+    closed = TRUE;
+  }
+  /** @brief check if the core is closed by tensor_filter */
+  gboolean isClosed ()
+  {
+    return closed;
+  }
   /** @brief cache input and output tensor ptr before invoke */
   int cacheInOutTensorPtr ();
   /** @brief callback method to delete interpreter for shared model */
@@ -268,6 +307,15 @@ class TFLiteCore
 
   TFLiteInterpreter *interpreter;
   TFLiteInterpreter *interpreter_sub;
+  TFLiteInterpreter *interpreter_pair; /**< second interpreter to double-buffer the outputs */
+  guint pair_index; /**< index of the interpreter to be invoked next */
+  gboolean closed; /**< TRUE if closed while downstream holds the output buffers */
+
+  TFLiteInterpreter *getPairedInterpreter (guint index)
+  {
+    return (index == 0) ? interpreter : interpreter_pair;
+  }
+  int initPairedInterpreter ();
 
   gchar *shared_tensor_filter_key;
   gboolean checkSharedInterpreter (const GstTensorFilterProperties *prop);
@@ -282,6 +330,13 @@ void fini_filter_tflite (void) __attribute__ ((destructor));
 
 G_LOCK_DEFINE_STATIC (slock);
 
+/**
+ * @brief The interpreter-owned output buffers pushed downstream (ZeroCopy), mapped to the core.
+ * The core is kept alive until all of them are released, even after tensor_filter closes it.
+ */
+static GHashTable *tflite_outputs = nullptr;
+G_LOCK_DEFINE_STATIC (tflite_outputs);
+
 /**
  * @brief TFLiteInterpreter constructor
  */
@@ -301,6 +356,8 @@ TFLiteInterpreter::TFLiteInterpreter ()
 
   is_cached_after_first_invoke = false;
   is_xnnpack_delegated = false;
+  outputs_in_flight = 0;
+  memset (bound_output, 0, sizeof (bound_output));
 }
 
 /**
@@ -320,11 +377,14 @@ TFLiteInterpreter::~TFLiteInterpreter ()
 
 /**
  * @brief Internal implementation of TFLiteCore's invoke()
+ * @param bind_output set the output tensors with the interpreter-owned buffers
+ *        instead of copying the result (XNNPACK delegate only). The buffers
+ *        should not be overwritten until releaseOutput() is called for each.
  */
 int
-TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output)
+TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output, bool bind_output)
 {
-  int64_t start_time, stop_time;
+  int64_t start_time, stop_time, overhead, latency;
   TfLiteTensor *tensor_ptr;
   TfLiteStatus status;
 
@@ -354,17 +414,29 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   }
 
   stop_time = g_get_monotonic_time ();
-
-  tflite_internal_stats.total_overhead_latency += stop_time - start_time;
+  overhead = stop_time - start_time;
 
   start_time = g_get_monotonic_time ();
   status = interpreter->Invoke ();
+  stop_time = g_get_monotonic_time ();
+  latency = stop_time - start_time;
 
-  /**
-   * After the very first invoke, the output buffer address may change.
-   * To handle the case, memcpy the output buffer directly.
-   */
-  if (is_xnnpack_delegated || !is_cached_after_first_invoke) {
+  /* copying the outputs is counted as the overhead */
+  start_time = stop_time;
+
+  if (bind_output && is_xnnpack_delegated && status == kTfLiteOk) {
+    for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+      tensor_ptr = outputTensorPtr[i];
+      g_assert (tensor_ptr->bytes == output[i].size);
+      output[i].data = bound_output[i] = tensor_ptr->data.raw;
+    }
+
+    g_atomic_int_add (&outputs_in_flight, (gint) outputTensorMeta.num_tensors);
+  } else if (is_xnnpack_delegated || !is_cached_after_first_invoke) {
+    /**
+     * After the very first invoke, the output buffer address may change.
+     * To handle the case, memcpy the output buffer directly.
+     */
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
       tensor_ptr = outputTensorPtr[i];
       g_assert (tensor_ptr->bytes == output[i].size);
@@ -373,13 +445,13 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   }
 
   stop_time = g_get_monotonic_time ();
+  overhead += stop_time - start_time;
 
-  tflite_internal_stats.total_invoke_latency += stop_time - start_time;
-  tflite_internal_stats.total_invoke_num += 1;
+  nnstreamer_filter_statistics_add (&tflite_internal_stats, latency, overhead);
 
 #if (DBG)
   ml_logi ("Invoke() is finished: %" G_GINT64_FORMAT "ms, model path: %s",
-      (stop_time - start_time) / 1000, getModelPath ());
+      latency / 1000, getModelPath ());
   ml_logi ("%" G_GINT64_FORMAT " invoke average %" G_GINT64_FORMAT
            ", total overhead %" G_GINT64_FORMAT,
       tflite_internal_stats.total_invoke_num,
@@ -403,6 +475,26 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   return 0;
 }
 
+/**
+ * @brief Release the output buffer pushed downstream by invoke().
+ * @return true if the data is the output buffer of this interpreter.
+ */
+bool
+TFLiteInterpreter::releaseOutput (void *data)
+{
+  if (g_atomic_int_get (&outputs_in_flight) == 0)
+    return false;
+
+  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+    if (bound_output[i] == data) {
+      g_atomic_int_add (&outputs_in_flight, -1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * @brief Internal implementation of TFLiteCore's loadModel()
  * @return 0 if OK. non-zero if error.
@@ -862,6 +954,9 @@ TFLiteCore::TFLiteCore (const GstTensorFilterProperties *prop)
   accelerator = ACCL_NONE;
   delegate = TFLITE_DELEGATE_NONE;
   interpreter_sub = nullptr;
+  interpreter_pair = nullptr;
+  pair_index = 0;
+  closed = FALSE;
   shared_tensor_filter_key = NULL;
 
   if (prop->shared_tensor_filter_key) {
@@ -898,6 +993,8 @@ TFLiteCore::~TFLiteCore ()
   } else {
     delete interpreter;
   }
+
+  delete interpreter_pair;
 }
 
 /**
@@ -1006,6 +1103,46 @@ TFLiteCore::init (tflite_option_s *option)
     ml_loge ("Failed to cache input and output tensors storage\n");
     return -4;
   }
+
+  if (option->zero_copy) {
+    if (!interpreter->isXnnpackDelegated ()) {
+      ml_logw ("ZeroCopy is available only with XNNPACK delegate, the option is ignored.");
+    } else if (shared_tensor_filter_key) {
+      ml_logw ("ZeroCopy is not available with the shared model, the option is ignored.");
+    } else if (initPairedInterpreter ()) {
+      ml_logw ("Failed to load the model for ZeroCopy, the option is ignored.");
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief load the second interpreter to push the output buffers downstream.
+ * @details XNNPACK delegate uses fixed buffers, so the next invoke would overwrite
+ *          the outputs downstream still holds. Invoke the two interpreters in turn
+ *          to double-buffer the outputs.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::initPairedInterpreter ()
+{
+  const char *_ext_delegate_path;
+  GHashTable *_ext_delegate_kv;
+  TFLiteInterpreter *pair = new TFLiteInterpreter ();
+
+  pair->setModelPath (interpreter->getModelPath ());
+  interpreter->getExtDelegate (&_ext_delegate_path, &_ext_delegate_kv);
+  pair->setExtDelegate (_ext_delegate_path, _ext_delegate_kv);
+
+  if (pair->loadModel (num_threads, delegate) != 0 || !pair->isXnnpackDelegated ()
+      || pair->setInputTensorProp () != 0 || pair->setOutputTensorProp () != 0
+      || pair->cacheInOutTensorPtr () != 0) {
+    delete pair;
+    return -EINVAL;
+  }
+
+  interpreter_pair = pair;
   return 0;
 }
 
@@ -1121,6 +1258,12 @@ TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
   err = interpreter->setInputTensorsInfo (info);
   interpreter->unlock ();
 
+  if (err == 0 && interpreter_pair) {
+    interpreter_pair->lock ();
+    err = interpreter_pair->setInputTensorsInfo (info);
+    interpreter_pair->unlock ();
+  }
+
   return err;
 }
 
@@ -1189,6 +1332,10 @@ TFLiteCore::reloadModel (const char *_model_path)
     ml_loge ("The path of model file(s), %s, to reload is invalid.", _model_path);
     return -EINVAL;
   }
+  if (isZeroCopy ()) {
+    ml_loge ("Cannot reload the model with ZeroCopy, downstream may hold the output buffers of the interpreter.");
+    return -EPERM;
+  }
   interpreter_sub = new TFLiteInterpreter ();
   interpreter_sub->setModelPath (_model_path);
   interpreter->getExtDelegate (&_ext_delegate_path, &_ext_delegate_kv);
@@ -1243,15 +1390,73 @@ error:
 int
 TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
+  TFLiteInterpreter *target;
+  const GstTensorsInfo *info;
+  bool bind_output = false;
+  guint i;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->invoke (input, output);
-  interpreter->unlock ();
+  if (!isZeroCopy ()) {
+    interpreter->lock ();
+    err = interpreter->invoke (input, output);
+    interpreter->unlock ();
+
+    return err;
+  }
+
+  /* invoke the interpreter whose outputs are released by downstream */
+  target = getPairedInterpreter (pair_index);
+  if (target->isOutputInFlight ()) {
+    pair_index = (pair_index + 1) % 2;
+    target = getPairedInterpreter (pair_index);
+  }
+
+  info = target->getOutputTensorsInfo ();
+  if (!target->isOutputInFlight ()) {
+    bind_output = true;
+    pair_index = (pair_index + 1) % 2;
+  } else {
+    /* both are held, copy the result into new buffers */
+    for (i = 0; i < info->num_tensors; i++)
+      output[i].data = g_malloc (output[i].size);
+  }
+
+  target->lock ();
+  err = target->invoke (input, output, bind_output);
+  target->unlock ();
+
+  if (err == 0 && bind_output) {
+    /* destroyNotify finds the core with the buffer, even after it is closed */
+    G_LOCK (tflite_outputs);
+    if (tflite_outputs == nullptr)
+      tflite_outputs = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (i = 0; i < info->num_tensors; i++)
+      g_hash_table_insert (tflite_outputs, output[i].data, this);
+    G_UNLOCK (tflite_outputs);
+  }
+
+  if (err != 0 && !bind_output) {
+    for (i = 0; i < info->num_tensors; i++) {
+      g_free (output[i].data);
+      output[i].data = nullptr;
+    }
+  }
 
   return err;
 }
 
+/**
+ * @brief Release the interpreter-owned output buffer, called when downstream does not use it anymore.
+ */
+void
+TFLiteCore::releaseOutput (void *data)
+{
+  if (interpreter->releaseOutput (data))
+    return;
+  if (interpreter_pair)
+    interpreter_pair->releaseOutput (data);
+}
+
 /**
  * @brief cache input and output tensor ptr before invoke
  */
@@ -1282,6 +1487,7 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->num_threads = -1;
   option->ext_delegate_path = nullptr;
   option->ext_delegate_kv_table = nullptr;
+  option->zero_copy = FALSE;
 
   if (prop->custom_properties) {
     gchar **strv;
@@ -1310,6 +1516,8 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
             option->delegate = TFLITE_DELEGATE_EXTERNAL;
           else
             ml_logw ("Unknown option to set tensorflow-lite delegate (%s).", pair[1]);
+        } else if (g_ascii_strcasecmp (pair[0], "ZeroCopy") == 0) {
+          option->zero_copy = (g_ascii_strcasecmp (pair[1], "true") == 0);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateLib") == 0) {
           option->ext_delegate_path = g_strdup (pair[1]);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateKeyVal") == 0) {
@@ -1366,6 +1574,14 @@ tflite_close (const GstTensorFilterProperties *prop, void **private_data)
   if (!core)
     return;
 
+  /* downstream may hold the output buffers, the last one deletes the core */
+  G_LOCK (tflite_outputs);
+  if (core->isOutputInFlight ()) {
+    core->setClosed ();
+    core = nullptr;
+  }
+  G_UNLOCK (tflite_outputs);
+
   delete core;
   *private_data = NULL;
 }
@@ -1618,6 +1834,56 @@ tflite_reloadModel (const GstTensorFilterProperties *prop, void **private_data)
   return core->reloadModel (prop->model_files[0]);
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : tensorflow lite plugin's private data
+ * @return 0 if the subplugin sets the output buffers in invoke.
+ */
+static int
+tflite_allocateInInvoke (void **private_data)
+{
+  TFLiteCore *core = static_cast<TFLiteCore *> (*private_data);
+
+  if (core && core->isZeroCopy ())
+    return 0;
+
+  return -EINVAL;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : tensorflow lite plugin's private data
+ * @param data the output buffer to be released
+ */
+static void
+tflite_destroyNotify (void **private_data, void *data)
+{
+  TFLiteCore *core = nullptr;
+  gboolean release_core = FALSE;
+  UNUSED (private_data);
+
+  /**
+   * Do not use the private data, which is NULL or another core once
+   * tensor_filter closes the core owning the buffer.
+   */
+  G_LOCK (tflite_outputs);
+  if (tflite_outputs)
+    core = static_cast<TFLiteCore *> (g_hash_table_lookup (tflite_outputs, data));
+  if (core) {
+    g_hash_table_remove (tflite_outputs, data);
+    core->releaseOutput (data);
+    release_core = core->isClosed () && !core->isOutputInFlight ();
+  }
+  G_UNLOCK (tflite_outputs);
+
+  if (core == nullptr) {
+    /* the buffer is allocated in invoke() */
+    g_free (data);
+  } else if (release_core) {
+    delete core;
+  }
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  * @param[in] hw backend accelerator hardware
@@ -1641,7 +1907,7 @@ static GstTensorFilterFramework NNS_support_tensorflow_lite
         { .v0 = {
               .name = filter_subplugin_tensorflow_lite,
               .allow_in_place = FALSE, /** @todo: support this to optimize performance later. */
-              .allocate_in_invoke = FALSE,
+              .allocate_in_invoke = TRUE,
               .run_without_model = FALSE,
               .verify_model_path = TRUE,
               .statistics = &tflite_internal_stats,
@@ -1649,11 +1915,11 @@ static GstTensorFilterFramework NNS_support_tensorflow_lite
               .getInputDimension = tflite_getInputDim,
               .getOutputDimension = tflite_getOutputDim,
               .setInputDimension = tflite_setInputDim,
-              .destroyNotify = nullptr,
+              .destroyNotify = tflite_destroyNotify,
               .reloadModel = tflite_reloadModel,
               .handleEvent = nullptr,
               .checkAvailability = tflite_checkAvailability,
-              .allocateInInvoke = nullptr,
+              .allocateInInvoke = tflite_allocateInInvoke,
           } } };
 
 /** @brief Initialize this object for tensor_filter subplugin runtime register */
@@ -1667,7 +1933,8 @@ init_filter_tflite (void)
       " Do not specify to disable delegation.",
       "ExtDelegateLib", "Path to external delegate shared library", "ExtDelegateKeyVal",
       "key/values pairs optional parameters for delegate."
-      " Format ExtDelegateKeyVal=key1#value1;key2#value2...",
+      " Format ExtDelegateKeyVal=key1#value1;key2#value2...", "ZeroCopy",
+      "Push the output buffers of XNNPACK delegate downstream without copying them: {'true', 'false'}.",
       NULL);
 }
 
@@ -19,6 +19,10 @@
  * other/tensors, format=static, num_tensors=2, framerate=0/1, dimensions=1:1:784:1.1:1:10:1, types=float32.float32 ! \
  * datareposink location=hyunil.dat json=file.json
  * ]|
+ * |[ Write the samples in the writer thread, dropping samples if 256 samples are pending
+ * gst-launch-1.0 videotestsrc ! datareposink location=filename json=video.json async-write=true \
+ * max-queued-samples=256 drop=true preallocate-size=67108864 fsync-interval=300
+ * ]|
  */
 
 #ifdef HAVE_CONFIG_H
@@ -31,6 +35,9 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
 #include <nnstreamer_plugin_api.h>
 #include <tensor_common.h>
 #include <nnstreamer_util.h>
@@ -84,9 +91,30 @@ enum
 {
   PROP_0,
   PROP_LOCATION,
-  PROP_JSON
+  PROP_JSON,
+  PROP_ASYNC_WRITE,
+  PROP_MAX_QUEUED_SAMPLES,
+  PROP_DROP,
+  PROP_PREALLOCATE_SIZE,
+  PROP_FSYNC_INTERVAL,
+  PROP_WRITER_STATS
 };
 
+#define DEFAULT_ASYNC_WRITE FALSE
+#define DEFAULT_MAX_QUEUED_SAMPLES 64
+#define DEFAULT_DROP FALSE
+#define DEFAULT_PREALLOCATE_SIZE 0
+#define DEFAULT_FSYNC_INTERVAL 0
+
+/**
+ * @brief The max number of samples written at once by the writer thread.
+ */
+#define WRITER_MAX_BATCH 64
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
 GST_DEBUG_CATEGORY_STATIC (gst_data_repo_sink_debug);
 #define GST_CAT_DEFAULT gst_data_repo_sink_debug
 #define _do_init \
@@ -112,6 +140,10 @@ static gboolean gst_data_repo_sink_set_caps (GstBaseSink * bsink,
 static gboolean gst_data_repo_sink_event (GstBaseSink * bsink,
     GstEvent * event);
 static gboolean gst_data_repo_sink_query (GstBaseSink * sink, GstQuery * query);
+static gboolean gst_data_repo_sink_unlock (GstBaseSink * bsink);
+static gboolean gst_data_repo_sink_unlock_stop (GstBaseSink * bsink);
+static GstStructure *gst_data_repo_sink_get_writer_stats (GstDataRepoSink *
+    sink);
 
 /**
  * @brief Initialize datareposink class.
@@ -146,6 +178,48 @@ gst_data_repo_sink_class_init (GstDataRepoSinkClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_ASYNC_WRITE,
+      g_param_spec_boolean ("async-write", "Asynchronous write",
+          "Write the samples in the writer thread, so that the streaming "
+          "thread does not wait for the storage. Not used for image files.",
+          DEFAULT_ASYNC_WRITE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_QUEUED_SAMPLES,
+      g_param_spec_uint ("max-queued-samples", "Max queued samples",
+          "The max number of samples queued for the writer thread",
+          1, G_MAXINT, DEFAULT_MAX_QUEUED_SAMPLES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_DROP,
+      g_param_spec_boolean ("drop", "Drop",
+          "Drop the sample instead of waiting for the writer thread "
+          "if the queue is full", DEFAULT_DROP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PREALLOCATE_SIZE,
+      g_param_spec_uint64 ("preallocate-size", "Preallocate size",
+          "Preallocate the file by this size in bytes when it is full, "
+          "0 to disable", 0, G_MAXUINT64, DEFAULT_PREALLOCATE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_FSYNC_INTERVAL,
+      g_param_spec_uint ("fsync-interval", "fsync interval",
+          "Flush the file to the storage every this number of samples, "
+          "0 to disable", 0, G_MAXUINT, DEFAULT_FSYNC_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_WRITER_STATS,
+      g_param_spec_boxed ("writer-stats", "Writer statistics",
+          "The statistics of writing samples (queued, max queued, written, "
+          "dropped samples, written bytes and write calls)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "NNStreamer MLOps Data Repository Sink",
       "Sink/File",
@@ -161,6 +235,9 @@ gst_data_repo_sink_class_init (GstDataRepoSinkClass * klass)
   gstbasesink_class->event = GST_DEBUG_FUNCPTR (gst_data_repo_sink_event);
   gstbasesink_class->query = GST_DEBUG_FUNCPTR (gst_data_repo_sink_query);
   gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_data_repo_sink_stop);
+  gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_data_repo_sink_unlock);
+  gstbasesink_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_data_repo_sink_unlock_stop);
 
   if (sizeof (off_t) < 8) {
     GST_LOG ("No large file support, sizeof (off_t) = %" G_GSIZE_FORMAT "!",
@@ -187,6 +264,27 @@ gst_data_repo_sink_init (GstDataRepoSink * sink)
   sink->sample_offset_array = json_array_new ();
   sink->tensor_size_array = json_array_new ();
   sink->tensor_count_array = json_array_new ();
+  sink->async_write = DEFAULT_ASYNC_WRITE;
+  sink->max_queued = DEFAULT_MAX_QUEUED_SAMPLES;
+  sink->drop = DEFAULT_DROP;
+  sink->preallocate_size = DEFAULT_PREALLOCATE_SIZE;
+  sink->fsync_interval = DEFAULT_FSYNC_INTERVAL;
+  sink->writer_thread = NULL;
+  g_queue_init (&sink->queue);
+  g_mutex_init (&sink->queue_lock);
+  g_cond_init (&sink->queue_cond);
+  sink->queued = 0;
+  sink->writer_stop = FALSE;
+  sink->unlocked = FALSE;
+  sink->write_error = FALSE;
+  sink->write_offset = 0;
+  sink->allocated = 0;
+  sink->unsynced = 0;
+  sink->max_queued_samples = 0;
+  sink->written_samples = 0;
+  sink->written_bytes = 0;
+  sink->dropped_samples = 0;
+  sink->write_calls = 0;
 }
 
 /**
@@ -219,6 +317,13 @@ gst_data_repo_sink_finalize (GObject * object)
     json_object_unref (sink->json_object);
     sink->json_object = NULL;
   }
+
+  while (!g_queue_is_empty (&sink->queue))
+    gst_data_repo_sample_free ((GstDataRepoSample *)
+        g_queue_pop_head (&sink->queue));
+  g_mutex_clear (&sink->queue_lock);
+  g_cond_clear (&sink->queue_cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -240,6 +345,21 @@ gst_data_repo_sink_set_property (GObject * object, guint prop_id,
       sink->json_filename = g_value_dup_string (value);
       GST_INFO_OBJECT (sink, "JSON filename: %s", sink->json_filename);
       break;
+    case PROP_ASYNC_WRITE:
+      sink->async_write = g_value_get_boolean (value);
+      break;
+    case PROP_MAX_QUEUED_SAMPLES:
+      sink->max_queued = g_value_get_uint (value);
+      break;
+    case PROP_DROP:
+      sink->drop = g_value_get_boolean (value);
+      break;
+    case PROP_PREALLOCATE_SIZE:
+      sink->preallocate_size = g_value_get_uint64 (value);
+      break;
+    case PROP_FSYNC_INTERVAL:
+      sink->fsync_interval = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -264,6 +384,24 @@ gst_data_repo_sink_get_property (GObject * object, guint prop_id,
     case PROP_JSON:
       g_value_set_string (value, sink->json_filename);
       break;
+    case PROP_ASYNC_WRITE:
+      g_value_set_boolean (value, sink->async_write);
+      break;
+    case PROP_MAX_QUEUED_SAMPLES:
+      g_value_set_uint (value, sink->max_queued);
+      break;
+    case PROP_DROP:
+      g_value_set_boolean (value, sink->drop);
+      break;
+    case PROP_PREALLOCATE_SIZE:
+      g_value_set_uint64 (value, sink->preallocate_size);
+      break;
+    case PROP_FSYNC_INTERVAL:
+      g_value_set_uint (value, sink->fsync_interval);
+      break;
+    case PROP_WRITER_STATS:
+      g_value_take_boxed (value, gst_data_repo_sink_get_writer_stats (sink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -271,43 +409,455 @@ gst_data_repo_sink_get_property (GObject * object, guint prop_id,
 }
 
 /**
- * @brief Function to write others media type (tensors(fixed), video, audio, octet and text)
+ * @brief Sample to be written to the file.
+ * @details The incoming buffer is referred until the sample is written, then the upstream buffer pool cannot recycle the memory blocks.
  */
-static GstFlowReturn
-gst_data_repo_sink_write_others (GstDataRepoSink * sink, GstBuffer * buffer)
+typedef struct
 {
-  gsize write_size = 0;
-  GstMapInfo info;
-  GstFlowReturn ret = GST_FLOW_OK;
+  GstBuffer *buffer;    /**< incoming buffer */
+  GPtrArray *mems;      /**< memory blocks (GstMemory) written in order */
+  gboolean flexible;    /**< the memory blocks are flexible or sparse tensors */
+} GstDataRepoSample;
 
-  g_return_val_if_fail (sink != NULL, GST_FLOW_ERROR);
-  g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
-  g_return_val_if_fail (sink->fd != 0, GST_FLOW_ERROR);
+/**
+ * @brief Create the sample with the incoming buffer.
+ */
+static GstDataRepoSample *
+gst_data_repo_sample_new (GstBuffer * buffer, guint num_mems,
+    gboolean flexible)
+{
+  GstDataRepoSample *sample = g_new0 (GstDataRepoSample, 1);
 
-  if (!gst_buffer_map (buffer, &info, GST_MAP_READ)) {
-    GST_ERROR_OBJECT (sink, "Failed to map the incoming buffer.");
-    return GST_FLOW_ERROR;
-  }
+  sample->buffer = gst_buffer_ref (buffer);
+  sample->mems = g_ptr_array_new_full (num_mems,
+      (GDestroyNotify) gst_memory_unref);
+  sample->flexible = flexible;
+
+  return sample;
+}
+
+/**
+ * @brief Free the sample and release the incoming buffer.
+ */
+static void
+gst_data_repo_sample_free (GstDataRepoSample * sample)
+{
+  g_ptr_array_unref (sample->mems);
+  gst_buffer_unref (sample->buffer);
+  g_free (sample);
+}
+
+/**
+ * @brief Update the meta information after the sample is written.
+ * @note The offsets in JSON file should refer the samples written to the file.
+ */
+static void
+gst_data_repo_sink_update_meta (GstDataRepoSink * sink,
+    GstDataRepoSample * sample)
+{
+  GstMemory *mem;
+  gsize total = 0;
+  guint i;
 
   GST_OBJECT_LOCK (sink);
-  sink->sample_size = info.size;
+
+  if (sample->flexible)
+    json_array_add_int_element (sink->sample_offset_array, sink->fd_offset);
+
+  for (i = 0; i < sample->mems->len; i++) {
+    mem = (GstMemory *) g_ptr_array_index (sample->mems, i);
+
+    if (sample->flexible)
+      json_array_add_int_element (sink->tensor_size_array, mem->size);
+    total += mem->size;
+  }
+
+  if (sample->flexible) {
+    json_array_add_int_element (sink->tensor_count_array,
+        sink->cumulative_tensors);
+    sink->cumulative_tensors += sample->mems->len;
+  }
+
+  sink->fd_offset += total;
+  sink->total_samples++;
+
+  GST_OBJECT_UNLOCK (sink);
+}
+
+/**
+ * @brief Preallocate the file for the data to be written.
+ */
+static void
+gst_data_repo_sink_preallocate (GstDataRepoSink * sink, gsize size)
+{
+#if defined(__linux__) || defined(__ANDROID__)
+  guint64 end = sink->write_offset + size;
+  guint64 new_size;
+  int err;
+
+  if (sink->preallocate_size == 0 || end <= sink->allocated)
+    return;
+
+  new_size = end + sink->preallocate_size;
+  err = posix_fallocate (sink->fd, (off_t) sink->allocated,
+      (off_t) (new_size - sink->allocated));
+
+  if (err != 0) {
+    GST_WARNING_OBJECT (sink, "Failed to preallocate the file: %s",
+        g_strerror (err));
+    /* Do not try again. */
+    sink->preallocate_size = 0;
+    return;
+  }
+
+  sink->allocated = new_size;
+#else
+  UNUSED (sink);
+  UNUSED (size);
+#endif
+}
+
+/**
+ * @brief Write the samples to the file with writev().
+ * @param sink datareposink
+ * @param samples array of samples to be written
+ * @param num the number of samples
+ * @return TRUE if all samples are written
+ */
+static gboolean
+gst_data_repo_sink_write_samples (GstDataRepoSink * sink,
+    GstDataRepoSample ** samples, guint num)
+{
+  GstMapInfo *maps;
+  struct iovec *iov;
+  GstMemory *mem;
+  gsize total = 0;
+  gssize write_size;
+  guint i, j, n_iov = 0, n_mapped = 0, idx = 0;
+  guint64 calls = 0;
+  gboolean ret = TRUE;
+
+  for (i = 0; i < num; i++)
+    n_iov += samples[i]->mems->len;
+
+  maps = g_new (GstMapInfo, n_iov);
+  iov = g_new (struct iovec, n_iov);
+
+  for (i = 0; i < num; i++) {
+    for (j = 0; j < samples[i]->mems->len; j++) {
+      mem = (GstMemory *) g_ptr_array_index (samples[i]->mems, j);
+
+      if (!gst_memory_map (mem, &maps[n_mapped], GST_MAP_READ)) {
+        GST_ERROR_OBJECT (sink, "Failed to map memory");
+        ret = FALSE;
+        goto done;
+      }
+
+      iov[n_mapped].iov_base = maps[n_mapped].data;
+      iov[n_mapped].iov_len = maps[n_mapped].size;
+      total += maps[n_mapped].size;
+      n_mapped++;
+    }
+  }
+
+  gst_data_repo_sink_preallocate (sink, total);
 
   GST_LOG_OBJECT (sink,
-      "Writing %lld bytes at offset 0x%" G_GINT64_MODIFIER "x (%lld size)",
-      (long long) info.size, sink->fd_offset, (long long) sink->fd_offset);
+      "Writing %u samples, %zd bytes at offset 0x%" G_GINT64_MODIFIER "x",
+      num, total, sink->write_offset);
+
+  while (idx < n_iov) {
+    /* skip empty memory */
+    if (iov[idx].iov_len == 0) {
+      idx++;
+      continue;
+    }
 
-  write_size = write (sink->fd, info.data, info.size);
+    errno = 0;
+    write_size = writev (sink->fd, &iov[idx], MIN (n_iov - idx, IOV_MAX));
+    calls++;
+
+    if (write_size < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      GST_ERROR_OBJECT (sink, "Could not write data to file: %s",
+          g_strerror (errno));
+      ret = FALSE;
+      goto done;
+    }
 
-  if (write_size != info.size) {
-    GST_ERROR_OBJECT (sink, "Could not write data to file");
+    /* skip written vectors and adjust the partially written one */
+    while (write_size > 0 && idx < n_iov) {
+      if ((gsize) write_size >= iov[idx].iov_len) {
+        write_size -= iov[idx].iov_len;
+        idx++;
+      } else {
+        iov[idx].iov_base = (guint8 *) iov[idx].iov_base + write_size;
+        iov[idx].iov_len -= write_size;
+        write_size = 0;
+      }
+    }
+  }
+
+  sink->write_offset += total;
+  sink->unsynced += num;
+
+  for (i = 0; i < num; i++)
+    gst_data_repo_sink_update_meta (sink, samples[i]);
+
+  if (sink->fsync_interval > 0 && sink->unsynced >= sink->fsync_interval) {
+    if (fsync (sink->fd) != 0)
+      GST_WARNING_OBJECT (sink, "Failed to sync the file: %s",
+          g_strerror (errno));
+    sink->unsynced = 0;
+  }
+
+done:
+  for (i = 0; i < n_mapped; i++) {
+    mem = maps[i].memory;
+    gst_memory_unmap (mem, &maps[i]);
+  }
+
+  g_free (maps);
+  g_free (iov);
+
+  g_mutex_lock (&sink->queue_lock);
+  sink->write_calls += calls;
+  if (ret) {
+    sink->written_samples += num;
+    sink->written_bytes += total;
+  }
+  g_mutex_unlock (&sink->queue_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Thread to write the queued samples.
+ */
+static gpointer
+gst_data_repo_sink_writer_loop (gpointer user_data)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (user_data);
+  GstDataRepoSample *batch[WRITER_MAX_BATCH];
+  gboolean written;
+  guint i, num;
+
+  g_mutex_lock (&sink->queue_lock);
+
+  while (TRUE) {
+    while (g_queue_is_empty (&sink->queue) && !sink->writer_stop)
+      g_cond_wait (&sink->queue_cond, &sink->queue_lock);
+
+    /* stop after writing all samples */
+    if (g_queue_is_empty (&sink->queue))
+      break;
+
+    num = 0;
+    while (num < WRITER_MAX_BATCH && !g_queue_is_empty (&sink->queue))
+      batch[num++] = (GstDataRepoSample *) g_queue_pop_head (&sink->queue);
+
+    g_mutex_unlock (&sink->queue_lock);
+
+    /* Do not write samples after an error, the file is already broken. */
+    written = !sink->write_error &&
+        gst_data_repo_sink_write_samples (sink, batch, num);
+
+    for (i = 0; i < num; i++)
+      gst_data_repo_sample_free (batch[i]);
+
+    g_mutex_lock (&sink->queue_lock);
+    if (!written)
+      sink->write_error = TRUE;
+    sink->queued -= num;
+    g_cond_broadcast (&sink->queue_cond);
+  }
+
+  g_mutex_unlock (&sink->queue_lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Start the writer thread.
+ */
+static gboolean
+gst_data_repo_sink_start_writer (GstDataRepoSink * sink)
+{
+  GError *error = NULL;
+
+  if (!sink->async_write || sink->writer_thread)
+    return TRUE;
+
+  sink->writer_stop = FALSE;
+  sink->write_error = FALSE;
+  sink->writer_thread = g_thread_try_new ("datareposink-writer",
+      gst_data_repo_sink_writer_loop, sink, &error);
+
+  if (!sink->writer_thread) {
+    GST_ERROR_OBJECT (sink, "Failed to create the writer thread: %s",
+        error ? error->message : "Unknown error");
+    g_clear_error (&error);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the writer thread after writing all queued samples.
+ */
+static void
+gst_data_repo_sink_stop_writer (GstDataRepoSink * sink)
+{
+  if (!sink->writer_thread)
+    return;
+
+  g_mutex_lock (&sink->queue_lock);
+  sink->writer_stop = TRUE;
+  g_cond_broadcast (&sink->queue_cond);
+  g_mutex_unlock (&sink->queue_lock);
+
+  g_thread_join (sink->writer_thread);
+  sink->writer_thread = NULL;
+}
+
+/**
+ * @brief Wait until the writer thread writes all queued samples.
+ * @return FALSE if the writer thread failed to write the samples.
+ */
+static gboolean
+gst_data_repo_sink_wait_writer (GstDataRepoSink * sink)
+{
+  gboolean written;
+
+  if (!sink->writer_thread)
+    return TRUE;
+
+  g_mutex_lock (&sink->queue_lock);
+  while (sink->queued > 0 && !sink->write_error && !sink->unlocked)
+    g_cond_wait (&sink->queue_cond, &sink->queue_lock);
+  written = !sink->write_error;
+  g_mutex_unlock (&sink->queue_lock);
+
+  return written;
+}
+
+/**
+ * @brief Reserve a slot of the queue for the incoming sample.
+ * @return GST_FLOW_OK if the sample can be written, GST_FLOW_CUSTOM_SUCCESS if
+ * the sample is dropped, otherwise the error.
+ */
+static GstFlowReturn
+gst_data_repo_sink_reserve (GstDataRepoSink * sink)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  if (!sink->writer_thread)
+    return GST_FLOW_OK;
+
+  g_mutex_lock (&sink->queue_lock);
+
+  while (sink->queued >= sink->max_queued && !sink->write_error &&
+      !sink->unlocked && !sink->drop)
+    g_cond_wait (&sink->queue_cond, &sink->queue_lock);
+
+  if (sink->write_error) {
     ret = GST_FLOW_ERROR;
+  } else if (sink->unlocked) {
+    ret = GST_FLOW_FLUSHING;
+  } else if (sink->queued >= sink->max_queued) {
+    sink->dropped_samples++;
+    ret = GST_FLOW_CUSTOM_SUCCESS;
   } else {
-    sink->fd_offset += write_size;
-    sink->total_samples++;
+    sink->queued++;
+    sink->max_queued_samples = MAX (sink->max_queued_samples, sink->queued);
+  }
+
+  g_mutex_unlock (&sink->queue_lock);
+
+  if (ret == GST_FLOW_ERROR)
+    GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
+        ("Failed to write data to file \"%s\".", sink->filename), (NULL));
+
+  return ret;
+}
+
+/**
+ * @brief Write the sample, or push it to the queue for the writer thread.
+ * @note This function takes the ownership of the sample.
+ */
+static GstFlowReturn
+gst_data_repo_sink_submit (GstDataRepoSink * sink, GstDataRepoSample * sample)
+{
+  gboolean written;
+
+  if (!sink->writer_thread) {
+    written = gst_data_repo_sink_write_samples (sink, &sample, 1);
+    gst_data_repo_sample_free (sample);
+
+    return written ? GST_FLOW_OK : GST_FLOW_ERROR;
   }
 
+  g_mutex_lock (&sink->queue_lock);
+  g_queue_push_tail (&sink->queue, sample);
+  g_cond_broadcast (&sink->queue_cond);
+  g_mutex_unlock (&sink->queue_lock);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Release the slot of the queue if failed to make the sample.
+ */
+static void
+gst_data_repo_sink_release (GstDataRepoSink * sink)
+{
+  if (!sink->writer_thread)
+    return;
+
+  g_mutex_lock (&sink->queue_lock);
+  sink->queued--;
+  g_cond_broadcast (&sink->queue_cond);
+  g_mutex_unlock (&sink->queue_lock);
+}
+
+/**
+ * @brief Function to write others media type (tensors(fixed), video, audio, octet and text)
+ */
+static GstFlowReturn
+gst_data_repo_sink_write_others (GstDataRepoSink * sink, GstBuffer * buffer)
+{
+  GstDataRepoSample *sample;
+  GstFlowReturn ret;
+  gsize size;
+  guint i, num_mems;
+
+  g_return_val_if_fail (sink != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (sink->fd != 0, GST_FLOW_ERROR);
+
+  ret = gst_data_repo_sink_reserve (sink);
+  if (ret != GST_FLOW_OK)
+    return (ret == GST_FLOW_CUSTOM_SUCCESS) ? GST_FLOW_OK : ret;
+
+  /* The memory blocks are written in order, same as mapping whole buffer. */
+  num_mems = gst_buffer_n_memory (buffer);
+  sample = gst_data_repo_sample_new (buffer, num_mems, FALSE);
+  for (i = 0; i < num_mems; i++)
+    g_ptr_array_add (sample->mems, gst_buffer_get_memory (buffer, i));
+
+  size = gst_buffer_get_size (buffer);
+
+  GST_OBJECT_LOCK (sink);
+  sink->sample_size = size;
   GST_OBJECT_UNLOCK (sink);
-  gst_buffer_unmap (buffer, &info);
+
+  GST_LOG_OBJECT (sink, "Submitting a sample of %zd bytes", size);
+
+  ret = gst_data_repo_sink_submit (sink, sample);
+  if (ret != GST_FLOW_OK)
+    GST_ERROR_OBJECT (sink, "Could not write data to file");
 
   return ret;
 }
@@ -320,10 +870,13 @@ gst_data_repo_sink_write_flexible_or_sparse_tensors (GstDataRepoSink * sink,
     GstBuffer * buffer)
 {
   guint num_tensors, i;
-  gsize write_size = 0, total_write = 0, tensor_size;
+  gsize total_write = 0;
   GstMapInfo info;
   GstMemory *mem = NULL;
   GstTensorMetaInfo meta;
+  GstDataRepoSample *sample;
+  GstFlowReturn ret;
+  gboolean valid;
 
   g_return_val_if_fail (sink != NULL, GST_FLOW_ERROR);
   g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
@@ -333,63 +886,49 @@ gst_data_repo_sink_write_flexible_or_sparse_tensors (GstDataRepoSink * sink,
   g_return_val_if_fail (sink->tensor_size_array != NULL, GST_FLOW_ERROR);
   g_return_val_if_fail (sink->tensor_count_array != NULL, GST_FLOW_ERROR);
 
-  GST_OBJECT_LOCK (sink);
+  ret = gst_data_repo_sink_reserve (sink);
+  if (ret != GST_FLOW_OK)
+    return (ret == GST_FLOW_CUSTOM_SUCCESS) ? GST_FLOW_OK : ret;
 
   num_tensors = gst_tensor_buffer_get_count (buffer);
   GST_INFO_OBJECT (sink, "num_tensors: %u", num_tensors);
 
+  sample = gst_data_repo_sample_new (buffer, num_tensors, TRUE);
+
   for (i = 0; i < num_tensors; i++) {
     mem = gst_tensor_buffer_get_nth_memory (buffer, i);
     if (!gst_memory_map (mem, &info, GST_MAP_READ)) {
       GST_ERROR_OBJECT (sink, "Failed to map memory");
-      goto mem_map_error;
-    }
-
-    if (!gst_tensor_meta_info_parse_header (&meta, info.data)) {
-      GST_ERROR_OBJECT (sink,
-          "Invalid format of tensors, the format is static.");
+      gst_memory_unref (mem);
       goto error;
     }
-    tensor_size = info.size;
 
-    GST_LOG_OBJECT (sink, "tensor[%u] size: %zd", i, tensor_size);
-    GST_LOG_OBJECT (sink,
-        "Writing %lld bytes at offset 0x%" G_GINT64_MODIFIER "x (%lld size)",
-        (long long) tensor_size, sink->fd_offset + total_write,
-        (long long) sink->fd_offset + total_write);
+    valid = gst_tensor_meta_info_parse_header (&meta, info.data);
+    gst_memory_unmap (mem, &info);
+    g_ptr_array_add (sample->mems, mem);
 
-    write_size = write (sink->fd, info.data, tensor_size);
-    if (write_size != tensor_size) {
-      GST_ERROR_OBJECT (sink, "Could not write data to file");
+    if (!valid) {
+      GST_ERROR_OBJECT (sink,
+          "Invalid format of tensors, the format is static.");
       goto error;
     }
 
-    json_array_add_int_element (sink->tensor_size_array, tensor_size);
-    total_write += write_size;
-
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
+    GST_LOG_OBJECT (sink, "tensor[%u] size: %zd", i, mem->size);
+    total_write += mem->size;
   }
 
-  json_array_add_int_element (sink->sample_offset_array, sink->fd_offset);
-  sink->fd_offset += total_write;
-
-  GST_LOG_OBJECT (sink, "cumulative_tensors: %u", sink->cumulative_tensors);
-  json_array_add_int_element (sink->tensor_count_array,
-      sink->cumulative_tensors);
-  sink->cumulative_tensors += num_tensors;
-
-  sink->total_samples++;
+  GST_LOG_OBJECT (sink, "Submitting a sample of %zd bytes (%u tensors)",
+      total_write, num_tensors);
 
-  GST_OBJECT_UNLOCK (sink);
+  ret = gst_data_repo_sink_submit (sink, sample);
+  if (ret != GST_FLOW_OK)
+    GST_ERROR_OBJECT (sink, "Could not write data to file");
 
-  return GST_FLOW_OK;
+  return ret;
 
 error:
-  gst_memory_unmap (mem, &info);
-mem_map_error:
-  gst_memory_unref (mem);
-  GST_OBJECT_UNLOCK (sink);
+  gst_data_repo_sample_free (sample);
+  gst_data_repo_sink_release (sink);
 
   return GST_FLOW_ERROR;
 }
@@ -554,6 +1093,13 @@ gst_data_repo_sink_event (GstBaseSink * bsink, GstEvent * event)
     case GST_EVENT_EOS:
       GST_INFO_OBJECT (sink, "get GST_EVENT_EOS event..state is %d",
           GST_STATE (sink));
+      /* all samples should be written before posting EOS message */
+      if (!gst_data_repo_sink_wait_writer (sink)) {
+        GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
+            ("Failed to write data to file \"%s\".", sink->filename), (NULL));
+        gst_event_unref (event);
+        return FALSE;
+      }
       break;
     case GST_EVENT_FLUSH_START:
       GST_INFO_OBJECT (sink, "get GST_EVENT_FLUSH_START event");
@@ -632,7 +1178,11 @@ gst_data_repo_sink_open_file (GstDataRepoSink * sink)
 
   g_free (filename);
 
-  return TRUE;
+  sink->write_offset = 0;
+  sink->allocated = 0;
+  sink->unsynced = 0;
+
+  return gst_data_repo_sink_start_writer (sink);
 
   /* ERRORS */
 no_filename:
@@ -673,6 +1223,18 @@ gst_data_repo_sink_stop (GstBaseSink * basesink)
 
   sink = GST_DATA_REPO_SINK_CAST (basesink);
 
+  gst_data_repo_sink_stop_writer (sink);
+
+  if (sink->fd > 0) {
+    /* remove preallocated space */
+    if (sink->allocated > sink->write_offset &&
+        ftruncate (sink->fd, (off_t) sink->write_offset) != 0)
+      GST_WARNING_OBJECT (sink, "Failed to truncate the file");
+
+    if (sink->fsync_interval > 0 && sink->unsynced > 0)
+      fsync (sink->fd);
+  }
+
   /* close the file */
   g_close (sink->fd, NULL);
   sink->fd = 0;
@@ -680,6 +1242,58 @@ gst_data_repo_sink_stop (GstBaseSink * basesink)
   return TRUE;
 }
 
+/**
+ * @brief Unblock the streaming thread waiting for the writer thread.
+ */
+static gboolean
+gst_data_repo_sink_unlock (GstBaseSink * bsink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK_CAST (bsink);
+
+  g_mutex_lock (&sink->queue_lock);
+  sink->unlocked = TRUE;
+  g_cond_broadcast (&sink->queue_cond);
+  g_mutex_unlock (&sink->queue_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the unlock state.
+ */
+static gboolean
+gst_data_repo_sink_unlock_stop (GstBaseSink * bsink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK_CAST (bsink);
+
+  g_mutex_lock (&sink->queue_lock);
+  sink->unlocked = FALSE;
+  g_mutex_unlock (&sink->queue_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the statistics of writing samples.
+ */
+static GstStructure *
+gst_data_repo_sink_get_writer_stats (GstDataRepoSink * sink)
+{
+  GstStructure *stats;
+
+  g_mutex_lock (&sink->queue_lock);
+  stats = gst_structure_new ("writer-stats",
+      "queued", G_TYPE_UINT, sink->queued,
+      "max-queued", G_TYPE_UINT, sink->max_queued_samples,
+      "written", G_TYPE_UINT64, sink->written_samples,
+      "dropped", G_TYPE_UINT64, sink->dropped_samples,
+      "bytes", G_TYPE_UINT64, sink->written_bytes,
+      "write-calls", G_TYPE_UINT64, sink->write_calls, NULL);
+  g_mutex_unlock (&sink->queue_lock);
+
+  return stats;
+}
+
 /**
  * @brief Write json to file
  */
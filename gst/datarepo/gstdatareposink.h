@@ -58,6 +58,31 @@ struct _GstDataRepoSink
   /* property */
   gchar *filename;      /**< filename */
   gchar *json_filename; /**< "JSON file path to store the meta information */
+  gboolean async_write; /**< write samples in the writer thread */
+  guint max_queued;     /**< the max number of samples queued for the writer thread */
+  gboolean drop;        /**< drop the sample instead of waiting if the queue is full */
+  guint64 preallocate_size; /**< size to preallocate the file at once, 0 to disable */
+  guint fsync_interval; /**< call fsync() every this number of samples, 0 to disable */
+
+  /* writer */
+  GThread *writer_thread; /**< thread to write the queued samples */
+  GQueue queue;           /**< samples (buffer and memory blocks) to be written */
+  GMutex queue_lock;      /**< lock for the queue and statistics */
+  GCond queue_cond;       /**< signalled when a sample is queued or written */
+  guint queued;           /**< the number of samples queued or being written */
+  gboolean writer_stop;   /**< stop the writer thread after writing all samples */
+  gboolean unlocked;      /**< unblock render while flushing or stopping */
+  gboolean write_error;   /**< failed to write samples in the writer thread */
+  guint64 write_offset;   /**< offset of the data written to the file */
+  guint64 allocated;      /**< preallocated size of the file */
+  guint unsynced;         /**< the number of samples written after last fsync() */
+
+  /* statistics */
+  guint max_queued_samples; /**< the max number of samples queued at once */
+  guint64 written_samples;  /**< the number of samples written */
+  guint64 written_bytes;    /**< the number of bytes written */
+  guint64 dropped_samples;  /**< the number of samples dropped with full queue */
+  guint64 write_calls;      /**< the number of write system calls */
 };
 
 /**
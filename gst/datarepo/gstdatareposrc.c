@@ -28,6 +28,9 @@
  * caps ="other/tensors, format=(string)static, framerate=(fraction)0/1, num_tensors=(int)2, dimensions=(string)1:1:784:1.1:1:10:1, types=(string)float32.float32" \
  * ! fakesink
  * ]|
+ * |[ Wrap the samples in memory-mapped file and read ahead the next 8 shuffled samples
+ * gst-launch-1.0 datareposrc location=mnist.data json=mnist.json epochs=5 use-mmap=true prefetch=8 ! tensor_sink
+ * ]|
  */
 
 #ifdef HAVE_CONFIG_H
@@ -49,6 +52,11 @@
 #include <inttypes.h>
 #include "gstdatareposrc.h"
 
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/mman.h>
+#define DATA_REPO_SRC_USE_MADVISE
+#endif
+
 #define struct_stat struct stat
 #ifndef S_ISREG
 /* regular file */
@@ -85,11 +93,27 @@ enum
   PROP_IS_SHUFFLE,
   PROP_TENSORS_SEQUENCE,
   PROP_CAPS,                    /* for setting caps of sample data directly */
+  PROP_USE_MMAP,
+  PROP_PREFETCH,
+  PROP_STATS,
 };
 
 #define DEFAULT_INDEX 0
 #define DEFAULT_EPOCHS 1
 #define DEFAULT_IS_SHUFFLE TRUE
+#define DEFAULT_USE_MMAP FALSE
+#define DEFAULT_PREFETCH 0
+#define MAX_PREFETCH 1024
+
+/**
+ * @brief Region of a sample in the file to be read ahead.
+ * The region with size 0 stops the prefetch thread.
+ */
+typedef struct
+{
+  guint64 offset;
+  gsize size;
+} GstDataRepoSrcRegion;
 
 static void gst_data_repo_src_finalize (GObject * object);
 static GstStateChangeReturn gst_data_repo_src_change_state (GstElement *
@@ -105,6 +129,7 @@ static gboolean gst_data_repo_src_set_caps (GstBaseSrc * basesrc,
     GstCaps * caps);
 static GstFlowReturn gst_data_repo_src_create (GstPushSrc * pushsrc,
     GstBuffer ** buffer);
+static GstStructure *gst_data_repo_src_get_stats (GstDataRepoSrc * src);
 #define _do_init \
   GST_DEBUG_CATEGORY_INIT (gst_data_repo_src_debug, "datareposrc", 0, "datareposrc element");
 
@@ -195,6 +220,29 @@ gst_data_repo_src_class_init (GstDataRepoSrcClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "Map the file into memory and push the samples without copying. "
+          "The buffers are read-only, downstream copies them to write. "
+          "Not used for image files.",
+          DEFAULT_USE_MMAP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PREFETCH,
+      g_param_spec_uint ("prefetch", "Prefetch",
+          "The number of next (shuffled) samples to be read ahead "
+          "in the background thread, 0 to disable it. Not used for image files.",
+          0, MAX_PREFETCH, DEFAULT_PREFETCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "The statistics of reading samples (samples, bytes, read time in "
+          "microseconds, throughput in MB/s and prefetched samples)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gobject_class->finalize = gst_data_repo_src_finalize;
   gstelement_class->change_state = gst_data_repo_src_change_state;
 
@@ -256,6 +304,16 @@ gst_data_repo_src_init (GstDataRepoSrc * src)
   src->n_frame = 0;
   src->running_time = 0;
   src->parser = NULL;
+  src->use_mmap = DEFAULT_USE_MMAP;
+  src->prefetch = DEFAULT_PREFETCH;
+  src->mapped_file = NULL;
+  src->prefetch_thread = NULL;
+  src->prefetch_queue = NULL;
+  src->prefetch_pos = 0;
+  src->read_samples = 0;
+  src->read_bytes = 0;
+  src->read_time = 0;
+  src->prefetched = 0;
   gst_tensors_config_init (&src->config);
 
   /* Filling the buffer should be pending until set_caps() */
@@ -558,11 +616,289 @@ gst_data_repo_src_epoch_is_done (GstDataRepoSrc * src)
 
   src->first_epoch_is_done = TRUE;
   src->array_index = 0;
+  src->prefetch_pos = 0;
   src->epochs--;
 
   return TRUE;
 }
 
+/**
+ * @brief Function to read a region of the file into GstMemory
+ * @note If the file is mapped, the region is wrapped without copying.
+ */
+static GstFlowReturn
+gst_data_repo_src_read_region (GstDataRepoSrc * src, guint64 offset,
+    gsize size, GstMemory ** memory)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  gsize to_read, byte_read;
+  gssize read_size;
+  GstMemory *mem;
+  GstMapInfo info;
+  gsize length;
+
+  if (src->mapped_file) {
+    length = g_mapped_file_get_length (src->mapped_file);
+
+    /* The last sample may be truncated, read it with the file descriptor. */
+    if (offset + size <= length) {
+      GST_LOG_OBJECT (src, "Wrapping %zd bytes at offset 0x%"
+          G_GINT64_MODIFIER "x", size, offset);
+
+      *memory = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+          g_mapped_file_get_contents (src->mapped_file), length, offset, size,
+          g_mapped_file_ref (src->mapped_file),
+          (GDestroyNotify) g_mapped_file_unref);
+
+      src->read_position += size;
+      src->fd_offset = offset + size;
+      return GST_FLOW_OK;
+    }
+  }
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+
+  if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (src, "Could not map GstMemory");
+    gst_memory_unref (mem);
+    return GST_FLOW_ERROR;
+  }
+
+  byte_read = 0;
+  to_read = size;
+  src->fd_offset = lseek (src->fd, offset, SEEK_SET);
+
+  while (to_read > 0) {
+    GST_LOG_OBJECT (src, "Reading %zd bytes at offset 0x%" G_GINT64_MODIFIER "x",
+        to_read, src->fd_offset + byte_read);
+    errno = 0;
+    read_size = read (src->fd, info.data + byte_read, to_read);
+    GST_LOG_OBJECT (src, "Read: %zd", read_size);
+    if (read_size < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
+      ret = GST_FLOW_ERROR;
+      goto error;
+    }
+    /* files should eos if they read 0 and more was requested */
+    if (read_size == 0) {
+      /* .. but first we should return any remaining data */
+      if (byte_read > 0)
+        break;
+      GST_DEBUG_OBJECT (src, "EOS");
+      ret = GST_FLOW_EOS;
+      goto error;
+    }
+    to_read -= read_size;
+    byte_read += read_size;
+
+    src->read_position += read_size;
+    src->fd_offset += read_size;
+  }
+
+  gst_memory_unmap (mem, &info);
+  *memory = mem;
+
+  return GST_FLOW_OK;
+
+error:
+  gst_memory_unmap (mem, &info);
+  gst_memory_unref (mem);
+
+  return ret;
+}
+
+/**
+ * @brief Function to get the region of the sample in the file
+ */
+static gboolean
+gst_data_repo_src_get_sample_region (GstDataRepoSrc * src, guint sample_index,
+    GstDataRepoSrcRegion * region)
+{
+  guint64 next;
+
+  if (src->data_type == GST_DATA_REPO_DATA_TENSOR &&
+      !gst_tensors_config_is_static (&src->config)) {
+    if (sample_index >= src->sample_offset_array_len)
+      return FALSE;
+
+    region->offset =
+        json_array_get_int_element (src->sample_offset_array, sample_index);
+
+    if (sample_index + 1 < src->sample_offset_array_len)
+      next = json_array_get_int_element (src->sample_offset_array,
+          sample_index + 1);
+    else
+      next = src->file_size;
+
+    if (next <= region->offset)
+      return FALSE;
+
+    region->size = next - region->offset;
+  } else {
+    region->offset = gst_data_repo_src_get_file_offset (src, sample_index);
+    region->size = src->sample_size;
+  }
+
+  return (region->size > 0 && region->offset < src->file_size);
+}
+
+/**
+ * @brief Request the prefetch thread to read ahead the next samples.
+ */
+static void
+gst_data_repo_src_prefetch (GstDataRepoSrc * src)
+{
+  GstDataRepoSrcRegion region, *data;
+  guint sample_index, last;
+
+  if (!src->prefetch_queue)
+    return;
+
+  /* The samples already read or requested are skipped. */
+  src->prefetch_pos = MAX (src->prefetch_pos, src->array_index);
+  last = MIN (src->array_index + src->prefetch, src->num_samples);
+
+  for (; src->prefetch_pos < last; src->prefetch_pos++) {
+    /* In the first epoch, the samples are read in order from start index. */
+    if (src->first_epoch_is_done)
+      sample_index = g_array_index (src->shuffled_index_array, guint,
+          src->prefetch_pos);
+    else
+      sample_index = src->start_sample_index + src->prefetch_pos;
+
+    if (!gst_data_repo_src_get_sample_region (src, sample_index, &region))
+      continue;
+
+    data = g_new (GstDataRepoSrcRegion, 1);
+    *data = region;
+    g_async_queue_push (src->prefetch_queue, data);
+  }
+}
+
+/**
+ * @brief Thread to read ahead the requested regions of the file.
+ */
+static gpointer
+gst_data_repo_src_prefetch_loop (gpointer user_data)
+{
+  GstDataRepoSrc *src = GST_DATA_REPO_SRC (user_data);
+  GstDataRepoSrcRegion *region;
+  const guint8 *data;
+  gsize length, end, pos, page = 4096;
+  volatile guint8 sum = 0;
+
+#ifdef DATA_REPO_SRC_USE_MADVISE
+  page = (gsize) sysconf (_SC_PAGESIZE);
+#endif
+
+  while ((region = g_async_queue_pop (src->prefetch_queue)) != NULL) {
+    if (region->size == 0) {
+      g_free (region);
+      break;
+    }
+
+    if (src->mapped_file) {
+      data = (const guint8 *) g_mapped_file_get_contents (src->mapped_file);
+      length = g_mapped_file_get_length (src->mapped_file);
+      end = MIN (region->offset + region->size, length);
+      pos = region->offset - (region->offset % page);
+
+#ifdef DATA_REPO_SRC_USE_MADVISE
+      if (pos < end)
+        madvise ((void *) (data + pos), end - pos, MADV_WILLNEED);
+#endif
+
+      /* Touch each page so that the streaming thread does not wait for I/O. */
+      for (; pos < end; pos += page)
+        sum += data[pos];
+    } else {
+#ifdef POSIX_FADV_WILLNEED
+      posix_fadvise (src->fd, (off_t) region->offset, (off_t) region->size,
+          POSIX_FADV_WILLNEED);
+#endif
+    }
+
+    g_atomic_int_inc (&src->prefetched);
+    g_free (region);
+  }
+
+  (void) sum;
+  return NULL;
+}
+
+/**
+ * @brief Map the file and start the prefetch thread if required.
+ */
+static void
+gst_data_repo_src_start_read_ahead (GstDataRepoSrc * src)
+{
+  GError *error = NULL;
+
+  if (src->use_mmap) {
+    src->mapped_file = g_mapped_file_new_from_fd (src->fd, FALSE, &error);
+
+    if (!src->mapped_file) {
+      GST_WARNING_OBJECT (src, "Failed to map the file, read it instead: %s",
+          error ? error->message : "Unknown error");
+      g_clear_error (&error);
+    } else {
+#ifdef DATA_REPO_SRC_USE_MADVISE
+      /* Kernel read-ahead is useless for the shuffled samples. */
+      madvise (g_mapped_file_get_contents (src->mapped_file),
+          g_mapped_file_get_length (src->mapped_file),
+          src->is_shuffle ? MADV_RANDOM : MADV_SEQUENTIAL);
+#endif
+    }
+  }
+
+  if (src->prefetch > 0) {
+    src->prefetch_queue = g_async_queue_new_full (g_free);
+    src->prefetch_pos = 0;
+    src->prefetch_thread = g_thread_try_new ("datareposrc-prefetch",
+        gst_data_repo_src_prefetch_loop, src, &error);
+
+    if (!src->prefetch_thread) {
+      GST_WARNING_OBJECT (src, "Failed to create the prefetch thread: %s",
+          error ? error->message : "Unknown error");
+      g_clear_error (&error);
+      g_async_queue_unref (src->prefetch_queue);
+      src->prefetch_queue = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Stop the prefetch thread and unmap the file.
+ */
+static void
+gst_data_repo_src_stop_read_ahead (GstDataRepoSrc * src)
+{
+  GstDataRepoSrcRegion *region;
+
+  if (src->prefetch_thread) {
+    /* Drop pending requests and wake up the thread with empty region. */
+    while ((region = g_async_queue_try_pop (src->prefetch_queue)) != NULL)
+      g_free (region);
+
+    g_async_queue_push (src->prefetch_queue, g_new0 (GstDataRepoSrcRegion, 1));
+    g_thread_join (src->prefetch_thread);
+    src->prefetch_thread = NULL;
+  }
+
+  if (src->prefetch_queue) {
+    g_async_queue_unref (src->prefetch_queue);
+    src->prefetch_queue = NULL;
+  }
+
+  if (src->mapped_file) {
+    /* GstMemory wrapping the samples holds the reference of mapped file. */
+    g_mapped_file_unref (src->mapped_file);
+    src->mapped_file = NULL;
+  }
+}
+
 /**
  * @brief Function to read tensors
  */
@@ -572,11 +908,7 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
   GstFlowReturn ret = GST_FLOW_OK;
   guint i = 0, seq_idx = 0;
   GstBuffer *buf;
-  gsize to_read, byte_read;
-  gssize read_size;
-  guint8 *data;
   GstMemory *mem = NULL;
-  GstMapInfo info;
   guint shuffled_index = 0;
   guint64 sample_offset = 0;
   guint64 offset = 0;           /* offset from 0 */
@@ -613,13 +945,6 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
 
   for (i = 0; i < src->tensors_seq_cnt; i++) {
     seq_idx = src->tensors_seq[i];
-    mem = gst_allocator_alloc (NULL, src->tensors_size[seq_idx], NULL);
-
-    if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
-      GST_ERROR_OBJECT (src, "Could not map GstMemory[%d]", i);
-      ret = GST_FLOW_ERROR;
-      goto error;
-    }
 
     GST_INFO_OBJECT (src, "sequence index: %d", seq_idx);
     GST_INFO_OBJECT (src, "tensor_size[%d]: %zd", seq_idx,
@@ -641,45 +966,11 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
       if user sets "tensor-sequence=2,1", datareposrc read offset 9528 then 9488.
     */
 
-    data = info.data;
-
-    byte_read = 0;
-    to_read = src->tensors_size[seq_idx];
     offset = sample_offset + src->tensors_offset[seq_idx];
-    src->fd_offset = lseek (src->fd, offset, SEEK_SET);
-
-    while (to_read > 0) {
-      GST_LOG_OBJECT (src,
-          "Reading %zd bytes at offset 0x%" G_GINT64_MODIFIER "x (%zd size)",
-          to_read, src->fd_offset + byte_read,
-          (guint) src->fd_offset + byte_read);
-      errno = 0;
-      read_size = read (src->fd, data + byte_read, to_read);
-      GST_LOG_OBJECT (src, "Read: %zd", read_size);
-      if (read_size < 0) {
-        if (errno == EAGAIN || errno == EINTR)
-          continue;
-        GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-        ret = GST_FLOW_ERROR;
-        goto error;
-      }
-      /* files should eos if they read 0 and more was requested */
-      if (read_size == 0) {
-        /* .. but first we should return any remaining data */
-        if (byte_read > 0)
-          break;
-        GST_DEBUG_OBJECT (src, "EOS");
-        ret = GST_FLOW_EOS;
-        goto error;
-      }
-      to_read -= read_size;
-      byte_read += read_size;
-
-      src->read_position += read_size;
-      src->fd_offset += read_size;
-    }
-
-    gst_memory_unmap (mem, &info);
+    ret = gst_data_repo_src_read_region (src, offset,
+        src->tensors_size[seq_idx], &mem);
+    if (ret != GST_FLOW_OK)
+      goto error;
 
     gst_tensor_buffer_append_memory (buf, mem,
         gst_tensors_info_get_nth_info (&src->config.info, i));
@@ -690,11 +981,6 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
   return GST_FLOW_OK;
 
 error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
-  }
-
   gst_buffer_unref (buf);
 
   return ret;
@@ -748,9 +1034,8 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
   GstMapInfo info;
   GstTensorMetaInfo meta;
   GstTensorInfo tinfo;
-  gsize to_read, byte_read;
-  gssize read_size;
-  guint8 *data;
+  gboolean valid;
+  guint64 offset;
   guint tensor_count;
   guint tensor_size;
 
@@ -784,67 +1069,41 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
   GST_LOG_OBJECT (src, "sample offset 0x%" G_GINT64_MODIFIER "x (%d size)",
       sample_offset, (guint) sample_offset);
 
-  src->fd_offset = lseek (src->fd, sample_offset, SEEK_SET);
-
   buf = gst_buffer_new ();
 
   tensor_count =
       json_array_get_int_element (src->tensor_count_array, shuffled_index);
   num_tensors = gst_data_repo_src_get_num_tensors (src, shuffled_index);
+  offset = sample_offset;
 
   for (i = 0; i < num_tensors; i++) {
     tensor_size =
         json_array_get_int_element (src->tensor_size_array, tensor_count + i);
-    mem = gst_allocator_alloc (NULL, tensor_size, NULL);
 
-    if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
-      GST_ERROR_OBJECT (src, "Could not map GstMemory[%d]", i);
-      ret = GST_FLOW_ERROR;
+    ret = gst_data_repo_src_read_region (src, offset, tensor_size, &mem);
+    if (ret != GST_FLOW_OK)
       goto error;
-    }
 
-    data = info.data;
-    byte_read = 0;
-    to_read = tensor_size;
-    while (to_read > 0) {
-      GST_LOG_OBJECT (src,
-          "Reading %zd bytes at offset 0x%" G_GINT64_MODIFIER "x (%lld size)",
-          to_read, src->fd_offset + byte_read, (long long) src->fd_offset);
-      errno = 0;
-      read_size = read (src->fd, data + byte_read, to_read);
-      GST_LOG_OBJECT (src, "Read: %zd", read_size);
-      if (read_size < 0) {
-        if (errno == EAGAIN || errno == EINTR)
-          continue;
-        GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-        ret = GST_FLOW_ERROR;
-        goto error;
-      }
-      /* files should eos if they read 0 and more was requested */
-      if (read_size == 0) {
-        /* .. but first we should return any remaining data */
-        if (byte_read > 0)
-          break;
-        GST_DEBUG_OBJECT (src, "EOS");
-        ret = GST_FLOW_EOS;
-        goto error;
-      }
-      to_read -= read_size;
-      byte_read += read_size;
+    offset += tensor_size;
 
-      src->read_position += read_size;
-      src->fd_offset += read_size;
+    if (!gst_memory_map (mem, &info, GST_MAP_READ)) {
+      GST_ERROR_OBJECT (src, "Could not map GstMemory[%d]", i);
+      gst_memory_unref (mem);
+      ret = GST_FLOW_ERROR;
+      goto error;
     }
 
     /* check invalid flexible tensor */
-    if (!gst_tensor_meta_info_parse_header (&meta, info.data)) {
+    valid = gst_tensor_meta_info_parse_header (&meta, info.data);
+    gst_memory_unmap (mem, &info);
+
+    if (!valid) {
       GST_ERROR_OBJECT (src, "Invalid flexible tensors");
+      gst_memory_unref (mem);
       ret = GST_FLOW_ERROR;
       goto error;
     }
 
-    gst_memory_unmap (mem, &info);
-
     gst_tensor_meta_info_convert (&meta, &tinfo);
     gst_tensor_buffer_append_memory (buf, mem, &tinfo);
     gst_tensor_info_free (&tinfo);
@@ -855,10 +1114,6 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
   return GST_FLOW_OK;
 
 error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
-  }
   gst_buffer_unref (buf);
 
   return ret;
@@ -980,11 +1235,7 @@ gst_data_repo_src_read_others (GstDataRepoSrc * src, GstBuffer ** buffer)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *buf;
-  gsize to_read, byte_read;
-  gssize read_size;
-  guint8 *data;
   GstMemory *mem;
-  GstMapInfo info;
   guint shuffled_index = 0;
   guint64 offset = 0;
 
@@ -1012,63 +1263,16 @@ gst_data_repo_src_read_others (GstDataRepoSrc * src, GstBuffer ** buffer)
   GST_LOG_OBJECT (src, "shuffled_index [%d] -> %d", src->array_index - 1,
       shuffled_index);
   offset = gst_data_repo_src_get_file_offset (src, shuffled_index);
-  src->fd_offset = lseek (src->fd, offset, SEEK_SET);
-
-  mem = gst_allocator_alloc (NULL, src->sample_size, NULL);
-
-  if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
-    GST_ERROR_OBJECT (src, "Could not map GstMemory");
-    return GST_FLOW_ERROR;
-  }
-
-  data = info.data;
 
-  byte_read = 0;
-  to_read = src->sample_size;
-  while (to_read > 0) {
-    GST_LOG_OBJECT (src, "Reading %zd bytes at offset 0x%" G_GINT64_MODIFIER "x",
-        to_read, src->fd_offset + byte_read);
-    errno = 0;
-    read_size = read (src->fd, data + byte_read, to_read);
-    GST_LOG_OBJECT (src, "Read: %zd", read_size);
-    if (read_size < 0) {
-      if (errno == EAGAIN || errno == EINTR)
-        continue;
-      GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-      ret = GST_FLOW_ERROR;
-      goto error;
-    }
-    /* files should eos if they read 0 and more was requested */
-    if (read_size == 0) {
-      /* .. but first we should return any remaining data */
-      if (byte_read > 0)
-        break;
-      GST_DEBUG_OBJECT (src, "EOS");
-      ret = GST_FLOW_EOS;
-      goto error;
-    }
-    to_read -= read_size;
-    byte_read += read_size;
-
-    src->read_position += read_size;
-    src->fd_offset += read_size;
-  }
-
-  gst_memory_unmap (mem, &info);
+  ret = gst_data_repo_src_read_region (src, offset, src->sample_size, &mem);
+  if (ret != GST_FLOW_OK)
+    return ret;
 
   buf = gst_buffer_new ();
   gst_buffer_append_memory (buf, mem);
 
   *buffer = buf;
   return GST_FLOW_OK;
-
-error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
-  }
-
-  return ret;
 }
 
 /**
@@ -1088,6 +1292,19 @@ gst_data_repo_src_start (GstDataRepoSrc * src)
 
   src->current_sample_index = src->start_sample_index;
   src->num_samples = src->stop_sample_index - src->start_sample_index + 1;
+
+  /* restart from the first sample of the epoch */
+  src->array_index = 0;
+  src->prefetch_pos = 0;
+  if (!src->first_epoch_is_done)
+    g_array_set_size (src->shuffled_index_array, 0);
+
+  GST_OBJECT_LOCK (src);
+  src->read_samples = 0;
+  src->read_bytes = 0;
+  src->read_time = 0;
+  GST_OBJECT_UNLOCK (src);
+  g_atomic_int_set (&src->prefetched, 0);
   GST_INFO_OBJECT (src,
       "The number of samples to be used out of the total samples in the file is %d, [%d] ~ [%d]",
       src->num_samples, src->start_sample_index, src->stop_sample_index);
@@ -1142,6 +1359,8 @@ gst_data_repo_src_start (GstDataRepoSrc * src)
     src->fd_offset = lseek (src->fd, src->start_offset, SEEK_SET);
     GST_LOG_OBJECT (src, "Start file offset 0x%" G_GINT64_MODIFIER "x",
         src->fd_offset);
+
+    gst_data_repo_src_start_read_ahead (src);
   }
 
   return TRUE;
@@ -1240,6 +1459,7 @@ gst_data_repo_src_create (GstPushSrc * pushsrc, GstBuffer ** buffer)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstDataRepoSrc *src;
+  gint64 start_time;
   src = GST_DATA_REPO_SRC (pushsrc);
 
   /** set_caps is completed after PAUSED_TO_PLAYING, so we cannot use change_state.
@@ -1251,6 +1471,8 @@ gst_data_repo_src_create (GstPushSrc * pushsrc, GstBuffer ** buffer)
     src->is_start = TRUE;
   }
 
+  start_time = g_get_monotonic_time ();
+
   switch (src->data_type) {
     case GST_DATA_REPO_DATA_VIDEO:
     case GST_DATA_REPO_DATA_AUDIO:
@@ -1274,6 +1496,14 @@ gst_data_repo_src_create (GstPushSrc * pushsrc, GstBuffer ** buffer)
   if (ret != GST_FLOW_OK)
     return ret;
 
+  GST_OBJECT_LOCK (src);
+  src->read_samples++;
+  src->read_bytes += gst_buffer_get_size (*buffer);
+  src->read_time += g_get_monotonic_time () - start_time;
+  GST_OBJECT_UNLOCK (src);
+
+  gst_data_repo_src_prefetch (src);
+
   if (src->rate_n)
     gst_data_repo_src_set_timestamp (src, *buffer);
 
@@ -1288,13 +1518,46 @@ gst_data_repo_src_stop (GstBaseSrc * basesrc)
 {
   GstDataRepoSrc *src = GST_DATA_REPO_SRC (basesrc);
 
+  gst_data_repo_src_stop_read_ahead (src);
+
   /* close the file */
   g_close (src->fd, NULL);
   src->fd = 0;
 
+  /* the file is opened again when the pipeline is restarted */
+  src->is_start = FALSE;
+
   return TRUE;
 }
 
+/**
+ * @brief Get the statistics of reading samples.
+ */
+static GstStructure *
+gst_data_repo_src_get_stats (GstDataRepoSrc * src)
+{
+  guint64 samples, bytes, read_time;
+  gdouble throughput = 0.0;
+
+  GST_OBJECT_LOCK (src);
+  samples = src->read_samples;
+  bytes = src->read_bytes;
+  read_time = src->read_time;
+  GST_OBJECT_UNLOCK (src);
+
+  /* bytes per microsecond is MB/s */
+  if (read_time > 0)
+    throughput = (gdouble) bytes / (gdouble) read_time;
+
+  return gst_structure_new ("stats",
+      "samples", G_TYPE_UINT64, samples,
+      "bytes", G_TYPE_UINT64, bytes,
+      "read-time", G_TYPE_UINT64, read_time,
+      "throughput", G_TYPE_DOUBLE, throughput,
+      "prefetched", G_TYPE_UINT, (guint) g_atomic_int_get (&src->prefetched),
+      NULL);
+}
+
 /**
  * @brief Get caps with tensors_sequence applied
  */
@@ -1582,6 +1845,12 @@ gst_data_repo_src_set_property (GObject * object, guint prop_id,
           src->need_changed_caps = TRUE;
       }
       break;
+    case PROP_USE_MMAP:
+      src->use_mmap = g_value_get_boolean (value);
+      break;
+    case PROP_PREFETCH:
+      src->prefetch = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1626,6 +1895,15 @@ gst_data_repo_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CAPS:
       gst_value_set_caps (value, src->caps);
       break;
+    case PROP_USE_MMAP:
+      g_value_set_boolean (value, src->use_mmap);
+      break;
+    case PROP_PREFETCH:
+      g_value_set_uint (value, src->prefetch);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_data_repo_src_get_stats (src));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -46,7 +46,7 @@ struct _GstDataRepoSrc {
   gboolean is_start;            /**< check if datareposrc is started */
   gboolean successful_read;     /**< used for checking EOS when reading more than one images(multi-files) from a path */
   gint fd;                      /**< open file descriptor */
-  gint file_size;               /**< file size, in bytes */
+  guint64 file_size;            /**< file size, in bytes */
   guint64 read_position;        /**< position of fd */
   guint64 fd_offset;            /**< offset of fd */
   guint64 start_offset;         /**< start offset to read */
@@ -68,6 +68,8 @@ struct _GstDataRepoSrc {
   guint stop_sample_index;      /**< stop index of sample to read, in case of image, the stoppting index of the numbered files */
   guint epochs;                 /**< repetition of range of files or samples to read */
   gboolean is_shuffle;          /**< shuffle the sample index */
+  gboolean use_mmap;            /**< wrap the samples in memory-mapped file without copying */
+  guint prefetch;               /**< the number of next samples to read ahead */
 
   GArray *shuffled_index_array; /**< shuffled sample index array */
   guint array_index;            /**< element index of shuffled_index_array */
@@ -87,6 +89,18 @@ struct _GstDataRepoSrc {
   guint tensor_size_array_len;
   guint tensor_count_array_len;
 
+  /* mmap and prefetch */
+  GMappedFile *mapped_file;     /**< memory-mapped file, NULL if reading the file with read() */
+  GThread *prefetch_thread;     /**< thread to read ahead the next samples */
+  GAsyncQueue *prefetch_queue;  /**< regions of the samples to be read ahead */
+  guint prefetch_pos;           /**< next element index of shuffled_index_array to be read ahead */
+
+  /* statistics */
+  guint64 read_samples;         /**< the number of samples read */
+  guint64 read_bytes;           /**< the number of bytes read */
+  guint64 read_time;            /**< total time to read samples, in microseconds */
+  gint prefetched;              /**< the number of samples read ahead (atomic) */
+
   GstClockTime running_time;    /**< one frame running time */
   gint rate_n, rate_d;
   guint64 n_frame;
@@ -90,6 +90,11 @@ enum
  */
 #define DEFAULT_FRAMES_FLUSH 0
 
+/**
+ * @brief The size of ring in the unit of window (frames-out and frames-in).
+ */
+#define RING_WINDOWS 4
+
 /**
  * @brief The dimension index of frames in configured tensor.
  */
@@ -143,6 +148,9 @@ gst_tensor_aggregator_change_state (GstElement * element,
     GstStateChange transition);
 
 static void gst_tensor_aggregator_reset (GstTensorAggregator * self);
+static void gst_tensor_aggregator_ring_free (gpointer data);
+static GstFlowReturn gst_tensor_aggregator_push (GstTensorAggregator * self,
+    GstBuffer * outbuf, gsize frame_size);
 static GstCaps *gst_tensor_aggregator_query_caps (GstTensorAggregator * self,
     GstPad * pad, GstCaps * filter);
 static gboolean gst_tensor_aggregator_parse_caps (GstTensorAggregator * self,
@@ -284,6 +292,8 @@ gst_tensor_aggregator_init (GstTensorAggregator * self)
   gst_tensors_config_init (&self->out_config);
 
   self->adapter_table = gst_tensor_aggregation_init ();
+  self->ring_table = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, gst_tensor_aggregator_ring_free);
   gst_tensor_aggregator_reset (self);
 }
 
@@ -302,6 +312,7 @@ gst_tensor_aggregator_finalize (GObject * object)
   gst_tensors_config_free (&self->in_config);
   gst_tensors_config_free (&self->out_config);
   g_hash_table_destroy (self->adapter_table);
+  g_hash_table_destroy (self->ring_table);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -530,6 +541,264 @@ gst_tensor_aggregator_get_adapter (GstTensorAggregator * self, GstBuffer * buf)
   return gst_tensor_aggregation_get_adapter (self->adapter_table, key);
 }
 
+/**
+ * @brief Data structure for the memory block of the ring, shared with outgoing buffers.
+ */
+typedef struct
+{
+  gint refcount; /**< reference count (ring and outgoing memories) */
+  guint8 *data; /**< memory block */
+  gsize size; /**< size of memory block */
+} GstTensorAggregatorArena;
+
+/**
+ * @brief Data structure to aggregate the frames without copying overlapped windows.
+ *
+ * Incoming frames are written once at the tail of the arena, and each outgoing buffer
+ * is a read-only memory view of the window in the arena. When the arena is full, the
+ * remained frames are moved to the beginning of the arena (or to new arena if the
+ * outgoing buffers still refer to the arena).
+ */
+typedef struct
+{
+  GstTensorAggregatorArena *arena; /**< memory block of frames */
+  gsize frame_size; /**< size of a frame */
+  guint capacity; /**< the number of frames in the arena */
+  guint head; /**< index of the first frame of next window */
+  guint tail; /**< index to write next frame */
+  GstClockTime *pts; /**< timestamp of each frame */
+  GstClockTime *dts; /**< decoding timestamp of each frame */
+  GstBuffer *meta_buf; /**< metadata of incoming buffer */
+} GstTensorAggregatorRing;
+
+/**
+ * @brief Create new arena.
+ */
+static GstTensorAggregatorArena *
+gst_tensor_aggregator_arena_new (gsize size)
+{
+  GstTensorAggregatorArena *arena;
+
+  arena = g_new0 (GstTensorAggregatorArena, 1);
+  arena->refcount = 1;
+  arena->data = g_malloc (size);
+  arena->size = size;
+
+  return arena;
+}
+
+/**
+ * @brief Increase the reference count of the arena.
+ */
+static GstTensorAggregatorArena *
+gst_tensor_aggregator_arena_ref (GstTensorAggregatorArena * arena)
+{
+  g_atomic_int_inc (&arena->refcount);
+  return arena;
+}
+
+/**
+ * @brief Decrease the reference count of the arena, and free it if it is not used.
+ */
+static void
+gst_tensor_aggregator_arena_unref (gpointer data)
+{
+  GstTensorAggregatorArena *arena = (GstTensorAggregatorArena *) data;
+
+  if (arena && g_atomic_int_dec_and_test (&arena->refcount)) {
+    g_free (arena->data);
+    g_free (arena);
+  }
+}
+
+/**
+ * @brief Free the ring.
+ */
+static void
+gst_tensor_aggregator_ring_free (gpointer data)
+{
+  GstTensorAggregatorRing *ring = (GstTensorAggregatorRing *) data;
+
+  if (ring) {
+    gst_tensor_aggregator_arena_unref (ring->arena);
+    if (ring->meta_buf)
+      gst_buffer_unref (ring->meta_buf);
+    g_free (ring->pts);
+    g_free (ring->dts);
+    g_free (ring);
+  }
+}
+
+/**
+ * @brief Internal function to get the ring for the client of incoming buffer.
+ */
+static GstTensorAggregatorRing *
+gst_tensor_aggregator_get_ring (GstTensorAggregator * self, GstBuffer * buf,
+    gsize frame_size)
+{
+  GstTensorAggregatorRing *ring;
+  GstMetaQuery *meta;
+  guint32 key = 0;
+
+  meta = gst_buffer_get_meta_query (buf);
+  if (meta)
+    key = meta->client_id;
+
+  ring = (GstTensorAggregatorRing *) g_hash_table_lookup (self->ring_table,
+      GUINT_TO_POINTER (key));
+
+  /* frame size is changed, drop the frames. */
+  if (ring && ring->frame_size != frame_size) {
+    g_hash_table_remove (self->ring_table, GUINT_TO_POINTER (key));
+    ring = NULL;
+  }
+
+  if (ring == NULL) {
+    ring = g_new0 (GstTensorAggregatorRing, 1);
+    ring->frame_size = frame_size;
+    ring->capacity = RING_WINDOWS * (self->frames_out + self->frames_in);
+    ring->arena = gst_tensor_aggregator_arena_new (frame_size * ring->capacity);
+    ring->pts = g_new (GstClockTime, ring->capacity);
+    ring->dts = g_new (GstClockTime, ring->capacity);
+
+    g_hash_table_insert (self->ring_table, GUINT_TO_POINTER (key), ring);
+  }
+
+  return ring;
+}
+
+/**
+ * @brief Write incoming frames at the tail of the ring.
+ */
+static gboolean
+gst_tensor_aggregator_ring_write (GstTensorAggregator * self,
+    GstTensorAggregatorRing * ring, GstBuffer * buf)
+{
+  GstTensorAggregatorArena *arena;
+  GstMapInfo map;
+  GstClockTime pts, dts, offset;
+  guint f, remained;
+  gint fn, fd;
+
+  if (ring->tail + self->frames_in > ring->capacity) {
+    /* move the remained frames to the beginning of the arena */
+    remained = ring->tail - ring->head;
+
+    if (g_atomic_int_get (&ring->arena->refcount) == 1) {
+      memmove (ring->arena->data, ring->arena->data + ring->frame_size * ring->head,
+          ring->frame_size * remained);
+    } else {
+      /* outgoing buffers still refer to the arena */
+      arena = gst_tensor_aggregator_arena_new (ring->arena->size);
+      memcpy (arena->data, ring->arena->data + ring->frame_size * ring->head,
+          ring->frame_size * remained);
+
+      gst_tensor_aggregator_arena_unref (ring->arena);
+      ring->arena = arena;
+    }
+
+    memmove (ring->pts, ring->pts + ring->head, sizeof (GstClockTime) * remained);
+    memmove (ring->dts, ring->dts + ring->head, sizeof (GstClockTime) * remained);
+    ring->head = 0;
+    ring->tail = remained;
+  }
+
+  if (!gst_buffer_map (buf, &map, GST_MAP_READ)) {
+    ml_loge ("Failed to map incoming buffer with tensor_aggregator.\n");
+    return FALSE;
+  }
+
+  memcpy (ring->arena->data + ring->frame_size * ring->tail, map.data,
+      ring->frame_size * self->frames_in);
+  gst_buffer_unmap (buf, &map);
+
+  /* timestamp of each frame */
+  fn = self->in_config.rate_n;
+  fd = self->in_config.rate_d;
+  pts = GST_BUFFER_PTS (buf);
+  dts = GST_BUFFER_DTS (buf);
+
+  for (f = 0; f < self->frames_in; f++) {
+    offset = 0;
+    if (fn > 0 && fd > 0)
+      offset = gst_util_uint64_scale_int (f * fd, GST_SECOND, fn);
+
+    ring->pts[ring->tail + f] = GST_CLOCK_TIME_IS_VALID (pts) ? pts + offset : pts;
+    ring->dts[ring->tail + f] = GST_CLOCK_TIME_IS_VALID (dts) ? dts + offset : dts;
+  }
+
+  ring->tail += self->frames_in;
+
+  /* keep metadata (e.g., query meta) of incoming buffer */
+  if (ring->meta_buf)
+    gst_buffer_unref (ring->meta_buf);
+  ring->meta_buf = gst_buffer_new ();
+  gst_buffer_copy_into (ring->meta_buf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  return TRUE;
+}
+
+/**
+ * @brief Aggregate the frames with the ring, and push the windows without copying frames.
+ */
+static GstFlowReturn
+gst_tensor_aggregator_chain_ring (GstTensorAggregator * self, GstBuffer * buf,
+    gsize frame_size)
+{
+  GstTensorAggregatorRing *ring;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstClockTime duration;
+  gsize out_size;
+  guint flush;
+
+  ring = gst_tensor_aggregator_get_ring (self, buf, frame_size);
+
+  duration = GST_BUFFER_DURATION (buf);
+  if (GST_CLOCK_TIME_IS_VALID (duration)) {
+    /** supposed same duration for incoming buffer */
+    duration = gst_util_uint64_scale_int (duration, self->frames_out,
+        self->frames_in);
+  }
+
+  if (!gst_tensor_aggregator_ring_write (self, ring, buf)) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
+  gst_buffer_unref (buf);
+
+  out_size = frame_size * self->frames_out;
+
+  while (ring->tail - ring->head >= self->frames_out && ret == GST_FLOW_OK) {
+    GstBuffer *outbuf;
+    GstMemory *mem;
+
+    /* read-only view of the window, overlapped windows share the frames */
+    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, ring->arena->data,
+        ring->arena->size, frame_size * ring->head, out_size,
+        gst_tensor_aggregator_arena_ref (ring->arena),
+        gst_tensor_aggregator_arena_unref);
+
+    outbuf = gst_buffer_new ();
+    gst_buffer_copy_into (outbuf, ring->meta_buf, GST_BUFFER_COPY_METADATA, 0,
+        -1);
+    gst_buffer_append_memory (outbuf, mem);
+
+    /** set timestamp */
+    GST_BUFFER_PTS (outbuf) = ring->pts[ring->head];
+    GST_BUFFER_DTS (outbuf) = ring->dts[ring->head];
+    GST_BUFFER_DURATION (outbuf) = duration;
+
+    ret = gst_tensor_aggregator_push (self, outbuf, frame_size);
+
+    /** flush frames, all available frames if flush is larger than available frames. */
+    flush = (self->frames_flush > 0) ? self->frames_flush : self->frames_out;
+    ring->head += MIN (flush, ring->tail - ring->head);
+  }
+
+  return ret;
+}
+
 /**
  * @brief Check tensor dimension and axis to concatenate data.
  * @param self this pointer to GstTensorAggregator
@@ -562,14 +831,15 @@ gst_tensor_aggregator_check_concat_axis (GstTensorAggregator * self,
 /**
  * @brief Change the data in buffer with given axis.
  * @param self this pointer to GstTensorAggregator
- * @param outbuf buffer to be concatenated
+ * @param srcbuf buffer to be concatenated (the buffer is released in this function)
  * @param info tensor info for one frame
+ * @return newly allocated buffer with concatenated data, NULL if failed
  */
-static gboolean
-gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * outbuf,
+static GstBuffer *
+gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * srcbuf,
     const GstTensorInfo * info)
 {
-  GstBuffer *srcbuf;
+  GstBuffer *outbuf;
   GstMapInfo src_info, dest_info;
   guint f;
   gsize block_size;
@@ -579,19 +849,25 @@ gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * outbuf,
   frame_size = gst_tensor_info_get_size (info);
   g_assert (frame_size > 0); /** Internal error */
 
-  srcbuf = gst_buffer_copy (outbuf);
-  outbuf = gst_buffer_make_writable (outbuf);
-
+  /**
+   * Write concatenated data into new buffer directly from the source buffer,
+   * instead of copying the source buffer and rewriting it.
+   */
   if (!gst_buffer_map (srcbuf, &src_info, GST_MAP_READ)) {
     ml_logf ("Failed to map source buffer with tensor_aggregator.\n");
     gst_buffer_unref (srcbuf);
-    return FALSE;
+    return NULL;
   }
+
+  outbuf = gst_buffer_new_allocate (NULL, src_info.size, NULL);
+  gst_buffer_copy_into (outbuf, srcbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
   if (!gst_buffer_map (outbuf, &dest_info, GST_MAP_WRITE)) {
     ml_logf ("Failed to map destination buffer with tensor_aggregator.\n");
     gst_buffer_unmap (srcbuf, &src_info);
     gst_buffer_unref (srcbuf);
-    return FALSE;
+    gst_buffer_unref (outbuf);
+    return NULL;
   }
 
   /**
@@ -795,7 +1071,7 @@ gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * outbuf,
 
   gst_buffer_unref (srcbuf);
 
-  return TRUE;
+  return outbuf;
 }
 
 /**
@@ -821,7 +1097,8 @@ gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
 
   if (gst_tensor_aggregator_check_concat_axis (self, &info)) {
     /** change data in buffer with given axis */
-    if (!gst_tensor_aggregator_concat (self, outbuf, &info))
+    outbuf = gst_tensor_aggregator_concat (self, outbuf, &info);
+    if (outbuf == NULL)
       return GST_FLOW_ERROR;
   }
 
@@ -858,6 +1135,14 @@ gst_tensor_aggregator_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return gst_tensor_aggregator_push (self, buf, frame_size);
   }
 
+  /**
+   * The windows are overlapped or larger than incoming buffer.
+   * Use the ring to write each frame once and share the frames with outgoing buffers.
+   * Otherwise, the adapter gives the sub-buffer of incoming buffer without copy.
+   */
+  if ((frames_flush > 0 && frames_flush < frames_out) || frames_out > frames_in)
+    return gst_tensor_aggregator_chain_ring (self, buf, frame_size);
+
   adapter = gst_tensor_aggregator_get_adapter (self, buf);
   g_assert (adapter != NULL);
 
@@ -981,6 +1266,7 @@ gst_tensor_aggregator_reset (GstTensorAggregator * self)
 {
   /* remove all buffers from adapter */
   gst_tensor_aggregation_clear_all (self->adapter_table);
+  g_hash_table_remove_all (self->ring_table);
 }
 
 /**
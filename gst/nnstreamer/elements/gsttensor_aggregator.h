@@ -64,6 +64,7 @@ struct _GstTensorAggregator
   guint frames_dim; /**< index of frames in tensor dimension */
 
   GHashTable *adapter_table; /**< adapt incoming tensor */
+  GHashTable *ring_table; /**< ring of incoming frames for overlapped or large windows */
 
   gboolean tensor_configured; /**< True if already successfully configured tensor metadata */
   GstTensorsConfig in_config; /**< input tensor info */
@@ -46,6 +46,7 @@
 
 #include <string.h>
 #include "gsttensor_converter.h"
+#include "tensor_data.h"
 #include "tensor_meta.h"
 
 #ifdef NO_VIDEO
@@ -123,7 +124,8 @@ enum
   PROP_SET_TIMESTAMP,
   PROP_SUBPLUGINS,
   PROP_SILENT,
-  PROP_MODE
+  PROP_MODE,
+  PROP_VIDEO_PREPROCESS
 };
 
 /**
@@ -170,6 +172,10 @@ static gboolean gst_tensor_converter_parse_caps (GstTensorConverter * self,
 static void gst_tensor_converter_update_caps (GstTensorConverter * self);
 static const NNStreamerExternalConverter *findExternalConverter (const char
     *media_type_name);
+static gboolean gst_tensor_converter_parse_video_preprocess (GstTensorConverter
+    * self, const gchar * option);
+static void gst_tensor_converter_video_preprocess_clear (GstTensorConverter *
+    self);
 
 /**
  * @brief Initialize the tensor_converter's class.
@@ -273,6 +279,20 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
           "Converter mode. e.g., mode=custom-code:<registered callback name>. For detail, refer to https://github.com/nnstreamer/nnstreamer/blob/main/gst/nnstreamer/elements/gsttensor_converter.md#custom-converter",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorConverter::video-preprocess:
+   *
+   * Option to resize, convert the color and normalize incoming video in a single pass.
+   * e.g., video-preprocess=width:224,height:224,order:rgb,layout:nchw,type:float32,mean:127.5,std:127.5
+   */
+  g_object_class_install_property (object_class, PROP_VIDEO_PREPROCESS,
+      g_param_spec_string ("video-preprocess", "Video preprocess",
+          "Option to preprocess video in a pass. Comma separated KEY:VALUE, "
+          "width:W, height:H, order:(rgb|bgr|gray), layout:(nhwc|nchw), "
+          "type:TYPE, method:(bilinear|nearest), mean:M[:M2:M3], std:S[:S2:S3]",
+          "", G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
   /* set src pad template */
   pad_caps =
       gst_caps_from_string (GST_TENSOR_CAP_DEFAULT ";"
@@ -366,6 +386,7 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->custom.func = NULL;
   self->custom.data = NULL;
   self->do_not_append_header = FALSE;
+  memset (&self->preprocess, 0, sizeof (GstTensorConverterVideoPreprocess));
   gst_tensors_info_init (&self->tensors_info);
   gst_tensors_config_init (&self->tensors_config);
   self->tensors_configured = FALSE;
@@ -392,6 +413,8 @@ gst_tensor_converter_finalize (GObject * object)
 
   g_free (self->mode_option);
   g_free (self->ext_fw);
+  gst_tensor_converter_video_preprocess_clear (self);
+  g_free (self->preprocess.option);
   self->custom.func = NULL;
   self->custom.data = NULL;
   if (self->externalConverter && self->externalConverter->close)
@@ -501,6 +524,29 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
 
       break;
     }
+    case PROP_VIDEO_PREPROCESS:
+    {
+      GstState state;
+
+      /* the tables are read in the streaming thread and decide the out caps */
+      GST_OBJECT_LOCK (self);
+      state = GST_STATE (self);
+      GST_OBJECT_UNLOCK (self);
+
+      if (state > GST_STATE_READY) {
+        nns_logw
+            ("Cannot change video-preprocess in %s state. Set it in NULL or READY state.",
+            gst_element_state_get_name (state));
+        break;
+      }
+
+      value_str = g_value_get_string (value);
+      if (!gst_tensor_converter_parse_video_preprocess (self, value_str)) {
+        nns_logw ("Invalid option for video-preprocess: %s",
+            GST_STR_NULL (value_str));
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -573,6 +619,10 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
       g_value_take_string (value, mode_str);
       break;
     }
+    case PROP_VIDEO_PREPROCESS:
+      g_value_set_string (value,
+          self->preprocess.option ? self->preprocess.option : "");
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1021,6 +1071,422 @@ _gst_tensor_converter_chain_chunk (GstTensorConverter * self,
   return ret;
 }
 
+/**
+ * @brief Clear the internal data of video preprocessing.
+ */
+static void
+gst_tensor_converter_video_preprocess_clear (GstTensorConverter * self)
+{
+  GstTensorConverterVideoPreprocess *pp = &self->preprocess;
+
+  g_free (pp->x_table);
+  g_free (pp->y_table);
+  g_free (pp->lut);
+
+  pp->x_table = pp->y_table = NULL;
+  pp->lut = NULL;
+}
+
+/**
+ * @brief Parse the option string of video preprocessing.
+ * @param self this pointer to GstTensorConverter
+ * @param option comma separated KEY:VALUE string (NULL or empty string to disable preprocessing)
+ * @return TRUE if the option is valid
+ */
+static gboolean
+gst_tensor_converter_parse_video_preprocess (GstTensorConverter * self,
+    const gchar * option)
+{
+  GstTensorConverterVideoPreprocess *pp = &self->preprocess;
+  gchar **options, **kv;
+  guint i, j, num, num_values;
+  gdouble *values;
+  gboolean ret = TRUE;
+
+  gst_tensor_converter_video_preprocess_clear (self);
+  g_free (pp->option);
+  pp->option = NULL;
+  pp->enabled = FALSE;
+
+  if (option == NULL || option[0] == '\0')
+    return TRUE;
+
+  /* default values */
+  pp->width = pp->height = 0;
+  pp->order = _CONVERTER_VIDEO_ORDER_NONE;
+  pp->nchw = FALSE;
+  pp->bilinear = TRUE;
+  pp->type = _NNS_UINT8;
+  for (i = 0; i < VIDEO_PREPROCESS_CH_MAX; i++) {
+    pp->mean[i] = 0.0;
+    pp->std[i] = 1.0;
+  }
+
+  options = g_strsplit (option, ",", -1);
+  num = g_strv_length (options);
+
+  for (i = 0; i < num && ret; i++) {
+    kv = g_strsplit (g_strstrip (options[i]), ":", -1);
+    num_values = g_strv_length (kv);
+    num_values = (num_values > 0) ? num_values - 1 : 0;
+
+    if (num_values == 0) {
+      ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "width") == 0) {
+      pp->width = (guint) g_ascii_strtoull (kv[1], NULL, 10);
+      ret = (pp->width > 0);
+    } else if (g_ascii_strcasecmp (kv[0], "height") == 0) {
+      pp->height = (guint) g_ascii_strtoull (kv[1], NULL, 10);
+      ret = (pp->height > 0);
+    } else if (g_ascii_strcasecmp (kv[0], "order") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "rgb") == 0)
+        pp->order = _CONVERTER_VIDEO_ORDER_RGB;
+      else if (g_ascii_strcasecmp (kv[1], "bgr") == 0)
+        pp->order = _CONVERTER_VIDEO_ORDER_BGR;
+      else if (g_ascii_strcasecmp (kv[1], "gray") == 0)
+        pp->order = _CONVERTER_VIDEO_ORDER_GRAY;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "layout") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "nchw") == 0)
+        pp->nchw = TRUE;
+      else if (g_ascii_strcasecmp (kv[1], "nhwc") == 0)
+        pp->nchw = FALSE;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "method") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "bilinear") == 0)
+        pp->bilinear = TRUE;
+      else if (g_ascii_strcasecmp (kv[1], "nearest") == 0)
+        pp->bilinear = FALSE;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "type") == 0) {
+      pp->type = gst_tensor_get_type (kv[1]);
+      ret = (pp->type != _NNS_END);
+    } else if (g_ascii_strcasecmp (kv[0], "mean") == 0 ||
+        g_ascii_strcasecmp (kv[0], "std") == 0) {
+      values = (g_ascii_strcasecmp (kv[0], "mean") == 0) ? pp->mean : pp->std;
+
+      if (num_values > VIDEO_PREPROCESS_CH_MAX) {
+        ret = FALSE;
+      } else {
+        /* a single value is applied to all channels */
+        for (j = 0; j < VIDEO_PREPROCESS_CH_MAX; j++) {
+          if (j < num_values || num_values == 1)
+            values[j] = g_ascii_strtod (kv[MIN (j, num_values - 1) + 1], NULL);
+        }
+
+        if (values == pp->std) {
+          for (j = 0; j < VIDEO_PREPROCESS_CH_MAX; j++)
+            ret = ret && (values[j] != 0.0);
+        }
+      }
+    } else {
+      ret = FALSE;
+    }
+
+    if (!ret)
+      GST_ERROR_OBJECT (self, "Invalid video-preprocess option '%s'",
+          options[i]);
+
+    g_strfreev (kv);
+  }
+
+  g_strfreev (options);
+
+  if (ret) {
+    pp->option = g_strdup (option);
+    pp->enabled = TRUE;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Fill the table of byte offsets and weights to resize the video.
+ * @param table table with 3 entries (two offsets and weight of the second) for each output pixel
+ * @param in_size width or height of incoming video
+ * @param out_size width or height of output tensor
+ * @param unit bytes of a pixel or a row in incoming video
+ * @param bilinear TRUE for bilinear interpolation, otherwise nearest
+ */
+static void
+gst_tensor_converter_video_preprocess_table (guint * table, guint in_size,
+    guint out_size, guint unit, gboolean bilinear)
+{
+  gdouble pos;
+  guint i, i0, i1, w;
+
+  for (i = 0; i < out_size; i++) {
+    /* align the centers of pixels */
+    pos = ((gdouble) i + 0.5) * in_size / out_size;
+
+    if (bilinear) {
+      pos = MAX (pos - 0.5, 0.0);
+      i0 = (guint) pos;
+
+      if (i0 >= in_size - 1) {
+        i0 = i1 = in_size - 1;
+        w = 0;
+      } else {
+        i1 = i0 + 1;
+        w = (guint) ((pos - i0) * 256.0 + 0.5);
+      }
+    } else {
+      i0 = i1 = MIN ((guint) pos, in_size - 1);
+      w = 0;
+    }
+
+    table[3 * i] = i0 * unit;
+    table[3 * i + 1] = i1 * unit;
+    table[3 * i + 2] = w;
+  }
+}
+
+/**
+ * @brief Configure video preprocessing with incoming video and set tensor config.
+ * @return TRUE if the video format is supported
+ */
+static gboolean
+gst_tensor_converter_video_preprocess_configure (GstTensorConverter * self,
+    GstVideoFormat format, guint width, guint height,
+    GstTensorsConfig * config)
+{
+  GstTensorConverterVideoPreprocess *pp = &self->preprocess;
+  GstTensorInfo *_info;
+  guint bpp, r, g, b, c, v, out_w, out_h;
+  gsize element_size;
+  gdouble value;
+
+  switch (format) {
+    case GST_VIDEO_FORMAT_GRAY8:
+      bpp = 1;
+      r = g = b = 0;
+      break;
+    case GST_VIDEO_FORMAT_RGB:
+      bpp = 3;
+      r = 0, g = 1, b = 2;
+      break;
+    case GST_VIDEO_FORMAT_BGR:
+      bpp = 3;
+      r = 2, g = 1, b = 0;
+      break;
+    case GST_VIDEO_FORMAT_RGBx:
+    case GST_VIDEO_FORMAT_RGBA:
+      bpp = 4;
+      r = 0, g = 1, b = 2;
+      break;
+    case GST_VIDEO_FORMAT_BGRx:
+    case GST_VIDEO_FORMAT_BGRA:
+      bpp = 4;
+      r = 2, g = 1, b = 0;
+      break;
+    case GST_VIDEO_FORMAT_xRGB:
+    case GST_VIDEO_FORMAT_ARGB:
+      bpp = 4;
+      r = 1, g = 2, b = 3;
+      break;
+    case GST_VIDEO_FORMAT_xBGR:
+    case GST_VIDEO_FORMAT_ABGR:
+      bpp = 4;
+      r = 3, g = 2, b = 1;
+      break;
+    default:
+      GST_ERROR_OBJECT (self,
+          "The video format \"%s\" is not supported with video-preprocess. Please use 8-bit formats (GRAY8, RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, or ABGR).",
+          GST_STR_NULL (gst_video_format_to_string (format)));
+      return FALSE;
+  }
+
+  gst_tensor_converter_video_preprocess_clear (self);
+
+  pp->luma = FALSE;
+  switch (pp->order) {
+    case _CONVERTER_VIDEO_ORDER_RGB:
+      pp->channels = 3;
+      pp->offset[0] = r, pp->offset[1] = g, pp->offset[2] = b;
+      break;
+    case _CONVERTER_VIDEO_ORDER_BGR:
+      pp->channels = 3;
+      pp->offset[0] = b, pp->offset[1] = g, pp->offset[2] = r;
+      break;
+    case _CONVERTER_VIDEO_ORDER_GRAY:
+      pp->channels = 1;
+      pp->offset[0] = r, pp->offset[1] = g, pp->offset[2] = b;
+      pp->luma = (bpp > 1);
+      break;
+    default:
+      /* keep the channels of incoming video */
+      pp->channels = bpp;
+      for (c = 0; c < bpp; c++)
+        pp->offset[c] = c;
+      break;
+  }
+
+  out_w = (pp->width > 0) ? pp->width : width;
+  out_h = (pp->height > 0) ? pp->height : height;
+
+  pp->in_width = width;
+  pp->in_height = height;
+  pp->in_stride = GST_ROUND_UP_4 (width * bpp);
+
+  pp->x_table = g_new (guint, 3 * out_w);
+  pp->y_table = g_new (guint, 3 * out_h);
+  gst_tensor_converter_video_preprocess_table (pp->x_table, width, out_w, bpp,
+      pp->bilinear);
+  gst_tensor_converter_video_preprocess_table (pp->y_table, height, out_h,
+      pp->in_stride, pp->bilinear);
+
+  /* normalization and typecast are done with lookup table of 8-bit value */
+  element_size = gst_tensor_get_element_size (pp->type);
+  pp->lut = g_malloc (element_size * 256 * pp->channels);
+  for (c = 0; c < pp->channels; c++) {
+    for (v = 0; v < 256; v++) {
+      value = ((gdouble) v - pp->mean[c]) / pp->std[c];
+      gst_tensor_data_raw_typecast (&value, _NNS_FLOAT64,
+          pp->lut + element_size * (c * 256 + v), pp->type);
+    }
+  }
+
+  _info = gst_tensors_info_get_nth_info (&config->info, 0);
+  _info->type = pp->type;
+  if (pp->nchw) {
+    _info->dimension[0] = out_w;
+    _info->dimension[1] = out_h;
+    _info->dimension[2] = pp->channels;
+  } else {
+    _info->dimension[0] = pp->channels;
+    _info->dimension[1] = out_w;
+    _info->dimension[2] = out_h;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the interpolated value of a channel.
+ */
+static inline guint
+gst_tensor_converter_video_interpolate (const guint8 * r0, const guint8 * r1,
+    const guint * xt, guint wy, guint offset)
+{
+  guint top, bottom;
+
+  top = r0[xt[0] + offset] * (256 - xt[2]) + r0[xt[1] + offset] * xt[2];
+  bottom = r1[xt[0] + offset] * (256 - xt[2]) + r1[xt[1] + offset] * xt[2];
+
+  return (top * (256 - wy) + bottom * wy + 32768) >> 16;
+}
+
+/**
+ * @brief Macro to resize, convert color and normalize a frame with the type of output tensor.
+ */
+#define video_preprocess_loop(ctype) do { \
+    const ctype *lut = (const ctype *) pp->lut; \
+    ctype *out = (ctype *) dest; \
+    for (dy = 0; dy < out_h; dy++) { \
+      const guint8 *r0 = src + pp->y_table[3 * dy]; \
+      const guint8 *r1 = src + pp->y_table[3 * dy + 1]; \
+      const guint wy = pp->y_table[3 * dy + 2]; \
+      for (dx = 0; dx < out_w; dx++) { \
+        const guint *xt = pp->x_table + 3 * dx; \
+        gsize base = pp->nchw ? (dy * out_w + dx) : ((dy * out_w + dx) * pp->channels); \
+        if (pp->luma) { \
+          v = (77 * gst_tensor_converter_video_interpolate (r0, r1, xt, wy, pp->offset[0]) + \
+              150 * gst_tensor_converter_video_interpolate (r0, r1, xt, wy, pp->offset[1]) + \
+              29 * gst_tensor_converter_video_interpolate (r0, r1, xt, wy, pp->offset[2]) + 128) >> 8; \
+          out[base] = lut[v]; \
+          continue; \
+        } \
+        for (c = 0; c < pp->channels; c++) { \
+          v = gst_tensor_converter_video_interpolate (r0, r1, xt, wy, pp->offset[c]); \
+          out[base + c * ch_step] = lut[c * 256 + v]; \
+        } \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Resize, convert color and normalize a frame into the output tensor.
+ */
+static void
+gst_tensor_converter_video_preprocess_frame (GstTensorConverter * self,
+    const guint8 * src, guint8 * dest)
+{
+  GstTensorConverterVideoPreprocess *pp = &self->preprocess;
+  guint dx, dy, c, v, out_w, out_h;
+  gsize ch_step;
+
+  out_w = (pp->width > 0) ? pp->width : pp->in_width;
+  out_h = (pp->height > 0) ? pp->height : pp->in_height;
+  ch_step = pp->nchw ? (gsize) out_w * out_h : 1;
+
+  switch (gst_tensor_get_element_size (pp->type)) {
+    case 1:
+      video_preprocess_loop (uint8_t);
+      break;
+    case 2:
+      video_preprocess_loop (uint16_t);
+      break;
+    case 4:
+      video_preprocess_loop (uint32_t);
+      break;
+    case 8:
+      video_preprocess_loop (uint64_t);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Preprocess the incoming video frame and get new buffer of output tensor.
+ * @return Newly allocated buffer, NULL if failed to process the frame.
+ */
+static GstBuffer *
+gst_tensor_converter_video_preprocess (GstTensorConverter * self,
+    GstBuffer * buf, gsize frame_size)
+{
+  GstTensorConverterVideoPreprocess *pp = &self->preprocess;
+  GstMapInfo src_info, dest_info;
+  GstBuffer *outbuf;
+
+  if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
+    ml_logf
+        ("tensor_converter: Cannot map src buffer at tensor_converter/video. The incoming buffer (GstBuffer) for the sinkpad of tensor_converter cannot be mapped for reading.\n");
+    return NULL;
+  }
+
+  if (src_info.size < (gsize) pp->in_stride * pp->in_height) {
+    GST_ERROR_OBJECT (self,
+        "The size of incoming video frame (%zd) is smaller than expected (%zd).",
+        src_info.size, (gsize) pp->in_stride * pp->in_height);
+    gst_buffer_unmap (buf, &src_info);
+    return NULL;
+  }
+
+  outbuf = gst_buffer_new_and_alloc (frame_size);
+  if (!gst_buffer_map (outbuf, &dest_info, GST_MAP_WRITE)) {
+    ml_logf
+        ("tensor_converter: Cannot map dest buffer at tensor_converter/video. The outgoing buffer (GstBuffer) for the srcpad of tensor_converter cannot be mapped for writing.\n");
+    gst_buffer_unmap (buf, &src_info);
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  gst_tensor_converter_video_preprocess_frame (self, src_info.data,
+      dest_info.data);
+
+  gst_buffer_unmap (buf, &src_info);
+  gst_buffer_unmap (outbuf, &dest_info);
+
+  /** copy timestamps */
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return outbuf;
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -1073,7 +1539,11 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       /** supposed 1 frame in buffer */
       g_assert ((buf_size / self->frame_size) == 1);
 
-      if (self->remove_padding) {
+      if (self->preprocess.enabled) {
+        inbuf = gst_tensor_converter_video_preprocess (self, buf, frame_size);
+        if (inbuf == NULL)
+          goto error;
+      } else if (self->remove_padding) {
         GstMapInfo src_info, dest_info;
         guint d0, d1;
         unsigned int src_idx = 0, dest_idx = 0;
@@ -1522,11 +1992,16 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
   config->rate_n = GST_VIDEO_INFO_FPS_N (&vinfo);
   config->rate_d = GST_VIDEO_INFO_FPS_D (&vinfo);
 
-  /**
-   * Emit Warning if RSTRIDE = RU4 (3BPP) && Width % 4 > 0
-   * @todo Add more conditions!
-   */
-  if (gst_tensor_converter_video_stride (format, width)) {
+  if (self->preprocess.enabled) {
+    /* preprocessing handles the stride of incoming video */
+    if (!gst_tensor_converter_video_preprocess_configure (self, format, width,
+            height, config))
+      return FALSE;
+  } else if (gst_tensor_converter_video_stride (format, width)) {
+    /**
+     * Emit Warning if RSTRIDE = RU4 (3BPP) && Width % 4 > 0
+     * @todo Add more conditions!
+     */
     self->remove_padding = TRUE;
     silent_debug (self, "Set flag to remove padding, width = %d", width);
 
@@ -1963,8 +2438,8 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
 
       switch (type) {
         case _NNS_VIDEO:
-          /* video caps from tensor info */
-          if (is_video_supported (self)) {
+          /* video caps from tensor info (any size and format with preprocessing) */
+          if (is_video_supported (self) && !self->preprocess.enabled) {
             GValue supported_formats = G_VALUE_INIT;
             gint colorspace, width, height;
 
@@ -69,6 +69,50 @@ typedef enum {
   _CONVERTER_MODE_CUSTOM_SCRIPT = 2,	/**<  Custom mode (script type) */
 } tensor_converter_mode;
 
+/**
+ * @brief The max number of channels for video preprocessing.
+ */
+#define VIDEO_PREPROCESS_CH_MAX (4)
+
+/**
+ * @brief Channel order of the video preprocessing.
+ */
+typedef enum {
+  _CONVERTER_VIDEO_ORDER_NONE = 0,	/**< Keep the channels of incoming video (default) */
+  _CONVERTER_VIDEO_ORDER_RGB = 1,	/**< 3 channels, red-green-blue */
+  _CONVERTER_VIDEO_ORDER_BGR = 2,	/**< 3 channels, blue-green-red */
+  _CONVERTER_VIDEO_ORDER_GRAY = 3,	/**< 1 channel, luma of incoming video */
+} tensor_converter_video_order;
+
+/**
+ * @brief Data structure for video preprocessing (resize, color conversion and normalization in a pass).
+ */
+typedef struct
+{
+  gboolean enabled; /**< True if the video preprocessing is configured */
+  gchar *option; /**< option string of the video preprocessing */
+
+  guint width; /**< target width (0 to keep the width of incoming video) */
+  guint height; /**< target height (0 to keep the height of incoming video) */
+  tensor_converter_video_order order; /**< channel order of output tensor */
+  gboolean nchw; /**< True if the layout of output tensor is channel-first */
+  gboolean bilinear; /**< True for bilinear interpolation, otherwise nearest */
+  tensor_type type; /**< type of output tensor */
+  gdouble mean[VIDEO_PREPROCESS_CH_MAX]; /**< value to subtract for each channel */
+  gdouble std[VIDEO_PREPROCESS_CH_MAX]; /**< value to divide for each channel */
+
+  /* internal data configured with incoming video */
+  guint in_width; /**< width of incoming video */
+  guint in_height; /**< height of incoming video */
+  guint in_stride; /**< bytes of a row in incoming video */
+  guint channels; /**< the number of channels in output tensor */
+  guint offset[VIDEO_PREPROCESS_CH_MAX]; /**< byte offset of each channel in the pixel of incoming video */
+  gboolean luma; /**< True to convert RGB to luma (offset has R, G and B) */
+  guint *x_table; /**< byte offsets of left and right pixels and weight for each column */
+  guint *y_table; /**< byte offsets of upper and lower rows and weight for each row */
+  guint8 *lut; /**< lookup table to normalize and typecast 8-bit value for each channel */
+} GstTensorConverterVideoPreprocess;
+
 /**
  * @brief Internal data structure for tensor_converter instances.
  */
@@ -105,6 +149,7 @@ struct _GstTensorConverter
   gchar *ext_fw; /**< tensor converter custom mode framework */
   converter_custom_cb_s custom;
   gboolean do_not_append_header;
+  GstTensorConverterVideoPreprocess preprocess; /**< video preprocessing */
 
   void *priv_data; /**< plugin's private data */
 };
@@ -24,6 +24,11 @@
  *
  * The output is always in the format of other/tensors-flexible.
  *
+ * By default, each region is copied into a separate memory block with its own size.
+ * If the property 'resize' is given, tensor_crop resizes every region to the given size with bilinear interpolation
+ * and packs all regions of a frame into a single tensor (channel:width:height:num-regions, or width:height:channel:num-regions with 'resize-layout=nchw').
+ * The output buffers are allocated from a buffer pool, so the next element (e.g., the classifier of two-stage detection pipeline) can process the regions at once.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -32,6 +37,12 @@
  *       t. ! queue ! crop.raw \
  *       t. ! queue ! (process raw video tensor and push buffer which includes crop info) ! crop.info
  * ]|
+ * |[
+ * gst-launch-1.0 tensor_crop name=crop resize=224:224 ! (batched regions 3:224:224:N) ! tensor_filter ... \
+ *     videotestsrc ! videoconvert ! video/x-raw,format=RGB ! tensor_converter ! tee name=t \
+ *       t. ! queue ! crop.raw \
+ *       t. ! queue ! (detection model and decoder to get the regions) ! crop.info
+ * ]|
  * </refsect2>
  */
 
@@ -40,6 +51,7 @@
 #endif
 
 #include <string.h>
+#include <math.h>
 #include <nnstreamer_util.h>
 #include "gsttensor_crop.h"
 #include "tensor_data.h"
@@ -75,7 +87,9 @@ enum
 {
   PROP_0,
   PROP_LATENESS,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_RESIZE,
+  PROP_RESIZE_LAYOUT
 };
 
 /**
@@ -88,6 +102,11 @@ enum
  */
 #define DEFAULT_LATENESS (-1)
 
+/**
+ * @brief Default layout of resized regions.
+ */
+#define DEFAULT_RESIZE_LAYOUT "nhwc"
+
 /**
  * @brief Template for sink pad (raw data).
  */
@@ -171,6 +190,29 @@ gst_tensor_crop_class_init (GstTensorCropClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorCrop::resize:
+   *
+   * The size (WIDTH:HEIGHT) to resize the regions. If given, tensor_crop resizes all regions
+   * with bilinear interpolation and packs them into a single tensor. Empty string disables resizing.
+   */
+  g_object_class_install_property (object_class, PROP_RESIZE,
+      g_param_spec_string ("resize", "Resize",
+          "The size (WIDTH:HEIGHT) to resize and pack the regions into a single tensor",
+          "", G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorCrop::resize-layout:
+   *
+   * The layout of resized regions, 'nhwc' (channel:width:height:num, default) or 'nchw' (width:height:channel:num).
+   */
+  g_object_class_install_property (object_class, PROP_RESIZE_LAYOUT,
+      g_param_spec_string ("resize-layout", "Resize layout",
+          "The layout of resized regions (nhwc or nchw)",
+          DEFAULT_RESIZE_LAYOUT, G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
   element_class->change_state =
       GST_DEBUG_FUNCPTR (gst_tensor_crop_change_state);
 
@@ -219,6 +261,13 @@ gst_tensor_crop_reset (GstTensorCrop * self)
   }
 
   self->send_stream_start = TRUE;
+
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+  self->pool_size = 0;
 }
 
 /**
@@ -256,6 +305,10 @@ gst_tensor_crop_init (GstTensorCrop * self)
   self->lateness = DEFAULT_LATENESS;
   self->silent = DEFAULT_SILENT;
   self->send_stream_start = TRUE;
+  self->resize_width = self->resize_height = 0;
+  self->resize_nchw = FALSE;
+  self->pool = NULL;
+  self->pool_size = 0;
 }
 
 /**
@@ -278,6 +331,29 @@ gst_tensor_crop_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Internal function to check the resize options can be changed.
+ * @details The resize options are read while processing the buffers without lock.
+ */
+static gboolean
+gst_tensor_crop_resize_is_mutable (GstTensorCrop * self, const gchar * name)
+{
+  GstState state;
+
+  GST_OBJECT_LOCK (self);
+  state = GST_STATE (self);
+  GST_OBJECT_UNLOCK (self);
+
+  if (state > GST_STATE_READY) {
+    GST_WARNING_OBJECT (self,
+        "Cannot change %s in %s state. Set it in NULL or READY state.",
+        name, gst_element_state_get_name (state));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Setter for tensor_crop properties.
  */
@@ -296,6 +372,46 @@ gst_tensor_crop_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_RESIZE:
+    {
+      const gchar *str = g_value_get_string (value);
+      tensor_dim dim;
+
+      if (!gst_tensor_crop_resize_is_mutable (self, "resize"))
+        break;
+
+      self->resize_width = self->resize_height = 0;
+
+      if (str && str[0] != '\0') {
+        if (gst_tensor_parse_dimension (str, dim) == 2 && dim[0] > 0
+            && dim[1] > 0) {
+          self->resize_width = dim[0];
+          self->resize_height = dim[1];
+        } else {
+          GST_ERROR_OBJECT (self,
+              "Invalid resize option '%s', it should be WIDTH:HEIGHT.", str);
+        }
+      }
+      break;
+    }
+    case PROP_RESIZE_LAYOUT:
+    {
+      const gchar *str = g_value_get_string (value);
+
+      if (!gst_tensor_crop_resize_is_mutable (self, "resize-layout"))
+        break;
+
+      if (str && g_ascii_strcasecmp (str, "nchw") == 0) {
+        self->resize_nchw = TRUE;
+      } else if (str && g_ascii_strcasecmp (str, "nhwc") == 0) {
+        self->resize_nchw = FALSE;
+      } else {
+        GST_ERROR_OBJECT (self,
+            "Invalid resize layout '%s', it should be nhwc or nchw.",
+            GST_STR_NULL (str));
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -320,6 +436,17 @@ gst_tensor_crop_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_RESIZE:
+      if (self->resize_width > 0 && self->resize_height > 0) {
+        g_value_take_string (value, g_strdup_printf ("%u:%u",
+                self->resize_width, self->resize_height));
+      } else {
+        g_value_set_string (value, "");
+      }
+      break;
+    case PROP_RESIZE_LAYOUT:
+      g_value_set_string (value, self->resize_nchw ? "nchw" : "nhwc");
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -612,6 +739,422 @@ done:
   return ret;
 }
 
+/**
+ * @brief Internal function to clip the region with the size of raw tensor.
+ */
+static void
+gst_tensor_crop_clip_region (const tensor_region_s * region, guint mw,
+    guint mh, tensor_region_s * clipped)
+{
+  clipped->x = (region->x < mw) ? region->x : mw;
+  clipped->y = (region->y < mh) ? region->y : mh;
+  clipped->w = (clipped->x + region->w - 1 < mw) ? region->w : (mw - clipped->x);
+  clipped->h = (clipped->y + region->h - 1 < mh) ? region->h : (mh - clipped->y);
+}
+
+/**
+ * @brief Fill the table of source indices and weights for bilinear interpolation.
+ * @param idx table with 2 entries (two source indices) for each output pixel
+ * @param weight weight of the second source index for each output pixel
+ * @param in_size width or height of the region
+ * @param out_size width or height of the resized region
+ */
+static void
+gst_tensor_crop_resize_table (guint * idx, gdouble * weight, guint in_size,
+    guint out_size)
+{
+  gdouble pos;
+  guint i, i0;
+
+  for (i = 0; i < out_size; i++) {
+    /* align the centers of pixels */
+    pos = ((gdouble) i + 0.5) * in_size / out_size;
+    pos = MAX (pos - 0.5, 0.0);
+    i0 = (guint) pos;
+
+    if (i0 >= in_size - 1) {
+      idx[2 * i] = idx[2 * i + 1] = in_size - 1;
+      weight[i] = 0.0;
+    } else {
+      idx[2 * i] = i0;
+      idx[2 * i + 1] = i0 + 1;
+      weight[i] = pos - i0;
+    }
+  }
+}
+
+/**
+ * @brief Internal function to check the type is interpolated in double.
+ * @details float cannot represent all values of 32-bit and 64-bit integers and float64.
+ */
+static inline gboolean
+gst_tensor_crop_resize_in_double (tensor_type type)
+{
+  switch (type) {
+    case _NNS_INT32:
+    case _NNS_UINT32:
+    case _NNS_INT64:
+    case _NNS_UINT64:
+    case _NNS_FLOAT64:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+/**
+ * @brief Macro to interpolate a row of the region horizontally.
+ */
+#define resize_row(type,rtype) do { \
+    const type *_s = (const type *) src; \
+    rtype *_r = (rtype *) row; \
+    for (i = 0; i < width; i++) { \
+      const type *_p0 = _s + xidx[2 * i] * ch; \
+      const type *_p1 = _s + xidx[2 * i + 1] * ch; \
+      const rtype _w = (rtype) xw[i]; \
+      for (c = 0; c < ch; c++) \
+        _r[c] = (rtype) _p0[c] + ((rtype) _p1[c] - (rtype) _p0[c]) * _w; \
+      _r += ch; \
+    } \
+  } while (0)
+
+/**
+ * @brief Internal function to interpolate a row of the region horizontally.
+ * @param src the first element of the row in the region
+ * @param row output row (width * ch) in double if gst_tensor_crop_resize_in_double(), otherwise in float
+ */
+static void
+gst_tensor_crop_resize_row (const guint8 * src, tensor_type type, guint ch,
+    const guint * xidx, const gdouble * xw, guint width, gpointer row)
+{
+  guint i, c;
+
+  switch (type) {
+    case _NNS_INT32:
+      resize_row (int32_t, gdouble);
+      break;
+    case _NNS_UINT32:
+      resize_row (uint32_t, gdouble);
+      break;
+    case _NNS_INT16:
+      resize_row (int16_t, gfloat);
+      break;
+    case _NNS_UINT16:
+      resize_row (uint16_t, gfloat);
+      break;
+    case _NNS_INT8:
+      resize_row (int8_t, gfloat);
+      break;
+    case _NNS_UINT8:
+      resize_row (uint8_t, gfloat);
+      break;
+    case _NNS_FLOAT64:
+      resize_row (double, gdouble);
+      break;
+    case _NNS_FLOAT32:
+      resize_row (float, gfloat);
+      break;
+    case _NNS_INT64:
+      resize_row (int64_t, gdouble);
+      break;
+    case _NNS_UINT64:
+      resize_row (uint64_t, gdouble);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Macro to store the interpolated row.
+ */
+#define resize_store(type,rtype,rounding) do { \
+    const rtype *_r = (const rtype *) row; \
+    type *_d = (type *) dest; \
+    if (nchw) { \
+      for (i = 0; i < width; i++) \
+        for (c = 0; c < ch; c++) \
+          _d[c * plane + i] = (type) rounding (_r[i * ch + c]); \
+    } else { \
+      for (i = 0; i < width * ch; i++) \
+        _d[i] = (type) rounding (_r[i]); \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to round the interpolated value to the nearest integer.
+ */
+#define resize_round(v) floorf ((v) + 0.5f)
+#define resize_round_double(v) floor ((v) + 0.5)
+
+/**
+ * @brief Macro to keep the interpolated value.
+ */
+#define resize_keep(v) (v)
+
+/**
+ * @brief Internal function to store the interpolated row into the output tensor.
+ * @param dest the first element of the row in the output (of the first channel if nchw)
+ * @param plane the number of elements in a channel (used if nchw)
+ */
+static void
+gst_tensor_crop_resize_store (gconstpointer row, tensor_type type, guint ch,
+    guint width, gboolean nchw, gsize plane, guint8 * dest)
+{
+  guint i, c;
+
+  switch (type) {
+    case _NNS_INT32:
+      resize_store (int32_t, gdouble, resize_round_double);
+      break;
+    case _NNS_UINT32:
+      resize_store (uint32_t, gdouble, resize_round_double);
+      break;
+    case _NNS_INT16:
+      resize_store (int16_t, gfloat, resize_round);
+      break;
+    case _NNS_UINT16:
+      resize_store (uint16_t, gfloat, resize_round);
+      break;
+    case _NNS_INT8:
+      resize_store (int8_t, gfloat, resize_round);
+      break;
+    case _NNS_UINT8:
+      resize_store (uint8_t, gfloat, resize_round);
+      break;
+    case _NNS_FLOAT64:
+      resize_store (double, gdouble, resize_keep);
+      break;
+    case _NNS_FLOAT32:
+      resize_store (float, gfloat, resize_keep);
+      break;
+    case _NNS_INT64:
+      resize_store (int64_t, gdouble, resize_round_double);
+      break;
+    case _NNS_UINT64:
+      resize_store (uint64_t, gdouble, resize_round_double);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to get the output buffer from the pool.
+ */
+static GstBuffer *
+gst_tensor_crop_acquire_buffer (GstTensorCrop * self, gsize size)
+{
+  GstBuffer *buffer = NULL;
+  GstStructure *config;
+
+  /* the pool is reallocated only if the size of output grows */
+  if (self->pool && self->pool_size < size) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+
+  if (!self->pool) {
+    self->pool = gst_buffer_pool_new ();
+    self->pool_size = size;
+
+    config = gst_buffer_pool_get_config (self->pool);
+    gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+
+    if (!gst_buffer_pool_set_config (self->pool, config) ||
+        !gst_buffer_pool_set_active (self->pool, TRUE)) {
+      GST_ERROR_OBJECT (self, "Failed to activate the buffer pool.");
+      gst_object_unref (self->pool);
+      self->pool = NULL;
+      self->pool_size = 0;
+      return NULL;
+    }
+  }
+
+  if (gst_buffer_pool_acquire_buffer (self->pool, &buffer, NULL) != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (self, "Failed to acquire the buffer from the pool.");
+    return NULL;
+  }
+
+  return buffer;
+}
+
+/**
+ * @brief Internal function to resize the regions and pack them into a single tensor.
+ * @details Each output row is blended from two rows of the region, which are interpolated horizontally once
+ *          and reused by the next output rows. The vertical blending is a plain loop over the float rows
+ *          to be vectorized by the compiler. 32-bit and 64-bit types are interpolated in double.
+ */
+static GstBuffer *
+gst_tensor_crop_do_resizing (GstTensorCrop * self, const guint8 * dpos,
+    GstTensorMetaInfo * meta, const GstTensorInfo * info,
+    const tensor_crop_info_s * cinfo)
+{
+  GstBuffer *result;
+  GstMapInfo map;
+  tensor_region_s region;
+  gsize hsize, esize, rsize, plane;
+  guint ch, mw, mh, ow, oh, i, j, k, n;
+  guint *xidx, *yidx;
+  gdouble *xw, *yw;
+  gpointer rows[2], blend;
+  gsize bsize;
+  gboolean in_double;
+  guint cached[2];
+  guint8 *dest;
+
+  ch = info->dimension[0];
+  mw = info->dimension[1];
+  mh = info->dimension[2];
+  ow = self->resize_width;
+  oh = self->resize_height;
+  n = cinfo->num;
+
+  switch (info->type) {
+    case _NNS_INT32:
+    case _NNS_UINT32:
+    case _NNS_INT16:
+    case _NNS_UINT16:
+    case _NNS_INT8:
+    case _NNS_UINT8:
+    case _NNS_FLOAT64:
+    case _NNS_FLOAT32:
+    case _NNS_INT64:
+    case _NNS_UINT64:
+      break;
+    default:
+      GST_ERROR_OBJECT (self, "The type %s is not supported to resize.",
+          gst_tensor_get_type_string (info->type));
+      return NULL;
+  }
+
+  if (n == 0) {
+    /* nothing to crop */
+    return gst_buffer_new ();
+  }
+
+  esize = gst_tensor_get_element_size (info->type);
+  plane = (gsize) ow * oh;
+  rsize = esize * ch * plane;
+
+  meta->type = info->type;
+  if (self->resize_nchw) {
+    meta->dimension[0] = ow;
+    meta->dimension[1] = oh;
+    meta->dimension[2] = ch;
+  } else {
+    meta->dimension[0] = ch;
+    meta->dimension[1] = ow;
+    meta->dimension[2] = oh;
+  }
+  meta->dimension[3] = n;
+  for (i = 4; i < NNS_TENSOR_RANK_LIMIT; i++)
+    meta->dimension[i] = 0;
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  result = gst_tensor_crop_acquire_buffer (self, hsize + rsize * n);
+  if (!result)
+    return NULL;
+
+  if (!gst_buffer_map (result, &map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the output buffer.");
+    gst_buffer_unref (result);
+    return NULL;
+  }
+
+  gst_tensor_meta_info_update_header (meta, map.data);
+
+  xidx = g_new (guint, 2 * ow);
+  yidx = g_new (guint, 2 * oh);
+  xw = g_new (gdouble, ow);
+  yw = g_new (gdouble, oh);
+
+  in_double = gst_tensor_crop_resize_in_double (info->type);
+  bsize = (in_double ? sizeof (gdouble) : sizeof (gfloat)) * ow * ch;
+  rows[0] = g_malloc (bsize);
+  rows[1] = g_malloc (bsize);
+  blend = g_malloc (bsize);
+
+  for (k = 0; k < n; k++) {
+    gst_tensor_crop_clip_region (&cinfo->region[k], mw, mh, &region);
+    g_assert (region.w > 0 && region.h > 0);
+
+    gst_tensor_crop_resize_table (xidx, xw, region.w, ow);
+    gst_tensor_crop_resize_table (yidx, yw, region.h, oh);
+    cached[0] = cached[1] = G_MAXUINT;
+
+    for (j = 0; j < oh; j++) {
+      gconstpointer r0, r1;
+      guint y0 = yidx[2 * j];
+      guint y1 = yidx[2 * j + 1];
+
+      /* interpolate the rows of the region horizontally if not cached */
+      if (cached[0] != y0 && cached[1] != y0) {
+        guint slot = (cached[0] == y1) ? 1 : 0;
+
+        gst_tensor_crop_resize_row (dpos + esize * ch * (region.x +
+                (gsize) (region.y + y0) * mw), info->type, ch, xidx, xw, ow,
+            rows[slot]);
+        cached[slot] = y0;
+      }
+
+      if (cached[0] != y1 && cached[1] != y1) {
+        guint slot = (cached[0] == y0) ? 1 : 0;
+
+        gst_tensor_crop_resize_row (dpos + esize * ch * (region.x +
+                (gsize) (region.y + y1) * mw), info->type, ch, xidx, xw, ow,
+            rows[slot]);
+        cached[slot] = y1;
+      }
+
+      r0 = (cached[0] == y0) ? rows[0] : rows[1];
+      r1 = (cached[0] == y1) ? rows[0] : rows[1];
+
+      if (in_double) {
+        const gdouble *d0 = r0, *d1 = r1;
+        const gdouble w = yw[j];
+        gdouble *b = blend;
+
+        for (i = 0; i < ow * ch; i++)
+          b[i] = d0[i] + (d1[i] - d0[i]) * w;
+      } else {
+        const gfloat *f0 = r0, *f1 = r1;
+        const gfloat w = (gfloat) yw[j];
+        gfloat *b = blend;
+
+        for (i = 0; i < ow * ch; i++)
+          b[i] = f0[i] + (f1[i] - f0[i]) * w;
+      }
+
+      if (self->resize_nchw)
+        dest = map.data + hsize + rsize * k + esize * ow * j;
+      else
+        dest = map.data + hsize + rsize * k + esize * ch * ow * j;
+
+      gst_tensor_crop_resize_store (blend, info->type, ch, ow,
+          self->resize_nchw, plane, dest);
+    }
+  }
+
+  g_free (xidx);
+  g_free (yidx);
+  g_free (xw);
+  g_free (yw);
+  g_free (rows[0]);
+  g_free (rows[1]);
+  g_free (blend);
+
+  gst_buffer_unmap (result, &map);
+
+  /* the buffer in the pool may be larger than the output */
+  gst_buffer_resize (result, 0, hsize + rsize * n);
+
+  return result;
+}
+
 /**
  * @brief Internal function to crop incoming buffer.
  */
@@ -658,6 +1201,15 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
     goto done;
   }
 
+  if (self->resize_width > 0 && self->resize_height > 0) {
+    result = gst_tensor_crop_do_resizing (self, dpos, &meta, &info, cinfo);
+    if (result) {
+      /* set timestamp from raw buffer */
+      gst_buffer_copy_into (result, raw, GST_BUFFER_COPY_METADATA, 0, -1);
+    }
+    goto done;
+  }
+
   result = gst_buffer_new ();
 
   /** @todo Add various mode to crop tensor. */
@@ -670,11 +1222,13 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
   for (i = 0; i < cinfo->num; i++) {
     GstTensorInfo crop_info;
     GstMemory *crop_mem;
+    tensor_region_s region;
 
-    _x = (cinfo->region[i].x < mw) ? cinfo->region[i].x : mw;
-    _y = (cinfo->region[i].y < mh) ? cinfo->region[i].y : mh;
-    _w = (_x + cinfo->region[i].w - 1 < mw) ? cinfo->region[i].w : (mw - _x);
-    _h = (_y + cinfo->region[i].h - 1 < mh) ? cinfo->region[i].h : (mh - _y);
+    gst_tensor_crop_clip_region (&cinfo->region[i], mw, mh, &region);
+    _x = region.x;
+    _y = region.y;
+    _w = region.w;
+    _h = region.h;
 
     g_assert (_w > 0 && _h > 0);
     dsize = hsize + (esize * ch * _w * _h);
@@ -783,6 +1337,11 @@ gst_tensor_crop_chain (GstTensorCrop * self,
   }
 
   result = gst_tensor_crop_do_cropping (self, buf_raw, &cinfo);
+  if (!result) {
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
+
   ret = gst_pad_push (self->srcpad, result);
 
 done:
@@ -59,6 +59,12 @@ struct _GstTensorCrop
   gboolean silent; /**< true to print minimized log */
   gboolean send_stream_start; /**< flag to send STREAM_START event */
   GstCollectPads *collect; /**< sink pads */
+
+  guint resize_width; /**< width of resized regions (0 to disable resizing) */
+  guint resize_height; /**< height of resized regions (0 to disable resizing) */
+  gboolean resize_nchw; /**< true to pack resized regions in NCHW layout */
+  GstBufferPool *pool; /**< pool of output buffers for resized regions */
+  gsize pool_size; /**< size of a buffer in the pool */
 };
 
 /**
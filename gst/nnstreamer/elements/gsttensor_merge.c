@@ -32,6 +32,11 @@
  * A Merger that merge tensor stream to tensor stream for NN frameworks.
  * The output is always in the format of other/tensor
  *
+ * The copy plan (contiguous blocks of incoming tensors) is prepared when the caps are configured.
+ * If there is a single row in the output (e.g., merging the outermost rank) and the incoming memories
+ * are adjacent in the same parent memory, the output shares the parent memory without copying.
+ * With num-threads, a large output tensor is copied with multiple threads.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -81,8 +86,24 @@ enum
   PROP_SYNC_MODE,
   PROP_SYNC_OPTION,
   PROP_SILENT,
+  PROP_NUM_THREADS,
 };
 
+/**
+ * @brief Default number of threads, the tensor is copied in the streaming thread.
+ */
+#define DEFAULT_NUM_THREADS (1)
+
+/**
+ * @brief Max number of threads to copy a tensor.
+ */
+#define MAX_NUM_THREADS (64)
+
+/**
+ * @brief The number of bytes in a part of output copied by a thread.
+ */
+#define MERGE_TILE_SIZE (256 * 1024)
+
 static const gchar *gst_tensor_merge_mode_string[] = {
   [GTT_LINEAR] = "linear",
   [GTT_END] = "error",
@@ -181,6 +202,15 @@ gst_tensor_merge_class_init (GstTensorMergeClass * klass)
       g_param_spec_string ("sync-option", "Sync Option",
           "Option for the time synchronization mode", "", G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of threads to copy the parts of a large output tensor. "
+          "The output is same regardless of the number of threads. "
+          "The threads are created when the element starts.",
+          1, MAX_NUM_THREADS, DEFAULT_NUM_THREADS,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_tensor_merge_request_new_pad);
   gstelement_class->change_state =
@@ -233,6 +263,9 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   tensor_merge->loaded = FALSE;
   tensor_merge->current_time = 0;
   tensor_merge->need_set_time = TRUE;
+  memset (&tensor_merge->plan, 0, sizeof (tensor_merge_plan));
+  tensor_merge->num_threads = DEFAULT_NUM_THREADS;
+  tensor_merge->thread_pool = NULL;
 }
 
 /**
@@ -277,6 +310,9 @@ gst_tensor_merge_finalize (GObject * object)
     tensor_merge->sync.option = NULL;
   }
 
+  gst_tensor_tile_pool_free (tensor_merge->thread_pool);
+  tensor_merge->thread_pool = NULL;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -362,6 +398,10 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
       tensor_merge->need_set_time = TRUE;
       gst_tensor_time_sync_flush (tensor_merge->collect);
       break;
+    case GST_EVENT_CAPS:
+      /* the copy plan is prepared again with new tensors config */
+      tensor_merge->plan.num_tensors = 0;
+      break;
     default:
       break;
   }
@@ -453,6 +493,135 @@ gst_tensor_merge_collect_buffer (GstTensorMerge * tensor_merge,
       &tensor_merge->tensors_config, is_eos);
 }
 
+/**
+ * @brief Prepare the copy plan with current tensors config.
+ * @param tensor_merge tensor merger
+ * @return TRUE if the plan is prepared
+ */
+static gboolean
+gst_tensor_merge_prepare_plan (GstTensorMerge * tensor_merge)
+{
+  tensor_merge_plan *plan = &tensor_merge->plan;
+  GstTensorsInfo *info = &tensor_merge->tensors_config.info;
+  GstTensorInfo *_info;
+  gsize element_size, block;
+  guint i, j, direction;
+
+  memset (plan, 0, sizeof (tensor_merge_plan));
+
+  if (tensor_merge->mode != GTT_LINEAR || info->num_tensors == 0)
+    return FALSE;
+
+  direction = tensor_merge->data_linear.direction;
+  element_size = gst_tensor_get_element_size (info->info[0].type);
+
+  /* the dimensions outer than the merged rank are same in all tensors */
+  plan->num_rows = 1;
+  for (j = direction + 1; j < NNS_TENSOR_RANK_LIMIT; j++) {
+    if (info->info[0].dimension[j] == 0)
+      break;
+    plan->num_rows *= info->info[0].dimension[j];
+  }
+
+  for (i = 0; i < info->num_tensors; i++) {
+    _info = gst_tensors_info_get_nth_info (info, i);
+
+    block = element_size;
+    for (j = 0; j <= direction; j++)
+      block *= MAX (_info->dimension[j], 1);
+
+    plan->block_size[i] = block;
+    plan->block_offset[i] = plan->row_size;
+    plan->row_size += block;
+  }
+
+  plan->num_tensors = info->num_tensors;
+  return TRUE;
+}
+
+/**
+ * @brief Copy the part [start, end) of output tensor with the copy plan.
+ * @param plan the copy plan
+ * @param inptr incoming tensors
+ * @param outptr output tensor
+ * @param start the first byte of the part in output tensor
+ * @param end the end of the part (exclusive)
+ */
+static void
+gst_tensor_merge_copy_part (const tensor_merge_plan * plan,
+    const uint8_t ** inptr, uint8_t * outptr, gsize start, gsize end)
+{
+  gsize row, pos, offset, len;
+  guint k = 0;
+
+  row = start / plan->row_size;
+  pos = start - row * plan->row_size;
+
+  while (start < end) {
+    /* find the block including the position */
+    while (pos >= plan->block_offset[k] + plan->block_size[k])
+      k++;
+
+    offset = pos - plan->block_offset[k];
+    len = MIN (plan->block_size[k] - offset, end - start);
+
+    memcpy (outptr + start, inptr[k] + row * plan->block_size[k] + offset, len);
+
+    start += len;
+    pos += len;
+    if (pos == plan->row_size) {
+      row++;
+      pos = 0;
+      k = 0;
+    }
+  }
+}
+
+/**
+ * @brief Data structure of the output tensor, shared with the threads.
+ */
+typedef struct
+{
+  const tensor_merge_plan *plan; /**< the copy plan */
+  const uint8_t *inptr[NNS_TENSOR_SIZE_LIMIT]; /**< incoming tensors */
+  uint8_t *outptr; /**< output tensor */
+} GstTensorMergeJob;
+
+/**
+ * @brief Copy a part of output tensor.
+ */
+static void
+gst_tensor_merge_copy_tile (gsize start, gsize end, gpointer user_data)
+{
+  GstTensorMergeJob *job = (GstTensorMergeJob *) user_data;
+
+  gst_tensor_merge_copy_part (job->plan, job->inptr, job->outptr, start, end);
+}
+
+/**
+ * @brief Get the memory sharing the parent of incoming memories without copying.
+ * @return merged memory if incoming memories are adjacent in the same parent, NULL otherwise.
+ */
+static GstMemory *
+gst_tensor_merge_get_spanned_mem (GstMemory ** mem, guint num_mem, gsize size)
+{
+  gsize offset, tmp;
+  guint i;
+
+  if (num_mem == 1)
+    return gst_memory_ref (mem[0]);
+
+  if (!gst_memory_is_span (mem[0], mem[1], &offset))
+    return NULL;
+
+  for (i = 2; i < num_mem; i++) {
+    if (!gst_memory_is_span (mem[i - 1], mem[i], &tmp))
+      return NULL;
+  }
+
+  return gst_memory_share (mem[0]->parent, offset, size);
+}
+
 /**
  * @brief Generate Output GstMemory
  * @param tensor_merge tensor merger
@@ -468,137 +637,94 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
   GstMapInfo mInfo[NNS_TENSOR_SIZE_LIMIT];
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo outInfo;
-  GstMemory *outMem;
-  uint8_t *inptr, *outptr;
+  GstMemory *outMem = NULL;
+  tensor_merge_plan *plan = &tensor_merge->plan;
+  GstTensorMergeJob job;
   guint num_mem = tensor_merge->tensors_config.info.num_tensors;
-  guint i, j, k, l;
-  size_t c, s;
-  gsize outSize = 0;
-  gsize element_size;
-  tensor_dim dim;
-  tensor_type type;
+  guint num_mapped = 0;
+  guint i;
+  gsize outSize;
 
-  memcpy (&dim, &tensor_merge->tensors_config.info.info[0].dimension,
-      sizeof (tensor_dim));
-  type = tensor_merge->tensors_config.info.info[0].type;
-  element_size = gst_tensor_get_element_size (type);
+  if (plan->num_tensors != num_mem &&
+      !gst_tensor_merge_prepare_plan (tensor_merge)) {
+    GST_ERROR_OBJECT (tensor_merge, "Failed to prepare the copy plan.");
+    return GST_FLOW_ERROR;
+  }
 
   for (i = 0; i < num_mem; i++) {
     mem[i] = gst_tensor_buffer_get_nth_memory (tensors_buf, i);
+    if (!mem[i]) {
+      num_mem = i;
+      ret = GST_FLOW_ERROR;
+      goto error_ret;
+    }
+  }
+
+  /* the plan is prepared again if the incoming tensors are changed */
+  for (i = 0; i < num_mem; i++) {
+    if (gst_memory_get_sizes (mem[i], NULL, NULL) !=
+        plan->num_rows * plan->block_size[i]) {
+      gst_tensor_merge_prepare_plan (tensor_merge);
+      break;
+    }
+  }
+
+  outSize = plan->num_rows * plan->row_size;
+  for (i = 0; i < num_mem; i++) {
+    if (gst_memory_get_sizes (mem[i], NULL, NULL) !=
+        plan->num_rows * plan->block_size[i]) {
+      GST_ERROR_OBJECT (tensor_merge,
+          "The size of incoming tensor %u is not matched with the configured dimension.",
+          i);
+      ret = GST_FLOW_ERROR;
+      goto error_ret;
+    }
+  }
+
+  /* single row (e.g., merging the outermost rank) is a concatenation of the incoming memories */
+  if (plan->num_rows == 1) {
+    outMem = gst_tensor_merge_get_spanned_mem (mem, num_mem, outSize);
+    if (outMem)
+      goto done;
+  }
+
+  for (i = 0; i < num_mem; i++) {
     if (!gst_memory_map (mem[i], &mInfo[i], GST_MAP_READ)) {
       ml_logf ("Cannot map input memory buffers (%d)\n", i);
-      gst_memory_unref (mem[i]);
-      num_mem = i;
       ret = GST_FLOW_ERROR;
       goto error_ret;
     }
-    outSize += mInfo[i].size;
+
+    job.inptr[i] = mInfo[i].data;
+    num_mapped++;
   }
 
   outMem = gst_allocator_alloc (NULL, outSize, NULL);
   if (!gst_memory_map (outMem, &outInfo, GST_MAP_WRITE)) {
     gst_allocator_free (NULL, outMem);
+    outMem = NULL;
     ml_logf ("Cannot map output memory buffer\n");
     ret = GST_FLOW_ERROR;
     goto error_ret;
   }
-  outptr = outInfo.data;
 
-  switch (tensor_merge->mode) {
-    case GTT_LINEAR:
-    {
-      switch (tensor_merge->data_linear.direction) {
-        case LINEAR_FIRST:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (j = 0; j < dim[1]; j++) {
-                for (k = 0; k < num_mem; k++) {
-                  c = tensor_merge->tensors_config.info.info[k].dimension[0];
-                  s = element_size * c;
-                  inptr =
-                      mInfo[k].data + (l * dim[2] * dim[1] + i * dim[1] +
-                      j) * s;
-                  memcpy (outptr, inptr, s);
-                  outptr += s;
-                }
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_SECOND:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (k = 0; k < num_mem; k++) {
-                c = 1;
-                for (j = 0; j < LINEAR_SECOND + 1; j++)
-                  c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-                s = element_size * c;
-
-                inptr = mInfo[k].data + (l * dim[2] + i) * s;
-
-                memcpy (outptr, inptr, s);
-                outptr += s;
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_THIRD:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (k = 0; k < num_mem; k++) {
-              c = 1;
-              for (j = 0; j < LINEAR_THIRD + 1; j++)
-                c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-              s = element_size * c;
-
-              inptr = mInfo[k].data + l * s;
-
-              memcpy (outptr, inptr, s);
-              outptr += s;
-            }
-          }
-          break;
-        }
-        case LINEAR_FOURTH:
-        {
-          for (k = 0; k < num_mem; k++) {
-            c = 1;
-            for (j = 0; j < LINEAR_FOURTH + 1; j++)
-              c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-            s = element_size * c;
-
-            inptr = mInfo[k].data;
-            memcpy (outptr, inptr, s);
-            outptr += s;
-          }
-          break;
-        }
-        default:
-          ret = GST_FLOW_ERROR;
-      }
-      break;
-    }
-    default:
-      ret = GST_FLOW_ERROR;
-  }
+  job.plan = plan;
+  job.outptr = outInfo.data;
+  gst_tensor_tile_run (tensor_merge->thread_pool, gst_tensor_merge_copy_tile,
+      outSize, MERGE_TILE_SIZE, &job);
 
   gst_memory_unmap (outMem, &outInfo);
+
+done:
   gst_buffer_append_memory (tensor_buf, outMem);
   gst_buffer_copy_into (tensor_buf, tensors_buf, GST_BUFFER_COPY_TIMESTAMPS, 0,
       -1);
 
 error_ret:
-  for (i = 0; i < num_mem; i++) {
+  for (i = 0; i < num_mapped; i++)
     gst_memory_unmap (mem[i], &mInfo[i]);
+  for (i = 0; i < num_mem; i++)
     gst_memory_unref (mem[i]);
-  }
   return ret;
 }
 
@@ -619,6 +745,9 @@ gst_tensor_merge_set_src_caps (GstTensorMerge * tensor_merge)
 
     /** Internal Logic Error? */
     g_assert (gst_tensors_config_validate (&config));
+
+    /* copy plan for the incoming tensors */
+    gst_tensor_merge_prepare_plan (tensor_merge);
     newcaps = gst_tensor_pad_caps_from_config (tensor_merge->srcpad, &config);
 
     if (gst_pad_set_caps (tensor_merge->srcpad, newcaps)) {
@@ -717,7 +846,11 @@ gst_tensor_merge_collected (GstCollectPads * pads,
     goto beach;
   }
 
-  gst_tensor_merge_generate_mem (tensor_merge, tensors_buf, tensor_buf);
+  ret = gst_tensor_merge_generate_mem (tensor_merge, tensors_buf, tensor_buf);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (tensor_buf);
+    goto beach;
+  }
 
   ret = gst_pad_push (tensor_merge->srcpad, tensor_buf);
   tensor_merge->need_set_time = TRUE;
@@ -740,6 +873,11 @@ gst_tensor_merge_ready_to_paused (GstTensorMerge * tensor_merge)
   tensor_merge->need_stream_start = TRUE;
   tensor_merge->need_segment = TRUE;
   tensor_merge->negotiated = FALSE;
+
+  gst_tensor_tile_pool_free (tensor_merge->thread_pool);
+  tensor_merge->thread_pool =
+      gst_tensor_tile_pool_new (tensor_merge->num_threads);
+
   gst_collect_pads_start (tensor_merge->collect);
 }
 
@@ -768,6 +906,9 @@ gst_tensor_merge_change_state (GstElement * element, GstStateChange transition)
     return ret;
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* the streaming thread is stopped, no tile is in process */
+      gst_tensor_tile_pool_free (tensor_merge->thread_pool);
+      tensor_merge->thread_pool = NULL;
       break;
     default:
       break;
@@ -855,6 +996,9 @@ gst_tensor_merge_set_property (GObject * object, guint prop_id,
       silent_debug (tensor_merge, "Option = %s\n", tensor_merge->sync.option);
       gst_tensor_time_sync_set_option_data (&tensor_merge->sync);
       break;
+    case PROP_NUM_THREADS:
+      tensor_merge->num_threads = MAX (g_value_get_uint (value), 1);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -887,6 +1031,9 @@ gst_tensor_merge_get_property (GObject * object, guint prop_id,
     case PROP_SYNC_OPTION:
       g_value_set_string (value, tensor_merge->sync.option);
       break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, tensor_merge->num_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
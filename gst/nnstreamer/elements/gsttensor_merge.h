@@ -65,6 +65,18 @@ typedef struct _tensor_merge_linear {
   tensor_merge_linear_mode direction;
 } tensor_merge_linear;
 
+/**
+ * @brief Copy plan of linear mode, prepared when the caps are configured.
+ * Output tensor is a sequence of rows, and each row is the concatenation of a contiguous block of each incoming tensor.
+ */
+typedef struct _tensor_merge_plan {
+  guint num_tensors; /**< the number of incoming tensors, 0 if not prepared */
+  gsize num_rows; /**< the number of rows, product of the dimensions outer than the merged rank */
+  gsize row_size; /**< bytes of a row in output tensor */
+  gsize block_size[NNS_TENSOR_SIZE_LIMIT]; /**< bytes of a block of each incoming tensor */
+  gsize block_offset[NNS_TENSOR_SIZE_LIMIT]; /**< offset of the block of each incoming tensor in a row */
+} tensor_merge_plan;
+
 /**
  * @brief Tensor Merge data structure
  */
@@ -91,6 +103,10 @@ struct _GstTensorMerge
   GstClockTime current_time;
   gboolean need_set_time;
   GstTensorsConfig tensors_config; /**< output tensors info */
+
+  tensor_merge_plan plan; /**< copy plan for current tensors config */
+  guint num_threads; /**< the number of threads to copy a large tensor */
+  GThreadPool *thread_pool; /**< thread pool to copy the parts of output */
 };
 
 /**
@@ -42,6 +42,91 @@ static GstTensorRepo _repo = {.num_data = 0,.initialized = FALSE };
 #define GST_REPO_WAIT() (g_cond_wait(&_repo.repo_cond, &_repo.repo_lock))
 #define GST_REPO_BROADCAST() (g_cond_broadcast (&_repo.repo_cond))
 
+/**
+ * @brief Macro to get the entry of the ring with the index.
+ */
+#define GST_REPO_RING_ENTRY(d,i) \
+    (&(d)->ring[(i) & (GST_TENSOR_REPO_MAX_RING_SIZE - 1)])
+
+/**
+ * @brief Get the number of buffers in the ring.
+ */
+static inline guint
+gst_tensor_repo_ring_occupancy (GstTensorRepoData * data)
+{
+  guint head = (guint) g_atomic_int_get (&data->head);
+  guint tail = (guint) g_atomic_int_get (&data->tail);
+
+  return tail - head;
+}
+
+/**
+ * @brief Check the ring is full.
+ */
+static inline gboolean
+gst_tensor_repo_ring_is_full (GstTensorRepoData * data)
+{
+  return (gst_tensor_repo_ring_occupancy (data) >=
+      (guint) g_atomic_int_get (&data->ring_size));
+}
+
+/**
+ * @brief Append the buffer to the ring. Only tensor_reposink calls this.
+ * @return FALSE if the ring is full.
+ */
+static gboolean
+gst_tensor_repo_ring_push (GstTensorRepoData * data, GstBuffer * buffer,
+    GstCaps * caps)
+{
+  GstTensorRepoEntry *entry;
+  guint tail, occupancy;
+
+  tail = (guint) g_atomic_int_get (&data->tail);
+  occupancy = tail - (guint) g_atomic_int_get (&data->head);
+
+  if (occupancy >= (guint) g_atomic_int_get (&data->ring_size))
+    return FALSE;
+
+  entry = GST_REPO_RING_ENTRY (data, tail);
+  g_atomic_pointer_set (&entry->buffer, buffer);
+  g_atomic_pointer_set (&entry->caps, caps);
+
+  /* publish the entry */
+  g_atomic_int_set (&data->tail, tail + 1);
+
+  occupancy++;
+  if (occupancy > (guint) g_atomic_int_get (&data->stats.max_occupancy))
+    g_atomic_int_set (&data->stats.max_occupancy, occupancy);
+  g_atomic_int_inc (&data->stats.pushed);
+  return TRUE;
+}
+
+/**
+ * @brief Take the oldest entry from the ring.
+ * @note In overwrite mode, tensor_reposink may drop the oldest entry while
+ *       tensor_reposrc pulls it. The entry is read before advancing the head,
+ *       and the caller owns the entry only if it advances the head.
+ * @return FALSE if the ring is empty.
+ */
+static gboolean
+gst_tensor_repo_ring_pop (GstTensorRepoData * data, GstTensorRepoEntry * entry)
+{
+  GstTensorRepoEntry *e;
+  guint head;
+
+  do {
+    head = (guint) g_atomic_int_get (&data->head);
+    if (head == (guint) g_atomic_int_get (&data->tail))
+      return FALSE;
+
+    e = GST_REPO_RING_ENTRY (data, head);
+    entry->buffer = (GstBuffer *) g_atomic_pointer_get (&e->buffer);
+    entry->caps = (GstCaps *) g_atomic_pointer_get (&e->caps);
+  } while (!g_atomic_int_compare_and_exchange (&data->head, head, head + 1));
+
+  return TRUE;
+}
+
 /**
  * @brief Getter to get nth GstTensorRepoData.
  */
@@ -137,8 +222,9 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
 
   g_mutex_lock (&data->lock);
   data->eos = FALSE;
-  data->buffer = NULL;
-  data->caps = NULL;
+  data->head = data->tail = 0;
+  data->ring_size = GST_TENSOR_REPO_DEFAULT_RING_SIZE;
+  data->overwrite = FALSE;
   data->sink_changed = FALSE;
   data->src_changed = FALSE;
   data->pushed = FALSE;
@@ -162,47 +248,126 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
 
 /**
  * @brief Push GstBuffer into repo.
+ * @note The buffer is not copied. The repo holds a reference of the buffer
+ *       until tensor_reposrc pulls it.
  */
 gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
 {
   GstTensorRepoData *data;
+  gboolean eos;
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, FALSE);
 
-  g_mutex_lock (&data->lock);
+  if (g_atomic_int_get (&data->eos))
+    return FALSE;
 
-  while (data->buffer != NULL && !data->eos) {
-    /* wait pull */
-    g_cond_wait (&data->cond_pull, &data->lock);
-  }
+  buffer = gst_buffer_ref (buffer);
+  caps = gst_caps_ref (caps);
+
+  while (!gst_tensor_repo_ring_push (data, buffer, caps)) {
+    if (g_atomic_int_get (&data->overwrite)) {
+      GstTensorRepoEntry entry;
+
+      /* drop the oldest buffer, tensor_reposrc may pull it first. */
+      if (gst_tensor_repo_ring_pop (data, &entry)) {
+        gst_buffer_unref (entry.buffer);
+        gst_caps_unref (entry.caps);
+        g_atomic_int_inc (&data->stats.dropped);
+      }
+      continue;
+    }
+
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->sink_waiting, 1);
+    g_atomic_int_inc (&data->stats.blocked);
 
-  if (data->eos) {
+    while (gst_tensor_repo_ring_is_full (data) && !data->eos &&
+        !g_atomic_int_get (&data->overwrite)) {
+      /* wait pull */
+      g_cond_wait (&data->cond_pull, &data->lock);
+    }
+
+    g_atomic_int_set (&data->sink_waiting, 0);
+    eos = data->eos;
     g_mutex_unlock (&data->lock);
-    return FALSE;
-  }
 
-  data->buffer = gst_buffer_copy_deep (buffer);
-  if (!data->caps || !gst_caps_is_equal (data->caps, caps)) {
-    if (data->caps)
-      gst_caps_unref (data->caps);
-    data->caps = gst_caps_copy (caps);
+    if (eos) {
+      gst_buffer_unref (buffer);
+      gst_caps_unref (caps);
+      return FALSE;
+    }
   }
 
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (data->buffer);
+    unsigned long size = gst_buffer_get_size (buffer);
     GST_DEBUG ("Pushed [%d] (size : %lu)\n", nth, size);
   }
 
-  /* signal push */
-  g_cond_signal (&data->cond_push);
+  if (g_atomic_int_get (&data->src_waiting)) {
+    /* signal push */
+    g_mutex_lock (&data->lock);
+    g_cond_signal (&data->cond_push);
+    g_mutex_unlock (&data->lock);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Set the number of buffers in the slot and the behavior if the ring is full.
+ */
+gboolean
+gst_tensor_repo_set_ring (guint nth, guint ring_size, gboolean overwrite)
+{
+  GstTensorRepoData *data;
+
+  g_return_val_if_fail (ring_size > 0U, FALSE);
+  g_return_val_if_fail (ring_size <= GST_TENSOR_REPO_MAX_RING_SIZE, FALSE);
+
+  data = gst_tensor_repo_get_repodata (nth);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  g_mutex_lock (&data->lock);
+
+  g_atomic_int_set (&data->ring_size, ring_size);
+  g_atomic_int_set (&data->overwrite, overwrite);
+
+  /* the ring may have a free entry now */
+  g_cond_signal (&data->cond_pull);
 
   g_mutex_unlock (&data->lock);
   return TRUE;
 }
 
+/**
+ * @brief Get the statistics of the buffer ring in the slot.
+ */
+gboolean
+gst_tensor_repo_get_stats (guint nth, GstTensorRepoStats * stats)
+{
+  GstTensorRepoData *data;
+
+  g_return_val_if_fail (stats != NULL, FALSE);
+
+  data = gst_tensor_repo_get_repodata (nth);
+
+  if (data == NULL)
+    return FALSE;
+
+  stats->ring_size = (guint) g_atomic_int_get (&data->ring_size);
+  stats->occupancy = gst_tensor_repo_ring_occupancy (data);
+  stats->max_occupancy = (guint) g_atomic_int_get (&data->stats.max_occupancy);
+  stats->pushed = (guint) g_atomic_int_get (&data->stats.pushed);
+  stats->popped = (guint) g_atomic_int_get (&data->stats.popped);
+  stats->dropped = (guint) g_atomic_int_get (&data->stats.dropped);
+  stats->blocked = (guint) g_atomic_int_get (&data->stats.blocked);
+  return TRUE;
+}
+
 /**
  * @brief Check EOS (End-of-Stream) of slot.
  */
@@ -268,7 +433,7 @@ gst_tensor_repo_set_eos (guint nth)
 
   g_mutex_lock (&data->lock);
 
-  data->eos = TRUE;
+  g_atomic_int_set (&data->eos, TRUE);
   g_cond_signal (&data->cond_push);
   g_cond_signal (&data->cond_pull);
 
@@ -284,44 +449,55 @@ gst_tensor_repo_get_buffer (guint nth, gboolean * eos, guint * newid,
     GstCaps ** caps)
 {
   GstTensorRepoData *data;
-  GstBuffer *buf = NULL;
+  GstTensorRepoEntry entry = { NULL, NULL };
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, NULL);
 
-  g_mutex_lock (&data->lock);
+  if (!gst_tensor_repo_ring_pop (data, &entry)) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->src_waiting, 1);
 
-  while (!data->buffer) {
-    if (gst_tensor_repo_check_changed (nth, newid, FALSE)) {
-      buf = NULL;
-      goto done;
-    }
+    while (!gst_tensor_repo_ring_pop (data, &entry)) {
+      if (data->src_changed) {
+        *newid = data->src_id;
+        break;
+      }
+
+      if (data->eos) {
+        *eos = TRUE;
+        break;
+      }
 
-    if (gst_tensor_repo_check_eos (nth)) {
-      *eos = TRUE;
-      buf = NULL;
-      goto done;
+      /* wait push */
+      g_cond_wait (&data->cond_push, &data->lock);
     }
 
-    /* wait push */
-    g_cond_wait (&data->cond_push, &data->lock);
+    g_atomic_int_set (&data->src_waiting, 0);
+    g_mutex_unlock (&data->lock);
+
+    if (entry.buffer == NULL)
+      return NULL;
   }
 
-  /* Current buffer will be wasted. */
-  buf = data->buffer;
-  *caps = gst_caps_ref (data->caps);
+  g_atomic_int_inc (&data->stats.popped);
+
+  /* the entry holds the references of buffer and caps */
+  *caps = entry.caps;
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (buf);
+    unsigned long size = gst_buffer_get_size (entry.buffer);
     GST_DEBUG ("Popped [ %d ] (size: %lu)\n", nth, size);
   }
 
-done:
-  data->buffer = NULL;
-  /* signal pull */
-  g_cond_signal (&data->cond_pull);
-  g_mutex_unlock (&data->lock);
-  return buf;
+  if (g_atomic_int_get (&data->sink_waiting)) {
+    /* signal pull */
+    g_mutex_lock (&data->lock);
+    g_cond_signal (&data->cond_pull);
+    g_mutex_unlock (&data->lock);
+  }
+
+  return entry.buffer;
 }
 
 /**
@@ -332,6 +508,7 @@ gst_tensor_repo_remove_repodata (guint nth)
 {
   gboolean ret = FALSE;
   GstTensorRepoData *data;
+  GstTensorRepoEntry entry;
 
   g_return_val_if_fail (_repo.initialized, FALSE);
 
@@ -347,10 +524,10 @@ gst_tensor_repo_remove_repodata (guint nth)
         GST_DEBUG ("key[%d] is removed\n", nth);
 
       g_mutex_lock (&data->lock);
-      if (data->buffer)
-        gst_buffer_unref (data->buffer);
-      if (data->caps)
-        gst_caps_unref (data->caps);
+      while (gst_tensor_repo_ring_pop (data, &entry)) {
+        gst_buffer_unref (entry.buffer);
+        gst_caps_unref (entry.caps);
+      }
       g_mutex_unlock (&data->lock);
 
       g_mutex_clear (&data->lock);
@@ -32,15 +32,58 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief The max number of buffers in a slot of GstTensorRepo (power of 2).
+ */
+#define GST_TENSOR_REPO_MAX_RING_SIZE (32U)
+
+/**
+ * @brief The default number of buffers in a slot of GstTensorRepo.
+ */
+#define GST_TENSOR_REPO_DEFAULT_RING_SIZE (1U)
+
+/**
+ * @brief An entry of the buffer ring in GstTensorRepoData.
+ */
+typedef struct
+{
+  GstBuffer *buffer;
+  GstCaps *caps;
+} GstTensorRepoEntry;
+
+/**
+ * @brief Statistics of the buffer ring in GstTensorRepoData.
+ */
+typedef struct
+{
+  guint ring_size; /**< The max number of buffers in the ring */
+  guint occupancy; /**< The number of buffers in the ring */
+  guint max_occupancy; /**< The max number of buffers in the ring so far */
+  guint pushed; /**< The number of buffers pushed by tensor_reposink */
+  guint popped; /**< The number of buffers pulled by tensor_reposrc */
+  guint dropped; /**< The number of buffers overwritten before pulled */
+  guint blocked; /**< The number of pushes waiting for a free entry */
+} GstTensorRepoStats;
+
 /**
  * @brief GstTensorRepo internal data structure.
  *
  * GstTensorRepo has GSlist of GstTensorRepoData.
+ * The buffers are passed with a single-producer/single-consumer ring.
+ * tensor_reposink appends a buffer at the tail and tensor_reposrc takes it
+ * from the head without locking. The lock and conditions are used only to
+ * wait if the ring is full or empty, and for the status (eos, changed).
  */
 typedef struct
 {
-  GstBuffer *buffer;
-  GstCaps *caps;
+  GstTensorRepoEntry ring[GST_TENSOR_REPO_MAX_RING_SIZE];
+  guint head; /**< The index of the next entry to pull (atomic) */
+  guint tail; /**< The index of the next entry to push (atomic) */
+  guint ring_size; /**< The max number of buffers in the ring (atomic) */
+  gboolean overwrite; /**< Overwrite the oldest buffer if the ring is full (atomic) */
+  gint src_waiting; /**< tensor_reposrc is waiting for a buffer (atomic) */
+  gint sink_waiting; /**< tensor_reposink is waiting for a free entry (atomic) */
+  GstTensorRepoStats stats;
   GCond cond_push;
   GCond cond_pull;
   GMutex lock;
@@ -82,6 +125,18 @@ gst_tensor_repo_add_repodata (guint myid, gboolean is_sink);
 gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps);
 
+/**
+ * @brief Set the number of buffers in the slot and the behavior if the ring is full.
+ */
+gboolean
+gst_tensor_repo_set_ring (guint nth, guint ring_size, gboolean overwrite);
+
+/**
+ * @brief Get the statistics of the buffer ring in the slot.
+ */
+gboolean
+gst_tensor_repo_get_stats (guint nth, GstTensorRepoStats * stats);
+
 /**
  * @brief Check EOS (End-of-Stream) of slot.
  */
@@ -47,19 +47,25 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_SLOT,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_RING_SIZE,
+  PROP_OVERWRITE,
+  PROP_STATS
 };
 
 #define DEFAULT_SIGNAL_RATE 0
 #define DEFAULT_SILENT TRUE
 #define DEFAULT_QOS TRUE
 #define DEFAULT_INDEX 0
+#define DEFAULT_OVERWRITE FALSE
 
 static void gst_tensor_reposink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_tensor_reposink_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_reposink_dispose (GObject * object);
+static void gst_tensor_reposink_update_ring (GstTensorRepoSink * self);
+static GstStructure *gst_tensor_reposink_get_stats (GstTensorRepoSink * self);
 
 static gboolean gst_tensor_reposink_start (GstBaseSink * sink);
 static gboolean gst_tensor_reposink_stop (GstBaseSink * sink);
@@ -116,6 +122,25 @@ gst_tensor_reposink_class_init (GstTensorRepoSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_RING_SIZE,
+      g_param_spec_uint ("ring-size", "Ring size",
+          "The max number of buffers in the repository slot", 1,
+          GST_TENSOR_REPO_MAX_RING_SIZE, GST_TENSOR_REPO_DEFAULT_RING_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_OVERWRITE,
+      g_param_spec_boolean ("overwrite", "Overwrite",
+          "Drop the oldest buffer instead of waiting for tensor_reposrc "
+          "if the repository slot is full", DEFAULT_OVERWRITE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "The statistics of the repository slot (occupancy, pushed, "
+          "popped, dropped and blocked buffers), notified at EOS",
+          GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "TensorRepoSink",
       "Sink/Tensor/Repository",
@@ -160,6 +185,8 @@ gst_tensor_reposink_init (GstTensorRepoSink * self)
   self->last_render_time = GST_CLOCK_TIME_NONE;
   self->set_startid = FALSE;
   self->in_caps = NULL;
+  self->ring_size = GST_TENSOR_REPO_DEFAULT_RING_SIZE;
+  self->overwrite = DEFAULT_OVERWRITE;
 
   gst_base_sink_set_qos_enabled (basesink, DEFAULT_QOS);
 
@@ -197,9 +224,19 @@ gst_tensor_reposink_set_property (GObject * object, guint prop_id,
         self->set_startid = TRUE;
       }
 
+      gst_tensor_reposink_update_ring (self);
+
       if (self->o_myid != self->myid)
         gst_tensor_repo_set_changed (self->o_myid, self->myid, TRUE);
       break;
+    case PROP_RING_SIZE:
+      self->ring_size = g_value_get_uint (value);
+      gst_tensor_reposink_update_ring (self);
+      break;
+    case PROP_OVERWRITE:
+      self->overwrite = g_value_get_boolean (value);
+      gst_tensor_reposink_update_ring (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -227,12 +264,58 @@ gst_tensor_reposink_get_property (GObject * object, guint prop_id,
     case PROP_SLOT:
       g_value_set_uint (value, self->myid);
       break;
+    case PROP_RING_SIZE:
+      g_value_set_uint (value, self->ring_size);
+      break;
+    case PROP_OVERWRITE:
+      g_value_set_boolean (value, self->overwrite);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_tensor_reposink_get_stats (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Apply the ring size and overwrite mode to the repository slot.
+ */
+static void
+gst_tensor_reposink_update_ring (GstTensorRepoSink * self)
+{
+  /* the slot is added when setting the index */
+  if (gst_tensor_repo_get_repodata (self->myid) == NULL)
+    return;
+
+  if (!gst_tensor_repo_set_ring (self->myid, self->ring_size, self->overwrite)) {
+    GST_WARNING_OBJECT (self, "Failed to set the ring of repo [key: %d]",
+        self->myid);
+  }
+}
+
+/**
+ * @brief Get the statistics of the repository slot.
+ */
+static GstStructure *
+gst_tensor_reposink_get_stats (GstTensorRepoSink * self)
+{
+  GstTensorRepoStats stats = { 0 };
+
+  gst_tensor_repo_get_stats (self->myid, &stats);
+
+  return gst_structure_new ("stats",
+      "slot-index", G_TYPE_UINT, self->myid,
+      "ring-size", G_TYPE_UINT, stats.ring_size,
+      "occupancy", G_TYPE_UINT, stats.occupancy,
+      "max-occupancy", G_TYPE_UINT, stats.max_occupancy,
+      "pushed", G_TYPE_UINT, stats.pushed,
+      "popped", G_TYPE_UINT, stats.popped,
+      "dropped", G_TYPE_UINT, stats.dropped,
+      "blocked", G_TYPE_UINT, stats.blocked, NULL);
+}
+
 /**
  * @brief dispose vmethod implementation
  */
@@ -255,7 +338,7 @@ gst_tensor_reposink_dispose (GObject * object)
 static gboolean
 gst_tensor_reposink_start (GstBaseSink * sink)
 {
-  UNUSED (sink);
+  gst_tensor_reposink_update_ring (GST_TENSOR_REPOSINK (sink));
   return TRUE;
 }
 
@@ -288,6 +371,8 @@ gst_tensor_reposink_event (GstBaseSink * sink, GstEvent * event)
   switch (type) {
     case GST_EVENT_EOS:
       gst_tensor_repo_set_eos (self->myid);
+      /* let the application (e.g., gst-launch -v) get the final statistics */
+      g_object_notify (G_OBJECT (self), "stats");
       break;
     default:
       break;
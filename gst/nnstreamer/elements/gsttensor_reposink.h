@@ -62,6 +62,8 @@ struct _GstTensorRepoSink
   gboolean set_startid;
   guint myid;
   guint o_myid;
+  guint ring_size;
+  gboolean overwrite;
 };
 
 /**
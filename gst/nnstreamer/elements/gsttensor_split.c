@@ -133,7 +133,8 @@ gst_tensor_split_class_init (GstTensorSplitClass * klass)
 
   g_object_class_install_property (gobject_class, PROP_TENSORSEG,
       g_param_spec_string ("tensorseg", "TensorSeg",
-          "How to split tensor ?", "", G_PARAM_READWRITE));
+          "How to split tensor ?", "",
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_tensor_split_change_state);
@@ -174,9 +175,60 @@ gst_tensor_split_init (GstTensorSplit * split)
   split->have_group_id = FALSE;
   split->group_id = G_MAXUINT;
   split->srcpads = NULL;
+  split->seg_offset = NULL;
+  split->seg_size = NULL;
   gst_tensors_config_init (&split->sink_tensor_conf);
 }
 
+/**
+ * @brief Clear the offsets of the segments.
+ */
+static void
+gst_tensor_split_clear_offsets (GstTensorSplit * split)
+{
+  g_free (split->seg_offset);
+  split->seg_offset = NULL;
+  g_free (split->seg_size);
+  split->seg_size = NULL;
+}
+
+/**
+ * @brief Compute the offset and size of each segment in the incoming buffer.
+ * @param split GstTensorSplit Object
+ * @return TRUE if the segments are valid
+ */
+static gboolean
+gst_tensor_split_update_offsets (GstTensorSplit * split)
+{
+  tensor_dim *dim;
+  gsize element_size, offset;
+  guint i;
+
+  gst_tensor_split_clear_offsets (split);
+
+  if (split->tensorseg == NULL || split->num_tensors == 0)
+    return FALSE;
+
+  element_size =
+      gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  if (element_size == 0)
+    return FALSE;
+
+  split->seg_offset = g_new (gsize, split->num_tensors);
+  split->seg_size = g_new (gsize, split->num_tensors);
+
+  offset = 0;
+  for (i = 0; i < split->num_tensors; i++) {
+    dim = g_array_index (split->tensorseg, tensor_dim *, i);
+
+    split->seg_offset[i] = offset;
+    split->seg_size[i] = gst_tensor_get_element_count (*dim) * element_size;
+    offset += split->seg_size[i];
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief function to remove srcpad list
  */
@@ -193,6 +245,7 @@ gst_tensor_split_remove_src_pads (GstTensorSplit * split)
   split->num_tensors = 0;
   split->num_srcpads = 0;
   gst_tensors_config_free (&split->sink_tensor_conf);
+  gst_tensor_split_clear_offsets (split);
 }
 
 /**
@@ -223,7 +276,12 @@ gst_tensor_split_get_capsparam (GstTensorSplit * split, GstCaps * caps)
 
   st = gst_caps_get_structure (caps, 0);
 
-  return gst_tensors_config_from_structure (&split->sink_tensor_conf, st);
+  if (!gst_tensors_config_from_structure (&split->sink_tensor_conf, st))
+    return FALSE;
+
+  /* The segments are computed once, each buffer is split with these offsets. */
+  gst_tensor_split_update_offsets (split);
+  return TRUE;
 }
 
 /**
@@ -409,41 +467,46 @@ done:
  * @param buffer gstbuffer form src
  * @param nth orther of tensor
  * @return return GstMemory for splited tensor
+ * @note The segment shares the memory of incoming buffer if possible.
+ * If downstream element maps it with write access, GstBuffer copies it then.
  */
 static GstMemory *
 gst_tensor_split_get_splited (GstTensorSplit * split, GstBuffer * buffer,
     gint nth)
 {
-  GstMemory *mem;
-  tensor_dim *dim;
-  int i;
-  gsize size, offset;
-  GstMapInfo src_info, dest_info;
+  GstMemory *mem, *in_mem;
+  gsize size, offset, skip;
+  guint idx, length;
+  GstMapInfo dest_info;
 
-  dim = g_array_index (split->tensorseg, tensor_dim *, nth);
-  size = gst_tensor_get_element_count (*dim) *
-      gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  size = split->seg_size[nth];
+  offset = split->seg_offset[nth];
 
-  mem = gst_allocator_alloc (NULL, size, NULL);
-  if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
-    ml_logf ("Cannot map memory for destination buffer.\n");
+  if (offset + size > gst_buffer_get_size (buffer)) {
+    ml_loge ("The size of incoming buffer is smaller than the segments.\n");
     return NULL;
   }
-  if (!gst_buffer_map (buffer, &src_info, GST_MAP_READ)) {
-    ml_logf ("Cannot map src-memory to gst buffer at tensor-split.\n");
-    gst_memory_unmap (mem, &dest_info);
-    return NULL;
+
+  /* Share the segment if it is in a memory block of incoming buffer. */
+  if (gst_buffer_find_memory (buffer, offset, size, &idx, &length, &skip) &&
+      length == 1) {
+    in_mem = gst_buffer_peek_memory (buffer, idx);
+
+    if (!GST_MEMORY_FLAG_IS_SET (in_mem, GST_MEMORY_FLAG_NO_SHARE)) {
+      mem = gst_memory_share (in_mem, skip, size);
+      if (mem)
+        return mem;
+    }
   }
 
-  offset = 0;
-  for (i = 0; i < nth; i++) {
-    dim = g_array_index (split->tensorseg, tensor_dim *, i);
-    offset += gst_tensor_get_element_count (*dim) *
-        gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
+    ml_logf ("Cannot map memory for destination buffer.\n");
+    gst_memory_unref (mem);
+    return NULL;
   }
 
-  nns_memcpy (dest_info.data, src_info.data + offset, size);
-  gst_buffer_unmap (buffer, &src_info);
+  gst_buffer_extract (buffer, offset, dest_info.data, size);
   gst_memory_unmap (mem, &dest_info);
 
   return mem;
@@ -470,6 +533,12 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return GST_FLOW_ERROR;
   }
 
+  if (split->seg_offset == NULL && !gst_tensor_split_update_offsets (split)) {
+    GST_ERROR_OBJECT (split, "Failed to get the segments of incoming buffers.");
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
   for (i = 0; i < num_tensors; i++) {
     GstTensorPad *srcpad;
     GstBuffer *outbuf;
@@ -492,8 +561,13 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     srcpad = gst_tensor_split_get_tensor_pad (split, buf, &created, i);
 
-    outbuf = gst_buffer_new ();
     mem = gst_tensor_split_get_splited (split, buf, i);
+    if (mem == NULL) {
+      res = GST_FLOW_ERROR;
+      break;
+    }
+
+    outbuf = gst_buffer_new ();
     gst_buffer_append_memory (outbuf, mem);
     ts = GST_BUFFER_TIMESTAMP (buf);
 
@@ -601,10 +675,28 @@ gst_tensor_split_set_property (GObject * object, guint prop_id,
     case PROP_TENSORSEG:
     {
       guint i;
-      const gchar *param = g_value_get_string (value);
-      gchar **strv = g_strsplit_set (param, ",.;/", -1);
-      GArray *tensorseg = split->tensorseg;
+      const gchar *param;
+      gchar **strv;
+      GArray *tensorseg;
+      GstState state;
+
+      /* the segments are read in the chain function without lock */
+      GST_OBJECT_LOCK (split);
+      state = GST_STATE (split);
+      GST_OBJECT_UNLOCK (split);
+
+      if (state > GST_STATE_READY) {
+        nns_logw
+            ("Cannot change tensorseg in %s state. Set it in NULL or READY state.",
+            gst_element_state_get_name (state));
+        break;
+      }
+
+      param = g_value_get_string (value);
+      strv = g_strsplit_set (param, ",.;/", -1);
+      tensorseg = split->tensorseg;
 
+      gst_tensor_split_clear_offsets (split);
       split->num_tensors = g_strv_length (strv);
       if (NULL == tensorseg) {
         split->tensorseg =
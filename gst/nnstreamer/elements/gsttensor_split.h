@@ -61,6 +61,8 @@ struct _GstTensorSplit
   gboolean have_group_id;
   guint group_id;
   GstTensorsConfig sink_tensor_conf;
+  gsize *seg_offset; /**< the offset of each segment in the incoming buffer, updated with caps */
+  gsize *seg_size; /**< the size of each segment in the incoming buffer */
 };
 
 /**
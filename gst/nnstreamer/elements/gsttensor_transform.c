@@ -80,6 +80,17 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
 
 #define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)))"
 
+/**
+ * @brief Transpose option at the end of arithmetic option, fused with the operators.
+ */
+#define ARITH_OPTION_TRANSPOSE ",transpose:"
+
+/**
+ * @brief The number of elements processed at once in arithmetic mode.
+ * The block stays in the cache while the operators are applied.
+ */
+#define ARITH_BLOCK_SIZE (4096)
+
 /**
  * @brief The transpose rank is fixed to 4.
  * This RANK does not affect other/tensors(s)'s NNS_TENSOR_RANK_LIMIT.
@@ -103,9 +114,25 @@ enum
   PROP_OPTION,
   PROP_ACCELERATION,
   PROP_APPLY,
-  PROP_TRANSPOSE_RANK_LIMIT
+  PROP_TRANSPOSE_RANK_LIMIT,
+  PROP_NUM_THREADS
 };
 
+/**
+ * @brief Default number of threads, the tensor is processed in the streaming thread.
+ */
+#define DEFAULT_NUM_THREADS (1)
+
+/**
+ * @brief Max number of threads to process a tensor.
+ */
+#define MAX_NUM_THREADS (64)
+
+/**
+ * @brief The number of elements in a tile processed by a thread.
+ */
+#define TRANSFORM_TILE_SIZE (64 * 1024)
+
 /**
  * @brief Flag to set orc acceleration.
  */
@@ -168,6 +195,8 @@ static gboolean gst_tensor_transform_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensor_transform_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_transform_start (GstBaseTransform * trans);
+static gboolean gst_tensor_transform_stop (GstBaseTransform * trans);
 
 static gboolean gst_tensor_transform_convert_dimension (GstTensorTransform *
     filter, GstPadDirection direction, guint idx, const GstTensorInfo * in_info,
@@ -192,7 +221,7 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_TYPECAST, "Mode for casting type of tensor, "
             "option=" REGEX_TYPECAST_OPTION, "typecast"},
       {GTT_ARITHMETIC, "Mode for arithmetic operations with tensor, "
-            "option=[typecast:TYPE,][per-channel:(false|true@DIM),]add|mul|div:NUMBER[@CH_IDX], ...",
+            "option=[typecast:TYPE,][per-channel:(false|true@DIM),]add|mul|div:NUMBER[@CH_IDX], ...[,transpose:D1\':D2\':D3\':D4]",
           "arithmetic"},
       {GTT_TRANSPOSE, "Mode for transposing shape of tensor, "
             "option=D1\':D2\':D3\':D4 (fixed to 3)",
@@ -260,6 +289,14 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
           "The rank limit of transpose, which varies per version of nnstreamer and may be lower than the global rank limit if it is over 4.",
           0, NNS_TENSOR_RANK_LIMIT, NNS_TENSOR_TRANSPOSE_RANK_LIMIT,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of threads to process the tiles of a large tensor. "
+          "The output is same regardless of the number of threads. "
+          "The threads are created when the element starts.",
+          1, MAX_NUM_THREADS, DEFAULT_NUM_THREADS,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
 
   gst_element_class_set_details_simple (gstelement_class,
       "TensorTransform",
@@ -287,6 +324,10 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_transform_transform_size);
+
+  /* start/stop to create and release the thread pool */
+  trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_transform_start);
+  trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_transform_stop);
 }
 
 /**
@@ -305,6 +346,8 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->operators = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
   filter->apply = NULL;
+  filter->num_threads = DEFAULT_NUM_THREADS;
+  filter->thread_pool = NULL;
 
   gst_tensors_config_init (&filter->in_config);
   gst_tensors_config_init (&filter->out_config);
@@ -397,6 +440,14 @@ refrain_from_heavy_op_on_float16 (gulong n)
     float16 *ip = (gpointer) (i); \
     refrain_from_heavy_op_on_float16 (n); \
     switch (otype) { \
+      case _NNS_INT64: { \
+        int64_t *op = (gpointer) (o); \
+        _conv_from_f16_action (n, op, ip, int64_t); \
+        break; } \
+      case _NNS_UINT64: { \
+        uint64_t *op = (gpointer) (o); \
+        _conv_from_f16_action (n, op, ip, uint64_t); \
+        break; } \
       case _NNS_INT32: { \
         int32_t *op = (gpointer) (o); \
         _conv_from_f16_action (n, op, ip, int32_t); \
@@ -468,25 +519,30 @@ refrain_from_heavy_op_on_float16 (gulong n)
 
 #ifdef HAVE_ORC
 /* define macros for orc */
-/** @todo support 64bit integer and remove below line */
-#define type_64bit_integer(t) ((t) == _NNS_INT64 || (t) == _NNS_UINT64)
-#define orc_supported(f,itype,otype) ((f)->acceleration && !(type_64bit_integer (itype) || type_64bit_integer (otype)))
+#define orc_supported(f,itype,otype) ((f)->acceleration && (itype) != _NNS_FLOAT16 && (otype) != _NNS_FLOAT16)
 
 #define orc_func_conv(intype,outtype) nns_orc_conv_ ## intype ## _to_ ## outtype
 #define orc_func_add(intype) nns_orc_add_c_ ## intype
 #define orc_func_mul(intype) nns_orc_mul_c_ ## intype
 #define orc_func_div(intype) nns_orc_div_c_ ## intype
 
-#define orc_typecast_to(i,o,n,intype,otype,intypename) do { \
+/* C loops for the types which orc cannot handle (64-bit integer with floating point, 64-bit multiplication) */
+#define transform_func_conv_c(intype,outtype) _transform_conv_ ## intype ## _to_ ## outtype ## _c
+#define transform_func_mul_c(intype) _transform_mul_ ## intype ## _c
+
+/* conv_int64 and conv_float are the functions to convert to 64-bit integer and floating point */
+#define orc_typecast_to(i,o,n,intype,otype,intypename,conv_int64,conv_float) do { \
     switch (otype) { \
+      case _NNS_INT64: conv_int64 (intype, s64) ((gpointer) o, (gpointer) i, n); break; \
+      case _NNS_UINT64: conv_int64 (intype, u64) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_INT32: orc_func_conv (intype, s32) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_UINT32: orc_func_conv (intype, u32) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_INT16: orc_func_conv (intype, s16) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_UINT16: orc_func_conv (intype, u16) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_INT8: orc_func_conv (intype, s8) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_UINT8: orc_func_conv (intype, u8) ((gpointer) o, (gpointer) i, n); break; \
-      case _NNS_FLOAT64: orc_func_conv (intype, f64) ((gpointer) o, (gpointer) i, n); break; \
-      case _NNS_FLOAT32: orc_func_conv (intype, f32) ((gpointer) o, (gpointer) i, n); break; \
+      case _NNS_FLOAT64: conv_float (intype, f64) ((gpointer) o, (gpointer) i, n); break; \
+      case _NNS_FLOAT32: conv_float (intype, f32) ((gpointer) o, (gpointer) i, n); break; \
       case _NNS_FLOAT16: _conv_to_f16 (intypename, o, i, n); break; \
       default: GST_ERROR_OBJECT (filter, "Unsupported output type %d", otype); g_assert (0); break; \
     } \
@@ -494,14 +550,16 @@ refrain_from_heavy_op_on_float16 (gulong n)
 
 #define orc_typecast(i,o,n,itype,otype) do { \
     switch (itype) { \
-      case _NNS_INT32: orc_typecast_to (i, o, n, s32, otype, int32_t); break; \
-      case _NNS_UINT32: orc_typecast_to (i, o, n, u32, otype, uint32_t); break; \
-      case _NNS_INT16: orc_typecast_to (i, o, n, s16, otype, int16_t); break; \
-      case _NNS_UINT16: orc_typecast_to (i, o, n, u16, otype, uint16_t); break; \
-      case _NNS_INT8: orc_typecast_to (i, o, n, s8, otype, int8_t); break; \
-      case _NNS_UINT8: orc_typecast_to (i, o, n, u8, otype, uint8_t); break; \
-      case _NNS_FLOAT64: orc_typecast_to (i, o, n, f64, otype, double); break; \
-      case _NNS_FLOAT32: orc_typecast_to (i, o, n, f32, otype, float); break; \
+      case _NNS_INT64: orc_typecast_to (i, o, n, s64, otype, int64_t, orc_func_conv, transform_func_conv_c); break; \
+      case _NNS_UINT64: orc_typecast_to (i, o, n, u64, otype, uint64_t, orc_func_conv, transform_func_conv_c); break; \
+      case _NNS_INT32: orc_typecast_to (i, o, n, s32, otype, int32_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_UINT32: orc_typecast_to (i, o, n, u32, otype, uint32_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_INT16: orc_typecast_to (i, o, n, s16, otype, int16_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_UINT16: orc_typecast_to (i, o, n, u16, otype, uint16_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_INT8: orc_typecast_to (i, o, n, s8, otype, int8_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_UINT8: orc_typecast_to (i, o, n, u8, otype, uint8_t, orc_func_conv, orc_func_conv); break; \
+      case _NNS_FLOAT64: orc_typecast_to (i, o, n, f64, otype, double, transform_func_conv_c, orc_func_conv); break; \
+      case _NNS_FLOAT32: orc_typecast_to (i, o, n, f32, otype, float, transform_func_conv_c, orc_func_conv); break; \
       case _NNS_FLOAT16: _conv_from_f16 (otype, o, i, n); break; \
       default: GST_ERROR_OBJECT (filter, "Unsupported input type %d", itype); g_assert (0); break; \
     } \
@@ -509,6 +567,8 @@ refrain_from_heavy_op_on_float16 (gulong n)
 
 #define orc_typesize(size, type) do { \
     switch (type) { \
+      case _NNS_INT64: size = sizeof(int64_t); break; \
+      case _NNS_UINT64: size = sizeof(uint64_t); break; \
       case _NNS_INT32: size = sizeof(int32_t); break; \
       case _NNS_UINT32: size = sizeof(uint32_t); break; \
       case _NNS_INT16: size = sizeof(int16_t); break; \
@@ -521,8 +581,11 @@ refrain_from_heavy_op_on_float16 (gulong n)
     } \
   } while (0)
 
-#define orc_operator_func(i,n,v,opfunc,op) do { \
+/* opfunc_int64 is the function for 64-bit integer */
+#define orc_operator_func(i,n,v,opfunc,opfunc_int64,op) do { \
     switch ((v)->type) { \
+      case _NNS_INT64: opfunc_int64 (s64) ((gpointer) i, (v)->data._int64_t, n); break; \
+      case _NNS_UINT64: opfunc_int64 (u64) ((gpointer) i, (v)->data._uint64_t, n); break; \
       case _NNS_INT32: opfunc (s32) ((gpointer) i, (v)->data._int32_t, n); break; \
       case _NNS_UINT32: opfunc (u32) ((gpointer) i, (v)->data._uint32_t, n); break; \
       case _NNS_INT16: opfunc (s16) ((gpointer) i, (v)->data._int16_t, n); break; \
@@ -546,16 +609,18 @@ refrain_from_heavy_op_on_float16 (gulong n)
 
 #define orc_operator(i,n,v,op) do { \
     switch (op) { \
-      case GTT_OP_ADD: orc_operator_func (i, n, v, orc_func_add, op); break; \
-      case GTT_OP_MUL: orc_operator_func (i, n, v, orc_func_mul, op); break; \
+      case GTT_OP_ADD: orc_operator_func (i, n, v, orc_func_add, orc_func_add, op); break; \
+      case GTT_OP_MUL: orc_operator_func (i, n, v, orc_func_mul, transform_func_mul_c, op); break; \
       case GTT_OP_DIV: \
         switch ((v)->type) { \
-          case _NNS_INT32: orc_operator_div_loop (i, n, (v)->data._int32_t, int32_t); break; \
+          case _NNS_INT64: orc_operator_div_loop (i, n, (v)->data._int64_t, int64_t); break; \
+          case _NNS_UINT64: orc_operator_div_loop (i, n, (v)->data._uint64_t, uint64_t); break; \
+          case _NNS_INT32: orc_func_div (s32) ((gpointer) i, (double) (v)->data._int32_t, n); break; \
           case _NNS_UINT32: orc_operator_div_loop (i, n, (v)->data._uint32_t, uint32_t); break; \
-          case _NNS_INT16: orc_operator_div_loop (i, n, (v)->data._int16_t, int16_t); break; \
-          case _NNS_UINT16: orc_operator_div_loop (i, n, (v)->data._uint16_t, uint16_t); break; \
-          case _NNS_INT8: orc_operator_div_loop (i, n, (v)->data._int8_t, int8_t); break; \
-          case _NNS_UINT8: orc_operator_div_loop (i, n, (v)->data._uint8_t, uint8_t); break; \
+          case _NNS_INT16: orc_func_div (s16) ((gpointer) i, (double) (v)->data._int16_t, n); break; \
+          case _NNS_UINT16: orc_func_div (u16) ((gpointer) i, (double) (v)->data._uint16_t, n); break; \
+          case _NNS_INT8: orc_func_div (s8) ((gpointer) i, (double) (v)->data._int8_t, n); break; \
+          case _NNS_UINT8: orc_func_div (u8) ((gpointer) i, (double) (v)->data._uint8_t, n); break; \
           case _NNS_FLOAT64: orc_func_div (f64) ((gpointer) i, (v)->data._double, n); break; \
           case _NNS_FLOAT32: orc_func_div (f32) ((gpointer) i, (v)->data._float, n); break; \
           case _NNS_FLOAT16: _op_float16 (i, n, (v)->data._float16, op); break; \
@@ -565,6 +630,42 @@ refrain_from_heavy_op_on_float16 (gulong n)
       default: GST_ERROR_OBJECT (filter, "Unknown operator %d", op); break; \
     } \
   } while (0)
+
+/**
+ * @brief Macro to define the typecast function for the types which orc cannot convert (64-bit integer and floating point).
+ */
+#define transform_define_conv_c(intype,outtype,intypename,outtypename) \
+static void \
+transform_func_conv_c (intype, outtype) (outtypename * d1, const intypename * s1, int n) \
+{ \
+  int idx; \
+  for (idx = 0; idx < n; idx++) \
+    d1[idx] = (outtypename) s1[idx]; \
+}
+
+transform_define_conv_c (s64, f32, int64_t, float);
+transform_define_conv_c (s64, f64, int64_t, double);
+transform_define_conv_c (u64, f32, uint64_t, float);
+transform_define_conv_c (u64, f64, uint64_t, double);
+transform_define_conv_c (f32, s64, float, int64_t);
+transform_define_conv_c (f32, u64, float, uint64_t);
+transform_define_conv_c (f64, s64, double, int64_t);
+transform_define_conv_c (f64, u64, double, uint64_t);
+
+/**
+ * @brief Macro to define the multiplication for 64-bit integer, orc does not have 64-bit multiplication.
+ */
+#define transform_define_mul_c(intype,intypename) \
+static void \
+transform_func_mul_c (intype) (intypename * d1, intypename p1, int n) \
+{ \
+  int idx; \
+  for (idx = 0; idx < n; idx++) \
+    d1[idx] *= p1; \
+}
+
+transform_define_mul_c (s64, int64_t);
+transform_define_mul_c (u64, uint64_t);
 #endif /* HAVE_ORC */
 
 /**
@@ -709,12 +810,14 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       gchar *str_option;
       gchar **str_operators;
       gchar **str_op;
+      gchar *str_trans;
       tensor_transform_operator_s *op_s;
       guint i, num_operators, num_op;
       GRegex *regex_option_tc;
 
       filter->data_arithmetic.out_type = _NNS_END;
       filter->data_arithmetic.per_channel_arith = FALSE;
+      filter->data_arithmetic.transpose = FALSE;
 
       if (filter->operators) {
         GST_WARNING_OBJECT (filter,
@@ -747,10 +850,36 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       }
       g_regex_unref (regex_option_tc);
 
+      /* transpose should be located at the end of operators */
+      str_trans = g_strrstr (str_option, ARITH_OPTION_TRANSPOSE);
+      if (str_trans) {
+        gchar *str_order = str_trans + strlen (ARITH_OPTION_TRANSPOSE);
+        gchar **strv;
+
+        if (!g_regex_match_simple (REGEX_TRANSPOSE_OPTION, str_order,
+                G_REGEX_CASELESS, 0)) {
+          ml_loge
+              ("%s: arithmetic: \'%s\' is not valid transpose option: it should be in the form of transpose:NEW_IDX_DIM0:NEW_IDX_DIM1:NEW_IDX_DIM2:3 at the end of operators\n",
+              filter_name, str_order);
+          g_free (str_option);
+          break;
+        }
+
+        strv = g_strsplit (str_order, ":", NNS_TENSOR_TRANSPOSE_RANK_LIMIT);
+        for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
+          filter->data_arithmetic.trans_order[i] =
+              (uint8_t) g_ascii_strtoull (strv[i], NULL, 10);
+        }
+        g_strfreev (strv);
+
+        filter->data_arithmetic.transpose = TRUE;
+        *str_trans = '\0';
+      }
+
       if (!g_regex_match_simple (REGEX_ARITH_OPTION, str_option,
               G_REGEX_CASELESS, 0)) {
         ml_loge
-            ("%s: arithmetic: \'%s\' is not valid option string: it should be in the form of [typecast:TYPE,][per-channel:(false|true@DIM),]add|mul|div:NUMBER[@CH_IDX]..., ...\n",
+            ("%s: arithmetic: \'%s\' is not valid option string: it should be in the form of [typecast:TYPE,][per-channel:(false|true@DIM),]add|mul|div:NUMBER[@CH_IDX]..., ...[,transpose:D1\':D2\':D3\':D4]\n",
             filter_name, str_option);
         g_free (str_option);
         break;
@@ -1033,6 +1162,71 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
   return ret;
 }
 
+/**
+ * @brief Function to process the tiles [start, end) of a tensor.
+ */
+typedef void (*GstTensorTransformTileFunc) (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info, const uint8_t * inptr,
+    uint8_t * outptr, gsize start, gsize end, gpointer data);
+
+/**
+ * @brief Data structure of the tensor to be processed in the tiles.
+ */
+typedef struct
+{
+  GstTensorTransform *filter; /**< "this" pointer */
+  GstTensorTransformTileFunc func; /**< function to process the tiles */
+  GstTensorInfo *in_info; /**< input tensor info */
+  GstTensorInfo *out_info; /**< output tensor info */
+  const uint8_t *inptr; /**< input tensor */
+  uint8_t *outptr; /**< output tensor */
+  gpointer data; /**< private data for the function */
+} GstTensorTransformJob;
+
+/**
+ * @brief Process a tile of the tensor.
+ */
+static void
+gst_tensor_transform_tile (gsize start, gsize end, gpointer user_data)
+{
+  GstTensorTransformJob *job = (GstTensorTransformJob *) user_data;
+
+  job->func (job->filter, job->in_info, job->out_info, job->inptr,
+      job->outptr, start, end, job->data);
+}
+
+/**
+ * @brief Split [0, total) into the tiles and process them with the thread pool.
+ * @param[in] filter "this" pointer
+ * @param[in] func function to process the tiles
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @param[in] total the number of units (elements or rows) to be processed
+ * @param[in] tile_size the number of units in a tile
+ * @param[in] data private data for the function
+ */
+static void
+gst_tensor_transform_run_tiles (GstTensorTransform * filter,
+    GstTensorTransformTileFunc func, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr,
+    gsize total, gsize tile_size, gpointer data)
+{
+  GstTensorTransformJob job;
+
+  job.filter = filter;
+  job.func = func;
+  job.in_info = in_info;
+  job.out_info = out_info;
+  job.inptr = inptr;
+  job.outptr = outptr;
+  job.data = data;
+
+  gst_tensor_tile_run (filter->thread_pool, gst_tensor_transform_tile, total,
+      tile_size, &job);
+}
+
 /**
  * @brief Set property (gst element vmethod)
  */
@@ -1094,6 +1288,10 @@ gst_tensor_transform_set_property (GObject * object, guint prop_id,
       g_strfreev (strv);
       break;
     }
+    case PROP_NUM_THREADS:
+      /* applied when the element starts */
+      filter->num_threads = MAX (g_value_get_uint (value), 1);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1150,6 +1348,9 @@ gst_tensor_transform_get_property (GObject * object, guint prop_id,
     case PROP_TRANSPOSE_RANK_LIMIT:
       g_value_set_uint (value, NNS_TENSOR_TRANSPOSE_RANK_LIMIT);
       break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, filter->num_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1181,6 +1382,9 @@ gst_tensor_transform_finalize (GObject * object)
     filter->apply = NULL;
   }
 
+  gst_tensor_tile_pool_free (filter->thread_pool);
+  filter->thread_pool = NULL;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -1318,153 +1522,205 @@ gst_tensor_transform_typecast (GstTensorTransform * filter,
 }
 
 /**
- * @brief subrouting for tensor-tranform, "arithmetic" case.
- * @param[in/out] filter "this" pointer
+ * Macro to write the elements to the transposed position
+ */
+#define scatter_transpose_loop(type) do { \
+    const type *_src = (const type *) src; \
+    type *_out = (type *) outptr; \
+    for (idx = 0; idx < n; idx++) { \
+      _out[offset] = _src[idx]; \
+      offset += stride[0]; \
+      if (++coord[0] < dim[0]) \
+        continue; \
+      for (a = 0; a < NNS_TENSOR_TRANSPOSE_RANK_LIMIT - 1; a++) { \
+        coord[a] = 0; \
+        offset -= dim[a] * stride[a]; \
+        offset += stride[a + 1]; \
+        if (++coord[a + 1] < dim[a + 1]) \
+          break; \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Write the elements of the input order to the transposed position of the output tensor.
+ * @param[in] trans_order transpose order (same as transpose mode)
  * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
+ * @param[in] src elements to be written, in the order of input tensor
+ * @param[in] start index of the first element in input tensor
+ * @param[in] n the number of elements
+ * @param[in] type_size element size
  * @param[out] outptr output tensor
- * @return Gst flow status
  */
-static GstFlowReturn
-gst_tensor_transform_arithmetic (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+static void
+gst_tensor_transform_scatter_transpose (const uint8_t * trans_order,
+    const GstTensorInfo * in_info, const uint8_t * src, gsize start,
+    gsize n, gsize type_size, uint8_t * outptr)
 {
-  gulong i, num, j, ch;
-  gsize in_element_size, out_element_size;
-
-  GSList *walk;
-  tensor_transform_operator_s *op_s;
-  tensor_data_s value;
+  gsize dim[NNS_TENSOR_TRANSPOSE_RANK_LIMIT];
+  gsize stride[NNS_TENSOR_TRANSPOSE_RANK_LIMIT];
+  gsize coord[NNS_TENSOR_TRANSPOSE_RANK_LIMIT];
+  gsize num, offset, idx, s;
+  guint a;
 
   num = gst_tensor_get_element_count (in_info->dimension);
 
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    walk = filter->operators;
-    /**
-     * Typecast should be called at the first.
-     * Do the typecast. If in/out type is same, this will copy the input array to output.
-     */
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+  s = 1;
+  for (a = 0; a < NNS_TENSOR_TRANSPOSE_RANK_LIMIT - 1; a++) {
+    dim[a] = in_info->dimension[a] > 0 ? in_info->dimension[a] : 1;
+    s *= dim[a];
+  }
+  /* the last dim is fixed, the higher dims are merged into it */
+  dim[a] = MAX (num / s, 1);
+
+  /* output dim i is input dim trans_order[i] */
+  s = 1;
+  for (a = 0; a < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; a++) {
+    stride[trans_order[a]] = s;
+    s *= dim[trans_order[a]];
+  }
 
-    if (!filter->data_arithmetic.per_channel_arith) {
-      while (walk) {
-        op_s = (tensor_transform_operator_s *) walk->data;
+  offset = 0;
+  for (a = 0, s = start; a < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; a++) {
+    coord[a] = s % dim[a];
+    s /= dim[a];
+    offset += coord[a] * stride[a];
+  }
 
-        if (op_s->op != GTT_OP_TYPECAST) {
-          gst_tensor_data_typecast (&op_s->value, out_info->type);
-          orc_operator (outptr, num, &op_s->value, op_s->op);
-        }
+  switch (type_size) {
+    case 1:
+      scatter_transpose_loop (uint8_t);
+      break;
+    case 2:
+      scatter_transpose_loop (uint16_t);
+      break;
+    case 4:
+      scatter_transpose_loop (uint32_t);
+      break;
+    case 8:
+      scatter_transpose_loop (uint64_t);
+      break;
+    default:
+      g_assert (0);
+      break;
+  }
+}
 
-        walk = g_slist_next (walk);
-      }
-    } else {
-      gsize typesize = 0;
-      guint ch_dim = filter->data_arithmetic.ch_dim;
-      gsize ch_offset, ch_size = 1;
-      uint8_t *tmp_outptr = NULL;
+#ifdef HAVE_ORC
+/**
+ * @brief Arithmetic with orc. Typecast and operators are applied to a block while it stays in the cache.
+ * @param[in] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] dest output of the block
+ * @param[in] start index of the first element of the block
+ * @param[in] n the number of elements in the block
+ */
+static void
+gst_tensor_transform_arithmetic_orc (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * dest, gsize start, gsize n)
+{
+  tensor_transform_arithmetic *arith = &filter->data_arithmetic;
+  tensor_transform_operator_s *op_s;
+  GSList *walk;
+  gsize i, in_size, out_size, ch_size = 1, num_ch = 1, run, pos, end;
+  const uint8_t *src;
+  uint8_t *ptr;
 
-      for (i = 0; i < ch_dim; ++i) {
-        ch_size *= in_info->dimension[i];
-      }
-      ch_offset = ch_size * in_info->dimension[ch_dim];
-      orc_typesize (typesize, out_info->type);
-
-      while (walk) {
-        op_s = (tensor_transform_operator_s *) walk->data;
-        if (op_s->op == GTT_OP_TYPECAST) {
-          walk = g_slist_next (walk);
-          continue;
-        }
+  in_size = gst_tensor_get_element_size (in_info->type);
+  out_size = gst_tensor_get_element_size (out_info->type);
+  src = inptr + start * in_size;
 
-        if (op_s->applying_ch == -1) {
-          gst_tensor_data_typecast (&op_s->value, out_info->type);
-          orc_operator (outptr, num, &op_s->value, op_s->op);
-        } else {
-          for (i = 0; i < num / ch_offset; ++i) {
-            tmp_outptr =
-                outptr + (ch_size * op_s->applying_ch +
-                ch_offset * i) * typesize;
-            gst_tensor_data_typecast (&op_s->value, out_info->type);
-            orc_operator (tmp_outptr, ch_size, &op_s->value, op_s->op);
-          }
-        }
-        walk = g_slist_next (walk);
-      }
+  if (arith->per_channel_arith) {
+    for (i = 0; i < arith->ch_dim; ++i) {
+      ch_size *= in_info->dimension[i];
     }
-    return GST_FLOW_OK;
+    num_ch = in_info->dimension[arith->ch_dim];
   }
-#endif
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
+  /**
+   * Typecast should be called at the first.
+   * Do the typecast. If in/out type is same, this will copy the input array to output.
+   */
+  orc_typecast (src, dest, n, in_info->type, out_info->type);
 
-  /* per-channel */
-  if (filter->data_arithmetic.per_channel_arith) {
-    guint ch_dim = filter->data_arithmetic.ch_dim;
-    gsize ch_offset, ch_size = 1;
-    for (i = 0; i < ch_dim; ++i) {
-      ch_size *= in_info->dimension[i];
+  for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+    op_s = (tensor_transform_operator_s *) walk->data;
+
+    if (op_s->op == GTT_OP_TYPECAST)
+      continue;
+
+    if (op_s->applying_ch == -1) {
+      orc_operator (dest, n, &op_s->value, op_s->op);
+      continue;
     }
-    ch_offset = ch_size * in_info->dimension[ch_dim];
 
-    /** In case of 3:4:4:1,
-     * ch_dim:0 -> #ch: 3, ch_size: 1, ch_offset: 3
-     * ch_dim:1 -> #ch: 4, ch_size: 3, ch_offset: 12
-     * ch_dim:2 -> #ch: 4, ch_size: 12, ch_offset: 48
-     * ch_dim:3 -> #ch: 1, ch_size: 48, ch_offset: 48 * 4
-     */
+    if ((gsize) op_s->applying_ch >= num_ch)
+      continue;
 
-    for (i = 0; i < num / ch_offset; ++i) {
-      for (ch = 0; ch < in_info->dimension[ch_dim]; ++ch) {
-        for (j = 0; j < ch_size; ++j) {
-          gulong data_idx = (i * ch_offset) + (ch * ch_size) + j;
-          gst_tensor_data_set (&value, in_info->type,
-              (gpointer) (inptr + in_element_size * data_idx));
-
-          walk = filter->operators;
-          while (walk) {
-            op_s = (tensor_transform_operator_s *) walk->data;
-            switch (op_s->op) {
-              case GTT_OP_TYPECAST:
-                gst_tensor_data_typecast (&value, op_s->value.type);
-                break;
-              case GTT_OP_ADD:
-              case GTT_OP_MUL:
-              case GTT_OP_DIV:
-              {
-                gst_tensor_data_typecast (&op_s->value, value.type);
-
-                if (op_s->applying_ch == (int) ch || op_s->applying_ch == -1) {
-                  gst_tensor_transform_do_operator (filter, &value,
-                      &op_s->value, op_s->op);
-                }
-                break;
-              }
-              default:
-                g_assert (0);
-                return GST_FLOW_ERROR;
-            }
+    /* find the first run of the channel and apply the operator to each run in this block */
+    run = start / ch_size;
+    run += (op_s->applying_ch + num_ch - (run % num_ch)) % num_ch;
 
-            walk = g_slist_next (walk);
-          }
+    while ((pos = MAX (run * ch_size, start)) < start + n) {
+      end = MIN ((run + 1) * ch_size, start + n);
+      ptr = dest + (pos - start) * out_size;
 
-          /* set output value */
-          g_assert (out_info->type == value.type);
-          gst_tensor_data_get (&value, outptr + out_element_size * data_idx);
-        }
-      }
+      orc_operator (ptr, end - pos, &op_s->value, op_s->op);
+      run += num_ch;
     }
+  }
+}
+#endif
 
-    return GST_FLOW_OK;
+/**
+ * @brief Apply the operators to each element of a block.
+ * @param[in] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] dest output of the block
+ * @param[in] start index of the first element of the block
+ * @param[in] n the number of elements in the block
+ */
+static void
+gst_tensor_transform_arithmetic_loop (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * dest, gsize start, gsize n)
+{
+  tensor_transform_arithmetic *arith = &filter->data_arithmetic;
+  gsize i, idx, ch, in_element_size, out_element_size;
+  gsize ch_size = 1, num_ch = 1;
+
+  GSList *walk;
+  tensor_transform_operator_s *op_s;
+  tensor_data_s value;
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  /** In case of 3:4:4:1,
+   * ch_dim:0 -> #ch: 3, ch_size: 1
+   * ch_dim:1 -> #ch: 4, ch_size: 3
+   * ch_dim:2 -> #ch: 4, ch_size: 12
+   * ch_dim:3 -> #ch: 1, ch_size: 48
+   */
+  if (arith->per_channel_arith) {
+    for (i = 0; i < arith->ch_dim; ++i) {
+      ch_size *= in_info->dimension[i];
+    }
+    num_ch = in_info->dimension[arith->ch_dim];
   }
 
-  for (i = 0; i < num; ++i) {
+  for (i = 0; i < n; ++i) {
+    idx = start + i;
+    ch = (idx / ch_size) % num_ch;
+
     /* init value with input tensor type */
     gst_tensor_data_set (&value, in_info->type,
-        (gpointer) (inptr + in_element_size * i));
+        (gpointer) (inptr + in_element_size * idx));
 
     walk = filter->operators;
     while (walk) {
@@ -1480,13 +1736,15 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
         case GTT_OP_ADD:
         case GTT_OP_MUL:
         case GTT_OP_DIV:
-          gst_tensor_data_typecast (&op_s->value, value.type);
-          gst_tensor_transform_do_operator (filter, &value, &op_s->value,
-              op_s->op);
+          if (!arith->per_channel_arith || op_s->applying_ch == -1 ||
+              op_s->applying_ch == (int) ch) {
+            gst_tensor_transform_do_operator (filter, &value, &op_s->value,
+                op_s->op);
+          }
           break;
         default:
           g_assert (0);
-          return GST_FLOW_ERROR;
+          return;
       }
 
       walk = g_slist_next (walk);
@@ -1494,9 +1752,105 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
 
     /* set output value */
     g_assert (out_info->type == value.type);
-    gst_tensor_data_get (&value, outptr + out_element_size * i);
+    gst_tensor_data_get (&value, dest + out_element_size * i);
+  }
+}
+
+/**
+ * @brief Scratch block of each thread, ARITH_BLOCK_SIZE elements of the largest type.
+ * The block is reused over the frames and released when the thread exits.
+ */
+static GPrivate transform_scratch = G_PRIVATE_INIT (g_free);
+
+/**
+ * @brief Get the scratch block of the calling thread.
+ */
+static gpointer
+gst_tensor_transform_get_scratch (void)
+{
+  gpointer block = g_private_get (&transform_scratch);
+
+  if (block == NULL) {
+    block = g_malloc (ARITH_BLOCK_SIZE * sizeof (gdouble));
+    g_private_set (&transform_scratch, block);
   }
 
+  return block;
+}
+
+/**
+ * @brief Process the tile of arithmetic mode, block by block.
+ */
+static void
+gst_tensor_transform_arithmetic_tile (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr, gsize start, gsize end,
+    gpointer data)
+{
+  tensor_transform_arithmetic *arith = &filter->data_arithmetic;
+  gsize n, out_size;
+  uint8_t *block = NULL, *dest;
+  UNUSED (data);
+
+  out_size = gst_tensor_get_element_size (out_info->type);
+
+  if (arith->transpose)
+    block = gst_tensor_transform_get_scratch ();
+
+  for (; start < end; start += n) {
+    n = MIN (ARITH_BLOCK_SIZE, end - start);
+    dest = block ? block : outptr + start * out_size;
+
+#ifdef HAVE_ORC
+    if (orc_supported (filter, in_info->type, out_info->type)) {
+      gst_tensor_transform_arithmetic_orc (filter, in_info, out_info,
+          inptr, dest, start, n);
+    } else
+#endif
+    {
+      gst_tensor_transform_arithmetic_loop (filter, in_info, out_info,
+          inptr, dest, start, n);
+    }
+
+    /* write the block to the transposed position */
+    if (block) {
+      gst_tensor_transform_scatter_transpose (arith->trans_order, in_info,
+          block, start, n, out_size, outptr);
+    }
+  }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "arithmetic" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_arithmetic (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  tensor_transform_operator_s *op_s;
+  GSList *walk;
+  gsize num;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  /* operand is casted to output type before processing the tiles */
+  for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+    op_s = (tensor_transform_operator_s *) walk->data;
+
+    if (op_s->op != GTT_OP_TYPECAST)
+      gst_tensor_data_typecast (&op_s->value, out_info->type);
+  }
+
+  gst_tensor_transform_run_tiles (filter, gst_tensor_transform_arithmetic_tile,
+      in_info, out_info, inptr, outptr, num, TRANSFORM_TILE_SIZE, NULL);
+
   return GST_FLOW_OK;
 }
 
@@ -1520,6 +1874,24 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
 	  }                                                      \
   } while(0);
 
+/**
+ * @brief Process the tile of transpose mode.
+ */
+static void
+gst_tensor_transform_transpose_tile (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr, gsize start, gsize end,
+    gpointer data)
+{
+  gsize type_size = gst_tensor_get_element_size (in_info->type);
+  UNUSED (out_info);
+  UNUSED (data);
+
+  gst_tensor_transform_scatter_transpose (filter->data_transpose.trans_order,
+      in_info, inptr + start * type_size, start, end - start, type_size,
+      outptr);
+}
+
 /**
  * @brief subrouting for tensor-tranform, "transpose" case.
  * @param[in/out] filter "this" pointer
@@ -1557,6 +1929,15 @@ gst_tensor_transform_transpose (GstTensorTransform * filter,
     return GST_FLOW_OK;
   }
 
+  /* with multiple threads, each tile of the input is written to the transposed position */
+  if (filter->thread_pool) {
+    gst_tensor_transform_run_tiles (filter,
+        gst_tensor_transform_transpose_tile, in_info, out_info, inptr, outptr,
+        gst_tensor_get_element_count (in_info->dimension),
+        TRANSFORM_TILE_SIZE, NULL);
+    return GST_FLOW_OK;
+  }
+
   indexI = filter->data_transpose.trans_order[0];
   indexJ = filter->data_transpose.trans_order[1];
   SL = fromDim[3] > 0 ? fromDim[3] : 1;
@@ -1591,6 +1972,145 @@ gst_tensor_transform_transpose (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Statistics of the tensor for stand mode.
+ */
+typedef struct
+{
+  gdouble *average; /**< average of the tensor (or each channel) */
+  gdouble *std; /**< standard deviation of the tensor (or each channel) */
+} tensor_transform_stand_stat;
+
+/**
+ * @brief Process the tile of stand mode.
+ */
+static void
+gst_tensor_transform_stand_tile (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr, gsize start, gsize end,
+    gpointer data)
+{
+  tensor_transform_stand_stat *stat = (tensor_transform_stand_stat *) data;
+  gsize in_element_size, out_element_size, ch_size;
+  gulong i, data_idx, ch = 0;
+  gdouble tmp;
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+  ch_size = in_info->dimension[0];
+
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, out_info->type)) {
+    gdouble *block = gst_tensor_transform_get_scratch ();
+    gsize n, k;
+
+    /* convert a block to double with orc, then apply the statistics */
+    for (i = start; i < end; i += n) {
+      n = MIN (ARITH_BLOCK_SIZE, end - i);
+      orc_typecast (inptr + in_element_size * i, block, n, in_info->type,
+          _NNS_FLOAT64);
+
+      for (k = 0; k < n; k++) {
+        if (filter->data_stand.per_channel)
+          ch = (i + k) % ch_size;
+
+        if (filter->data_stand.mode == STAND_DEFAULT)
+          block[k] = fabs ((block[k] - stat->average[ch]) / stat->std[ch]);
+        else
+          block[k] -= stat->average[ch];
+      }
+
+      orc_typecast (block, outptr + out_element_size * i, n, _NNS_FLOAT64,
+          out_info->type);
+    }
+
+    return;
+  }
+#endif
+
+  for (i = start; i < end; i++) {
+    if (filter->data_stand.per_channel)
+      ch = i % ch_size;
+
+    data_idx = in_element_size * i;
+    gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
+        in_info->type, &tmp, _NNS_FLOAT64);
+
+    if (filter->data_stand.mode == STAND_DEFAULT)
+      tmp = fabs ((tmp - stat->average[ch]) / stat->std[ch]);
+    else
+      tmp -= stat->average[ch];
+
+    data_idx = out_element_size * i;
+    gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
+        (gpointer) (outptr + data_idx), out_info->type);
+  }
+}
+
+#ifdef HAVE_ORC
+/**
+ * @brief Calculate the statistics of the tensor for stand mode with orc.
+ *        This converts a block of the tensor to double at a time, and keeps the same order of the calculation with tensor_data.
+ */
+static gboolean
+gst_tensor_transform_stand_stat_orc (GstTensorTransform * filter,
+    GstTensorInfo * in_info, const uint8_t * inptr,
+    tensor_transform_stand_stat * stat)
+{
+  gdouble *block;
+  gsize in_element_size, num_ch, num, start, n, k;
+  gulong idx, i, ch = 0;
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  num = gst_tensor_get_element_count (in_info->dimension);
+  num_ch = filter->data_stand.per_channel ? in_info->dimension[0] : 1;
+  if (num_ch == 0 || num == 0)
+    return FALSE;
+
+  block = gst_tensor_transform_get_scratch ();
+  stat->average = g_new0 (gdouble, num_ch);
+  if (filter->data_stand.mode == STAND_DEFAULT)
+    stat->std = g_new0 (gdouble, num_ch);
+
+  /* average */
+  for (start = 0; start < num; start += n) {
+    n = MIN (ARITH_BLOCK_SIZE, num - start);
+    orc_typecast (inptr + in_element_size * start, block, n, in_info->type,
+        _NNS_FLOAT64);
+
+    for (k = 0; k < n; k++) {
+      idx = start + k;
+      ch = idx % num_ch;
+      i = idx / num_ch;
+      stat->average[ch] = (block[k] - stat->average[ch]) / (i + 1) +
+          stat->average[ch];
+    }
+  }
+
+  if (stat->std == NULL)
+    goto done;
+
+  /* standard deviation */
+  num = num / num_ch;
+  for (start = 0; start < num * num_ch; start += n) {
+    n = MIN (ARITH_BLOCK_SIZE, num * num_ch - start);
+    orc_typecast (inptr + in_element_size * start, block, n, in_info->type,
+        _NNS_FLOAT64);
+
+    for (k = 0; k < n; k++) {
+      ch = (start + k) % num_ch;
+      stat->std[ch] += pow (block[k] - stat->average[ch], 2) / num;
+    }
+  }
+
+  for (ch = 0; ch < num_ch; ch++)
+    stat->std[ch] = (stat->std[ch] != 0.0) ? sqrt (stat->std[ch]) : (1e-10);
+
+done:
+  return TRUE;
+}
+#endif
+
 /**
  * @brief subrouting for tensor-tranform, "stand" case.
  *        : pixel = abs((pixel - average(tensor))/(std(tensor) + val))
@@ -1607,134 +2127,76 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
     const uint8_t * inptr, uint8_t * outptr)
 {
   GstFlowReturn ret = GST_FLOW_OK;
-  gsize in_element_size, out_element_size, data_size, ch_size;
-  gulong i, num, data_idx, ch;
-  gdouble tmp, *average, *std;
+  tensor_transform_stand_stat stat;
+  gboolean stat_done = FALSE;
+  gsize data_size;
+  gulong num;
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
-
   data_size = gst_tensor_info_get_size (in_info);
-  ch_size = in_info->dimension[0];
 
   /* calc average and std */
-  average = std = NULL;
-  if (filter->data_stand.per_channel) {
+  stat.average = stat.std = NULL;
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, _NNS_FLOAT64))
+    stat_done = gst_tensor_transform_stand_stat_orc (filter, in_info, inptr,
+        &stat);
+#endif
+
+  if (stat_done) {
+    /* statistics are already calculated with orc */
+  } else if (filter->data_stand.per_channel) {
     gst_tensor_data_raw_average_per_channel ((gpointer) inptr, data_size,
-        in_info->type, in_info->dimension, &average);
+        in_info->type, in_info->dimension, &stat.average);
     /* calculate std only for default mode */
     if (filter->data_stand.mode == STAND_DEFAULT)
       gst_tensor_data_raw_std_per_channel ((gpointer) inptr, data_size,
-          in_info->type, in_info->dimension, average, &std);
+          in_info->type, in_info->dimension, stat.average, &stat.std);
   } else {
     gst_tensor_data_raw_average ((gpointer) inptr, data_size,
-        in_info->type, &average);
+        in_info->type, &stat.average);
     /* calculate std only for default mode */
     if (filter->data_stand.mode == STAND_DEFAULT)
       gst_tensor_data_raw_std ((gpointer) inptr, data_size, in_info->type,
-          average, &std);
+          stat.average, &stat.std);
   }
 
   switch (filter->data_stand.mode) {
     case STAND_DEFAULT:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
-
-          tmp = fabs ((tmp - *average) / *std);
-
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
-
-            tmp = fabs ((tmp - average[ch]) / std[ch]);
-
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
-      }
-      break;
-    }
     case STAND_DC_AVERAGE:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
-
-          tmp -= *average;
-
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
-
-            tmp -= average[ch];
-
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
-      }
+      /* statistics are calculated once, then each element is processed in the tiles */
+      gst_tensor_transform_run_tiles (filter, gst_tensor_transform_stand_tile,
+          in_info, out_info, inptr, outptr, num, TRANSFORM_TILE_SIZE, &stat);
       break;
-    }
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = GST_FLOW_ERROR;
   }
 
-  g_free (average);
-  g_free (std);
+  g_free (stat.average);
+  g_free (stat.std);
 
   return ret;
 }
 
 /**
- * @brief subrouting for tensor-tranform, "clamp" case.
- *        : pixel = if (pixel > max) ? max :
- *                  if (pixel < min) ? min : pixel
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief Process the tile of clamp mode.
  */
-static GstFlowReturn
-gst_tensor_transform_clamp (GstTensorTransform * filter,
+static void
+gst_tensor_transform_clamp_tile (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+    const uint8_t * inptr, uint8_t * outptr, gsize start, gsize end,
+    gpointer data)
 {
   gsize in_element_size, out_element_size;
-  gulong i, num, data_idx;
+  gulong i, data_idx;
   gdouble tmp;
+  UNUSED (data);
 
   in_element_size = gst_tensor_get_element_size (in_info->type);
   out_element_size = gst_tensor_get_element_size (out_info->type);
-  num = gst_tensor_get_element_count (in_info->dimension);
 
-  for (i = 0; i < num; ++i) {
+  for (i = start; i < end; ++i) {
     data_idx = in_element_size * i;
     gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
         &tmp, _NNS_FLOAT64);
@@ -1745,10 +2207,78 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
     gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64, outptr + data_idx,
         out_info->type);
   }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "clamp" case.
+ *        : pixel = if (pixel > max) ? max :
+ *                  if (pixel < min) ? min : pixel
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_clamp (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  gst_tensor_transform_run_tiles (filter, gst_tensor_transform_clamp_tile,
+      in_info, out_info, inptr, outptr,
+      gst_tensor_get_element_count (in_info->dimension),
+      TRANSFORM_TILE_SIZE, NULL);
 
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Process the tile of padding mode. A unit of the tile is a row (dimension[0]) of the input.
+ */
+static void
+gst_tensor_transform_padding_tile (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr, gsize start, gsize end,
+    gpointer data)
+{
+  gsize element_size, in_loop_size, out_loop_size, copy_block_size;
+  gsize r, i, j, k;
+  guint left, top, front;
+  UNUSED (data);
+
+  element_size = gst_tensor_get_element_size (in_info->type);
+
+  in_loop_size = in_info->dimension[2] * in_info->dimension[1]
+      * in_info->dimension[0] * element_size;
+  out_loop_size = out_info->dimension[2] * out_info->dimension[1]
+      * out_info->dimension[0] * element_size;
+  copy_block_size = in_info->dimension[0] * element_size;
+
+  left = filter->data_padding.pad[PADDING_LEFT];
+  top = filter->data_padding.pad[PADDING_TOP];
+  front = filter->data_padding.pad[PADDING_FRONT];
+
+  for (r = start; r < end; r++) {
+    gsize in_idx, out_idx;
+
+    k = r % in_info->dimension[1];
+    j = (r / in_info->dimension[1]) % in_info->dimension[2];
+    i = r / (in_info->dimension[1] * in_info->dimension[2]);
+
+    in_idx = j * in_info->dimension[1] * in_info->dimension[0]
+        + k * in_info->dimension[0];
+    out_idx = j * out_info->dimension[1] * out_info->dimension[0]
+        + k * out_info->dimension[0];
+
+    out_idx += left + top * out_info->dimension[0]
+        + front * out_info->dimension[1] * out_info->dimension[0];
+
+    memcpy (outptr + out_idx * element_size + out_loop_size * i,
+        inptr + in_idx * element_size + in_loop_size * i, copy_block_size);
+  }
+}
+
 /**
  * @brief subrouting for tensor-tranform, "padding" case.
  * @param[in/out] filter "this" pointer
@@ -1763,15 +2293,12 @@ gst_tensor_transform_padding (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info, const uint8_t * inptr,
     uint8_t * outptr)
 {
-  gsize element_size, in_loop_size, out_loop_size, copy_block_size;
-  guint i, j, k, left, top, front, loop_limit = 1;
+  gsize element_size, out_loop_size, num_rows;
+  guint i, loop_limit = 1;
   element_size = gst_tensor_get_element_size (in_info->type);
 
-  in_loop_size = in_info->dimension[2] * in_info->dimension[1]
-      * in_info->dimension[0] * element_size;
   out_loop_size = out_info->dimension[2] * out_info->dimension[1]
       * out_info->dimension[0] * element_size;
-  copy_block_size = in_info->dimension[0] * element_size;
 
   for (i = NNS_TENSOR_PADDING_RANK_LIMIT; i < NNS_TENSOR_RANK_LIMIT; i++) {
     if (in_info->dimension[i] == 0)
@@ -1779,27 +2306,13 @@ gst_tensor_transform_padding (GstTensorTransform * filter,
     loop_limit *= in_info->dimension[i];
   }
 
-  left = filter->data_padding.pad[PADDING_LEFT];
-  top = filter->data_padding.pad[PADDING_TOP];
-  front = filter->data_padding.pad[PADDING_FRONT];
-
   /** @todo Add constant option instead of using zero padding value */
   memset (outptr, 0, out_loop_size * loop_limit);
 
-  for (i = 0; i < loop_limit; i++)
-    for (j = 0; j < in_info->dimension[2]; j++)
-      for (k = 0; k < in_info->dimension[1]; k++) {
-        guint in_idx = j * in_info->dimension[1] * in_info->dimension[0]
-            + k * in_info->dimension[0];
-        guint out_idx = j * out_info->dimension[1] * out_info->dimension[0]
-            + k * out_info->dimension[0];
-
-        out_idx += left + top * out_info->dimension[0]
-            + front * out_info->dimension[1] * out_info->dimension[0];
-
-        memcpy (outptr + out_idx * element_size + out_loop_size * i,
-            inptr + in_idx * element_size + in_loop_size * i, copy_block_size);
-      }
+  num_rows = (gsize) loop_limit * in_info->dimension[2] * in_info->dimension[1];
+  gst_tensor_transform_run_tiles (filter, gst_tensor_transform_padding_tile,
+      in_info, out_info, inptr, outptr, num_rows,
+      TRANSFORM_TILE_SIZE / MAX (in_info->dimension[0], 1), NULL);
 
   return GST_FLOW_OK;
 }
@@ -2072,6 +2585,18 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
           out_info->type = _NNS_END;
         }
       }
+
+      /* fused transpose */
+      if (filter->data_arithmetic.transpose) {
+        const uint8_t *order = filter->data_arithmetic.trans_order;
+
+        for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
+          if (direction == GST_PAD_SINK)
+            out_info->dimension[i] = in_info->dimension[order[i]];
+          else
+            out_info->dimension[order[i]] = in_info->dimension[i];
+        }
+      }
       break;
 
     case GTT_TRANSPOSE:
@@ -2343,3 +2868,29 @@ gst_tensor_transform_transform_size (GstBaseTransform * trans,
 
   return TRUE;
 }
+
+/**
+ * @brief Called when the element starts processing. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensor_transform_start (GstBaseTransform * trans)
+{
+  GstTensorTransform *filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  gst_tensor_tile_pool_free (filter->thread_pool);
+  filter->thread_pool = gst_tensor_tile_pool_new (filter->num_threads);
+  return TRUE;
+}
+
+/**
+ * @brief Called when the element stops processing. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensor_transform_stop (GstBaseTransform * trans)
+{
+  GstTensorTransform *filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  gst_tensor_tile_pool_free (filter->thread_pool);
+  filter->thread_pool = NULL;
+  return TRUE;
+}
@@ -127,6 +127,8 @@ typedef struct _tensor_transform_arithmetic {
   tensor_type out_type;
   gboolean per_channel_arith;
   guint ch_dim;
+  gboolean transpose; /**< TRUE to transpose the result in the same pass */
+  uint8_t trans_order[NNS_TENSOR_RANK_LIMIT]; /**< transpose order if transpose is set */
 } tensor_transform_arithmetic;
 
 /**
@@ -186,6 +188,9 @@ struct _GstTensorTransform
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+
+  guint num_threads; /**< the number of threads to process the tiles of a tensor */
+  GThreadPool *thread_pool; /**< thread pool for the tiles, NULL if num_threads is 1 */
 };
 
 /**
@@ -83,6 +83,13 @@ gst_tensors_caps_from_config (const GstTensorsConfig * config);
 extern void
 gst_tensor_alloc_init (gsize alignment);
 
+/**
+ * @brief Get the statistics of the tensor allocator (hits, misses, bytes-outstanding, bytes-cached).
+ * @return newly allocated structure, caller should release this using gst_structure_free().
+ */
+extern GstStructure *
+gst_tensor_alloc_get_stats (void);
+
 /**
  * @brief Parse memory and fill the tensor meta.
  * @param[out] meta tensor meta structure to be filled
@@ -135,6 +135,7 @@ typedef struct _GstTensorFilterProperties
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
   int invoke_dynamic; /**< True for supporting invoke with flexible output. */
+  int batch_size; /**< The number of frames stacked along the outermost axis of each input/output tensor for the current invoke. 1 unless the framework declares support_batch and tensor_filter runs in batching mode. */
 } GstTensorFilterProperties;
 
 /**
@@ -165,6 +166,7 @@ typedef struct _GstTensorFilterFrameworkInfo
   accl_hw accl_auto;  /**< accelerator to be used in auto mode (acceleration to be used but accelerator is not specified for the filter) - default -1 implies use first entry from hw_list. */
   accl_hw accl_default;   /**< accelerator to be used by default (valid user input is not provided) - default -1 implies use first entry from hw_list. */
   const GstTensorFilterFrameworkStatistics *statistics;  /**< usage statistics by the framework. This is shared across all opened instances of this framework. */
+  int support_batch; /**< TRUE(nonzero) if invoke can process multiple frames stacked along the outermost axis of the tensors. The number of frames is given with prop->batch_size and the size of each input/output tensor is multiplied by it. */
 } GstTensorFilterFrameworkInfo;
 
 /**
@@ -237,6 +239,13 @@ typedef struct _GstTensorFilterFrameworkEventData
 
 typedef struct _GstTensorFilterFramework GstTensorFilterFramework;
 
+/**
+ * @brief Callback to notify tensor_filter that the asynchronous invoke is completed.
+ * @param[in] user_data The user data given with invokeAsync.
+ * @param[in] status 0 if OK. Positive value to drop the frame, negative value if error. (same as the return value of invoke)
+ */
+typedef void (*GstTensorFilterInvokeCallback) (void *user_data, int status);
+
 /**
  * @brief Tensor_Filter Subplugin definition
  *
@@ -460,6 +469,23 @@ struct _GstTensorFilterFramework
        * @return 0 if OK. non-zero if error. -ENOENT if operation is not supported. -EINVAL if operation is supported but provided arguments are invalid.
        */
       void *subplugin_data; /**< This is used by tensor_filter infrastructure. Subplugin authors should NEVER update this. Only the files in /gst/nnstreamer/tensor_filter/ are allowed to access this. */
+
+      int (*invokeAsync) (const GstTensorFilterFramework * self,
+          GstTensorFilterProperties * prop, void *private_data,
+          const GstTensorMemory * input, GstTensorMemory * output,
+          GstTensorFilterInvokeCallback done, void *user_data);
+      /**< Optional. Set NULL if not supported. Start to invoke the given network model and return without waiting for the result.
+       * If this is defined and 'inflight-requests' of tensor_filter is larger than 0, tensor_filter calls this instead of invoke and keeps the input and output tensors until 'done' is called.
+       * The subplugin should call 'done' exactly once for each call returning 0, from any thread, after the output tensors are filled. Note that the completion order may differ from the call order; tensor_filter pushes the results in order.
+       *
+       * @param[in/out] prop property values. Dynamic invoke is not supported with this method.
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The array of input tensors. Allocated and filled by tensor_filter/main. Valid until 'done' is called.
+       * @param[out] output The array of output tensors. Valid until 'done' is called. If allocate_in_invoke is TRUE, sub-plugin should allocate the memory block for output tensor. (data in GstTensorMemory)
+       * @param[in] done The callback to be called when the invoke is completed.
+       * @param[in] user_data The user data to be passed to 'done'.
+       * @return 0 if the invoke is started. non-zero if error ('done' must not be called in this case).
+       */
     }
 #ifdef NO_ANONYMOUS_NESTED_STRUCT
         v1
@@ -500,6 +526,17 @@ nnstreamer_filter_find (const char *name);
 extern void
 nnstreamer_filter_set_custom_property_desc (const char *name, const char *prop, ...);
 
+/**
+ * @brief Add the latencies of an invoke to the framework statistics.
+ * @details The counters are updated atomically, so the instances invoked in different threads can share the statistics.
+ * @param[in] stats The statistics of the framework
+ * @param[in] invoke_latency The latency of the backend compute (usec)
+ * @param[in] overhead_latency The latency of the extension, e.g., copying input and output tensors (usec)
+ */
+extern void
+nnstreamer_filter_statistics_add (GstTensorFilterFrameworkStatistics * stats,
+    int64_t invoke_latency, int64_t overhead_latency);
+
 /**
  * @brief return accl_hw type from string
  */
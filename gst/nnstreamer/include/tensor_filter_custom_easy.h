@@ -63,6 +63,21 @@ extern int NNS_custom_easy_register (const char * modelname,
     NNS_custom_invoke func, void *data,
     const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
 
+/**
+ * @brief Register the custom-easy tensor function supporting batched invoke.
+ * @param[in] modelname The name of custom-easy tensor function.
+ * @param[in] func The tensor function body
+ * @param[in/out] private_data The internal data for the function
+ * @param[in] in_info Input tensor metadata of a frame.
+ * @param[in] out_info Output tensor metadata of a frame.
+ * @note With batch-size of tensor_filter, func is called with prop->batch_size
+ *       frames stacked along the outermost axis of each tensor, and the size
+ *       of each input and output tensor is multiplied by it.
+ */
+extern int NNS_custom_easy_batch_register (const char * modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
+
 /**
  * @brief Invoke the "main function" with flexible input and output. Output tensor memory should be allocated.
  * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
@@ -45,6 +45,31 @@ typedef struct
   GstTensorInfo infos[NNS_TENSOR_SIZE_EXTRA_LIMIT];
 } GstTensorExtraInfo;
 
+/**
+ * @brief Offsets of the extra tensors, attached to the extra memory block.
+ * This is updated only when appending a tensor to the writable memory block,
+ * so that the nth tensor is found without summing the sizes of the previous tensors.
+ */
+typedef struct
+{
+  guint num_extra_tensors; /**< The number of extra tensors when updated */
+  gsize offsets[NNS_TENSOR_SIZE_EXTRA_LIMIT]; /**< The offset of each extra tensor in the memory block */
+} GstTensorExtraOffsets;
+
+/**
+ * @brief Get the quark to attach GstTensorExtraOffsets to the extra memory block.
+ */
+static GQuark
+gst_tensor_extra_offsets_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("nnstreamer-tensor-extra-offsets");
+
+  return quark;
+}
+
 /**
  * @brief Check if given memory has extra tensors.
  * @param[in] map GstMapInfo of GstMemory to be checked.
@@ -92,6 +117,95 @@ gst_tensor_extra_info_init (GstTensorExtraInfo * extra, gsize reserved_size)
   }
 }
 
+/**
+ * @brief Get the offset of the extra tensor in the extra memory block.
+ * @param[in] memory The extra memory block.
+ * @param[in] extra GstTensorExtraInfo of the memory block.
+ * @param[in] index The index of the extra tensor.
+ * @return The offset of the tensor data in the memory block.
+ */
+static gsize
+gst_tensor_extra_info_get_offset (GstMemory * memory,
+    const GstTensorExtraInfo * extra, guint index)
+{
+  GstTensorExtraOffsets *offsets;
+  gsize offset;
+  guint i;
+
+  offsets = (GstTensorExtraOffsets *)
+      gst_mini_object_get_qdata (GST_MINI_OBJECT_CAST (memory),
+      gst_tensor_extra_offsets_quark ());
+
+  if (offsets && offsets->num_extra_tensors == extra->num_extra_tensors)
+    return offsets->offsets[index];
+
+  /* The memory block is not built by this process, sum the size of tensors. */
+  offset = sizeof (GstTensorExtraInfo) + extra->reserved;
+  for (i = 0; i < index; ++i)
+    offset += gst_tensor_info_get_size (&extra->infos[i]);
+
+  return offset;
+}
+
+/**
+ * @brief Update the offsets of the extra tensors after appending a tensor.
+ * @param[in] memory The extra memory block (writable).
+ * @param[in] extra GstTensorExtraInfo of the memory block.
+ */
+static void
+gst_tensor_extra_info_update_offsets (GstMemory * memory,
+    const GstTensorExtraInfo * extra)
+{
+  GstTensorExtraOffsets *offsets;
+  guint i, last;
+
+  g_return_if_fail (extra->num_extra_tensors > 0);
+
+  offsets = (GstTensorExtraOffsets *)
+      gst_mini_object_get_qdata (GST_MINI_OBJECT_CAST (memory),
+      gst_tensor_extra_offsets_quark ());
+  last = extra->num_extra_tensors - 1;
+
+  if (offsets && offsets->num_extra_tensors == last) {
+    /* Only the offset of the appended tensor is required. */
+    i = last;
+  } else {
+    offsets = g_new (GstTensorExtraOffsets, 1);
+    offsets->offsets[0] = sizeof (GstTensorExtraInfo) + extra->reserved;
+    i = 0;
+
+    gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (memory),
+        gst_tensor_extra_offsets_quark (), offsets, g_free);
+  }
+
+  for (i = MAX (i, 1U); i <= last; ++i) {
+    offsets->offsets[i] = offsets->offsets[i - 1] +
+        gst_tensor_info_get_size (&extra->infos[i - 1]);
+  }
+
+  offsets->num_extra_tensors = extra->num_extra_tensors;
+}
+
+/**
+ * @brief Check the extra memory block can be extended in place.
+ * @param[in] buffer GstBuffer which has the memory block.
+ * @param[in] memory The extra memory block.
+ * @param[in] size The new size of the memory block.
+ */
+static gboolean
+gst_tensor_extra_memory_can_grow (GstBuffer * buffer, GstMemory * memory,
+    gsize size)
+{
+  gsize offset, maxsize;
+
+  if (!gst_buffer_is_writable (buffer) || !gst_memory_is_writable (memory) ||
+      GST_MEMORY_IS_READONLY (memory))
+    return FALSE;
+
+  gst_memory_get_sizes (memory, &offset, &maxsize);
+  return (maxsize - offset >= size);
+}
+
 /**
  * @brief Get the corresponding mode from the string value.
  * @param[in] str The string value for the mode.
@@ -1638,17 +1752,13 @@ gst_tensor_buffer_get_nth_memory (GstBuffer * buffer, const guint index)
     goto done;
   }
 
-  offset += extra_info->reserved;
-
-  for (i = 1; i <= index - NNS_TENSOR_MEMORY_MAX; ++i) {
-    offset += gst_tensor_info_get_size (&extra_info->infos[i - 1]);
-  }
+  i = index - NNS_TENSOR_MEMORY_MAX;
+  offset = gst_tensor_extra_info_get_offset (extra_tensors_memory,
+      extra_info, i);
 
   /* wrap it as GstMemory */
-  res_mem =
-      gst_memory_share (extra_tensors_memory, offset,
-      gst_tensor_info_get_size (&extra_info->infos[index -
-              NNS_TENSOR_MEMORY_MAX]));
+  res_mem = gst_memory_share (extra_tensors_memory, offset,
+      gst_tensor_info_get_size (&extra_info->infos[i]));
 
 done:
   gst_memory_unmap (extra_tensors_memory, &extra_tensors_map);
@@ -1668,11 +1778,12 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
 {
   guint num_mems, new_mem_index;
   GstMemory *new_memory = NULL, *last_memory = NULL;
-  gsize offset, new_mem_size, last_mem_size;
+  gsize offset, new_mem_size, last_mem_size, alloc_size;
   GstMapInfo new_memory_map, last_memory_map, incoming_memory_map;
   GstTensorExtraInfo *extra_info;
   GstTensorMetaInfo meta;
-  gboolean is_extra, is_static;
+  gboolean is_extra, is_static, in_place;
+  gboolean incoming_mapped = FALSE;
   gboolean appended = FALSE;
 
   if (!GST_IS_BUFFER (buffer)) {
@@ -1719,47 +1830,88 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
     goto failed;
   }
 
-  new_mem_size = last_mem_size = gst_memory_get_sizes (last_memory, NULL, NULL);
+  new_mem_size = last_mem_size = last_memory_map.size;
 
   /* if the memory does not have proper header, append it */
   is_extra = gst_memory_map_is_extra_tensor (&last_memory_map);
   if (!is_extra) {
     new_mem_size += sizeof (GstTensorExtraInfo);
-  }
+  } else {
+    extra_info = (GstTensorExtraInfo *) last_memory_map.data;
 
-  new_mem_size += gst_memory_get_sizes (memory, NULL, NULL);
+    if (extra_info->num_extra_tensors >= NNS_TENSOR_SIZE_EXTRA_LIMIT) {
+      nns_loge ("Failed to append memory, the buffer already has %d tensors.",
+          NNS_TENSOR_SIZE_LIMIT);
+      goto failed;
+    }
+  }
 
-  new_memory = gst_allocator_alloc (NULL, new_mem_size, NULL);
-  if (!new_memory) {
-    nns_loge ("Failed to allocate memory for extra tensors.");
+  if (!gst_memory_map (memory, &incoming_memory_map, GST_MAP_READ)) {
+    nns_loge ("Failed to map incoming memory");
     goto failed;
   }
 
+  incoming_mapped = TRUE;
+  new_mem_size += incoming_memory_map.size;
+
+  /**
+   * Extend the extra memory block in place if it has enough space.
+   * Otherwise, allocate new memory block twice the size of the previous one,
+   * so that appending N tensors copies the data O(N) times in total.
+   */
+  in_place = is_extra &&
+      gst_tensor_extra_memory_can_grow (buffer, last_memory, new_mem_size);
+
+  if (in_place) {
+    gst_memory_unmap (last_memory, &last_memory_map);
+    gst_memory_resize (last_memory, 0, new_mem_size);
+
+    new_memory = gst_memory_ref (last_memory);
+    last_memory = NULL;
+  } else {
+    alloc_size = new_mem_size;
+    if (is_extra)
+      alloc_size = MAX (alloc_size, last_mem_size * 2);
+
+    new_memory = gst_allocator_alloc (NULL, alloc_size, NULL);
+    if (!new_memory) {
+      nns_loge ("Failed to allocate memory for extra tensors.");
+      goto failed;
+    }
+
+    gst_memory_resize (new_memory, 0, new_mem_size);
+  }
+
   if (!gst_memory_map (new_memory, &new_memory_map, GST_MAP_WRITE)) {
     nns_loge ("Failed to map extra memory");
+    if (in_place)
+      gst_memory_resize (new_memory, 0, last_mem_size);
     gst_memory_unref (new_memory);
     new_memory = NULL;
     goto failed;
   }
 
-  if (!gst_memory_map (memory, &incoming_memory_map, GST_MAP_READ)) {
-    nns_loge ("Failed to map incoming memory");
-    goto failed;
-  }
-
   extra_info = (GstTensorExtraInfo *) new_memory_map.data;
 
-  /* if the last_memory does not have proper header, append it */
-  if (!is_extra) {
-    gst_tensor_extra_info_init (extra_info, last_mem_size);
-    offset = sizeof (GstTensorExtraInfo);
+  if (in_place) {
+    offset = last_mem_size;
   } else {
-    offset = 0;
-  }
+    /* if the last_memory does not have proper header, append it */
+    if (!is_extra) {
+      gst_tensor_extra_info_init (extra_info, last_mem_size);
+      offset = sizeof (GstTensorExtraInfo);
+    } else {
+      offset = 0;
+    }
+
+    /* copy last_memory into new_memory */
+    memcpy (new_memory_map.data + offset, last_memory_map.data,
+        last_memory_map.size);
+    offset += last_memory_map.size;
 
-  /* copy last_memory into new_memory */
-  memcpy (new_memory_map.data + offset, last_memory_map.data,
-      last_memory_map.size);
+    gst_memory_unmap (last_memory, &last_memory_map);
+    last_memory = NULL;
+  }
 
   /* copy incoming_memory into new_memory */
   new_mem_index = extra_info->num_extra_tensors;
@@ -1779,26 +1931,26 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
     gst_tensor_meta_info_convert (&meta, &extra_info->infos[new_mem_index]);
   }
 
-  memcpy (new_memory_map.data + offset + last_memory_map.size,
-      incoming_memory_map.data, incoming_memory_map.size);
+  memcpy (new_memory_map.data + offset, incoming_memory_map.data,
+      incoming_memory_map.size);
 
-  gst_memory_unmap (memory, &incoming_memory_map);
-  gst_memory_unmap (last_memory, &last_memory_map);
-  last_memory = NULL;
+  gst_tensor_extra_info_update_offsets (new_memory, extra_info);
+  gst_memory_unmap (new_memory, &new_memory_map);
+
+  if (in_place)
+    gst_memory_unref (new_memory);
+  else
+    gst_buffer_replace_memory (buffer, num_mems - 1, new_memory);
 
-  gst_buffer_replace_memory (buffer, num_mems - 1, new_memory);
   appended = TRUE;
 
 failed:
-  if (new_memory) {
-    gst_memory_unmap (new_memory, &new_memory_map);
-    if (!appended)
-      gst_memory_unref (new_memory);
-  }
-
   if (last_memory)
     gst_memory_unmap (last_memory, &last_memory_map);
 
+  if (incoming_mapped)
+    gst_memory_unmap (memory, &incoming_memory_map);
+
   /* Release incoming memory even if failed to append it into buffer. */
   if (memory)
     gst_memory_unref (memory);
@@ -1935,3 +2087,129 @@ gst_tensor_parse_config_file (const gchar * config_path, const GObject * object)
     }
   }
 }
+
+/**
+ * @brief Data structure of the tiles of a tensor, shared with the threads.
+ */
+typedef struct
+{
+  GstTensorTileFunc func; /**< function to process the tiles */
+  gpointer user_data; /**< private data for the function */
+
+  GMutex lock; /**< lock for pending */
+  GCond cond; /**< signaled when all tiles are processed */
+  gsize pending; /**< the number of tiles not processed yet */
+} GstTensorTileJob;
+
+/**
+ * @brief A tile to be processed in the thread pool.
+ */
+typedef struct
+{
+  GstTensorTileJob *job; /**< the tensor to be processed */
+  gsize start; /**< the first unit of the tile */
+  gsize end; /**< the end of the tile (exclusive) */
+} GstTensorTile;
+
+/**
+ * @brief Process a tile in the thread pool.
+ */
+static void
+gst_tensor_tile_thread (gpointer data, gpointer user_data)
+{
+  GstTensorTile *tile = (GstTensorTile *) data;
+  GstTensorTileJob *job = tile->job;
+  UNUSED (user_data);
+
+  job->func (tile->start, tile->end, job->user_data);
+
+  g_mutex_lock (&job->lock);
+  if (--job->pending == 0)
+    g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Create the thread pool to process the tiles of a tensor.
+ */
+GThreadPool *
+gst_tensor_tile_pool_new (guint num_threads)
+{
+  GThreadPool *pool;
+  GError *err = NULL;
+
+  if (num_threads <= 1)
+    return NULL;
+
+  /* the caller processes a tile, the pool has one less thread */
+  pool = g_thread_pool_new (gst_tensor_tile_thread, NULL,
+      (gint) num_threads - 1, FALSE, &err);
+  if (pool == NULL) {
+    nns_logw
+        ("Failed to create the thread pool, process the tensor in a thread (%s).",
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+  }
+
+  return pool;
+}
+
+/**
+ * @brief Release the thread pool, waiting for the tiles in process.
+ */
+void
+gst_tensor_tile_pool_free (GThreadPool * pool)
+{
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/**
+ * @brief Split [0, total) into the tiles and process them with the thread pool.
+ */
+void
+gst_tensor_tile_run (GThreadPool * pool, GstTensorTileFunc func, gsize total,
+    gsize tile_size, gpointer user_data)
+{
+  GstTensorTileJob job;
+  GstTensorTile *tiles;
+  gsize i, num_tiles;
+
+  g_return_if_fail (func != NULL);
+
+  tile_size = MAX (tile_size, 1);
+  num_tiles = (total + tile_size - 1) / tile_size;
+
+  if (pool == NULL || num_tiles <= 1) {
+    func (0, total, user_data);
+    return;
+  }
+
+  job.func = func;
+  job.user_data = user_data;
+  job.pending = num_tiles - 1;
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+
+  tiles = g_new (GstTensorTile, num_tiles);
+  for (i = 0; i < num_tiles; i++) {
+    tiles[i].job = &job;
+    tiles[i].start = i * tile_size;
+    tiles[i].end = MIN (total, (i + 1) * tile_size);
+
+    /* the first tile is processed in the caller */
+    if (i > 0 && !g_thread_pool_push (pool, &tiles[i], NULL))
+      gst_tensor_tile_thread (&tiles[i], NULL);
+  }
+
+  func (tiles[0].start, tiles[0].end, user_data);
+
+  g_mutex_lock (&job.lock);
+  while (job.pending > 0)
+    g_cond_wait (&job.cond, &job.lock);
+  g_mutex_unlock (&job.lock);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+  g_free (tiles);
+}
@@ -13,6 +13,7 @@
 #include <string.h>
 #include "nnstreamer_plugin_api_util.h"
 #include "nnstreamer_log.h"
+#include "nnstreamer_util.h"
 
 /**
  * @brief String representations for each tensor element type.
@@ -70,6 +70,7 @@
 #include <elements/gsttensor_srciio.h>
 #endif
 
+#include <tensor_common.h>
 #include <tensor_filter/tensor_filter.h>
 #if defined(ENABLE_NNSTREAMER_EDGE)
 #include <tensor_query/tensor_query_serversrc.h>
@@ -91,6 +92,8 @@
 static gboolean
 gst_nnstreamer_init (GstPlugin * plugin)
 {
+  gst_tensor_alloc_init_from_conf ();
+
   NNSTREAMER_INIT (plugin, aggregator, AGGREGATOR);
   NNSTREAMER_INIT (plugin, converter, CONVERTER);
   NNSTREAMER_INIT (plugin, crop, CROP);
@@ -4,19 +4,130 @@
  *
  * @file    tensor_allocator.c
  * @date    12 May 2021
- * @brief   Allocator for memory alignment
+ * @brief   Allocator for memory alignment and size-class pooling
  * @author  Junhwan Kim <jejudo.kim@samsung.com>
  * @see     http://github.com/nnstreamer/nnstreamer
  * @bug     No known bugs
  *
+ * GstTensorAllocator allocates the memory blocks with the configured alignment.
+ * If the pool is enabled, the released blocks are kept in the free lists of
+ * size classes (4 classes for each power of two) and reused by the next
+ * allocation. Each thread caches a few small blocks to avoid the lock.
+ * Large blocks may be backed by hugepages and bound to a NUMA node.
+ * These are configured with [allocator] section of nnstreamer.ini.
  */
 
+#include <string.h>
 #include <gst/gst.h>
 #include "nnstreamer_plugin_api.h"
+#include "nnstreamer_conf.h"
+#include "nnstreamer_log.h"
+#include "tensor_common.h"
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TENSOR_ALLOC_USE_MMAP
+#endif
 
 #define GST_TENSOR_ALLOCATOR "GstTensorAllocator"
 
-static gsize gst_tensor_allocator_alignment = 0;
+/**
+ * @brief The smallest size class (64 bytes) and the largest pooled size class (256 MB).
+ */
+#define SIZE_CLASS_MIN_SHIFT (6)
+#define SIZE_CLASS_MAX_SHIFT (28)
+#define SIZE_CLASS_STEPS (4)
+#define SIZE_CLASS_NUM (((SIZE_CLASS_MAX_SHIFT - SIZE_CLASS_MIN_SHIFT) * SIZE_CLASS_STEPS) + 1)
+
+/**
+ * @brief Thread-local cache keeps up to 4 blocks of each class smaller than 256 KB.
+ */
+#define TLS_CACHE_MAX_BLOCKS (4)
+#define TLS_CACHE_MAX_SIZE (256 * 1024)
+
+/**
+ * @brief Blocks larger than this are mapped directly if hugepage or NUMA binding is enabled.
+ */
+#define MMAP_THRESHOLD (256 * 1024)
+#define HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * @brief Default max bytes of the blocks kept in the shared free lists.
+ */
+#define DEFAULT_POOL_MAX_BYTES (64 * 1024 * 1024)
+
+/**
+ * @brief Header of the memory block. The data follows this header.
+ */
+typedef struct _GstTensorBlock
+{
+  struct _GstTensorBlock *next; /**< link of the free list */
+  gsize length; /**< length of the block including this header */
+  gint size_class; /**< index of the size class, -1 if not pooled */
+  guint generation; /**< configuration generation when the block is allocated */
+  gboolean mmapped; /**< TRUE if the block is mapped with mmap() */
+} GstTensorBlock;
+
+/**
+ * @brief Header size of the memory block, keeps the data 16-byte aligned.
+ */
+#define BLOCK_HEADER_SIZE ((sizeof (GstTensorBlock) + 15) & ~((gsize) 15))
+
+/**
+ * @brief Free list of the memory blocks.
+ */
+typedef struct
+{
+  GstTensorBlock *head; /**< the first free block */
+  guint count; /**< the number of free blocks */
+} GstTensorBlockList;
+
+/**
+ * @brief Thread-local cache of the configuration and the memory blocks.
+ */
+typedef struct
+{
+  guint generation; /**< configuration generation of the snapshot and the cached blocks */
+  GstTensorAllocConfig conf; /**< snapshot of the configuration, updated when the generation is changed */
+  GstTensorBlockList lists[SIZE_CLASS_NUM]; /**< free lists for each size class */
+} GstTensorBlockCache;
+
+/**
+ * @brief Memory allocated by GstTensorAllocator.
+ */
+typedef struct
+{
+  GstMemory mem; /**< parent memory */
+  GstTensorBlock *block; /**< memory block, NULL if this is shared from the parent */
+  guint8 *data; /**< start of the memory, aligned */
+} GstTensorAllocMemory;
+
+/**
+ * @brief Current configuration of the allocator, protected by pool_lock.
+ * @note Allocation paths read the thread-local snapshot (see _cache_get), which
+ *       is refreshed when pool_generation is changed by gst_tensor_alloc_configure.
+ */
+static GstTensorAllocConfig alloc_conf = {
+  .alignment = 0,
+  .pool = FALSE,
+  .pool_max_bytes = DEFAULT_POOL_MAX_BYTES,
+  .hugepage = TENSOR_ALLOC_HUGEPAGE_NONE,
+  .numa_node = -1,
+};
+
+static GMutex pool_lock;
+static GstTensorBlockList pool_lists[SIZE_CLASS_NUM];
+static guint pool_generation = 0;
+
+static gsize stat_hits = 0;
+static gsize stat_misses = 0;
+static gssize stat_outstanding = 0;
+static gssize stat_cached = 0;
+
+static void _cache_free (gpointer data);
+static GPrivate pool_cache = G_PRIVATE_INIT (_cache_free);
 
 /**
  * @brief struct for type GstTensorAllocator
@@ -38,27 +149,461 @@ typedef struct
 static GType gst_tensor_allocator_get_type (void);
 G_DEFINE_TYPE (GstTensorAllocator, gst_tensor_allocator, GST_TYPE_ALLOCATOR);
 
+/**
+ * @brief Get the size class of the given size.
+ * @param[in/out] size the requested size, updated to the size of the class
+ * @return index of the size class, -1 if the size is too large to be pooled.
+ */
+static gint
+_size_class (gsize * size)
+{
+  gsize base, step, n;
+  guint shift;
+
+  if (*size <= ((gsize) 1 << SIZE_CLASS_MIN_SHIFT)) {
+    *size = (gsize) 1 << SIZE_CLASS_MIN_SHIFT;
+    return 0;
+  }
+
+  /* base < size <= base * 2 */
+  shift = g_bit_storage (*size - 1) - 1;
+  if (shift >= SIZE_CLASS_MAX_SHIFT)
+    return -1;
+
+  base = (gsize) 1 << shift;
+  step = base / SIZE_CLASS_STEPS;
+  n = (*size - base + step - 1) / step;
+
+  *size = base + n * step;
+  return (gint) ((shift - SIZE_CLASS_MIN_SHIFT) * SIZE_CLASS_STEPS + n);
+}
+
+/**
+ * @brief Allocate new memory block.
+ */
+static GstTensorBlock *
+_block_new (const GstTensorAllocConfig * conf, gsize length, gint size_class,
+    guint generation)
+{
+  GstTensorBlock *block = NULL;
+  gboolean mmapped = FALSE;
+
+#ifdef TENSOR_ALLOC_USE_MMAP
+  if (length >= MMAP_THRESHOLD &&
+      (conf->hugepage != TENSOR_ALLOC_HUGEPAGE_NONE ||
+          conf->numa_node >= 0)) {
+    gpointer ptr = MAP_FAILED;
+    gsize page = (gsize) sysconf (_SC_PAGESIZE);
+
+#ifdef MAP_HUGETLB
+    if (conf->hugepage == TENSOR_ALLOC_HUGEPAGE_HUGETLB) {
+      gsize hlength = (length + HUGEPAGE_SIZE - 1) & ~((gsize) HUGEPAGE_SIZE - 1);
+
+      ptr = mmap (NULL, hlength, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED)
+        length = hlength;
+    }
+#endif
+
+    if (ptr == MAP_FAILED) {
+      /* fallback to normal pages if hugetlbfs is not available */
+      length = (length + page - 1) & ~(page - 1);
+      ptr = mmap (NULL, length, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+      if (ptr != MAP_FAILED && conf->hugepage != TENSOR_ALLOC_HUGEPAGE_NONE)
+        madvise (ptr, length, MADV_HUGEPAGE);
+#endif
+    }
+
+#ifdef SYS_mbind
+    if (ptr != MAP_FAILED && conf->numa_node >= 0 &&
+        conf->numa_node < (gint) (sizeof (gulong) * 8)) {
+      /* MPOL_PREFERRED (1), prefer the node and fallback to others */
+      gulong nodemask = 1UL << conf->numa_node;
+
+      if (syscall (SYS_mbind, ptr, length, 1, &nodemask,
+              sizeof (nodemask) * 8, 0) != 0)
+        ml_logw ("Failed to bind the tensor memory to NUMA node %d.",
+            conf->numa_node);
+    }
+#endif
+
+    if (ptr != MAP_FAILED) {
+      block = (GstTensorBlock *) ptr;
+      mmapped = TRUE;
+    }
+  }
+#endif
+
+  if (block == NULL) {
+    block = (GstTensorBlock *) g_try_malloc (length);
+    if (block == NULL)
+      return NULL;
+  }
+
+  block->next = NULL;
+  block->length = length;
+  block->size_class = size_class;
+  block->generation = generation;
+  block->mmapped = mmapped;
+
+  return block;
+}
+
+/**
+ * @brief Free the memory block.
+ */
+static void
+_block_free (GstTensorBlock * block)
+{
+#ifdef TENSOR_ALLOC_USE_MMAP
+  if (block->mmapped) {
+    munmap (block, block->length);
+    return;
+  }
+#endif
+
+  g_free (block);
+}
+
+/**
+ * @brief Free all blocks in the list.
+ */
+static void
+_block_list_free (GstTensorBlockList * list)
+{
+  GstTensorBlock *block;
+
+  while ((block = list->head) != NULL) {
+    list->head = block->next;
+    g_atomic_pointer_add (&stat_cached, -(gssize) block->length);
+    _block_free (block);
+  }
+
+  list->count = 0;
+}
+
+/**
+ * @brief Release the thread-local cache when the thread exits.
+ */
+static void
+_cache_free (gpointer data)
+{
+  GstTensorBlockCache *cache = (GstTensorBlockCache *) data;
+  guint i;
+
+  for (i = 0; i < SIZE_CLASS_NUM; i++)
+    _block_list_free (&cache->lists[i]);
+
+  g_free (cache);
+}
+
+/**
+ * @brief Copy the current configuration.
+ * @return generation of the configuration
+ */
+static guint
+_conf_snapshot (GstTensorAllocConfig * conf)
+{
+  guint generation;
+
+  g_mutex_lock (&pool_lock);
+  *conf = alloc_conf;
+  generation = pool_generation;
+  g_mutex_unlock (&pool_lock);
+
+  return generation;
+}
+
+/**
+ * @brief Get the thread-local cache of the current configuration.
+ * @details The configuration may be changed at runtime (e.g., gst_tensor_alloc_init() from a subplugin).
+ *          The snapshot is taken under the lock only when the generation is changed.
+ */
+static GstTensorBlockCache *
+_cache_get (void)
+{
+  GstTensorBlockCache *cache;
+  guint i, generation;
+
+  cache = (GstTensorBlockCache *) g_private_get (&pool_cache);
+  if (cache == NULL) {
+    cache = g_new0 (GstTensorBlockCache, 1);
+    cache->generation = _conf_snapshot (&cache->conf);
+    g_private_set (&pool_cache, cache);
+  } else if (cache->generation != (guint) g_atomic_int_get (&pool_generation)) {
+    generation = _conf_snapshot (&cache->conf);
+
+    /* configuration is changed, drop the old blocks */
+    if (cache->generation != generation) {
+      for (i = 0; i < SIZE_CLASS_NUM; i++)
+        _block_list_free (&cache->lists[i]);
+      cache->generation = generation;
+    }
+  }
+
+  return cache;
+}
+
+/**
+ * @brief Get a memory block from the pool or allocate new one.
+ */
+static GstTensorBlock *
+_block_acquire (GstTensorBlockCache * cache, gsize length)
+{
+  GstTensorBlockList *list;
+  GstTensorBlock *block = NULL;
+  guint generation = cache->generation;
+  gint size_class = -1;
+
+  if (cache->conf.pool) {
+    size_class = _size_class (&length);
+
+    if (size_class >= 0) {
+      if (length < TLS_CACHE_MAX_SIZE) {
+        list = &cache->lists[size_class];
+
+        if ((block = list->head) != NULL) {
+          list->head = block->next;
+          list->count--;
+        }
+      }
+
+      if (block == NULL) {
+        g_mutex_lock (&pool_lock);
+        if (generation == pool_generation) {
+          list = &pool_lists[size_class];
+
+          if ((block = list->head) != NULL) {
+            list->head = block->next;
+            list->count--;
+          }
+        }
+        g_mutex_unlock (&pool_lock);
+      }
+    }
+  }
+
+  if (block) {
+    g_atomic_pointer_add (&stat_hits, 1);
+    g_atomic_pointer_add (&stat_cached, -(gssize) block->length);
+  } else {
+    block = _block_new (&cache->conf, length, size_class, generation);
+    if (block == NULL)
+      return NULL;
+
+    if (size_class >= 0)
+      g_atomic_pointer_add (&stat_misses, 1);
+  }
+
+  g_atomic_pointer_add (&stat_outstanding, (gssize) block->length);
+  return block;
+}
+
+/**
+ * @brief Return the memory block to the pool, or free it.
+ */
+static void
+_block_release (GstTensorBlock * block)
+{
+  GstTensorBlockCache *cache;
+  GstTensorBlockList *list;
+  guint generation;
+
+  g_atomic_pointer_add (&stat_outstanding, -(gssize) block->length);
+
+  cache = _cache_get ();
+  generation = cache->generation;
+  if (!cache->conf.pool || block->size_class < 0 ||
+      block->generation != generation) {
+    _block_free (block);
+    return;
+  }
+
+  g_atomic_pointer_add (&stat_cached, (gssize) block->length);
+
+  if (block->length < TLS_CACHE_MAX_SIZE) {
+    list = &cache->lists[block->size_class];
+
+    if (list->count < TLS_CACHE_MAX_BLOCKS) {
+      block->next = list->head;
+      list->head = block;
+      list->count++;
+      return;
+    }
+  }
+
+  g_mutex_lock (&pool_lock);
+  if (generation == pool_generation &&
+      (gsize) (gintptr) g_atomic_pointer_get (&stat_cached) <= cache->conf.pool_max_bytes) {
+    list = &pool_lists[block->size_class];
+
+    block->next = list->head;
+    list->head = block;
+    list->count++;
+    block = NULL;
+  }
+  g_mutex_unlock (&pool_lock);
+
+  if (block) {
+    g_atomic_pointer_add (&stat_cached, -(gssize) block->length);
+    _block_free (block);
+  }
+}
+
+/**
+ * @brief Create new memory with given block.
+ */
+static GstTensorAllocMemory *
+_mem_new (GstAllocator * allocator, GstMemoryFlags flags, GstMemory * parent,
+    GstTensorBlock * block, guint8 * data, gsize maxsize, gsize align,
+    gsize offset, gsize size)
+{
+  GstTensorAllocMemory *mem = g_new (GstTensorAllocMemory, 1);
+
+  gst_memory_init (GST_MEMORY_CAST (mem), flags, allocator, parent, maxsize,
+      align, offset, size);
+  mem->block = block;
+  mem->data = data;
+
+  return mem;
+}
+
 /**
  * @brief   allocation wrapper that binds alignment parameter
  */
 static GstMemory *
 _alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
 {
-  GstAllocator *sysmem_alloc;
-  GstAllocatorClass *sysmem_aclass;
-  GstAllocationParams *_params;
-  GstMemory *mem;
+  GstTensorBlockCache *cache;
+  GstTensorBlock *block;
+  GstTensorAllocMemory *mem;
+  gsize align, maxsize, aoffset;
+  guint8 *data;
 
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
-  sysmem_aclass = GST_ALLOCATOR_GET_CLASS (sysmem_alloc);
-  _params = gst_allocation_params_copy (params);
-  _params->align = gst_tensor_allocator_alignment;
+  cache = _cache_get ();
+  align = params->align | gst_memory_alignment | cache->conf.alignment;
+  maxsize = size + params->prefix + params->padding;
 
-  mem = sysmem_aclass->alloc (allocator, size, _params);
+  block = _block_acquire (cache, BLOCK_HEADER_SIZE + maxsize + align);
+  if (block == NULL)
+    return NULL;
 
-  gst_allocation_params_free (_params);
-  gst_object_unref (sysmem_alloc);
-  return mem;
+  data = (guint8 *) block + BLOCK_HEADER_SIZE;
+  if ((aoffset = ((guintptr) data & align)))
+    data += (align + 1) - aoffset;
+
+  mem = _mem_new (allocator, params->flags, NULL, block, data, maxsize, align,
+      params->prefix, size);
+
+  if (params->prefix && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED))
+    memset (data, 0, params->prefix);
+  if (params->padding && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED))
+    memset (data + params->prefix + size, 0, params->padding);
+
+  return GST_MEMORY_CAST (mem);
+}
+
+/**
+ * @brief   free the memory, the block returns to the pool
+ */
+static void
+_free (GstAllocator * allocator, GstMemory * memory)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+
+  if (mem->block)
+    _block_release (mem->block);
+
+  g_free (mem);
+}
+
+/**
+ * @brief   map the memory
+ */
+static gpointer
+_mem_map (GstMemory * memory, gsize maxsize, GstMapFlags flags)
+{
+  return ((GstTensorAllocMemory *) memory)->data;
+}
+
+/**
+ * @brief   unmap the memory
+ */
+static void
+_mem_unmap (GstMemory * memory)
+{
+  /* nothing to do */
+}
+
+/**
+ * @brief   copy the memory
+ */
+static GstMemory *
+_mem_copy (GstMemory * memory, gssize offset, gssize size)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+  GstAllocationParams params = { 0, memory->align, 0, 0, };
+  GstMemory *copy;
+  GstMapInfo map;
+
+  if (size == -1)
+    size = (gssize) memory->size > offset ? (gssize) memory->size - offset : 0;
+
+  copy = gst_allocator_alloc (memory->allocator, size, &params);
+  if (copy == NULL)
+    return NULL;
+
+  if (gst_memory_map (copy, &map, GST_MAP_WRITE)) {
+    memcpy (map.data, mem->data + memory->offset + offset, size);
+    gst_memory_unmap (copy, &map);
+  }
+
+  return copy;
+}
+
+/**
+ * @brief   share the memory, sub-memory refers the block of the parent
+ */
+static GstMemory *
+_mem_share (GstMemory * memory, gssize offset, gssize size)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+  GstTensorAllocMemory *sub;
+  GstMemory *parent;
+
+  if ((parent = memory->parent) == NULL)
+    parent = memory;
+
+  if (size == -1)
+    size = memory->size - offset;
+
+  sub = _mem_new (memory->allocator,
+      GST_MINI_OBJECT_FLAGS (parent) | GST_MINI_OBJECT_FLAG_LOCK_READONLY,
+      parent, NULL, mem->data, memory->maxsize, memory->align,
+      memory->offset + offset, size);
+
+  return GST_MEMORY_CAST (sub);
+}
+
+/**
+ * @brief   check the memories are contiguous
+ */
+static gboolean
+_mem_is_span (GstMemory * mem1, GstMemory * mem2, gsize * offset)
+{
+  GstTensorAllocMemory *m1 = (GstTensorAllocMemory *) mem1;
+  GstTensorAllocMemory *m2 = (GstTensorAllocMemory *) mem2;
+
+  if (offset) {
+    GstMemory *parent = mem1->parent;
+    *offset = mem1->offset - parent->offset;
+  }
+
+  return (m1->data + mem1->offset + mem1->size == m2->data + mem2->offset);
 }
 
 /**
@@ -67,17 +612,12 @@ _alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
 static void
 gst_tensor_allocator_class_init (GstTensorAllocatorClass * klass)
 {
-  GstAllocatorClass *allocator_class, *sysmem_aclass;
-  GstAllocator *sysmem_alloc;
+  GstAllocatorClass *allocator_class;
 
   allocator_class = (GstAllocatorClass *) klass;
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
-  sysmem_aclass = GST_ALLOCATOR_GET_CLASS (sysmem_alloc);
 
   allocator_class->alloc = _alloc;
-  allocator_class->free = sysmem_aclass->free;
-
-  gst_object_unref (sysmem_alloc);
+  allocator_class->free = _free;
 }
 
 /**
@@ -86,34 +626,48 @@ gst_tensor_allocator_class_init (GstTensorAllocatorClass * klass)
 static void
 gst_tensor_allocator_init (GstTensorAllocator * allocator)
 {
-  GstAllocator *sysmem_alloc, *alloc;
+  GstAllocator *alloc;
 
   alloc = GST_ALLOCATOR_CAST (allocator);
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
 
-  alloc->mem_type = sysmem_alloc->mem_type;
-  alloc->mem_map = sysmem_alloc->mem_map;
-  alloc->mem_unmap = sysmem_alloc->mem_unmap;
-  alloc->mem_copy = sysmem_alloc->mem_copy;
-  alloc->mem_share = sysmem_alloc->mem_share;
-  alloc->mem_is_span = sysmem_alloc->mem_is_span;
-
-  gst_object_unref (sysmem_alloc);
+  /* the memory is accessible as system memory */
+  alloc->mem_type = GST_ALLOCATOR_SYSMEM;
+  alloc->mem_map = _mem_map;
+  alloc->mem_unmap = _mem_unmap;
+  alloc->mem_copy = _mem_copy;
+  alloc->mem_share = _mem_share;
+  alloc->mem_is_span = _mem_is_span;
 }
 
 /**
- * @brief set alignment that default allocator would align to
- * @param alignment bytes of alignment
+ * @brief Public function defined in the header.
  */
 void
-gst_tensor_alloc_init (gsize alignment)
+gst_tensor_alloc_configure (const GstTensorAllocConfig * config)
 {
   GstAllocator *allocator;
+  GstTensorBlockList released[SIZE_CLASS_NUM];
+  guint i;
+
+  g_return_if_fail (config != NULL);
+
+  g_mutex_lock (&pool_lock);
+  alloc_conf = *config;
+  if (alloc_conf.pool_max_bytes == 0)
+    alloc_conf.pool_max_bytes = DEFAULT_POOL_MAX_BYTES;
 
-  gst_tensor_allocator_alignment = alignment;
+  /* blocks of previous configuration are freed when released */
+  g_atomic_int_inc (&pool_generation);
+  memcpy (released, pool_lists, sizeof (pool_lists));
+  memset (pool_lists, 0, sizeof (pool_lists));
+  g_mutex_unlock (&pool_lock);
 
-  /* no alignment */
-  if (alignment == 0) {
+  for (i = 0; i < SIZE_CLASS_NUM; i++)
+    _block_list_free (&released[i]);
+
+  /* use system memory allocator if nothing is configured */
+  if (config->alignment == 0 && !config->pool &&
+      config->hugepage == TENSOR_ALLOC_HUGEPAGE_NONE && config->numa_node < 0) {
     gst_allocator_set_default (gst_allocator_find (GST_ALLOCATOR_SYSMEM));
     return;
   }
@@ -126,3 +680,90 @@ gst_tensor_alloc_init (gsize alignment)
   }
   gst_allocator_set_default (allocator);
 }
+
+/**
+ * @brief Public function defined in the header.
+ */
+void
+gst_tensor_alloc_init_from_conf (void)
+{
+  GstTensorAllocConfig config;
+  gchar *str;
+
+  _conf_snapshot (&config);
+
+  str = nnsconf_get_custom_value_string ("allocator", "alignment");
+  if (str) {
+    guint64 bytes = g_ascii_strtoull (str, NULL, 10);
+
+    /* alignment in bytes (power of 2) to the mask */
+    config.alignment = (bytes > 1) ? (gsize) (bytes - 1) : 0;
+    g_free (str);
+  }
+
+  config.pool = nnsconf_get_custom_value_bool ("allocator", "pool", FALSE);
+
+  str = nnsconf_get_custom_value_string ("allocator", "pool_max_bytes");
+  if (str) {
+    config.pool_max_bytes = (gsize) g_ascii_strtoull (str, NULL, 10);
+    g_free (str);
+  }
+
+  str = nnsconf_get_custom_value_string ("allocator", "hugepage");
+  if (str) {
+    if (g_ascii_strcasecmp (str, "thp") == 0)
+      config.hugepage = TENSOR_ALLOC_HUGEPAGE_THP;
+    else if (g_ascii_strcasecmp (str, "hugetlb") == 0)
+      config.hugepage = TENSOR_ALLOC_HUGEPAGE_HUGETLB;
+    else
+      config.hugepage = TENSOR_ALLOC_HUGEPAGE_NONE;
+    g_free (str);
+  }
+
+  str = nnsconf_get_custom_value_string ("allocator", "numa_node");
+  if (str) {
+    config.numa_node = (gint) g_ascii_strtoll (str, NULL, 10);
+    g_free (str);
+  }
+
+  /* do not change the default allocator if nothing is configured */
+  if (config.alignment == 0 && !config.pool &&
+      config.hugepage == TENSOR_ALLOC_HUGEPAGE_NONE && config.numa_node < 0)
+    return;
+
+  gst_tensor_alloc_configure (&config);
+}
+
+/**
+ * @brief set alignment that default allocator would align to
+ * @param alignment bytes of alignment
+ */
+void
+gst_tensor_alloc_init (gsize alignment)
+{
+  GstTensorAllocConfig config;
+
+  _conf_snapshot (&config);
+  config.alignment = alignment;
+  gst_tensor_alloc_configure (&config);
+}
+
+/**
+ * @brief Public function defined in the header.
+ */
+GstStructure *
+gst_tensor_alloc_get_stats (void)
+{
+  GstTensorAllocConfig config;
+
+  _conf_snapshot (&config);
+
+  return gst_structure_new ("tensor-allocator-stats",
+      "pool", G_TYPE_BOOLEAN, config.pool,
+      "hits", G_TYPE_UINT64, (guint64) (guintptr) g_atomic_pointer_get (&stat_hits),
+      "misses", G_TYPE_UINT64, (guint64) (guintptr) g_atomic_pointer_get (&stat_misses),
+      "bytes-outstanding", G_TYPE_INT64,
+      (gint64) (gintptr) g_atomic_pointer_get (&stat_outstanding),
+      "bytes-cached", G_TYPE_INT64,
+      (gint64) (gintptr) g_atomic_pointer_get (&stat_cached), NULL);
+}
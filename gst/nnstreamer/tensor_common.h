@@ -267,6 +267,74 @@ gst_tensor_aggregation_clear_all (GHashTable * table);
 extern GstAdapter *
 gst_tensor_aggregation_get_adapter (GHashTable * table, const guint32 key);
 
+/**
+ * @brief Backing memory of the large blocks in GstTensorAllocator.
+ */
+typedef enum
+{
+  TENSOR_ALLOC_HUGEPAGE_NONE = 0, /**< normal pages */
+  TENSOR_ALLOC_HUGEPAGE_THP, /**< transparent hugepages with madvise() */
+  TENSOR_ALLOC_HUGEPAGE_HUGETLB, /**< MAP_HUGETLB, fallback to normal pages */
+} tensor_alloc_hugepage;
+
+/**
+ * @brief Configuration of GstTensorAllocator.
+ */
+typedef struct
+{
+  gsize alignment; /**< alignment mask (bytes - 1), 0 for default alignment */
+  gboolean pool; /**< TRUE to reuse the released blocks */
+  gsize pool_max_bytes; /**< max bytes of the blocks kept in the shared free lists */
+  tensor_alloc_hugepage hugepage; /**< backing pages of the large blocks */
+  gint numa_node; /**< preferred NUMA node of the large blocks, -1 to disable */
+} GstTensorAllocConfig;
+
+/**
+ * @brief Configures the default tensor allocator. Cached blocks of previous configuration are released.
+ * @param config the allocator configuration
+ */
+extern void
+gst_tensor_alloc_configure (const GstTensorAllocConfig * config);
+
+/**
+ * @brief Configures the default tensor allocator with [allocator] section of nnstreamer.ini.
+ */
+extern void
+gst_tensor_alloc_init_from_conf (void);
+
+/**
+ * @brief Function to process the tile [start, end) of a tensor.
+ */
+typedef void (*GstTensorTileFunc) (gsize start, gsize end, gpointer user_data);
+
+/**
+ * @brief Create the thread pool to process the tiles of a tensor.
+ * @param num_threads the number of threads including the caller of gst_tensor_tile_run()
+ * @return Newly created thread pool. NULL if num_threads is less than 2 or failed to create the pool, then the tiles are processed in the caller.
+ */
+extern GThreadPool *
+gst_tensor_tile_pool_new (guint num_threads);
+
+/**
+ * @brief Release the thread pool, waiting for the tiles in process.
+ * @param pool the thread pool created with gst_tensor_tile_pool_new(), can be NULL
+ */
+extern void
+gst_tensor_tile_pool_free (GThreadPool * pool);
+
+/**
+ * @brief Split [0, total) into the tiles and process them with the thread pool.
+ * @details The first tile is processed in the caller, which returns when all tiles are processed. Each tile should write the disjoint region of the output, thus the result does not depend on the number of threads.
+ * @param pool the thread pool created with gst_tensor_tile_pool_new(). If NULL, the whole range is processed in the caller.
+ * @param func function to process the tiles
+ * @param total the number of units to be processed
+ * @param tile_size the number of units in a tile
+ * @param user_data private data for the function
+ */
+extern void
+gst_tensor_tile_run (GThreadPool * pool, GstTensorTileFunc func, gsize total,
+    gsize tile_size, gpointer user_data);
+
 /******************************************************
  ************ Commonly used debugging macros **********
  ******************************************************
@@ -119,6 +119,51 @@ G_DEFINE_TYPE (GstTensorFilter, gst_tensor_filter, GST_TYPE_BASE_TRANSFORM);
  */
 #define LATENCY_REPORT_THRESHOLD 0.25
 
+/**
+ * @brief The max number of free memory blocks kept for each size in the output pool.
+ */
+#define OUTPUT_POOL_MAX_FREE (32)
+
+/**
+ * @brief Data structure for the free memory blocks of the same size.
+ */
+typedef struct
+{
+  gsize size; /**< size of the memory blocks */
+  GQueue free; /**< free memory blocks to be reused */
+} GstTensorFilterMemBucket;
+
+/**
+ * @brief Data structure for the pool of output memory blocks.
+ * @details The memory allocated from the pool returns to the pool when its refcount
+ *          reaches 0 (mini-object dispose), so the steady-state invoke does not
+ *          allocate the output memory. The pool is refcounted by the memory blocks
+ *          and may outlive tensor_filter.
+ */
+struct _GstTensorFilterMemPool
+{
+  gint refcount; /**< reference count */
+  GMutex lock; /**< lock for the buckets and statistics */
+  gboolean active; /**< FALSE to free the released memory blocks */
+  GArray *buckets; /**< array of GstTensorFilterMemBucket */
+
+  guint64 allocated; /**< the number of memory blocks newly allocated */
+  guint64 reused; /**< the number of allocations served by the free memory blocks */
+  guint64 recycled; /**< the number of released memory blocks kept in the pool */
+  guint64 discarded; /**< the number of released memory blocks freed */
+};
+
+static GQuark gst_tensor_filter_pool_quark;
+
+static GstTensorFilterMemPool *gst_tensor_filter_pool_new (void);
+static void gst_tensor_filter_pool_unref (gpointer data);
+static void gst_tensor_filter_pool_set_active (GstTensorFilterMemPool * pool,
+    gboolean active);
+static GstStructure *gst_tensor_filter_pool_get_stats (GstTensorFilterMemPool *
+    pool);
+static GstStructure *gst_tensor_filter_get_invoke_stats (GstTensorFilterPrivate
+    * priv);
+
 /* GObject vmethod implementations */
 static void gst_tensor_filter_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -146,6 +191,10 @@ static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
     GstEvent * event);
 static gboolean gst_tensor_filter_src_event (GstBaseTransform * trans,
     GstEvent * event);
+static GstFlowReturn gst_tensor_filter_submit_input_buffer (GstBaseTransform *
+    trans, gboolean is_discont, GstBuffer * inbuf);
+static GstFlowReturn gst_tensor_filter_generate_output (GstBaseTransform *
+    trans, GstBuffer ** outbuf);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -160,6 +209,9 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_tensor_filter_debug, "tensor_filter", 0,
       "Tensor filter to invoke neural network model");
 
+  gst_tensor_filter_pool_quark =
+      g_quark_from_static_string ("GstTensorFilterMemPool");
+
   trans_class = (GstBaseTransformClass *) klass;
   gstelement_class = (GstElementClass *) trans_class;
   gobject_class = (GObjectClass *) gstelement_class;
@@ -170,6 +222,50 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   gst_tensor_filter_install_properties (gobject_class);
 
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The max number of incoming frames stacked along the outermost axis "
+          "for a single invoke. Output tensors are split back into per-frame "
+          "buffers. If the framework does not support batched invoke, "
+          "tensor_filter falls back to per-frame invoke. 1 disables batching.",
+          1, G_MAXUINT, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_BATCH_LATENCY,
+      g_param_spec_uint64 ("max-batch-latency", "Max batch latency",
+          "The max duration in microseconds the oldest pending frame waits "
+          "for the batch to be filled. When this duration elapses, the "
+          "pending frames are invoked without waiting for 'batch-size' "
+          "frames. 0 waits until the batch is full.",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INFLIGHT_REQUESTS,
+      g_param_spec_uint ("inflight-requests", "In-flight requests",
+          "The max number of frames being invoked asynchronously. The next "
+          "frame is prepared while the previous frames are being invoked, "
+          "and the results are pushed in arrival order by another thread. "
+          "0 invokes the model synchronously in the streaming thread.",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUM_INSTANCES,
+      g_param_spec_uint ("num-instances", "Number of instances",
+          "The number of framework instances opened with the same model. "
+          "Incoming frames are dispatched to the idle instance and invoked "
+          "in parallel, and the results are pushed in arrival order. "
+          "'inflight-requests' is raised to this value if it is smaller.",
+          1, 64, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_STATS,
+      g_param_spec_boxed ("output-pool-stats", "Output pool statistics",
+          "The statistics of the output memory pool: the number of memory "
+          "blocks allocated, reused, recycled (returned to the pool), "
+          "discarded (freed when released) and currently free in the pool",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_STATS,
+      g_param_spec_boxed ("invoke-stats", "Invoke statistics",
+          "The latency of each stage of the invoke measured with monotonic "
+          "time (usec): preparing the tensors (prepare), the invoke of the "
+          "subplugin (invoke) and appending the output tensors (finish). "
+          "Each stage has the count, average, p50, p95, p99 and max. The "
+          "statistics of the framework shared across the instances are "
+          "included if the subplugin provides them.",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorFilter",
       "Filter/Tensor",
@@ -186,6 +282,10 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->submit_input_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_submit_input_buffer);
+  trans_class->generate_output =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_generate_output);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -225,6 +325,59 @@ gst_tensor_filter_init (GstTensorFilter * self)
   self->prev_ts = GST_CLOCK_TIME_NONE;
   self->throttling_delay = 0;
   self->throttling_accum = 0;
+
+  /* init micro-batching */
+  self->batch.size = 1;
+  self->batch.max_latency = 0;
+  self->batch.enabled = FALSE;
+  self->batch.first_arrival = 0;
+  self->batch.flusher = NULL;
+  self->batch.running = FALSE;
+  self->batch.pushing = FALSE;
+  self->batch.last_ret = GST_FLOW_OK;
+  g_mutex_init (&self->batch.lock);
+  g_cond_init (&self->batch.cond);
+  g_queue_init (&self->batch.pending);
+  g_queue_init (&self->batch.outputs);
+
+  /* init asynchronous invoke */
+  self->async.depth = 0;
+  self->async.num_instances = 1;
+  self->async.limit = 0;
+  self->async.enabled = FALSE;
+  self->async.native = FALSE;
+  self->async.in_flexible = FALSE;
+  self->async.workers = NULL;
+  self->async.num_workers = 0;
+  self->async.pusher = NULL;
+  self->async.running = FALSE;
+  self->async.flushing = FALSE;
+  self->async.last_ret = GST_FLOW_OK;
+  g_mutex_init (&self->async.lock);
+  g_cond_init (&self->async.cond);
+  g_queue_init (&self->async.requests);
+
+  self->out_pool = gst_tensor_filter_pool_new ();
+}
+
+/**
+ * @brief Release the pending input and output buffers of micro-batching.
+ */
+static void
+gst_tensor_filter_batch_clear (GstTensorFilter * self)
+{
+  GstBuffer *buf;
+
+  g_mutex_lock (&self->batch.lock);
+  while ((buf = g_queue_pop_head (&self->batch.pending)) != NULL)
+    gst_buffer_unref (buf);
+
+  while ((buf = g_queue_pop_head (&self->batch.outputs)) != NULL)
+    gst_buffer_unref (buf);
+
+  self->batch.first_arrival = 0;
+  self->batch.last_ret = GST_FLOW_OK;
+  g_mutex_unlock (&self->batch.lock);
 }
 
 /**
@@ -239,9 +392,18 @@ gst_tensor_filter_finalize (GObject * object)
   self = GST_TENSOR_FILTER (object);
   priv = &self->priv;
 
+  gst_tensor_filter_batch_clear (self);
   gst_tensor_filter_common_close_fw (priv);
   gst_tensor_filter_common_free_property (priv);
 
+  g_mutex_clear (&self->batch.lock);
+  g_cond_clear (&self->batch.cond);
+  g_mutex_clear (&self->async.lock);
+  g_cond_clear (&self->async.cond);
+
+  gst_tensor_filter_pool_set_active (self->out_pool, FALSE);
+  gst_tensor_filter_pool_unref (self->out_pool);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -290,11 +452,43 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Setting property for prop %d.\n", prop_id);
 
-  if (prop_id == PROP_CONFIG) {
-    g_free (priv->config_path);
-    priv->config_path = g_strdup (g_value_get_string (value));
-    gst_tensor_parse_config_file (priv->config_path, object);
-    return;
+  switch (prop_id) {
+    case PROP_CONFIG:
+      g_free (priv->config_path);
+      priv->config_path = g_strdup (g_value_get_string (value));
+      gst_tensor_parse_config_file (priv->config_path, object);
+      return;
+    case PROP_BATCH_SIZE:
+      self->batch.size = g_value_get_uint (value);
+      return;
+    case PROP_MAX_BATCH_LATENCY:
+      g_mutex_lock (&self->batch.lock);
+      self->batch.max_latency = g_value_get_uint64 (value);
+      g_cond_signal (&self->batch.cond);
+      g_mutex_unlock (&self->batch.lock);
+      return;
+    case PROP_INFLIGHT_REQUESTS:
+      self->async.depth = g_value_get_uint (value);
+      return;
+    case PROP_NUM_INSTANCES:
+      self->async.num_instances = g_value_get_uint (value);
+      return;
+    case PROP_MODEL:
+    case PROP_INPUTLAYOUT:
+    case PROP_OUTPUTLAYOUT:
+    case PROP_CUSTOM:
+    case PROP_ACCELERATOR:
+      /* the update only reaches the primary framework instance */
+      if (self->async.num_workers > 1) {
+        ml_loge
+            ("Cannot update the property '%s' while tensor_filter (%s) runs %u framework instances (num-instances). Update it in NULL or READY state.",
+            pspec->name, GST_STR_NULL (priv->prop.fwname),
+            self->async.num_workers);
+        return;
+      }
+      break;
+    default:
+      break;
   }
 
   if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
@@ -316,9 +510,31 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Getting property for prop %d.\n", prop_id);
 
-  if (prop_id == PROP_CONFIG) {
-    g_value_set_string (value, priv->config_path ? priv->config_path : "");
-    return;
+  switch (prop_id) {
+    case PROP_CONFIG:
+      g_value_set_string (value, priv->config_path ? priv->config_path : "");
+      return;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, self->batch.size);
+      return;
+    case PROP_MAX_BATCH_LATENCY:
+      g_value_set_uint64 (value, self->batch.max_latency);
+      return;
+    case PROP_INFLIGHT_REQUESTS:
+      g_value_set_uint (value, self->async.depth);
+      return;
+    case PROP_NUM_INSTANCES:
+      g_value_set_uint (value, self->async.num_instances);
+      return;
+    case PROP_OUTPUT_POOL_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_filter_pool_get_stats (self->out_pool));
+      return;
+    case PROP_INVOKE_STATS:
+      g_value_take_boxed (value, gst_tensor_filter_get_invoke_stats (priv));
+      return;
+    default:
+      break;
   }
 
   if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
@@ -359,13 +575,268 @@ gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
       gst_tensor_filter_destroy_notify);
 }
 
+/**
+ * @brief Create a new pool of output memory blocks.
+ */
+static GstTensorFilterMemPool *
+gst_tensor_filter_pool_new (void)
+{
+  GstTensorFilterMemPool *pool = g_new0 (GstTensorFilterMemPool, 1);
+
+  pool->refcount = 1;
+  pool->active = TRUE;
+  g_mutex_init (&pool->lock);
+  pool->buckets = g_array_new (FALSE, FALSE, sizeof (GstTensorFilterMemBucket));
+
+  return pool;
+}
+
+/**
+ * @brief Increase the refcount of the pool.
+ */
+static GstTensorFilterMemPool *
+gst_tensor_filter_pool_ref (GstTensorFilterMemPool * pool)
+{
+  g_atomic_int_inc (&pool->refcount);
+  return pool;
+}
+
+/**
+ * @brief Decrease the refcount of the pool and free it if the refcount reaches 0.
+ * @note All free memory blocks hold the refcount, thus the buckets are empty here.
+ */
+static void
+gst_tensor_filter_pool_unref (gpointer data)
+{
+  GstTensorFilterMemPool *pool = (GstTensorFilterMemPool *) data;
+
+  if (!g_atomic_int_dec_and_test (&pool->refcount))
+    return;
+
+  g_array_free (pool->buckets, TRUE);
+  g_mutex_clear (&pool->lock);
+  g_free (pool);
+}
+
+/**
+ * @brief Find the bucket of the given size.
+ * @note Caller should hold the lock of the pool.
+ */
+static GstTensorFilterMemBucket *
+gst_tensor_filter_pool_find_bucket (GstTensorFilterMemPool * pool, gsize size,
+    gboolean create)
+{
+  GstTensorFilterMemBucket *bucket;
+  guint i;
+
+  for (i = 0; i < pool->buckets->len; i++) {
+    bucket = &g_array_index (pool->buckets, GstTensorFilterMemBucket, i);
+    if (bucket->size == size)
+      return bucket;
+  }
+
+  if (!create)
+    return NULL;
+
+  g_array_set_size (pool->buckets, pool->buckets->len + 1);
+  bucket = &g_array_index (pool->buckets, GstTensorFilterMemBucket,
+      pool->buckets->len - 1);
+  bucket->size = size;
+  g_queue_init (&bucket->free);
+
+  return bucket;
+}
+
+/**
+ * @brief Mini-object dispose function of the memory from the pool.
+ * @return FALSE if the memory is returned to the pool, TRUE to free it.
+ */
+static gboolean
+gst_tensor_filter_pool_dispose (GstMiniObject * obj)
+{
+  GstMemory *mem = GST_MEMORY_CAST (obj);
+  GstTensorFilterMemPool *pool;
+  GstTensorFilterMemBucket *bucket = NULL;
+  gboolean recycle = FALSE;
+
+  pool = (GstTensorFilterMemPool *) gst_mini_object_get_qdata (obj,
+      gst_tensor_filter_pool_quark);
+  if (pool == NULL)
+    return TRUE;
+
+  g_mutex_lock (&pool->lock);
+  /* reuse the memory only if it is not resized or restricted by others */
+  if (pool->active && mem->offset == 0 && !GST_MEMORY_IS_READONLY (mem)) {
+    bucket = gst_tensor_filter_pool_find_bucket (pool, mem->size, FALSE);
+    recycle = (bucket != NULL &&
+        g_queue_get_length (&bucket->free) < OUTPUT_POOL_MAX_FREE);
+  }
+
+  if (recycle) {
+    /* keep the memory alive in the pool */
+    gst_memory_ref (mem);
+    g_queue_push_tail (&bucket->free, mem);
+    pool->recycled++;
+  } else {
+    pool->discarded++;
+  }
+  g_mutex_unlock (&pool->lock);
+
+  return !recycle;
+}
+
+/**
+ * @brief Get a memory block of the given size from the pool.
+ * @return Newly allocated or reused memory. NULL if failed to allocate.
+ */
+static GstMemory *
+gst_tensor_filter_pool_alloc (GstTensorFilterMemPool * pool, gsize size)
+{
+  GstTensorFilterMemBucket *bucket;
+  GstMemory *mem;
+
+  g_mutex_lock (&pool->lock);
+  bucket = gst_tensor_filter_pool_find_bucket (pool, size, TRUE);
+  mem = (GstMemory *) g_queue_pop_head (&bucket->free);
+  if (mem)
+    pool->reused++;
+  g_mutex_unlock (&pool->lock);
+
+  if (mem)
+    return mem;
+
+  /* the default allocator, aligned if nnstreamer is configured to */
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  if (mem == NULL)
+    return NULL;
+
+  gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem),
+      gst_tensor_filter_pool_quark, gst_tensor_filter_pool_ref (pool),
+      gst_tensor_filter_pool_unref);
+  GST_MINI_OBJECT_CAST (mem)->dispose = gst_tensor_filter_pool_dispose;
+
+  g_mutex_lock (&pool->lock);
+  pool->allocated++;
+  g_mutex_unlock (&pool->lock);
+
+  return mem;
+}
+
+/**
+ * @brief Activate or deactivate the pool. Free memory blocks are released when deactivated.
+ */
+static void
+gst_tensor_filter_pool_set_active (GstTensorFilterMemPool * pool,
+    gboolean active)
+{
+  GstTensorFilterMemBucket *bucket;
+  GQueue released = G_QUEUE_INIT;
+  GstMemory *mem;
+  guint i;
+
+  g_mutex_lock (&pool->lock);
+  pool->active = active;
+
+  if (!active) {
+    for (i = 0; i < pool->buckets->len; i++) {
+      bucket = &g_array_index (pool->buckets, GstTensorFilterMemBucket, i);
+      while ((mem = (GstMemory *) g_queue_pop_head (&bucket->free)) != NULL)
+        g_queue_push_tail (&released, mem);
+    }
+    g_array_set_size (pool->buckets, 0);
+  }
+  g_mutex_unlock (&pool->lock);
+
+  /* dispose function frees the memory since the pool is inactive */
+  while ((mem = (GstMemory *) g_queue_pop_head (&released)) != NULL)
+    gst_memory_unref (mem);
+}
+
+/**
+ * @brief Get the statistics of the pool.
+ */
+static GstStructure *
+gst_tensor_filter_pool_get_stats (GstTensorFilterMemPool * pool)
+{
+  GstTensorFilterMemBucket *bucket;
+  GstStructure *stats;
+  guint i, num_free = 0;
+
+  g_mutex_lock (&pool->lock);
+  for (i = 0; i < pool->buckets->len; i++) {
+    bucket = &g_array_index (pool->buckets, GstTensorFilterMemBucket, i);
+    num_free += g_queue_get_length (&bucket->free);
+  }
+
+  stats = gst_structure_new ("output-pool-stats",
+      "allocated", G_TYPE_UINT64, pool->allocated,
+      "reused", G_TYPE_UINT64, pool->reused,
+      "recycled", G_TYPE_UINT64, pool->recycled,
+      "discarded", G_TYPE_UINT64, pool->discarded,
+      "free", G_TYPE_UINT, num_free, NULL);
+  g_mutex_unlock (&pool->lock);
+
+  return stats;
+}
+
+/**
+ * @brief Get the latency statistics of each invoke stage and the framework.
+ */
+static GstStructure *
+gst_tensor_filter_get_invoke_stats (GstTensorFilterPrivate * priv)
+{
+  static const gchar *stage_names[GST_TF_STAGE_MAX] = {
+    "prepare", "invoke", "finish"
+  };
+  GstTensorFilterLatencyHistogram *hist;
+  GstTensorFilterFrameworkStatistics fw_stats;
+  GstStructure *stats;
+  guint64 count, total, max;
+  guint i;
+
+  stats = gst_structure_new_empty ("invoke-stats");
+
+  for (i = 0; i < GST_TF_STAGE_MAX; i++) {
+    g_autofree gchar *f_count = g_strdup_printf ("%s-count", stage_names[i]);
+    g_autofree gchar *f_avg = g_strdup_printf ("%s-avg", stage_names[i]);
+    g_autofree gchar *f_p50 = g_strdup_printf ("%s-p50", stage_names[i]);
+    g_autofree gchar *f_p95 = g_strdup_printf ("%s-p95", stage_names[i]);
+    g_autofree gchar *f_p99 = g_strdup_printf ("%s-p99", stage_names[i]);
+    g_autofree gchar *f_max = g_strdup_printf ("%s-max", stage_names[i]);
+
+    hist = &priv->stat.stages[i];
+    gst_tensor_filter_histogram_get_summary (hist, &count, &total, &max);
+
+    gst_structure_set (stats,
+        f_count, G_TYPE_UINT64, count,
+        f_avg, G_TYPE_DOUBLE, (count > 0) ? (gdouble) total / count : 0.0,
+        f_p50, G_TYPE_UINT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 50.0),
+        f_p95, G_TYPE_UINT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 95.0),
+        f_p99, G_TYPE_UINT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 99.0),
+        f_max, G_TYPE_UINT64, max, NULL);
+  }
+
+  if (gst_tensor_filter_framework_statistics_get (priv, &fw_stats)) {
+    gst_structure_set (stats,
+        "framework-invoke-num", G_TYPE_INT64, fw_stats.total_invoke_num,
+        "framework-invoke-latency", G_TYPE_INT64, fw_stats.total_invoke_latency,
+        "framework-overhead-latency", G_TYPE_INT64,
+        fw_stats.total_overhead_latency, NULL);
+  }
+
+  return stats;
+}
+
 /**
  * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
  */
 static void
 prepare_statistics (GstTensorFilterPrivate * priv)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
+  priv->stat.latest_invoke_time = g_get_monotonic_time ();
 }
 
 /**
@@ -389,7 +860,7 @@ accumulate_latency (void *data, void *user_data)
 static void
 record_statistics (GstTensorFilterPrivate * priv)
 {
-  gint64 end_time = g_get_real_time ();
+  gint64 end_time = g_get_monotonic_time ();
   gint64 *latency;
   GQueue *recent_latencies = priv->stat.recent_latencies;
 
@@ -563,13 +1034,11 @@ gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
 }
 
 /**
- * @brief Check input paramters for gst_tensor_filter_transform ();
+ * @brief Check the configuration and the framework to invoke the model.
  */
 static GstFlowReturn
-_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+_gst_tensor_filter_invoke_validate (GstTensorFilter * self)
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
   GstTensorFilterPrivate *priv = &self->priv;
   GstTensorFilterProperties *prop = &priv->prop;
 
@@ -616,6 +1085,25 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
   silent_debug (self, "Invoking %s with %s model\n", priv->fw->name,
       GST_STR_NULL (prop->model_files[0]));
 
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Check input paramters for gst_tensor_filter_transform ();
+ */
+static GstFlowReturn
+_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstFlowReturn retval;
+
+  retval = _gst_tensor_filter_invoke_validate (self);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
   /* skip input data when throttling delay is set */
   if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
     return GST_BASE_TRANSFORM_FLOW_DROPPED;
@@ -637,52 +1125,97 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
 }
 
 /**
- * @brief non-ip transform. required vmethod of GstBaseTransform.
+ * @brief Data structure for an invoke request of an incoming frame.
  */
-static GstFlowReturn
-gst_tensor_filter_transform (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+typedef struct
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
-  GstTensorFilterPrivate *priv = &self->priv;
-  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilter *self; /**< tensor_filter instance which owns this request */
+  GstBuffer *inbuf; /**< input buffer, holds the input memory and metadata */
+  guint num_tensors; /**< the number of tensors in input buffer */
+  gboolean allocate_in_invoke; /**< TRUE if the subplugin allocates output memory */
+  gboolean in_flexible; /**< TRUE if input tensors are flexible */
+  gboolean out_flexible; /**< TRUE if output tensors are flexible */
+
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT]; /**< input memory blocks (mapped if not NULL) */
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT]; /**< mapped input memory */
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT]; /**< output memory blocks (mapped if not NULL) */
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT]; /**< mapped output memory */
+
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors */
+  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors to invoke (with input combination) */
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< output tensors */
+
+  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT]; /**< meta of input tensors */
+  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT]; /**< meta of output tensors */
+
+  gint ret; /**< return value of the invoke callback */
+  gboolean invoked; /**< TRUE if the request is taken for invoke (async mode) */
+  gboolean done; /**< TRUE if the invoke is completed (async mode) */
+  gint64 invoke_time; /**< the time when the request is invoked (async mode) */
+} GstTensorFilterRequest;
 
-  /* TODO: Consider malloc in_mem, in_info, etc. rather than take the stack */
-  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
+/**
+ * @brief Release the memory blocks of the request when preparing or invoking is failed.
+ */
+static void
+gst_tensor_filter_request_cleanup (GstTensorFilter * self,
+    GstTensorFilterRequest * req)
+{
+  GstTensorFilterProperties *prop = &self->priv.prop;
+  guint i;
+
+  for (i = 0; i < req->num_tensors; i++) {
+    if (req->in_mem[i]) {
+      gst_memory_unmap (req->in_mem[i], &req->in_info[i]);
+      gst_memory_unref (req->in_mem[i]);
+      req->in_mem[i] = NULL;
+    }
+  }
 
-  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  if (!req->allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      if (req->out_mem[i]) {
+        gst_memory_unmap (req->out_mem[i], &req->out_info[i]);
+        gst_memory_unref (req->out_mem[i]);
+        req->out_mem[i] = NULL;
+      }
+    }
+  }
+}
 
+/**
+ * @brief Map the input tensors of the incoming buffer and prepare output tensors to invoke.
+ * @return GST_FLOW_OK if the request is ready to invoke.
+ */
+static GstFlowReturn
+gst_tensor_filter_request_prepare (GstTensorFilter * self, GstBuffer * inbuf,
+    GstTensorFilterRequest * req)
+{
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
   GList *list;
-  guint i, num_tensors;
-  gint ret;
-  gboolean allocate_in_invoke, in_flexible, out_flexible;
-  gboolean need_profiling;
+  guint i;
   gsize expected, hsize;
+  gint64 start_time = g_get_monotonic_time ();
 
-  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
-
-  GstMemory *mem;
-
-  /* 0. Check all properties. */
-  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
-      outbuf);
-  if (retval != GST_FLOW_OK)
-    return retval;
+  req->self = self;
+  req->inbuf = inbuf;
+  req->ret = 0;
+  req->invoked = FALSE;
+  req->done = FALSE;
+  req->invoke_time = 0;
+  memset (req->in_mem, 0, sizeof (req->in_mem));
+  memset (req->out_mem, 0, sizeof (req->out_mem));
 
-  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  req->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
 
-  in_flexible =
+  req->in_flexible =
       gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
-  out_flexible =
+  req->out_flexible =
       gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
 
-  if (priv->prop.invoke_dynamic && !out_flexible) {
+  if (priv->prop.invoke_dynamic && !req->out_flexible) {
     ml_loge
         ("Dynamic Invoke of tensor filter is activated but the output of tensor filter is static tensors. Currently, only flexible tensors is supported as output of dynamic invoke. If you don't want to dynamic invoke, remove the invoke-dynamic option of tensor filter.");
     return GST_FLOW_ERROR;
@@ -690,26 +1223,30 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
 
   /* 1. Get all input tensors from inbuf. */
   /* Internal Logic Error or GST Bug (sinkcap changed!) */
-  num_tensors = gst_tensor_buffer_get_count (inbuf);
+  req->num_tensors = gst_tensor_buffer_get_count (inbuf);
 
-  for (i = 0; i < num_tensors; i++) {
-    in_mem[i] = gst_tensor_buffer_get_nth_memory (inbuf, i);
-    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+  for (i = 0; i < req->num_tensors; i++) {
+    req->in_mem[i] = gst_tensor_buffer_get_nth_memory (inbuf, i);
+    if (!gst_memory_map (req->in_mem[i], &req->in_info[i], GST_MAP_READ)) {
       ml_logf_stacktrace
           ("gst_tensor_filter_transform: For the given input buffer, tensor-filter (%s : %s) cannot map input memory from the buffer for reading. The %u-th memory chunk (%u-th tensor) has failed for memory map.\n",
           prop->fwname, TF_MODELNAME (prop), i, i);
+      gst_memory_unref (req->in_mem[i]);
+      req->in_mem[i] = NULL;
       goto mem_map_error;
     }
 
     hsize = 0;
-    if (in_flexible) {
-      gst_tensor_meta_info_parse_header (&in_meta[i], in_info[i].data);
-      hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-      gst_tensor_meta_info_convert (&in_meta[i], &prop->input_meta.info[i]);
+    if (req->in_flexible) {
+      gst_tensor_meta_info_parse_header (&req->in_meta[i],
+          req->in_info[i].data);
+      hsize = gst_tensor_meta_info_get_header_size (&req->in_meta[i]);
+      gst_tensor_meta_info_convert (&req->in_meta[i],
+          &prop->input_meta.info[i]);
     }
 
-    in_tensors[i].data = in_info[i].data + hsize;
-    in_tensors[i].size = in_info[i].size - hsize;
+    req->in_tensors[i].data = req->in_info[i].data + hsize;
+    req->in_tensors[i].size = req->in_info[i].size - hsize;
   }
 
   /* 1.1 Prepare tensors to invoke. */
@@ -719,86 +1256,90 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     for (list = priv->combi.in_combi; list != NULL; list = list->next) {
       i = GPOINTER_TO_UINT (list->data);
 
-      if (i >= num_tensors) {
+      if (i >= req->num_tensors) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: Invalid input combination ('input-combination' property) for the tensor-filter (%s:%s). The %u'th combination's index is %u, which is out of bound (>= %u = the number of memory chunks (tensors) of incoming buffer). Because of buffer index inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
-            prop->fwname, TF_MODELNAME (prop), info_idx, i, num_tensors);
+            prop->fwname, TF_MODELNAME (prop), info_idx, i, req->num_tensors);
         goto mem_map_error;
       }
 
       expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
-      if (expected != in_tensors[i].size) {
+      if (expected != req->in_tensors[i].size) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: With the given input combination ('input-combination' property) of the tensor-filter, the incoming buffer size of combination index %u (%u'th combination) is %zd, which is invalid and is expected to be %zd. Because of buffer size inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
-            i, info_idx, in_tensors[i].size, expected);
+            i, info_idx, req->in_tensors[i].size, expected);
         goto mem_map_error;
       }
 
-      invoke_tensors[info_idx++] = in_tensors[i];
+      req->invoke_tensors[info_idx++] = req->in_tensors[i];
     }
   } else {
-    if (num_tensors != prop->input_meta.num_tensors) {
+    if (req->num_tensors != prop->input_meta.num_tensors) {
       ml_loge_stacktrace
           ("gst_tensor_filter_transform: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
-          num_tensors, prop->input_meta.num_tensors);
+          req->num_tensors, prop->input_meta.num_tensors);
       goto mem_map_error;
     }
 
     for (i = 0; i < prop->input_meta.num_tensors; i++) {
       expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
-      if (expected != in_tensors[i].size) {
+      if (expected != req->in_tensors[i].size) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream; if the size is supposed to change dynamically and the given neural network, framework, and the subpluigins can handle it, please consider using format=flexible.\n",
-            i, in_tensors[i].size, expected);
+            i, req->in_tensors[i].size, expected);
         goto mem_map_error;
       }
 
-      invoke_tensors[i] = in_tensors[i];
+      req->invoke_tensors[i] = req->in_tensors[i];
     }
   }
 
   /* 2. Prepare output tensors. */
   for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    out_tensors[i].data = NULL;
-    out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+    req->out_tensors[i].data = NULL;
+    req->out_tensors[i].size =
+        gst_tensor_filter_get_tensor_size (self, i, FALSE);
 
     hsize = 0;
-    if (out_flexible && !priv->prop.invoke_dynamic) {
+    if (req->out_flexible && !priv->prop.invoke_dynamic) {
       gboolean ret = FALSE;
       ret = gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
-          &out_meta[i]);
+          &req->out_meta[i]);
       if (TRUE != ret) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: The configured output tensor information is invalid, at %u'th output tensor\n",
             i);
         goto mem_map_error;
       }
-      hsize = gst_tensor_meta_info_get_header_size (&out_meta[i]);
+      hsize = gst_tensor_meta_info_get_header_size (&req->out_meta[i]);
     }
 
     /* allocate memory if allocate_in_invoke is FALSE */
-    if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
-      if (!out_mem[i]) {
+    if (!req->allocate_in_invoke) {
+      req->out_mem[i] = gst_tensor_filter_pool_alloc (self->out_pool,
+          req->out_tensors[i].size + hsize);
+      if (!req->out_mem[i]) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_allocate_alloc has returned Null. Out of memory?",
-            i, i, out_tensors[i].size + hsize);
+            i, i, req->out_tensors[i].size + hsize);
         goto mem_map_error;
       }
-      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+      if (!gst_memory_map (req->out_mem[i], &req->out_info[i], GST_MAP_WRITE)) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: For the given output buffer, allocated by gst_tensor_filter_transform, it cannot map output memory buffer for the %u'th memory chunk (%u'th output tensor) for write.\n",
             i, i);
+        /* not mapped, the cleanup unmaps the memory blocks in the request only */
+        gst_memory_unref (req->out_mem[i]);
+        req->out_mem[i] = NULL;
         goto mem_map_error;
       }
 
-      out_tensors[i].data = out_info[i].data + hsize;
+      req->out_tensors[i].data = req->out_info[i].data + hsize;
 
       /* append header */
-      if (out_flexible) {
+      if (req->out_flexible) {
         if (FALSE == gst_tensor_meta_info_update_header
-            (&out_meta[i], out_info[i].data)) {
+            (&req->out_meta[i], req->out_info[i].data)) {
           ml_loge_stacktrace
               ("gst_tensor_meta_info_update_header() has failed to update header for flexible format: invalid metadata or buffer for header is not available. This looks like an internal error of nnstreamer/tensor_filter. Please report to github.com/nnstreamer/nnstreamer/issues. %u'th output buffer has failed to update its header.\n",
               i);
@@ -808,39 +1349,96 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_PREPARE],
+      g_get_monotonic_time () - start_time);
+  return GST_FLOW_OK;
+
+mem_map_error:
+  gst_tensor_filter_request_cleanup (self, req);
+  return GST_FLOW_ERROR;
+}
+
+/**
+ * @brief Call the filter-subplugin callback, "invoke", with the prepared request.
+ * @param private_data private data of the framework instance to invoke
+ * @return TRUE if the invoke time is measured for profiling.
+ */
+static gboolean
+gst_tensor_filter_request_invoke (GstTensorFilter * self,
+    GstTensorFilterRequest * req, void **private_data)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gboolean need_profiling;
+  gint ret;
+
   need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
       priv->latency_reporting);
-  if (need_profiling)
-    prepare_statistics (priv);
+  req->invoke_time = g_get_monotonic_time ();
 
-  /* 3. Call the filter-subplugin callback, "invoke" */
-  GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
-  if (need_profiling) {
-    record_statistics (priv);
-    track_latency (self);
-  }
+  GST_TF_FW_INVOKE_COMPAT_DATA (priv, private_data, ret, req->invoke_tensors,
+      req->out_tensors);
+
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_INVOKE],
+      g_get_monotonic_time () - req->invoke_time);
+
+  req->ret = ret;
+  return need_profiling;
+}
+
+/**
+ * @brief Record the statistics with the invoke time of the request.
+ * @note Caller should hold the lock of async data if the requests are invoked concurrently.
+ */
+static void
+gst_tensor_filter_request_record (GstTensorFilter * self,
+    GstTensorFilterRequest * req)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  priv->stat.latest_invoke_time = req->invoke_time;
+  record_statistics (priv);
+}
+
+/**
+ * @brief Release the input tensors and append the results of the invoked request to outbuf.
+ * @return GST_FLOW_OK if the outbuf is filled with output tensors.
+ */
+static GstFlowReturn
+gst_tensor_filter_request_finish (GstTensorFilter * self,
+    GstTensorFilterRequest * req, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem;
+  GList *list;
+  guint i;
+  gsize hsize;
+  gint64 start_time = g_get_monotonic_time ();
 
   /* 4. Free map info and handle error case */
-  for (i = 0; i < num_tensors; i++) {
-    gst_memory_unmap (in_mem[i], &in_info[i]);
-    gst_memory_unref (in_mem[i]);
-  }
+  for (i = 0; i < req->num_tensors; i++)
+    gst_memory_unmap (req->in_mem[i], &req->in_info[i]);
 
-  if (!allocate_in_invoke) {
+  if (!req->allocate_in_invoke) {
     for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      gst_memory_unmap (out_mem[i], &out_info[i]);
-      if (ret != 0)
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+      gst_memory_unmap (req->out_mem[i], &req->out_info[i]);
+      if (req->ret != 0)
+        gst_memory_unref (req->out_mem[i]);
     }
   }
 
   /** @todo define enum to indicate status code */
-  if (ret < 0) {
-    ml_loge_stacktrace
-        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
-        prop->fwname, TF_MODELNAME (prop), ret);
-    return GST_FLOW_ERROR;
-  } else if (ret > 0) {
+  if (req->ret != 0) {
+    for (i = 0; i < req->num_tensors; i++)
+      gst_memory_unref (req->in_mem[i]);
+
+    if (req->ret < 0) {
+      ml_loge_stacktrace
+          ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+          prop->fwname, TF_MODELNAME (prop), req->ret);
+      return GST_FLOW_ERROR;
+    }
+
     /* drop this buffer */
     return GST_BASE_TRANSFORM_FLOW_DROPPED;
   }
@@ -851,23 +1449,27 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
       i = GPOINTER_TO_UINT (list->data);
 
-      if (!in_flexible && out_flexible) {
+      if (!req->in_flexible && req->out_flexible) {
         /* append header */
         gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
-            &in_meta[i]);
-        mem = gst_tensor_meta_info_append_header (&in_meta[i], in_mem[i]);
-      } else if (in_flexible && !out_flexible) {
+            &req->in_meta[i]);
+        mem = gst_tensor_meta_info_append_header (&req->in_meta[i],
+            req->in_mem[i]);
+      } else if (req->in_flexible && !req->out_flexible) {
         /* remove header */
-        hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-        mem = gst_memory_share (in_mem[i], hsize, -1);
+        hsize = gst_tensor_meta_info_get_header_size (&req->in_meta[i]);
+        mem = gst_memory_share (req->in_mem[i], hsize, -1);
       } else {
-        mem = gst_memory_ref (in_mem[i]);
+        mem = gst_memory_ref (req->in_mem[i]);
       }
 
       gst_buffer_append_memory (outbuf, mem);
     }
   }
 
+  for (i = 0; i < req->num_tensors; i++)
+    gst_memory_unref (req->in_mem[i]);
+
   for (i = 0; i < prop->output_meta.num_tensors; i++) {
     if (priv->combi.out_combi_o_defined) {
       gboolean out_combi = FALSE;
@@ -880,10 +1482,11 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
       }
       if (!out_combi) {
         /* release memory block if output tensor is not in the combi list */
-        if (allocate_in_invoke) {
-          gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
+        if (req->allocate_in_invoke) {
+          gst_tensor_filter_destroy_notify_util (priv,
+              req->out_tensors[i].data);
         } else {
-          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+          gst_memory_unref (req->out_mem[i]);
         }
 
         continue;
@@ -900,60 +1503,932 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
       meta.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
 
       flex_mem = gst_memory_new_wrapped (0,
-          out_tensors[i].data, out_tensors[i].size, 0,
-          out_tensors[i].size, out_tensors[i].data, g_free);
+          req->out_tensors[i].data, req->out_tensors[i].size, 0,
+          req->out_tensors[i].size, req->out_tensors[i].data, g_free);
 
-      out_mem[i] = gst_tensor_meta_info_append_header (&meta, flex_mem);
+      req->out_mem[i] = gst_tensor_meta_info_append_header (&meta, flex_mem);
       gst_memory_unref (flex_mem);
-    } else if (allocate_in_invoke) {
+    } else if (req->allocate_in_invoke) {
       /* prepare memory block if successfully done */
-      out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
-          out_tensors[i].data, out_tensors[i].size);
+      req->out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
+          req->out_tensors[i].data, req->out_tensors[i].size);
 
-      if (out_flexible) {
+      if (req->out_flexible) {
         /* prepare new memory block with meta */
-        out_mem[i] = gst_tensor_meta_info_append_header (&out_meta[i], mem);
+        req->out_mem[i] =
+            gst_tensor_meta_info_append_header (&req->out_meta[i], mem);
         gst_memory_unref (mem);
       }
     }
 
     /* append the memory block to outbuf */
-    gst_tensor_buffer_append_memory (outbuf, out_mem[i],
+    gst_tensor_buffer_append_memory (outbuf, req->out_mem[i],
         gst_tensors_info_get_nth_info (&prop->output_meta, i));
   }
 
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_FINISH],
+      g_get_monotonic_time () - start_time);
   return GST_FLOW_OK;
-mem_map_error:
-  num_tensors = gst_tensor_buffer_get_count (inbuf);
-  for (i = 0; i < num_tensors; i++) {
-    if (in_mem[i]) {
-      gst_memory_unmap (in_mem[i], &in_info[i]);
-      gst_memory_unref (in_mem[i]);
-    }
-  }
-
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      if (out_mem[i]) {
-        gst_memory_unmap (out_mem[i], &out_info[i]);
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-      }
-    }
-  }
-  return GST_FLOW_ERROR;
 }
 
 /**
- * @brief Configure input and output tensor info from incaps.
- * @param self "this" pointer
- * @param incaps received caps for sink pad
- * @return TRUE if fully configured
+ * @brief non-ip transform. required vmethod of GstBaseTransform.
  */
-static gboolean
-gst_tensor_filter_configure_tensor (GstTensorFilter * self,
-    const GstCaps * incaps)
+static GstFlowReturn
+gst_tensor_filter_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
 {
-  GstTensorFilterPrivate *priv;
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterRequest req;
+  GstFlowReturn retval;
+
+  /* 0. Check all properties. */
+  retval = _gst_tensor_filter_transform_validate (trans, inbuf, outbuf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  /* 1-2. Map input tensors and prepare output tensors. */
+  retval = gst_tensor_filter_request_prepare (self, inbuf, &req);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  /* 3. Call the filter-subplugin callback, "invoke" */
+  if (gst_tensor_filter_request_invoke (self, &req, &self->priv.privateData)) {
+    gst_tensor_filter_request_record (self, &req);
+    track_latency (self);
+  }
+
+  /* 4-5. Release input tensors and update result */
+  return gst_tensor_filter_request_finish (self, &req, outbuf);
+}
+
+/**
+ * @brief Check whether the batched invoke is available with the negotiated caps.
+ */
+static void
+gst_tensor_filter_batch_configure (GstTensorFilter * self,
+    gboolean in_flexible, gboolean out_flexible)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  self->batch.enabled = FALSE;
+
+  if (self->batch.size <= 1)
+    return;
+
+  if (self->async.enabled) {
+    ml_logw
+        ("Batched invoke is not available with asynchronous invoke (inflight-requests=%u). batch-size=%u is ignored.",
+        self->async.limit, self->batch.size);
+    return;
+  }
+
+  if (!GST_TF_FW_V1 (priv->fw) || !priv->info.support_batch) {
+    ml_logw
+        ("The tensor-filter subplugin (%s) does not support batched invoke. batch-size=%u is ignored and tensor_filter invokes the model per frame.",
+        prop->fwname, self->batch.size);
+    return;
+  }
+
+  if (prop->invoke_dynamic || priv->combi.in_combi_defined ||
+      priv->combi.out_combi_i_defined || priv->combi.out_combi_o_defined ||
+      in_flexible || out_flexible) {
+    ml_logw
+        ("Batched invoke requires static tensors without invoke-dynamic and in/out combination options. batch-size=%u is ignored and tensor_filter (%s) invokes the model per frame.",
+        self->batch.size, prop->fwname);
+    return;
+  }
+
+  self->batch.enabled = TRUE;
+}
+
+/**
+ * @brief Invoke the model with the pending frames stacked along the outermost axis,
+ *        and split the output tensors into per-frame buffers.
+ * @note The caller should hold the batch lock.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_invoke (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
+
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gsize in_size[NNS_TENSOR_SIZE_LIMIT];
+  gsize out_size[NNS_TENSOR_SIZE_LIMIT];
+
+  GstBuffer *inbuf, *outbuf;
+  GList *list;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i, b, num_frames;
+  guint num_in_mapped = 0, num_out_mapped = 0;
+  gint ret = -1;
+  gboolean allocate_in_invoke, need_profiling;
+  GstFlowReturn retval = GST_FLOW_ERROR;
+  gint64 start_time;
+
+  num_frames = g_queue_get_length (&self->batch.pending);
+  if (num_frames == 0)
+    return GST_FLOW_OK;
+
+  start_time = g_get_monotonic_time ();
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  /* 1. Stack the input tensors of pending frames. */
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_size[i] = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+
+    in_mem[i] = gst_tensor_filter_pool_alloc (self->out_pool,
+        in_size[i] * num_frames);
+    if (!in_mem[i] || !gst_memory_map (in_mem[i], &in_info[i], GST_MAP_WRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_batch_invoke: cannot allocate and map the memory to stack %u frames of %u'th input tensor, which requires %zd bytes.\n",
+          num_frames, i, in_size[i] * num_frames);
+      goto done;
+    }
+    num_in_mapped = i + 1;
+
+    for (list = self->batch.pending.head, b = 0; list; list = list->next, b++) {
+      inbuf = GST_BUFFER_CAST (list->data);
+
+      if (gst_tensor_buffer_get_count (inbuf) != prop->input_meta.num_tensors) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors).\n",
+            gst_tensor_buffer_get_count (inbuf), prop->input_meta.num_tensors);
+        goto done;
+      }
+
+      mem = gst_tensor_buffer_get_nth_memory (inbuf, i);
+      if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: cannot map %u'th input tensor of %u'th frame for reading.\n",
+            i, b);
+        gst_memory_unref (mem);
+        goto done;
+      }
+
+      if (map.size != in_size[i]) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: Input buffer size (%u'th memory chunk of %u'th frame: %zd) is invalid, which is expected to be %zd.\n",
+            i, b, map.size, in_size[i]);
+        gst_memory_unmap (mem, &map);
+        gst_memory_unref (mem);
+        goto done;
+      }
+
+      memcpy (in_info[i].data + b * in_size[i], map.data, in_size[i]);
+
+      gst_memory_unmap (mem, &map);
+      gst_memory_unref (mem);
+    }
+
+    in_tensors[i].data = in_info[i].data;
+    in_tensors[i].size = in_size[i] * num_frames;
+  }
+
+  /* 2. Prepare the stacked output tensors. */
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    out_size[i] = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+    out_tensors[i].data = NULL;
+    out_tensors[i].size = out_size[i] * num_frames;
+
+    if (!allocate_in_invoke) {
+      out_mem[i] = gst_tensor_filter_pool_alloc (self->out_pool,
+          out_tensors[i].size);
+      if (!out_mem[i]
+          || !gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: cannot allocate and map the memory for %u'th output tensor, which requires %zd bytes.\n",
+            i, out_tensors[i].size);
+        goto done;
+      }
+      num_out_mapped = i + 1;
+
+      out_tensors[i].data = out_info[i].data;
+    }
+  }
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_PREPARE],
+      g_get_monotonic_time () - start_time);
+
+  /* 3. Call the filter-subplugin callback with the stacked tensors. */
+  start_time = g_get_monotonic_time ();
+  prop->batch_size = (int) num_frames;
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+  prop->batch_size = 1;
+
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_INVOKE],
+      g_get_monotonic_time () - start_time);
+  start_time = g_get_monotonic_time ();
+
+  if (need_profiling) {
+    record_statistics (priv);
+    track_latency (self);
+  }
+
+  for (i = 0; i < num_out_mapped; i++)
+    gst_memory_unmap (out_mem[i], &out_info[i]);
+  num_out_mapped = 0;
+
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling batched invoke (%u frames) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        num_frames, prop->fwname, TF_MODELNAME (prop), ret);
+    goto done;
+  } else if (ret > 0) {
+    /* drop the frames in this batch */
+    retval = GST_FLOW_OK;
+    goto done;
+  }
+
+  if (allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      out_mem[i] = gst_tensor_filter_get_wrapped_mem (self,
+          out_tensors[i].data, out_tensors[i].size);
+  }
+
+  /* 4. Split the output tensors into per-frame buffers with original metadata. */
+  for (b = 0; b < num_frames; b++) {
+    inbuf = GST_BUFFER_CAST (g_queue_peek_nth (&self->batch.pending, b));
+
+    outbuf = gst_buffer_new ();
+    gst_buffer_copy_into (outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      mem = gst_memory_share (out_mem[i], b * out_size[i], out_size[i]);
+      gst_tensor_buffer_append_memory (outbuf, mem,
+          gst_tensors_info_get_nth_info (&prop->output_meta, i));
+    }
+
+    g_queue_push_tail (&self->batch.outputs, outbuf);
+  }
+
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_FINISH],
+      g_get_monotonic_time () - start_time);
+  retval = GST_FLOW_OK;
+
+done:
+  for (i = 0; i < num_in_mapped; i++)
+    gst_memory_unmap (in_mem[i], &in_info[i]);
+  for (i = 0; i < num_out_mapped; i++)
+    gst_memory_unmap (out_mem[i], &out_info[i]);
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (in_mem[i])
+      gst_memory_unref (in_mem[i]);
+    if (out_mem[i])
+      gst_memory_unref (out_mem[i]);
+  }
+
+  while ((inbuf = g_queue_pop_head (&self->batch.pending)) != NULL)
+    gst_buffer_unref (inbuf);
+  self->batch.first_arrival = 0;
+
+  return retval;
+}
+
+/**
+ * @brief Wait until the results of the previous batch are pushed.
+ * @note The caller should hold the batch lock.
+ */
+static void
+gst_tensor_filter_batch_wait_pushing (GstTensorFilter * self)
+{
+  while (self->batch.pushing)
+    g_cond_wait (&self->batch.cond, &self->batch.lock);
+}
+
+/**
+ * @brief Invoke the pending frames and push all the results to the src pad.
+ * @note The caller should hold the batch lock. This is called in the streaming
+ *       thread before a serialized event, or in the flusher when
+ *       max-batch-latency elapses. The lock is released while pushing, and
+ *       the other threads wait until the results are pushed, so that the
+ *       results of a batch are never interleaved with the next one.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_drain (GstTensorFilter * self)
+{
+  GstTensorFilterBatch *batch = &self->batch;
+  GQueue outputs;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  gst_tensor_filter_batch_wait_pushing (self);
+
+  ret = gst_tensor_filter_batch_invoke (self);
+  if (g_queue_is_empty (&batch->outputs))
+    return ret;
+
+  outputs = batch->outputs;
+  g_queue_init (&batch->outputs);
+  batch->pushing = TRUE;
+  g_mutex_unlock (&batch->lock);
+
+  while ((outbuf = g_queue_pop_head (&outputs)) != NULL) {
+    if (ret == GST_FLOW_OK)
+      ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+    else
+      gst_buffer_unref (outbuf);
+  }
+
+  g_mutex_lock (&batch->lock);
+  batch->pushing = FALSE;
+  g_cond_broadcast (&batch->cond);
+
+  return ret;
+}
+
+/**
+ * @brief Thread to invoke the pending frames when the oldest one has waited for max-batch-latency.
+ */
+static gpointer
+gst_tensor_filter_batch_flusher (gpointer data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (data);
+  GstTensorFilterBatch *batch = &self->batch;
+  GstFlowReturn ret;
+  gint64 deadline;
+
+  g_mutex_lock (&batch->lock);
+  while (batch->running) {
+    if (g_queue_is_empty (&batch->pending) || batch->max_latency == 0) {
+      g_cond_wait (&batch->cond, &batch->lock);
+      continue;
+    }
+
+    deadline = batch->first_arrival + (gint64) MIN (batch->max_latency,
+        (guint64) G_MAXINT64 - batch->first_arrival);
+    if (g_get_monotonic_time () < deadline) {
+      g_cond_wait_until (&batch->cond, &batch->lock, deadline);
+      continue;
+    }
+
+    ret = gst_tensor_filter_batch_drain (self);
+
+    /* keep the first error until the upstream receives it */
+    if (ret != GST_FLOW_OK && batch->last_ret == GST_FLOW_OK)
+      batch->last_ret = ret;
+  }
+  g_mutex_unlock (&batch->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Start the flusher if max-batch-latency is set.
+ * @note The caller should hold the batch lock.
+ */
+static void
+gst_tensor_filter_batch_start_flusher (GstTensorFilter * self)
+{
+  GstTensorFilterBatch *batch = &self->batch;
+  GError *err = NULL;
+
+  if (batch->flusher != NULL || batch->max_latency == 0)
+    return;
+
+  batch->running = TRUE;
+  batch->flusher = g_thread_try_new ("tensor_filter_batch",
+      gst_tensor_filter_batch_flusher, self, &err);
+  if (batch->flusher == NULL) {
+    /* the pending frames are invoked when the next frame arrives */
+    ml_logw ("Failed to create the thread to flush the pending frames: %s",
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    batch->running = FALSE;
+  }
+}
+
+/**
+ * @brief Stop the flusher. The pending frames are not invoked.
+ */
+static void
+gst_tensor_filter_batch_stop_flusher (GstTensorFilter * self)
+{
+  GstTensorFilterBatch *batch = &self->batch;
+  GThread *flusher;
+
+  g_mutex_lock (&batch->lock);
+  flusher = batch->flusher;
+  batch->flusher = NULL;
+  batch->running = FALSE;
+  g_cond_broadcast (&batch->cond);
+  g_mutex_unlock (&batch->lock);
+
+  if (flusher)
+    g_thread_join (flusher);
+}
+
+/**
+ * @brief Complete the asynchronous request and wake up the pusher thread.
+ * @note This is the callback given to invokeAsync of the framework.
+ */
+static void
+gst_tensor_filter_async_done (void *user_data, int status)
+{
+  GstTensorFilterRequest *req = (GstTensorFilterRequest *) user_data;
+  GstTensorFilter *self = req->self;
+  GstTensorFilterPrivate *priv = &self->priv;
+  gboolean need_profiling;
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting);
+
+  gst_tensor_filter_histogram_record (&priv->stat.stages[GST_TF_STAGE_INVOKE],
+      g_get_monotonic_time () - req->invoke_time);
+
+  g_mutex_lock (&self->async.lock);
+  if (need_profiling)
+    gst_tensor_filter_request_record (self, req);
+
+  req->ret = status;
+  req->done = TRUE;
+  g_cond_broadcast (&self->async.cond);
+  g_mutex_unlock (&self->async.lock);
+
+  /* the request may be released by the pusher thread from here */
+  if (need_profiling)
+    track_latency (self);
+}
+
+/**
+ * @brief Thread to invoke the in-flight requests in arrival order.
+ * @details With multiple framework instances, each worker takes the oldest request
+ *          not yet invoked whenever its instance becomes idle.
+ * @note This is used only if the framework does not provide invokeAsync.
+ */
+static gpointer
+gst_tensor_filter_async_worker (gpointer data)
+{
+  GstTensorFilterWorker *worker = (GstTensorFilterWorker *) data;
+  GstTensorFilter *self = worker->self;
+  GstTensorFilterAsync *async = &self->async;
+  GstTensorFilterRequest *req;
+  GList *list;
+  gboolean profiled;
+
+  g_mutex_lock (&async->lock);
+  while (async->running) {
+    req = NULL;
+    for (list = async->requests.head; list != NULL; list = list->next) {
+      if (!((GstTensorFilterRequest *) list->data)->invoked) {
+        req = (GstTensorFilterRequest *) list->data;
+        break;
+      }
+    }
+
+    if (req == NULL) {
+      g_cond_wait (&async->cond, &async->lock);
+      continue;
+    }
+
+    req->invoked = TRUE;
+    profiled = FALSE;
+    if (async->flushing) {
+      /* drop this frame without invoking the model */
+      req->ret = 1;
+    } else {
+      /* the request is not released until it is done */
+      g_mutex_unlock (&async->lock);
+      profiled = gst_tensor_filter_request_invoke (self, req,
+          worker->private_data);
+      g_mutex_lock (&async->lock);
+
+      if (profiled)
+        gst_tensor_filter_request_record (self, req);
+    }
+
+    req->done = TRUE;
+    g_cond_broadcast (&async->cond);
+
+    if (profiled) {
+      g_mutex_unlock (&async->lock);
+      track_latency (self);
+      g_mutex_lock (&async->lock);
+    }
+  }
+  g_mutex_unlock (&async->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Thread to push the results of the completed requests in arrival order.
+ */
+static gpointer
+gst_tensor_filter_async_pusher (gpointer data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (data);
+  GstTensorFilterAsync *async = &self->async;
+  GstTensorFilterRequest *req;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+  gboolean flushing;
+
+  g_mutex_lock (&async->lock);
+  while (async->running) {
+    req = (GstTensorFilterRequest *) g_queue_peek_head (&async->requests);
+    if (req == NULL || !req->done) {
+      g_cond_wait (&async->cond, &async->lock);
+      continue;
+    }
+
+    flushing = async->flushing;
+    g_mutex_unlock (&async->lock);
+
+    outbuf = gst_buffer_new ();
+    gst_buffer_copy_into (outbuf, req->inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+    ret = gst_tensor_filter_request_finish (self, req, outbuf);
+    gst_buffer_unref (req->inbuf);
+
+    if (ret == GST_FLOW_OK && !flushing) {
+      ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+    } else {
+      gst_buffer_unref (outbuf);
+      if (ret == GST_BASE_TRANSFORM_FLOW_DROPPED)
+        ret = GST_FLOW_OK;
+    }
+
+    g_mutex_lock (&async->lock);
+    g_queue_pop_head (&async->requests);
+    g_free (req);
+
+    /* keep the first error until the upstream receives it */
+    if (ret != GST_FLOW_OK && !async->flushing &&
+        async->last_ret == GST_FLOW_OK)
+      async->last_ret = ret;
+
+    g_cond_broadcast (&async->cond);
+  }
+  g_mutex_unlock (&async->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Stop the threads for asynchronous invoke after discarding the in-flight requests.
+ */
+static void
+gst_tensor_filter_async_stop (GstTensorFilter * self)
+{
+  GstTensorFilterAsync *async = &self->async;
+  GstTensorFilterPrivate *priv = &self->priv;
+  guint i;
+
+  g_mutex_lock (&async->lock);
+  if (async->pusher != NULL) {
+    async->flushing = TRUE;
+    g_cond_broadcast (&async->cond);
+
+    while (!g_queue_is_empty (&async->requests))
+      g_cond_wait (&async->cond, &async->lock);
+  }
+
+  async->running = FALSE;
+  g_cond_broadcast (&async->cond);
+  g_mutex_unlock (&async->lock);
+
+  for (i = 0; i < async->num_workers; i++) {
+    GstTensorFilterWorker *worker = &async->workers[i];
+
+    if (worker->thread)
+      g_thread_join (worker->thread);
+
+    /* close the additional framework instance */
+    if (worker->opened && priv->fw->close)
+      priv->fw->close (&priv->prop, &worker->instance);
+  }
+
+  g_free (async->workers);
+  async->workers = NULL;
+  async->num_workers = 0;
+
+  if (async->pusher) {
+    g_thread_join (async->pusher);
+    async->pusher = NULL;
+  }
+
+  async->enabled = FALSE;
+  async->flushing = FALSE;
+  async->last_ret = GST_FLOW_OK;
+}
+
+/**
+ * @brief Start the threads for asynchronous invoke if 'inflight-requests' or 'num-instances' is set.
+ * @return FALSE if failed to open the framework instances or to create the threads.
+ */
+static gboolean
+gst_tensor_filter_async_start (GstTensorFilter * self)
+{
+  GstTensorFilterAsync *async = &self->async;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GError *err = NULL;
+  guint i, num_instances;
+
+  async->enabled = FALSE;
+  num_instances = MAX (async->num_instances, 1);
+
+  if (async->depth == 0 && num_instances == 1)
+    return TRUE;
+
+  if (priv->prop.invoke_dynamic) {
+    ml_logw
+        ("Asynchronous invoke does not support invoke-dynamic. inflight-requests=%u and num-instances=%u are ignored and tensor_filter (%s) invokes the model synchronously.",
+        async->depth, num_instances, priv->prop.fwname);
+    return TRUE;
+  }
+
+  if (num_instances > 1 && priv->fw->open == NULL) {
+    /* the workers cannot have their own instances, do not share the primary one */
+    ml_logw
+        ("Multiple framework instances are not available if the framework (%s) does not open an instance. num-instances=%u is ignored.",
+        priv->prop.fwname, num_instances);
+    num_instances = 1;
+
+    if (async->depth == 0)
+      return TRUE;
+  }
+
+  if (num_instances > 1 && (gst_tensor_filter_allocate_in_invoke (priv) ||
+          priv->is_updatable)) {
+    ml_logw
+        ("Multiple framework instances are not available if the framework (%s) allocates the output in invoke or the model is updatable. num-instances=%u is ignored.",
+        priv->prop.fwname, num_instances);
+    num_instances = 1;
+
+    if (async->depth == 0)
+      return TRUE;
+  }
+
+  /* keep all the framework instances busy */
+  async->limit = MAX (async->depth, num_instances);
+  async->native = (num_instances == 1 && GST_TF_FW_V1 (priv->fw) &&
+      priv->fw->invokeAsync != NULL);
+  async->running = TRUE;
+  async->flushing = FALSE;
+  async->last_ret = GST_FLOW_OK;
+
+  if (!async->native) {
+    async->workers = g_new0 (GstTensorFilterWorker, num_instances);
+    async->num_workers = num_instances;
+
+    for (i = 0; i < num_instances; i++) {
+      GstTensorFilterWorker *worker = &async->workers[i];
+
+      worker->self = self;
+      worker->private_data = &priv->privateData;
+
+      if (i > 0) {
+        /* open a separate framework instance, not to share the model representation */
+        gchar *shared_key = priv->prop.shared_tensor_filter_key;
+        gint status;
+
+        priv->prop.shared_tensor_filter_key = NULL;
+        status = priv->fw->open (&priv->prop, &worker->instance);
+        priv->prop.shared_tensor_filter_key = shared_key;
+
+        if (status < 0) {
+          ml_loge
+              ("Failed to open the %u'th instance of the framework (%s) with model %s.",
+              i, priv->prop.fwname, TF_MODELNAME (&priv->prop));
+          goto error;
+        }
+
+        worker->opened = TRUE;
+        worker->private_data = &worker->instance;
+      }
+    }
+
+    for (i = 0; i < num_instances; i++) {
+      async->workers[i].thread = g_thread_try_new ("tensor_filter_invoke",
+          gst_tensor_filter_async_worker, &async->workers[i], &err);
+      if (async->workers[i].thread == NULL)
+        goto error;
+    }
+  }
+
+  async->pusher = g_thread_try_new ("tensor_filter_push",
+      gst_tensor_filter_async_pusher, self, &err);
+  if (async->pusher == NULL)
+    goto error;
+
+  async->enabled = TRUE;
+  return TRUE;
+
+error:
+  if (err) {
+    ml_loge ("Failed to create the thread for asynchronous invoke: %s",
+        err->message);
+    g_clear_error (&err);
+  }
+
+  gst_tensor_filter_async_stop (self);
+  return FALSE;
+}
+
+/**
+ * @brief Wait until all the in-flight requests are pushed.
+ * @note This is called in the streaming thread before serialized events.
+ */
+static void
+gst_tensor_filter_async_drain (GstTensorFilter * self)
+{
+  GstTensorFilterAsync *async = &self->async;
+
+  g_mutex_lock (&async->lock);
+  while (async->running && !g_queue_is_empty (&async->requests))
+    g_cond_wait (&async->cond, &async->lock);
+  g_mutex_unlock (&async->lock);
+}
+
+/**
+ * @brief Prepare the request of the incoming buffer and queue it for asynchronous invoke.
+ * @details This waits for a free slot if 'inflight-requests' frames are already being
+ *          invoked, and returns the error of the previous push to the upstream.
+ */
+static GstFlowReturn
+gst_tensor_filter_async_submit (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterAsync *async = &self->async;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterRequest *req;
+  GstFlowReturn ret;
+  gint status;
+
+  g_mutex_lock (&async->lock);
+  while (!async->flushing && async->last_ret == GST_FLOW_OK &&
+      g_queue_get_length (&async->requests) >= async->limit)
+    g_cond_wait (&async->cond, &async->lock);
+
+  ret = async->flushing ? GST_FLOW_FLUSHING : async->last_ret;
+  g_mutex_unlock (&async->lock);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (inbuf);
+    return ret;
+  }
+
+  req = g_new (GstTensorFilterRequest, 1);
+
+  ret = gst_tensor_filter_request_prepare (self, inbuf, req);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (inbuf);
+    g_free (req);
+    return ret;
+  }
+
+  g_mutex_lock (&async->lock);
+  if (async->native) {
+    req->invoked = TRUE;
+    req->invoke_time = g_get_monotonic_time ();
+  }
+  g_queue_push_tail (&async->requests, req);
+  g_cond_broadcast (&async->cond);
+  g_mutex_unlock (&async->lock);
+
+  if (async->native) {
+    status = priv->fw->invokeAsync (priv->fw, &priv->prop, priv->privateData,
+        req->invoke_tensors, req->out_tensors, gst_tensor_filter_async_done,
+        req);
+
+    if (status != 0) {
+      /* the framework does not call the callback if failed to start */
+      g_mutex_lock (&async->lock);
+      req->ret = status;
+      req->done = TRUE;
+      g_cond_broadcast (&async->cond);
+      g_mutex_unlock (&async->lock);
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Receive an input buffer. optional vmethod of GstBaseTransform.
+ * @details In batching mode, tensor_filter holds the incoming buffer until
+ *          'batch-size' frames are collected or 'max-batch-latency' elapses.
+ *          The flusher invokes the pending frames if no frame arrives in time.
+ *          In asynchronous mode, the buffer is invoked and pushed by other threads.
+ */
+static GstFlowReturn
+gst_tensor_filter_submit_input_buffer (GstBaseTransform * trans,
+    gboolean is_discont, GstBuffer * inbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstFlowReturn ret;
+  gboolean async_enabled;
+  gint64 now;
+
+  ret = GST_BASE_TRANSFORM_CLASS (parent_class)->submit_input_buffer (trans,
+      is_discont, inbuf);
+
+  async_enabled = (self->async.enabled && !self->async.in_flexible);
+
+  if (ret != GST_FLOW_OK || trans->queued_buf == NULL ||
+      (!self->batch.enabled && !async_enabled))
+    return ret;
+
+  ret = _gst_tensor_filter_invoke_validate (self);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  /* take the buffer stashed by the default method */
+  inbuf = trans->queued_buf;
+  trans->queued_buf = NULL;
+
+  /* skip input data when throttling delay is set */
+  if (gst_tensor_filter_check_throttling_delay (trans, inbuf)) {
+    gst_buffer_unref (inbuf);
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  if (async_enabled)
+    return gst_tensor_filter_async_submit (self, inbuf);
+
+  g_mutex_lock (&self->batch.lock);
+  gst_tensor_filter_batch_wait_pushing (self);
+
+  /* return the error of the frames pushed by the flusher */
+  if (self->batch.last_ret != GST_FLOW_OK) {
+    ret = self->batch.last_ret;
+    self->batch.last_ret = GST_FLOW_OK;
+    g_mutex_unlock (&self->batch.lock);
+    gst_buffer_unref (inbuf);
+    return ret;
+  }
+
+  now = g_get_monotonic_time ();
+  if (g_queue_is_empty (&self->batch.pending)) {
+    self->batch.first_arrival = now;
+
+    /* wake up the flusher to wait for max-batch-latency */
+    gst_tensor_filter_batch_start_flusher (self);
+    g_cond_signal (&self->batch.cond);
+  }
+
+  g_queue_push_tail (&self->batch.pending, inbuf);
+
+  if (g_queue_get_length (&self->batch.pending) >= self->batch.size ||
+      (self->batch.max_latency > 0 &&
+          (guint64) (now - self->batch.first_arrival) >=
+          self->batch.max_latency))
+    ret = gst_tensor_filter_batch_invoke (self);
+
+  g_mutex_unlock (&self->batch.lock);
+  return ret;
+}
+
+/**
+ * @brief Produce an output buffer. optional vmethod of GstBaseTransform.
+ * @details In batching mode, this returns the per-frame results of the batched
+ *          invoke one by one. GstBaseTransform calls this until outbuf is NULL.
+ */
+static GstFlowReturn
+gst_tensor_filter_generate_output (GstBaseTransform * trans,
+    GstBuffer ** outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+
+  g_mutex_lock (&self->batch.lock);
+  *outbuf = g_queue_pop_head (&self->batch.outputs);
+  g_mutex_unlock (&self->batch.lock);
+
+  if (*outbuf == NULL)
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->generate_output (trans,
+        outbuf);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Configure input and output tensor info from incaps.
+ * @param self "this" pointer
+ * @param incaps received caps for sink pad
+ * @return TRUE if fully configured
+ */
+static gboolean
+gst_tensor_filter_configure_tensor (GstTensorFilter * self,
+    const GstCaps * incaps)
+{
+  GstTensorFilterPrivate *priv;
   GstTensorFilterProperties *prop;
   GstStructure *structure;
   GstTensorsConfig in_config, out_config;
@@ -1357,6 +2832,22 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  gst_tensor_filter_batch_configure (self,
+      gst_tensors_config_is_flexible (&priv->in_config),
+      gst_tensors_config_is_flexible (&config));
+
+  /**
+   * Flexible input updates the input info of the framework for each frame,
+   * which is being read by the in-flight requests. The in-flight requests
+   * are already drained before the caps event.
+   */
+  self->async.in_flexible = gst_tensors_config_is_flexible (&priv->in_config);
+  if (self->async.enabled && self->async.in_flexible) {
+    ml_logw
+        ("Asynchronous invoke is not available with flexible input. tensor_filter (%s) invokes the model synchronously.",
+        priv->prop.fwname);
+  }
+
   gst_tensors_config_free (&config);
 
   return TRUE;
@@ -1472,6 +2963,21 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+
+  /* push the results of in-flight requests before serialized events */
+  if (self->async.enabled && GST_EVENT_IS_SERIALIZED (event))
+    gst_tensor_filter_async_drain (self);
+
+  /* invoke the frames waiting for the batch to be filled before serialized events */
+  if (self->batch.enabled && GST_EVENT_IS_SERIALIZED (event) &&
+      GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP) {
+    g_mutex_lock (&self->batch.lock);
+    if (gst_tensor_filter_batch_drain (self) != GST_FLOW_OK)
+      ml_logw ("Failed to invoke the pending frames before the event %s.",
+          GST_EVENT_TYPE_NAME (event));
+    g_mutex_unlock (&self->batch.lock);
+  }
+
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_CUSTOM_DOWNSTREAM:
     {
@@ -1492,6 +2998,21 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
       gst_event_unref (event);
       return (ret == 0);
     }
+    case GST_EVENT_FLUSH_START:
+      /* discard in-flight requests and wake up the streaming thread */
+      g_mutex_lock (&self->async.lock);
+      self->async.flushing = TRUE;
+      g_cond_broadcast (&self->async.cond);
+      g_mutex_unlock (&self->async.lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_filter_batch_clear (self);
+
+      g_mutex_lock (&self->async.lock);
+      self->async.flushing = FALSE;
+      self->async.last_ret = GST_FLOW_OK;
+      g_mutex_unlock (&self->async.lock);
+      break;
     default:
       break;
   }
@@ -1555,8 +3076,12 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
   gst_tensor_filter_common_open_fw (priv);
+  if (!priv->prop.fw_opened)
+    return FALSE;
+
+  gst_tensor_filter_pool_set_active (self->out_pool, TRUE);
 
-  return priv->prop.fw_opened;
+  return gst_tensor_filter_async_start (self);
 }
 
 /**
@@ -1571,6 +3096,10 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+  gst_tensor_filter_async_stop (self);
+  gst_tensor_filter_batch_stop_flusher (self);
+  gst_tensor_filter_batch_clear (self);
+  gst_tensor_filter_pool_set_active (self->out_pool, FALSE);
   gst_tensor_filter_common_close_fw (priv);
   return TRUE;
 }
@@ -54,6 +54,60 @@ G_BEGIN_DECLS
 
 typedef struct _GstTensorFilter GstTensorFilter;
 typedef struct _GstTensorFilterClass GstTensorFilterClass;
+typedef struct _GstTensorFilterMemPool GstTensorFilterMemPool;
+
+/**
+ * @brief Internal data structure for micro-batching.
+ */
+typedef struct
+{
+  guint size; /**< the max number of frames stacked for an invoke (1 to disable batching) */
+  guint64 max_latency; /**< the max duration (usec) the oldest pending frame waits for the batch to be filled (0 to wait until the batch is full) */
+  gboolean enabled; /**< TRUE if the framework supports batched invoke with the negotiated caps */
+  GQueue pending; /**< input buffers to be stacked for the next invoke */
+  GQueue outputs; /**< output buffers split from the batched invoke, to be pushed */
+  gint64 first_arrival; /**< monotonic time (usec) when the oldest pending frame arrived */
+  GMutex lock; /**< lock for the pending frames, held while invoking a batch */
+  GCond cond; /**< condition to wake up the flusher when a new batch is started, or the waiting threads when the results are pushed */
+  GThread *flusher; /**< thread to invoke the pending frames when max-batch-latency elapses */
+  gboolean running; /**< TRUE while the flusher is running */
+  gboolean pushing; /**< TRUE while the results of a batch are pushed without the lock */
+  GstFlowReturn last_ret; /**< flow return of the latest push from the flusher, returned to the upstream */
+} GstTensorFilterBatch;
+
+/**
+ * @brief Internal data structure for the thread invoking the in-flight requests.
+ */
+typedef struct
+{
+  GstTensorFilter *self; /**< tensor_filter instance which owns this worker */
+  GThread *thread; /**< thread to invoke the requests */
+  void **private_data; /**< private data of the framework instance used to invoke */
+  void *instance; /**< private data of the additional framework instance (num-instances > 1) */
+  gboolean opened; /**< TRUE if the additional framework instance is opened */
+} GstTensorFilterWorker;
+
+/**
+ * @brief Internal data structure for asynchronous (pipelined) invoke.
+ */
+typedef struct
+{
+  guint depth; /**< the max number of in-flight invoke requests (0 to invoke synchronously) */
+  guint num_instances; /**< the number of framework instances invoking the requests in parallel */
+  guint limit; /**< the max number of in-flight requests of the current session */
+  gboolean enabled; /**< TRUE if the requests are invoked asynchronously */
+  gboolean native; /**< TRUE if the framework provides invokeAsync */
+  gboolean in_flexible; /**< TRUE if the input is flexible, which is invoked synchronously */
+  GMutex lock; /**< lock for the async data */
+  GCond cond; /**< condition to notify the state change of requests */
+  GQueue requests; /**< in-flight requests in arrival order */
+  GstTensorFilterWorker *workers; /**< threads to invoke the requests (if the framework does not provide invokeAsync) */
+  guint num_workers; /**< the number of workers */
+  GThread *pusher; /**< thread to push the results in order */
+  gboolean running; /**< TRUE while the threads are running */
+  gboolean flushing; /**< TRUE to discard the in-flight requests */
+  GstFlowReturn last_ret; /**< flow return of the latest push, returned to the upstream */
+} GstTensorFilterAsync;
 
 /**
  * @brief Internal data structure for tensor_filter instances.
@@ -67,6 +121,10 @@ struct _GstTensorFilter
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
+
+  GstTensorFilterBatch batch; /**< micro-batching of incoming frames */
+  GstTensorFilterAsync async; /**< asynchronous invoke of incoming frames */
+  GstTensorFilterMemPool *out_pool; /**< pool of output memory blocks, recycled when downstream releases them */
 };
 
 /**
@@ -519,6 +519,8 @@ gst_tensor_filter_properties_init (GstTensorFilterProperties * prop)
   gst_tensors_info_init (&prop->output_meta);
   gst_tensors_layout_init (prop->output_layout);
   gst_tensors_rank_init (prop->output_ranks);
+
+  prop->batch_size = 1;
 }
 
 /**
@@ -536,6 +538,7 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
   info->accl_auto = -1;
   info->accl_default = -1;
   info->statistics = NULL;
+  info->support_batch = 0;
 }
 
 /**
@@ -551,6 +554,166 @@ gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
   stat->latest_invoke_time = 0;
   stat->recent_latencies = g_queue_new ();
   stat->latency_ignore_count = 1;
+  memset (stat->stages, 0, sizeof (stat->stages));
+}
+
+#if !defined(__ATOMIC_RELAXED)
+G_LOCK_DEFINE_STATIC (histogram_lock);
+#endif
+
+/**
+ * @brief Get the index of the histogram bucket for the latency.
+ */
+static guint
+gst_tensor_filter_histogram_get_index (guint64 latency)
+{
+  guint msb, shift, sub;
+
+  if (latency < GST_TF_HIST_SUB_BUCKETS)
+    return (guint) latency;
+
+  msb = g_bit_storage (latency) - 1;
+  if (msb > GST_TF_HIST_MAX_BITS)
+    return GST_TF_HIST_BUCKETS - 1;
+
+  shift = msb - GST_TF_HIST_SUB_BITS;
+  sub = (guint) ((latency >> shift) & (GST_TF_HIST_SUB_BUCKETS - 1));
+
+  return GST_TF_HIST_SUB_BUCKETS * (shift + 1) + sub;
+}
+
+/**
+ * @brief Get the upper bound of the latency in the histogram bucket.
+ */
+static guint64
+gst_tensor_filter_histogram_get_upper (guint index)
+{
+  guint shift, sub;
+
+  if (index < GST_TF_HIST_SUB_BUCKETS)
+    return index;
+
+  shift = index / GST_TF_HIST_SUB_BUCKETS - 1;
+  sub = index % GST_TF_HIST_SUB_BUCKETS;
+
+  return (((guint64) (GST_TF_HIST_SUB_BUCKETS + sub + 1)) << shift) - 1;
+}
+
+/**
+ * @brief Add the latency of the stage to the histogram.
+ */
+void
+gst_tensor_filter_histogram_record (GstTensorFilterLatencyHistogram * hist,
+    gint64 latency)
+{
+  guint index;
+
+  g_return_if_fail (hist != NULL);
+
+  if (latency < 0)
+    latency = 0;
+
+  index = gst_tensor_filter_histogram_get_index ((guint64) latency);
+
+#if defined(__ATOMIC_RELAXED)
+  {
+    guint64 max;
+
+    __atomic_fetch_add (&hist->buckets[index], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add (&hist->total, (guint64) latency, __ATOMIC_RELAXED);
+    __atomic_fetch_add (&hist->count, 1, __ATOMIC_RELAXED);
+
+    /* the failed exchange reloads the max updated by other threads */
+    max = __atomic_load_n (&hist->max, __ATOMIC_RELAXED);
+    while ((guint64) latency > max &&
+        !__atomic_compare_exchange_n (&hist->max, &max, (guint64) latency,
+            TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  }
+#else
+  G_LOCK (histogram_lock);
+  hist->buckets[index]++;
+  hist->total += (guint64) latency;
+  hist->count++;
+  if ((guint64) latency > hist->max)
+    hist->max = (guint64) latency;
+  G_UNLOCK (histogram_lock);
+#endif
+}
+
+/**
+ * @brief Load the counter of the histogram.
+ */
+static inline guint64
+gst_tensor_filter_histogram_load (guint64 * counter)
+{
+  guint64 value;
+
+#if defined(__ATOMIC_RELAXED)
+  value = __atomic_load_n (counter, __ATOMIC_RELAXED);
+#else
+  G_LOCK (histogram_lock);
+  value = *counter;
+  G_UNLOCK (histogram_lock);
+#endif
+
+  return value;
+}
+
+/**
+ * @brief Get the percentile of the latency in the histogram.
+ */
+guint64
+gst_tensor_filter_histogram_get_percentile (GstTensorFilterLatencyHistogram *
+    hist, gdouble percentile)
+{
+  guint64 buckets[GST_TF_HIST_BUCKETS];
+  guint64 count = 0, target, accum = 0;
+  guint i;
+
+  g_return_val_if_fail (hist != NULL, 0);
+  g_return_val_if_fail (percentile > 0.0 && percentile <= 100.0, 0);
+
+  /**
+   * The buckets may be updated while reading.
+   * Count the measurements in the snapshot, instead of the counter.
+   */
+  for (i = 0; i < GST_TF_HIST_BUCKETS; i++) {
+    buckets[i] = gst_tensor_filter_histogram_load (&hist->buckets[i]);
+    count += buckets[i];
+  }
+
+  if (count == 0)
+    return 0;
+
+  /* the rank of the measurement (rounded up) */
+  target = (guint64) (count * percentile / 100.0);
+  if (target < count * percentile / 100.0 || target == 0)
+    target++;
+
+  for (i = 0; i < GST_TF_HIST_BUCKETS; i++) {
+    accum += buckets[i];
+    if (accum >= target)
+      break;
+  }
+
+  /* the upper bound of the bucket cannot exceed the real max */
+  return MIN (gst_tensor_filter_histogram_get_upper (i),
+      gst_tensor_filter_histogram_load (&hist->max));
+}
+
+/**
+ * @brief Get the number of measurements, accumulated and max latency in the histogram.
+ */
+void
+gst_tensor_filter_histogram_get_summary (GstTensorFilterLatencyHistogram *
+    hist, guint64 * count, guint64 * total, guint64 * max)
+{
+  g_return_if_fail (hist != NULL);
+  g_return_if_fail (count != NULL && total != NULL && max != NULL);
+
+  *count = gst_tensor_filter_histogram_load (&hist->count);
+  *total = gst_tensor_filter_histogram_load (&hist->total);
+  *max = gst_tensor_filter_histogram_load (&hist->max);
 }
 
 /**
@@ -655,6 +818,72 @@ nnstreamer_filter_set_custom_property_desc (const char *name, const char *prop,
   va_end (varargs);
 }
 
+#if !defined(__ATOMIC_RELAXED)
+G_LOCK_DEFINE_STATIC (fw_stats_lock);
+#endif
+
+/**
+ * @brief Add the latencies of an invoke to the framework statistics.
+ */
+void
+nnstreamer_filter_statistics_add (GstTensorFilterFrameworkStatistics * stats,
+    int64_t invoke_latency, int64_t overhead_latency)
+{
+  g_return_if_fail (stats != NULL);
+
+#if defined(__ATOMIC_RELAXED)
+  __atomic_fetch_add (&stats->total_invoke_latency, invoke_latency,
+      __ATOMIC_RELAXED);
+  __atomic_fetch_add (&stats->total_overhead_latency, overhead_latency,
+      __ATOMIC_RELAXED);
+  __atomic_fetch_add (&stats->total_invoke_num, 1, __ATOMIC_RELAXED);
+#else
+  G_LOCK (fw_stats_lock);
+  stats->total_invoke_latency += invoke_latency;
+  stats->total_overhead_latency += overhead_latency;
+  stats->total_invoke_num += 1;
+  G_UNLOCK (fw_stats_lock);
+#endif
+}
+
+/**
+ * @brief Get a snapshot of the statistics of the framework.
+ * @return FALSE if the framework does not provide the statistics.
+ */
+gboolean
+gst_tensor_filter_framework_statistics_get (GstTensorFilterPrivate * priv,
+    GstTensorFilterFrameworkStatistics * stats)
+{
+  const GstTensorFilterFrameworkStatistics *fw_stats = NULL;
+
+  g_return_val_if_fail (priv != NULL && stats != NULL, FALSE);
+
+  if (priv->fw) {
+    if (GST_TF_FW_V0 (priv->fw))
+      fw_stats = priv->fw->statistics;
+    else if (GST_TF_FW_V1 (priv->fw))
+      fw_stats = priv->info.statistics;
+  }
+
+  if (fw_stats == NULL)
+    return FALSE;
+
+#if defined(__ATOMIC_RELAXED)
+  stats->total_invoke_num =
+      __atomic_load_n (&fw_stats->total_invoke_num, __ATOMIC_RELAXED);
+  stats->total_invoke_latency =
+      __atomic_load_n (&fw_stats->total_invoke_latency, __ATOMIC_RELAXED);
+  stats->total_overhead_latency =
+      __atomic_load_n (&fw_stats->total_overhead_latency, __ATOMIC_RELAXED);
+#else
+  G_LOCK (fw_stats_lock);
+  *stats = *fw_stats;
+  G_UNLOCK (fw_stats_lock);
+#endif
+
+  return TRUE;
+}
+
 /**
  * @brief Find sub-plugin filter given the name list
  * @param[in] names comma, whitespace separated list of the sub-plugin name
@@ -65,15 +65,18 @@ G_BEGIN_DECLS
       } \
     } while (0)
 
-#define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) do { \
+#define GST_TF_FW_INVOKE_COMPAT_DATA(priv,data,ret,in,out) do { \
       ret = -1; \
       if (GST_TF_FW_V0 ((priv)->fw)) { \
-        ret = (priv)->fw->invoke_NN (&(priv)->prop, &(priv)->privateData, (in), (out)); \
+        ret = (priv)->fw->invoke_NN (&(priv)->prop, (data), (in), (out)); \
       } else if (GST_TF_FW_V1 ((priv)->fw)) { \
-        ret = (priv)->fw->invoke ((priv)->fw, &(priv)->prop, (priv)->privateData, (in), (out)); \
+        ret = (priv)->fw->invoke ((priv)->fw, &(priv)->prop, *(data), (in), (out)); \
       } \
     } while (0)
 
+#define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) \
+    GST_TF_FW_INVOKE_COMPAT_DATA (priv, &(priv)->privateData, ret, in, out)
+
 #define GST_TF_STAT_MAX_RECENT (10)
 
 /**
@@ -106,9 +109,52 @@ enum
   PROP_SHARED_TENSOR_FILTER_KEY,
   PROP_LATENCY_REPORT,
   PROP_INVOKE_DYNAMIC,
-  PROP_CONFIG
+  PROP_CONFIG,
+  PROP_BATCH_SIZE,
+  PROP_MAX_BATCH_LATENCY,
+  PROP_INFLIGHT_REQUESTS,
+  PROP_NUM_INSTANCES,
+  PROP_OUTPUT_POOL_STATS,
+  PROP_INVOKE_STATS
 };
 
+/**
+ * @brief Stages of an invoke request measured for the statistics.
+ */
+typedef enum
+{
+  GST_TF_STAGE_PREPARE = 0, /**< map the input tensors and prepare the output tensors */
+  GST_TF_STAGE_INVOKE, /**< the invoke callback of the filter subplugin */
+  GST_TF_STAGE_FINISH, /**< release the input tensors and append the output tensors */
+
+  GST_TF_STAGE_MAX
+} GstTensorFilterStage;
+
+/**
+ * @brief The number of sub-buckets for each power of two in the latency histogram.
+ */
+#define GST_TF_HIST_SUB_BITS (3)
+#define GST_TF_HIST_SUB_BUCKETS (1 << GST_TF_HIST_SUB_BITS)
+
+/**
+ * @brief The max power of two of the latency (usec) in the histogram. Larger values are counted in the last bucket.
+ */
+#define GST_TF_HIST_MAX_BITS (40)
+#define GST_TF_HIST_BUCKETS \
+    (GST_TF_HIST_SUB_BUCKETS * (GST_TF_HIST_MAX_BITS - GST_TF_HIST_SUB_BITS + 2))
+
+/**
+ * @brief Latency histogram with log-linear buckets (relative error under 1/8).
+ * @details The counters are updated with atomic operations, the invoke stages may run in different threads.
+ */
+typedef struct _GstTensorFilterLatencyHistogram
+{
+  guint64 count; /**< the number of measurements */
+  guint64 total; /**< accumulated latency (usec) */
+  guint64 max; /**< the max latency (usec) */
+  guint64 buckets[GST_TF_HIST_BUCKETS]; /**< the number of measurements in each bucket */
+} GstTensorFilterLatencyHistogram;
+
 /**
  * @brief Structure definition for tensor-filter statistics
  */
@@ -121,6 +167,7 @@ typedef struct _GstTensorFilterStatistics
   gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
   void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
   guint latency_ignore_count;   /* number of initial latency measurements to ignore in averaging */
+  GstTensorFilterLatencyHistogram stages[GST_TF_STAGE_MAX]; /**< latency of each stage, measured with monotonic time */
 } GstTensorFilterStatistics;
 
 /**
@@ -171,6 +218,46 @@ typedef struct _GstTensorFilterPrivate
   GstTensorFilterCombination combi;
 } GstTensorFilterPrivate;
 
+/**
+ * @brief Add the latency of the stage to the histogram.
+ * @param[in] hist The histogram of the stage
+ * @param[in] latency The latency (usec)
+ */
+extern void
+gst_tensor_filter_histogram_record (GstTensorFilterLatencyHistogram * hist,
+    gint64 latency);
+
+/**
+ * @brief Get the percentile of the latency in the histogram.
+ * @param[in] hist The histogram of the stage
+ * @param[in] percentile The percentile (0 < percentile <= 100)
+ * @return The upper bound of the bucket (usec) where the percentile falls, or the max latency if it is smaller. 0 if the histogram is empty.
+ */
+extern guint64
+gst_tensor_filter_histogram_get_percentile (GstTensorFilterLatencyHistogram *
+    hist, gdouble percentile);
+
+/**
+ * @brief Get the number of measurements, accumulated and max latency in the histogram.
+ * @param[in] hist The histogram of the stage
+ * @param[out] count The number of measurements
+ * @param[out] total The accumulated latency (usec)
+ * @param[out] max The max latency (usec)
+ */
+extern void
+gst_tensor_filter_histogram_get_summary (GstTensorFilterLatencyHistogram *
+    hist, guint64 * count, guint64 * total, guint64 * max);
+
+/**
+ * @brief Get a snapshot of the statistics of the framework.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[out] stats The statistics of the framework
+ * @return FALSE if the framework does not provide the statistics.
+ */
+extern gboolean
+gst_tensor_filter_framework_statistics_get (GstTensorFilterPrivate * priv,
+    GstTensorFilterFrameworkStatistics * stats);
+
 /**
  * @brief Printout the comparison results of two tensors as a string.
  * @param[in] info1 The tensors to be shown on the left hand side
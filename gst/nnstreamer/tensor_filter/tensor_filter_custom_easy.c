@@ -45,6 +45,7 @@ typedef struct _internal_data
   GstTensorsInfo out_info;
   void *data; /**< The easy-filter writer's data */
   NNS_custom_invoke_dynamic func_dynamic;
+  int support_batch; /**< TRUE if func accepts the frames stacked along the outermost axis */
 } internal_data;
 
 /**
@@ -69,13 +70,14 @@ custom_free_internal_data (internal_data * data)
 }
 
 /**
- * @brief Register the custom-easy tensor function. More info in .h
+ * @brief Internal function to register the custom-easy tensor function.
  * @return 0 if success. -ERRNO if error.
  */
-int
-NNS_custom_easy_register (const char *modelname,
+static int
+custom_easy_register (const char *modelname,
     NNS_custom_invoke func, void *data,
-    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    int support_batch)
 {
   internal_data *ptr;
 
@@ -93,6 +95,7 @@ NNS_custom_easy_register (const char *modelname,
 
   ptr->func = func;
   ptr->data = data;
+  ptr->support_batch = support_batch;
   gst_tensors_info_copy (&ptr->in_info, in_info);
   gst_tensors_info_copy (&ptr->out_info, out_info);
 
@@ -103,6 +106,30 @@ NNS_custom_easy_register (const char *modelname,
   return -EINVAL;
 }
 
+/**
+ * @brief Register the custom-easy tensor function. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info, 0);
+}
+
+/**
+ * @brief Register the custom-easy tensor function supporting batched invoke. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_batch_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info, 1);
+}
+
 
 /**
  * @brief Register the custom-easy tensor function. More info in .h
@@ -279,9 +306,9 @@ custom_getFrameworkInfo (const GstTensorFilterFramework * self,
     const GstTensorFilterProperties * prop, void *private_data,
     GstTensorFilterFrameworkInfo * fw_info)
 {
+  runtime_data *rd = private_data;
   UNUSED (self);
   UNUSED (prop);
-  UNUSED (private_data);
   fw_info->name = fw_name;
   fw_info->allow_in_place = 0;
   fw_info->allocate_in_invoke = 0;
@@ -289,6 +316,8 @@ custom_getFrameworkInfo (const GstTensorFilterFramework * self,
   fw_info->verify_model_path = 0;
   fw_info->hw_list = NULL;
   fw_info->num_hw = 0;
+  /* the model is known once the framework is opened */
+  fw_info->support_batch = (rd && rd->model) ? rd->model->support_batch : 0;
 
   return 0;
 }
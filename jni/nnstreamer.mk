@@ -141,6 +141,7 @@ NNSTREAMER_DECODER_FLEXBUF_SRCS := \
 NNSTREAMER_DECODER_BB_SRCS := \
     $(wildcard $(NNSTREAMER_EXT_HOME)/tensor_decoder/box_properties/*.cc) \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-boundingbox.cc \
+    $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-nms.cc \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordecutil.c \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-font.c
 
@@ -2251,6 +2251,203 @@ TEST (commonUtil, tensorDimensionIsEqualInvalid_n)
   EXPECT_FALSE (gst_tensor_dimension_is_equal (dim1, dim2));
 }
 
+/**
+ * @brief Test for the tensor allocator with the pool.
+ */
+TEST (commonAllocator, poolReuse)
+{
+  GstTensorAllocConfig config = { 0 };
+  GstStructure *stats;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint64 hits = 0, reused = 0;
+
+  config.alignment = 63;
+  config.pool = TRUE;
+  config.numa_node = -1;
+  gst_tensor_alloc_configure (&config);
+
+  stats = gst_tensor_alloc_get_stats ();
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "hits", &hits));
+  gst_structure_free (stats);
+
+  mem = gst_allocator_alloc (NULL, 1000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  EXPECT_EQ ((guintptr) map.data & 63, 0U);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  /* same size class, released block is reused */
+  mem = gst_allocator_alloc (NULL, 1010, NULL);
+  ASSERT_TRUE (mem != NULL);
+
+  stats = gst_tensor_alloc_get_stats ();
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "hits", &reused));
+  EXPECT_EQ (reused, hits + 1);
+  gst_structure_free (stats);
+  gst_memory_unref (mem);
+
+  /* reset to the system memory allocator */
+  config.alignment = 0;
+  config.pool = FALSE;
+  gst_tensor_alloc_configure (&config);
+}
+
+/**
+ * @brief Allocate, fill and check the memory with the tensor allocator.
+ */
+static void
+_check_alloc_memory (gsize size, gsize align_mask)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  gsize i;
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READWRITE));
+  EXPECT_EQ (map.size, size);
+  EXPECT_EQ ((guintptr) map.data & align_mask, 0U);
+
+  memset (map.data, 0xA5, size);
+  for (i = 0; i < size; i += 4096)
+    EXPECT_EQ (map.data[i], 0xA5);
+  EXPECT_EQ (map.data[size - 1], 0xA5);
+
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+}
+
+/**
+ * @brief Test for the tensor allocator with hugepages.
+ * @note The large block falls back to normal pages if hugepages are not available.
+ */
+TEST (commonAllocator, hugepage)
+{
+  GstTensorAllocConfig config = { 0 };
+
+  config.alignment = 63;
+  config.numa_node = -1;
+
+  config.hugepage = TENSOR_ALLOC_HUGEPAGE_THP;
+  gst_tensor_alloc_configure (&config);
+  _check_alloc_memory (4 * 1024 * 1024, 63);
+  _check_alloc_memory (1000, 63);
+
+  config.hugepage = TENSOR_ALLOC_HUGEPAGE_HUGETLB;
+  config.pool = TRUE;
+  gst_tensor_alloc_configure (&config);
+  _check_alloc_memory (3 * 1024 * 1024 + 1, 63);
+  _check_alloc_memory (3 * 1024 * 1024 + 1, 63);
+
+  /* reset to the system memory allocator */
+  config.alignment = 0;
+  config.pool = FALSE;
+  config.hugepage = TENSOR_ALLOC_HUGEPAGE_NONE;
+  gst_tensor_alloc_configure (&config);
+}
+
+/**
+ * @brief Test for the tensor allocator with NUMA binding.
+ * @note The block is allocated even if the node is not available.
+ */
+TEST (commonAllocator, numaNode)
+{
+  GstTensorAllocConfig config = { 0 };
+
+  config.numa_node = 0;
+  gst_tensor_alloc_configure (&config);
+  _check_alloc_memory (2 * 1024 * 1024, 0);
+
+  /* invalid node, mbind fails and the block uses the default policy */
+  config.numa_node = 63;
+  config.pool = TRUE;
+  gst_tensor_alloc_configure (&config);
+  _check_alloc_memory (2 * 1024 * 1024, 0);
+  _check_alloc_memory (512, 0);
+
+  /* reset to the system memory allocator */
+  config.numa_node = -1;
+  config.pool = FALSE;
+  gst_tensor_alloc_configure (&config);
+}
+
+/**
+ * @brief Thread to allocate and release the memory while the allocator is configured.
+ */
+static gpointer
+_alloc_thread (gpointer data)
+{
+  gint *running = (gint *) data;
+  GstMemory *mem;
+  GstMapInfo map;
+  gsize size = 64;
+
+  while (g_atomic_int_get (running)) {
+    mem = gst_allocator_alloc (NULL, size, NULL);
+    if (mem && gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      memset (map.data, 0, map.size);
+      gst_memory_unmap (mem, &map);
+    }
+    if (mem)
+      gst_memory_unref (mem);
+
+    size = (size < 1024 * 1024) ? size * 2 : 64;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Test for the tensor allocator configured while other threads allocate the memory.
+ */
+TEST (commonAllocator, configureAtRuntime)
+{
+  GstTensorAllocConfig config = { 0 };
+  GThread *threads[4];
+  GstStructure *stats;
+  gint64 outstanding = -1, prev_outstanding = -1;
+  gint running = 1;
+  guint i;
+
+  config.pool = TRUE;
+  config.numa_node = -1;
+  gst_tensor_alloc_configure (&config);
+
+  stats = gst_tensor_alloc_get_stats ();
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "bytes-outstanding", &prev_outstanding));
+  gst_structure_free (stats);
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("alloc", _alloc_thread, &running);
+
+  for (i = 0; i < 200; i++) {
+    /* same as a subplugin changing the alignment (e.g., tvm) */
+    gst_tensor_alloc_init ((i % 2) ? 127 : 0);
+
+    config.pool = (i % 3) != 0;
+    config.hugepage = (i % 4 == 0) ? TENSOR_ALLOC_HUGEPAGE_THP : TENSOR_ALLOC_HUGEPAGE_NONE;
+    config.alignment = (i % 5 == 0) ? 63 : 0;
+    gst_tensor_alloc_configure (&config);
+  }
+
+  g_atomic_int_set (&running, 0);
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  stats = gst_tensor_alloc_get_stats ();
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "bytes-outstanding", &outstanding));
+  EXPECT_EQ (outstanding, prev_outstanding);
+  gst_structure_free (stats);
+
+  /* reset to the system memory allocator */
+  config.alignment = 0;
+  config.pool = FALSE;
+  config.hugepage = TENSOR_ALLOC_HUGEPAGE_NONE;
+  gst_tensor_alloc_configure (&config);
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -11,6 +11,7 @@
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <gst/gst.h>
+#include <json-glib/json-glib.h>
 #include <unittest_util.h>
 
 static const gchar filename[] = "mnist.data";
@@ -313,6 +314,153 @@ TEST (datareposink, writeTensors)
   g_remove ("mnist.json");
 }
 
+/**
+ * @brief Test for writing tensors with the writer thread
+ */
+TEST (datareposink, writeTensorsAsync)
+{
+  GstBus *bus;
+  GMainLoop *loop;
+  GstElement *datareposink = NULL;
+  GstStructure *stats = NULL;
+  gchar *src_data = NULL, *dst_data = NULL;
+  gsize src_size, dst_size;
+  guint64 written = 0, dropped = 0;
+  gboolean async_write;
+  g_autofree gchar *file_path = get_file_path (filename);
+  g_autofree gchar *json_path = get_file_path (json);
+  g_autofree gchar *str_pipeline = g_strdup_printf (
+      "datareposrc location=%s json=%s start-sample-index=0 stop-sample-index=9 is-shuffle=false ! "
+      "datareposink name=datareposink location=async.data json=async.json "
+      "async-write=true max-queued-samples=4 preallocate-size=1048576 fsync-interval=4",
+      file_path, json_path);
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  datareposink = gst_bin_get_by_name (GST_BIN (pipeline), "datareposink");
+  ASSERT_NE (datareposink, nullptr);
+
+  g_object_get (datareposink, "async-write", &async_write, NULL);
+  EXPECT_TRUE (async_write);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT);
+  g_main_loop_run (loop);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+
+  g_object_get (datareposink, "writer-stats", &stats, NULL);
+  ASSERT_NE (stats, nullptr);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "written", &written));
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "dropped", &dropped));
+  EXPECT_EQ (written, 10U);
+  EXPECT_EQ (dropped, 0U);
+  gst_structure_free (stats);
+
+  gst_object_unref (datareposink);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+
+  /* The samples are written in order, and preallocated space is removed. */
+  ASSERT_TRUE (g_file_get_contents (file_path, &src_data, &src_size, NULL));
+  ASSERT_TRUE (g_file_get_contents ("async.data", &dst_data, &dst_size, NULL));
+  ASSERT_LE (dst_size, src_size);
+  EXPECT_GT (dst_size, 0U);
+  EXPECT_EQ (dst_size % 10, 0U);
+  EXPECT_EQ (memcmp (src_data, dst_data, dst_size), 0);
+
+  g_free (src_data);
+  g_free (dst_data);
+
+  g_remove ("async.data");
+  g_remove ("async.json");
+}
+
+/**
+ * @brief Test for dropping samples when the queue of the writer thread is full
+ */
+TEST (datareposink, writeTensorsAsyncDrop)
+{
+  GstBus *bus;
+  GMainLoop *loop;
+  GstElement *datareposink = NULL;
+  GstStructure *stats = NULL;
+  JsonParser *parser;
+  JsonObject *object;
+  gchar *src_data = NULL, *dst_data = NULL;
+  gsize src_size, dst_size;
+  guint64 written = 0, dropped = 0, total_samples, sample_size;
+  gboolean drop;
+  g_autofree gchar *file_path = get_file_path (filename);
+  g_autofree gchar *json_path = get_file_path (json);
+  g_autofree gchar *str_pipeline = g_strdup_printf (
+      "datareposrc location=%s json=%s start-sample-index=0 stop-sample-index=199 is-shuffle=false ! "
+      "datareposink name=datareposink location=drop.data json=drop.json "
+      "async-write=true max-queued-samples=1 drop=true fsync-interval=1",
+      file_path, json_path);
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  datareposink = gst_bin_get_by_name (GST_BIN (pipeline), "datareposink");
+  ASSERT_NE (datareposink, nullptr);
+
+  g_object_get (datareposink, "drop", &drop, NULL);
+  EXPECT_TRUE (drop);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT);
+  g_main_loop_run (loop);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+
+  /* Every sample is written or dropped, the element never blocks. */
+  g_object_get (datareposink, "writer-stats", &stats, NULL);
+  ASSERT_NE (stats, nullptr);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "written", &written));
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "dropped", &dropped));
+  EXPECT_GT (written, 0U);
+  EXPECT_EQ (written + dropped, 200U);
+  gst_structure_free (stats);
+
+  gst_object_unref (datareposink);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+
+  /* The meta refers the written samples only. */
+  parser = json_parser_new ();
+  ASSERT_TRUE (json_parser_load_from_file (parser, "drop.json", NULL));
+  object = json_node_get_object (json_parser_get_root (parser));
+  total_samples = json_object_get_int_member (object, "total_samples");
+  sample_size = json_object_get_int_member (object, "sample_size");
+  EXPECT_EQ (total_samples, written);
+  g_object_unref (parser);
+
+  /* The written samples are in order, without a hole for the dropped one. */
+  ASSERT_TRUE (g_file_get_contents (file_path, &src_data, &src_size, NULL));
+  ASSERT_TRUE (g_file_get_contents ("drop.data", &dst_data, &dst_size, NULL));
+  EXPECT_EQ (dst_size, total_samples * sample_size);
+  ASSERT_LE (dst_size, src_size);
+  EXPECT_EQ (memcmp (src_data, dst_data, sample_size), 0);
+
+  g_free (src_data);
+  g_free (dst_data);
+
+  g_remove ("drop.data");
+  g_remove ("drop.json");
+}
+
 /**
  * @brief Test for writing flexible tensors
  */
@@ -65,6 +65,47 @@ new_data_cb (GstElement *element, GstBuffer *buffer, gint *user_data)
   return;
 }
 
+/**
+ * @brief Run the pipeline until EOS or error.
+ */
+static void
+run_pipeline (const gchar *str_pipeline)
+{
+  GstBus *bus;
+  GMainLoop *loop;
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_main_loop_run (loop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+}
+
+/**
+ * @brief Check two files have the same contents.
+ */
+static void
+expect_same_file (const gchar *file1, const gchar *file2)
+{
+  g_autofree gchar *data1 = NULL, *data2 = NULL;
+  gsize size1 = 0, size2 = 0;
+
+  ASSERT_TRUE (g_file_get_contents (file1, &data1, &size1, NULL));
+  ASSERT_TRUE (g_file_get_contents (file2, &data2, &size2, NULL));
+  EXPECT_GT (size1, 0U);
+  ASSERT_EQ (size1, size2);
+  EXPECT_EQ (memcmp (data1, data2, size1), 0);
+}
+
 /**
  * @brief create sparse tensors file
  */
@@ -566,6 +607,132 @@ TEST (datareposrc, readTensors)
   g_main_loop_unref (loop);
 }
 
+/**
+ * @brief Test for reading tensors with mmap and prefetch, the output should be the same as read().
+ */
+TEST (datareposrc, readTensorsWithMmap)
+{
+  GstBus *bus;
+  GMainLoop *loop;
+  g_autofree gchar *file_path = get_file_path (filename);
+  g_autofree gchar *json_path = get_file_path (json);
+  GstElement *datareposrc = NULL, *tensor_sink = NULL;
+  GstStructure *stats = NULL;
+  gboolean use_mmap;
+  guint prefetch;
+  guint64 samples = 0, bytes = 0;
+  gint buffer_count = 0;
+  g_autofree gchar *str_pipeline = g_strdup_printf (
+      "datareposrc name=datareposrc location=%s json=%s "
+      "start-sample-index=0 stop-sample-index=9 epochs=2 is-shuffle=false use-mmap=true prefetch=4 ! "
+      "tee name=t t. ! queue ! filesink location=mmap.data "
+      "t. ! queue ! tensor_sink name=tensor_sink",
+      file_path, json_path);
+  g_autofree gchar *str_read_pipeline = g_strdup_printf (
+      "datareposrc location=%s json=%s "
+      "start-sample-index=0 stop-sample-index=9 epochs=2 is-shuffle=false use-mmap=false ! "
+      "filesink location=read.data",
+      file_path, json_path);
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  datareposrc = gst_bin_get_by_name (GST_BIN (pipeline), "datareposrc");
+  EXPECT_NE (datareposrc, nullptr);
+
+  tensor_sink = gst_bin_get_by_name (GST_BIN (pipeline), "tensor_sink");
+  EXPECT_NE (tensor_sink, nullptr);
+  g_signal_connect (tensor_sink, "new-data", (GCallback) new_data_cb, &buffer_count);
+
+  g_object_get (datareposrc, "use-mmap", &use_mmap, "prefetch", &prefetch, NULL);
+  EXPECT_TRUE (use_mmap);
+  EXPECT_EQ (prefetch, 4U);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_main_loop_run (loop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (buffer_count, 20);
+
+  g_object_get (datareposrc, "stats", &stats, NULL);
+  ASSERT_NE (stats, nullptr);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "samples", &samples));
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "bytes", &bytes));
+  EXPECT_EQ (samples, 20U);
+  EXPECT_GT (bytes, 0U);
+  gst_structure_free (stats);
+
+  /* the samples wrapped from the mapped file should be the same as read() */
+  run_pipeline (str_read_pipeline);
+  expect_same_file ("mmap.data", "read.data");
+
+  /* restart with an epoch, the statistics are reset */
+  g_object_set (datareposrc, "epochs", 1U, NULL);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_main_loop_run (loop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (buffer_count, 30);
+
+  g_object_get (datareposrc, "stats", &stats, NULL);
+  ASSERT_NE (stats, nullptr);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "samples", &samples));
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "bytes", &bytes));
+  EXPECT_EQ (samples, 10U);
+  EXPECT_GT (bytes, 0U);
+  gst_structure_free (stats);
+
+  gst_object_unref (tensor_sink);
+  gst_object_unref (datareposrc);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+
+  g_remove ("mmap.data");
+  g_remove ("read.data");
+}
+
+/**
+ * @brief Test for reading flexible and sparse tensors with mmap, the output should be the same as read().
+ */
+TEST (datareposrc, readFlexibleSparseTensorsWithMmap)
+{
+  const gchar *types[] = { "flexible", "sparse" };
+  guint i;
+
+  create_flexible_tensors_test_file (10, 5);
+  create_sparse_tensors_test_file (5);
+
+  for (i = 0; i < G_N_ELEMENTS (types); i++) {
+    g_autofree gchar *str_mmap_pipeline = g_strdup_printf (
+        "datareposrc location=%s5.data json=%s5.json is-shuffle=false use-mmap=true prefetch=4 ! "
+        "filesink location=mmap.data",
+        types[i], types[i]);
+    g_autofree gchar *str_read_pipeline = g_strdup_printf (
+        "datareposrc location=%s5.data json=%s5.json is-shuffle=false use-mmap=false ! "
+        "filesink location=read.data",
+        types[i], types[i]);
+
+    run_pipeline (str_mmap_pipeline);
+    run_pipeline (str_read_pipeline);
+    expect_same_file ("mmap.data", "read.data");
+
+    g_remove ("mmap.data");
+    g_remove ("read.data");
+  }
+
+  g_remove ("flexible5.data");
+  g_remove ("flexible5.json");
+  g_remove ("sparse5.data");
+  g_remove ("sparse5.json");
+}
+
 /**
  * @brief Test for reading a file composed of flexible tensors
  * the default shuffle is TRUE.
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics
+#
+# @file generateTest.py
+# @brief Generate yolov5 input tensors with moving boxes and the golden tensor output
+# @author MyungJoo Ham <myungjoo.ham@samsung.com>
+
+from struct import pack
+
+# yolov5 320x320 with 80 classes: 85:6300
+I_WIDTH = 320
+I_HEIGHT = 320
+NUM_INFO = 85
+NUM_BOXES = 6300
+NUM_FRAMES = 9
+
+
+def get_boxes(frame):
+    """Return the boxes (cx, cy, w, h, score, class) in pixels, moving frame by frame.
+    The last frame has no box to check the regions drawn before are cleared.
+    The coordinates are multiples of 10 to be represented exactly in float.
+    """
+    if frame == NUM_FRAMES - 1:
+        return []
+
+    return [
+        (60 + 20 * frame, 100, 40, 40, 0.75, 0),
+        (260 - 20 * frame, 200 + 10 * frame, 80, 40, 0.5, 2),
+    ]
+
+
+def save_input(filename, boxes):
+    data = [0.0] * (NUM_INFO * NUM_BOXES)
+
+    # put the boxes apart in the tensor
+    for i, (cx, cy, w, h, score, cls) in enumerate(boxes):
+        row = i * 100 * NUM_INFO
+        data[row + 0] = cx / I_WIDTH
+        data[row + 1] = cy / I_HEIGHT
+        data[row + 2] = w / I_WIDTH
+        data[row + 3] = h / I_HEIGHT
+        data[row + 4] = 1.0
+        data[row + 5 + cls] = score
+
+    with open(filename, 'wb') as fd:
+        fd.write(pack('%df' % len(data), *data))
+
+
+def save_golden(filename, boxes):
+    """6:N tensor (x:y:width:height:score:class-id) sorted by score, without the flexible header."""
+    data = []
+
+    for (cx, cy, w, h, score, cls) in sorted(boxes, key=lambda b: -b[4]):
+        data += [cx - w / 2, cy - h / 2, w, h, score, cls]
+
+    if not data:
+        data = [0.0, 0.0, 0.0, 0.0, 0.0, -1.0]
+
+    with open(filename, 'wb') as fd:
+        fd.write(pack('%df' % len(data), *data))
+
+
+for f in range(NUM_FRAMES):
+    b = get_boxes(f)
+    save_input('yolov5_moving_input.%d' % f, b)
+    save_golden('yolov5_moving_tensor_golden.%d' % f, b)
@@ -23,6 +23,13 @@ PATH_TO_PLUGIN="../../build"
 CASESTART=0
 CASEEND=1
 
+if [ "$SKIPGEN" == "YES" ]; then
+    echo "Test Case Generation Skipped"
+else
+    echo "Test Case Generation Started"
+    python3 generateTest.py
+fi
+
 # mobilenet-ssd & tflite-ssd(deprecated) case: 4:1:1917:1/f32, 91:1917:1/f32 --> 4:160:120:1
 
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_mux name=mux ! tensor_decoder mode=bounding_boxes option1=mobilenet-ssd option2=coco_labels_list.txt option3=box_priors.txt option4=160:120 option5=300:300 ! videoconvert ! video/x-raw,format=BGRx ! multifilesink location=mobilenetssd_output.%d  multifilesrc name=fs1 location=mobilenetssd_tensors.0.%d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=4:1:1917:1 input-type=float32 ! mux.sink_0  multifilesrc name=fs2 location=mobilenetssd_tensors.1.%d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=91:1917:1 input-type=float32 ! mux.sink_1  " 0 0 0 $PERFORMANCE
@@ -118,6 +125,29 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=yolov8_decode
 
 callCompareTest yolov8_result_golden.raw yolov8_result_0.log "8 diff" "yolov8 golden" 0
 
-rm yolov*.log
+# dirty-rect overlay with moving boxes, the result should be the same with the full overlay
+# 9 frames to reuse the cached canvases, the boxes move in each frame and disappear in the last frame
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=yolov5_moving_input.%1d start-index=0 stop-index=8 caps=application/octet-stream ! tensor_converter input-dim=85:6300:1 input-type=float32 ! tensor_decoder mode=bounding_boxes option1=yolov5 option2=coco-80.txt option3=0:0.25:0.45 option4=320:320 option5=320:320 ! videoconvert ! video/x-raw,format=RGBA ! multifilesink location=yolov5_moving_full_%1d.log" "9-1 yolov5 decoder with moving boxes" 0 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=yolov5_moving_input.%1d start-index=0 stop-index=8 caps=application/octet-stream ! tensor_converter input-dim=85:6300:1 input-type=float32 ! tensor_decoder mode=bounding_boxes option1=yolov5 option2=coco-80.txt option3=0:0.25:0.45 option4=320:320 option5=320:320 option9=dirty-rect ! videoconvert ! video/x-raw,format=RGBA ! multifilesink location=yolov5_moving_dirty_%1d.log" "9-2 yolov5 decoder with dirty-rect" 0 0
+
+for i in 0 1 2 3 4 5 6 7 8; do
+    callCompareTest yolov5_moving_full_${i}.log yolov5_moving_dirty_${i}.log "9-3-${i}" "yolov5 with dirty-rect, frame ${i}" 0
+done
+
+# tensor output without drawing a frame, 6:N tensor (x:y:width:height:score:class-id) after the flexible header (128 bytes)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=yolov5_moving_input.%1d start-index=0 stop-index=8 caps=application/octet-stream ! tensor_converter input-dim=85:6300:1 input-type=float32 ! tensor_decoder mode=bounding_boxes option1=yolov5 option2=coco-80.txt option3=0:0.25:0.45 option5=320:320 option9=tensor ! other/tensors,format=flexible ! multifilesink location=yolov5_moving_tensor_%1d.log" "10-1 yolov5 decoder with tensor output" 0 0
+
+for i in 0 1 2 3 4 5 6 7 8; do
+    tail -c +129 yolov5_moving_tensor_${i}.log > yolov5_moving_tensor_${i}.data.log
+    callCompareTest yolov5_moving_tensor_golden.${i} yolov5_moving_tensor_${i}.data.log "10-2-${i}" "yolov5 tensor output golden, frame ${i}" 0
+done
+
+# the boxes are attached as GstVideoRegionOfInterestMeta
+gst-launch-1.0 -v --gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=yolov5_moving_input.%1d start-index=0 stop-index=0 caps=application/octet-stream ! tensor_converter input-dim=85:6300:1 input-type=float32 ! tensor_decoder mode=bounding_boxes option1=yolov5 option2=coco-80.txt option3=0:0.25:0.45 option5=320:320 option9=tensor ! other/tensors,format=flexible ! fakesink silent=false > yolov5_moving_roi.log 2>&1
+grep -q "GstVideoRegionOfInterestMeta" yolov5_moving_roi.log
+testResult $? "10-3" "yolov5 tensor output with ROI meta" 0 1
+
+rm yolov*.log yolov5_moving_input.* yolov5_moving_tensor_golden.*
 
 report
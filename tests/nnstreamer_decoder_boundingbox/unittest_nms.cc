@@ -0,0 +1,290 @@
+/**
+ * @file	unittest_nms.cc
+ * @date	16 Oct 2026
+ * @brief	Unit test for nms of tensor_decoder::bounding_boxes.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	MyungJoo Ham <myungjoo.ham@samsung.com>
+ * @bug		No known bugs.
+ */
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <string.h>
+#include "tensordec-boundingbox.h"
+
+/**
+ * @brief Compare function of the previous implementation.
+ */
+static gint
+legacy_compare (gconstpointer _a, gconstpointer _b)
+{
+  const detectedObject *a = static_cast<const detectedObject *> (_a);
+  const detectedObject *b = static_cast<const detectedObject *> (_b);
+
+  return (a->prob > b->prob) ? -1 : ((a->prob == b->prob) ? 0 : 1);
+}
+
+/**
+ * @brief IoU of the previous implementation.
+ */
+static gfloat
+legacy_iou (detectedObject *a, detectedObject *b)
+{
+  int x1 = MAX (a->x, b->x);
+  int y1 = MAX (a->y, b->y);
+  int x2 = MIN (a->x + a->width, b->x + b->width);
+  int y2 = MIN (a->y + a->height, b->y + b->height);
+  int w = MAX (0, (x2 - x1 + 1));
+  int h = MAX (0, (y2 - y1 + 1));
+  float inter = w * h;
+  float areaA = a->width * a->height;
+  float areaB = b->width * b->height;
+  float o = inter / (areaA + areaB - inter);
+  return (o >= 0) ? o : 0;
+}
+
+/**
+ * @brief The previous implementation of nms, which is the reference of the results.
+ */
+static void
+legacy_nms (GArray *results, gfloat threshold, gboolean class_aware)
+{
+  guint boxes_size;
+  guint i, j;
+
+  boxes_size = results->len;
+  if (boxes_size == 0U)
+    return;
+
+  g_array_sort (results, legacy_compare);
+
+  for (i = 0; i < boxes_size; i++) {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    if (a->valid == TRUE) {
+      for (j = i + 1; j < boxes_size; j++) {
+        detectedObject *b = &g_array_index (results, detectedObject, j);
+        if (b->valid == TRUE && (!class_aware || a->class_id == b->class_id)) {
+          if (legacy_iou (a, b) > threshold) {
+            b->valid = FALSE;
+          }
+        }
+      }
+    }
+  }
+
+  i = 0;
+  do {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    if (a->valid == FALSE)
+      g_array_remove_index (results, i);
+    else
+      i++;
+  } while (i < results->len);
+}
+
+/**
+ * @brief Generate random candidates as a detection decoder does.
+ * @note The scores are distinct to compare the order with the reference.
+ */
+static GArray *
+generate_candidates (guint num, guint size, guint num_labels, guint32 seed)
+{
+  GRand *rand = g_rand_new_with_seed (seed);
+  GArray *results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num);
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    detectedObject object;
+
+    object.valid = TRUE;
+    object.class_id = g_rand_int_range (rand, 0, num_labels);
+    object.x = g_rand_int_range (rand, 0, size);
+    object.y = g_rand_int_range (rand, 0, size);
+    object.width = g_rand_int_range (rand, 1, size / 4);
+    object.height = g_rand_int_range (rand, 1, size / 4);
+    object.prob = (gfloat) (i + 1) / (gfloat) (num + 1);
+    object.tracking_id = 0;
+    g_array_append_val (results, object);
+  }
+
+  /* shuffle the scores */
+  for (i = num - 1; i > 0; i--) {
+    guint j = g_rand_int_range (rand, 0, i + 1);
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    detectedObject *b = &g_array_index (results, detectedObject, j);
+    gfloat p = a->prob;
+
+    a->prob = b->prob;
+    b->prob = p;
+  }
+
+  g_rand_free (rand);
+  return results;
+}
+
+/**
+ * @brief Copy the candidates.
+ */
+static GArray *
+copy_candidates (GArray *src)
+{
+  GArray *dest = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), src->len);
+
+  g_array_append_vals (dest, src->data, src->len);
+  return dest;
+}
+
+/**
+ * @brief Check nms results with the reference implementation.
+ */
+static void
+check_nms (guint num, guint size, guint num_labels, gboolean class_aware)
+{
+  const guint repeat = 5;
+  nmsOptions options = { 0.45f, class_aware, 0U };
+  guint r, i;
+
+  for (r = 0; r < repeat; r++) {
+    GArray *expected = generate_candidates (num, size, num_labels, r + 1);
+    GArray *results = copy_candidates (expected);
+
+    legacy_nms (expected, options.iou_threshold, class_aware);
+    nms (results, &options);
+
+    ASSERT_EQ (results->len, expected->len);
+    for (i = 0; i < results->len; i++) {
+      EXPECT_EQ (memcmp (&g_array_index (results, detectedObject, i),
+                     &g_array_index (expected, detectedObject, i), sizeof (detectedObject)),
+          0);
+    }
+
+    g_array_free (expected, TRUE);
+    g_array_free (results, TRUE);
+  }
+}
+
+/**
+ * @brief Test nms with the candidates of yolov5 (640x640, 80 labels).
+ */
+TEST (decoderBoundingBoxNms, yolov5)
+{
+  check_nms (25200, 640, 80, FALSE);
+  check_nms (25200, 640, 80, TRUE);
+}
+
+/**
+ * @brief Test nms with the candidates of yolov8 (640x640, 80 labels).
+ */
+TEST (decoderBoundingBoxNms, yolov8)
+{
+  check_nms (8400, 640, 80, FALSE);
+  check_nms (8400, 640, 80, TRUE);
+}
+
+/**
+ * @brief Test nms with the candidates of mobilenet-ssd (300x300, 91 labels).
+ */
+TEST (decoderBoundingBoxNms, mobilenetSsd)
+{
+  check_nms (1917, 300, 91, FALSE);
+  check_nms (1917, 300, 91, TRUE);
+}
+
+/**
+ * @brief Test nms with top-k candidates.
+ */
+TEST (decoderBoundingBoxNms, topK)
+{
+  nmsOptions options = { 0.45f, FALSE, 100U };
+  GArray *expected = generate_candidates (1000, 640, 80, 10);
+  GArray *results = copy_candidates (expected);
+  guint i;
+
+  /* the reference with the candidates of the highest 100 scores */
+  g_array_sort (expected, legacy_compare);
+  g_array_set_size (expected, options.top_k);
+  legacy_nms (expected, options.iou_threshold, FALSE);
+
+  nms (results, &options);
+
+  ASSERT_EQ (results->len, expected->len);
+  EXPECT_LE (results->len, options.top_k);
+  for (i = 0; i < results->len; i++) {
+    EXPECT_EQ (memcmp (&g_array_index (results, detectedObject, i),
+                   &g_array_index (expected, detectedObject, i), sizeof (detectedObject)),
+        0);
+  }
+
+  g_array_free (expected, TRUE);
+  g_array_free (results, TRUE);
+}
+
+/**
+ * @brief Test nms with invalid and overlapped boxes.
+ */
+TEST (decoderBoundingBoxNms, invalidBoxes)
+{
+  detectedObject objects[] = {
+    { TRUE, 0, 10, 10, 50, 50, 0.9f, 0 },
+    { FALSE, 0, 100, 100, 50, 50, 0.95f, 0 },
+    { TRUE, 1, 12, 12, 50, 50, 0.8f, 0 },
+    { TRUE, 0, 11, 11, 50, 50, 0.7f, 0 },
+    { TRUE, 2, 200, 200, 0, 0, 0.6f, 0 },
+  };
+  nmsOptions options = { 0.5f, TRUE, 0U };
+  GArray *results = g_array_new (FALSE, TRUE, sizeof (detectedObject));
+
+  g_array_append_vals (results, objects, G_N_ELEMENTS (objects));
+  nms (results, &options);
+
+  /* invalid box is removed and the box of class 1 is not suppressed by class 0 */
+  ASSERT_EQ (results->len, 3U);
+  EXPECT_FLOAT_EQ (g_array_index (results, detectedObject, 0).prob, 0.9f);
+  EXPECT_EQ (g_array_index (results, detectedObject, 1).class_id, 1);
+  EXPECT_EQ (g_array_index (results, detectedObject, 2).class_id, 2);
+
+  /* the overlapped box of class 1 is suppressed as well */
+  options.class_aware = FALSE;
+  nms (results, &options);
+  ASSERT_EQ (results->len, 2U);
+  EXPECT_EQ (g_array_index (results, detectedObject, 1).class_id, 2);
+
+  g_array_free (results, TRUE);
+}
+
+/**
+ * @brief Test nms with invalid parameters.
+ */
+TEST (decoderBoundingBoxNms, invalidParam_n)
+{
+  nmsOptions options = { 0.5f, FALSE, 0U };
+  GArray *results = g_array_new (FALSE, TRUE, sizeof (detectedObject));
+
+  nms (nullptr, &options);
+  nms (results, nullptr);
+  nms (results, &options);
+  EXPECT_EQ (results->len, 0U);
+
+  g_array_free (results, TRUE);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int ret = -1;
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    ret = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return ret;
+}
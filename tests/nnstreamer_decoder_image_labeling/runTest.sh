@@ -93,6 +93,40 @@ for result in tensordecoder.orange.*.log; do
     let i++
 done
 
+# Decoding top-k labels with the scores, the first one is the label of the highest score
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow2-lite\" model=\"${PATH_TO_MODEL}\" ! \
+tee name=t ! queue ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=3 option4=0.00390625 ! filesink location=\"tensordecoder.topk.uint8.log\" \
+t. ! queue ! tensor_transform mode=typecast option=int32 ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=3 ! filesink location=\"tensordecoder.topk.int32.log\" \
+t. ! queue ! tensor_transform mode=typecast option=float32 ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=3 ! filesink location=\"tensordecoder.topk.float.log\"" D2 0 0 $PERFORMANCE
+let i=1
+for result in tensordecoder.topk.*.log; do
+    lines=$(grep -c "" "${result}")
+    label=$(head -n 1 "${result}" | cut -f 1)
+    if [ "$label" == "orange" ] && [ "$lines" -eq 3 ]; then
+        testResult 1 D2-${i} "Decoding top-k labels"
+    else
+        testResult 0 D2-${i} "Decoding top-k labels"
+    fi
+    let i++
+done
+
+# Decoding top-k labels to tensors, uint32 indices and float32 scores
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow2-lite\" model=\"${PATH_TO_MODEL}\" ! \
+tee name=t ! queue ! tensor_decoder mode=image_labeling option2=3 option3=tensor ! filesink location=\"tensordecoder.tensor.uint8.log\" \
+t. ! queue ! tensor_transform mode=typecast option=float32 ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=3 option3=tensor ! filesink location=\"tensordecoder.tensor.float.log\"" D3 0 0 $PERFORMANCE
+orange_index=$(($(grep -n "^orange$" "${PATH_TO_LABEL}" | cut -d : -f 1) - 1))
+let i=1
+for result in tensordecoder.tensor.*.log; do
+    size=$(stat -c %s "${result}")
+    index=$(od -An -tu4 -N4 "${result}" | tr -d ' ')
+    if [ "$size" -eq 24 ] && [ "$index" -eq "$orange_index" ]; then
+        testResult 1 D3-${i} "Decoding top-k labels to tensors"
+    else
+        testResult 0 D3-${i} "Decoding top-k labels to tensors"
+    fi
+    let i++
+done
+
 rm *.log
 
 report
@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <gst/gst.h>
 
 #include <nnstreamer_plugin_api_filter.h>
@@ -291,6 +292,133 @@ TEST (nnstreamerFilterOnnxRuntime, invoke01_n)
   sp->close (&prop, &data);
 }
 
+/**
+ * @brief Test onnxruntime subplugin with session options and the optimized model cache
+ */
+TEST (nnstreamerFilterOnnxRuntime, invokeCustomProperties)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output[2], output_cached;
+  g_autofree gchar *model_file = NULL;
+  g_autofree gchar *cache_dir = NULL;
+  g_autofree gchar *custom = NULL;
+  const gchar *name;
+  GDir *dir;
+  guint i, num_cached = 0;
+
+  ASSERT_TRUE (_GetModelFilePath (&model_file));
+
+  cache_dir = g_dir_make_tmp ("nns_onnx_cache_XXXXXX", NULL);
+  ASSERT_TRUE (cache_dir != NULL);
+
+  const gchar *model_files[] = {
+    model_file,
+    NULL,
+  };
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("onnxruntime");
+  ASSERT_TRUE (sp != nullptr);
+
+  GstTensorFilterProperties prop;
+  _SetFilterProp (&prop, "onnxruntime", model_files);
+  custom = g_strdup_printf ("NumThreads:2,ExecutionMode:sequential,GraphOptimizationLevel:extended,OptimizedModelCache:%s",
+      cache_dir);
+  prop.custom_properties = custom;
+
+  input.size = sizeof (float) * 224 * 224 * 3 * 1;
+  input.data = g_malloc0 (input.size);
+  for (i = 0; i < input.size / sizeof (float); i++)
+    ((float *) input.data)[i] = (float) (i % 255) / 255.0f;
+
+  for (i = 0; i < 2; i++) {
+    output[i].size = sizeof (float) * 1000 * 1;
+    output[i].data = g_malloc0 (output[i].size);
+  }
+  output_cached.size = sizeof (float) * 1000 * 1;
+  output_cached.data = g_malloc0 (output_cached.size);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+
+  /* the binding is re-pointed when the output buffer is changed */
+  EXPECT_EQ (sp->invoke (NULL, &prop, data, &input, &output[0]), 0);
+  EXPECT_EQ (sp->invoke (NULL, &prop, data, &input, &output[1]), 0);
+  EXPECT_EQ (memcmp (output[0].data, output[1].data, output[0].size), 0);
+  sp->close (&prop, &data);
+
+  /* the optimized model is stored */
+  dir = g_dir_open (cache_dir, 0, NULL);
+  ASSERT_TRUE (dir != NULL);
+  while ((name = g_dir_read_name (dir)) != NULL) {
+    EXPECT_TRUE (g_str_has_suffix (name, ".onnx"));
+    num_cached++;
+  }
+  g_dir_close (dir);
+  EXPECT_EQ (num_cached, 1U);
+
+  /* open again with the cached model */
+  data = NULL;
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (sp->invoke (NULL, &prop, data, &input, &output_cached), 0);
+  for (i = 0; i < output_cached.size / sizeof (float); i++)
+    EXPECT_NEAR (((float *) output_cached.data)[i], ((float *) output[0].data)[i], 1e-4);
+  sp->close (&prop, &data);
+
+  dir = g_dir_open (cache_dir, 0, NULL);
+  if (dir) {
+    while ((name = g_dir_read_name (dir)) != NULL) {
+      g_autofree gchar *path = g_build_filename (cache_dir, name, NULL);
+      g_remove (path);
+    }
+    g_dir_close (dir);
+  }
+  g_rmdir (cache_dir);
+
+  g_free (input.data);
+  g_free (output[0].data);
+  g_free (output[1].data);
+  g_free (output_cached.data);
+}
+
+/**
+ * @brief Invalid or unknown custom properties are ignored with the default values
+ */
+TEST (nnstreamerFilterOnnxRuntime, ignoredCustomProperties)
+{
+  const gchar *customs[] = {
+    "GraphOptimizationLevel:invalid",
+    "ExecutionMode:invalid",
+    "OptimizedModelCache:/invalid/cache/dir",
+    "UnknownOption:true",
+    "NoValue",
+  };
+  void *data;
+  guint i;
+  g_autofree gchar *model_file = NULL;
+
+  ASSERT_TRUE (_GetModelFilePath (&model_file));
+
+  const gchar *model_files[] = {
+    model_file,
+    NULL,
+  };
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("onnxruntime");
+  ASSERT_TRUE (sp != nullptr);
+
+  GstTensorFilterProperties prop;
+  _SetFilterProp (&prop, "onnxruntime", model_files);
+
+  for (i = 0; i < G_N_ELEMENTS (customs); i++) {
+    data = NULL;
+    prop.custom_properties = customs[i];
+    EXPECT_EQ (sp->open (&prop, &data), 0) << customs[i];
+    sp->close (&prop, &data);
+  }
+}
+
 /**
  * @brief Negative case to launch gst pipeline: wrong dimension
  */
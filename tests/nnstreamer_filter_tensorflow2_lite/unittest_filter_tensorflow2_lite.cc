@@ -286,6 +286,67 @@ TEST (nnstreamerFilterTensorFlow2Lite, floatModelXNNPACKResult)
   g_free (is_float);
 }
 
+/**
+ * @brief Signal to keep the first output buffer in tensor_sink.
+ */
+static void
+hold_output (GstElement *element, GstBuffer *buffer, gpointer user_data)
+{
+  GstBuffer **held = (GstBuffer **) user_data;
+  UNUSED (element);
+
+  if (g_atomic_pointer_get (held) == NULL) {
+    gst_buffer_ref (buffer);
+    if (!g_atomic_pointer_compare_and_exchange (held, NULL, buffer))
+      gst_buffer_unref (buffer);
+  }
+}
+
+/**
+ * @brief Hold the output buffer of the interpreter (ZeroCopy) after the pipeline is stopped.
+ */
+TEST (nnstreamerFilterTensorFlow2Lite, floatModelZeroCopyHold)
+{
+  gchar *pipeline;
+  GstElement *gstpipe;
+  GError *err = NULL;
+  gchar *model_file, *input_file;
+  GstBuffer *held = NULL;
+  guint8 is_float = 1;
+
+  ASSERT_TRUE (_GetModelFilePath (&model_file, 1));
+  ASSERT_TRUE (_GetOrangePngFilePath (&input_file));
+
+  /* create a nnstreamer pipeline */
+  pipeline = g_strdup_printf ("filesrc location=\"%s\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw,format=RGB,width=224,height=224,framerate=20/1 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 ! tensor_filter framework=tensorflow2-lite model=\"%s\" custom=Delegate:XNNPACK,NumThreads:4,ZeroCopy:true ! tensor_sink name=sink",
+      input_file, model_file);
+
+  gstpipe = gst_parse_launch (pipeline, &err);
+  ASSERT_TRUE (gstpipe != nullptr);
+
+  GstElement *sink_handle = gst_bin_get_by_name (GST_BIN (gstpipe), "sink");
+  ASSERT_TRUE (sink_handle != nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback) hold_output, &held);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT * 10),
+      0);
+  g_usleep (1000 * 1000); // wait for 1 second to receive the output
+
+  /* the model is closed while the buffer is held */
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  ASSERT_TRUE (held != NULL);
+  check_output (NULL, held, &is_float);
+  gst_buffer_unref (held);
+
+  gst_object_unref (sink_handle);
+  gst_object_unref (gstpipe);
+  g_free (pipeline);
+  g_free (model_file);
+  g_free (input_file);
+}
+
 /**
  * @brief Signal to validate the result in tensor_sink of 32 input/output model.
  */
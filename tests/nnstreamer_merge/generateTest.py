@@ -100,3 +100,10 @@ for n in range(0, 3):
 out = pack('%df' % (len(out_data)), *out_data)
 with open("batch.golden", 'wb') as file:
     file.write(out)
+
+# split batch_3 into the batches 1 and 2, then merge them in reversed order
+out_data = buf[2][width * height * ch:] + buf[2][:width * height * ch]
+
+out = pack('%df' % (len(out_data)), *out_data)
+with open("split_batch_reversed.golden", 'wb') as file:
+    file.write(out)
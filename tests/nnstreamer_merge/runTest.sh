@@ -163,6 +163,31 @@ callCompareTest testsynch08_1.golden testsynch08_1.log 19-2 "Compare 19-2" 1 0
 callCompareTest testsynch08_2.golden testsynch08_2.log 19-3 "Compare 19-3" 1 0
 callCompareTest testsynch08_3.golden testsynch08_3.log 19-4 "Compare 19-4" 1 0
 
+# Test Case for num-threads. The output should be same regardless of the number of threads.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=0 num-threads=4 ! filesink location=channel_mt.log filesrc location=channel_00.dat blocksize=60000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:50:100:1 input-type=float32 ! merge.sink_0 filesrc location=channel_01.dat blocksize=40000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=2:50:100:1 input-type=float32 ! merge.sink_1 filesrc location=channel_02.dat blocksize=80000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=4:50:100:1 input-type=float32 ! merge.sink_2" 20 0 0 $PERFORMANCE
+
+callCompareTest channel.golden channel_mt.log 20 "Compare 20" 1 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=3 num-threads=4 ! filesink location=batch_mt.log filesrc location=batch_1.dat blocksize=60000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:1 input-type=float32 ! merge.sink_0 filesrc location=batch_2.dat blocksize=120000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:2 input-type=float32 ! merge.sink_1 filesrc location=batch_3.dat blocksize=180000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:3 input-type=float32 ! merge.sink_2" 21 0 0 $PERFORMANCE
+
+callCompareTest batch.golden batch_mt.log 21 "Compare 21" 1 0
+
+# Large frames are copied with multiple threads, compare with the output of the streaming thread.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=0 ! filesink location=large_st.log videotestsrc num-buffers=3 pattern=13 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=30/1 ! tensor_converter ! merge.sink_0 videotestsrc num-buffers=3 pattern=18 ! video/x-raw,format=GRAY8,width=1920,height=1080,framerate=30/1 ! tensor_converter ! merge.sink_1" 22-1 0 0 $PERFORMANCE
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=0 num-threads=4 ! filesink location=large_mt.log videotestsrc num-buffers=3 pattern=13 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=30/1 ! tensor_converter ! merge.sink_0 videotestsrc num-buffers=3 pattern=18 ! video/x-raw,format=GRAY8,width=1920,height=1080,framerate=30/1 ! tensor_converter ! merge.sink_1" 22-2 0 0 $PERFORMANCE
+
+callCompareTest large_st.log large_mt.log 22 "Compare 22" 1 0
+
+# The segments of tensor_split share adjacent regions of the incoming memory, tensor_merge along the outermost rank spans them without copying.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=batch_3.dat blocksize=180000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:3 input-type=float32 ! tensor_split name=split tensorseg=3:100:50:1,3:100:50:2 tensor_merge name=merge mode=linear option=3 ! filesink location=split_batch.log split.src_0 ! queue ! merge.sink_0 split.src_1 ! queue ! merge.sink_1" 23-1 0 0 $PERFORMANCE
+
+callCompareTest batch_3.dat split_batch.log 23-1 "Compare 23-1" 1 0
+
+# Not adjacent in the order of the sink pads, the segments are copied.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=batch_3.dat blocksize=180000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:3 input-type=float32 ! tensor_split name=split tensorseg=3:100:50:1,3:100:50:2 tensor_merge name=merge mode=linear option=3 ! filesink location=split_batch_reversed.log split.src_1 ! queue ! merge.sink_0 split.src_0 ! queue ! merge.sink_1" 23-2 0 0 $PERFORMANCE
+
+callCompareTest split_batch_reversed.golden split_batch_reversed.log 23-2 "Compare 23-2" 1 0
+
 rm *.log *.bmp *.png *.golden *.raw *.dat
 
 report
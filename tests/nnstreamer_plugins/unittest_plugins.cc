@@ -1947,6 +1947,191 @@ TEST (testTensorTransform, arithmeticPerChannel)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_transform arithmetic (normalize and transpose in the same pass)
+ */
+TEST (testTensorTransform, arithmeticTranspose)
+{
+  const guint num_buffers = 3;
+  const guint ch = 3, width = 64, height = 48;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, c, x, y;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
+      "typecast:float32,add:-127.5,div:127.5,transpose:1:2:0:3", NULL);
+  g_object_set (h->element, "acceleration", (gboolean) TRUE, NULL);
+
+  /* input tensor info, NHWC (larger than a block of fused operators) */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_FLOAT32;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (y = 0; y < height; y++) {
+      for (x = 0; x < width; x++) {
+        for (c = 0; c < ch; c++) {
+          ((uint8_t *) info.data)[c + ch * (x + width * y)] =
+              (uint8_t) (c * 50 + x + y + b);
+        }
+      }
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    /* output is NCHW (64:48:3:1) */
+    for (c = 0; c < ch; c++) {
+      for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+          float expected = ((float) (uint8_t) (c * 50 + x + y + b) - 127.5f) / 127.5f;
+          EXPECT_FLOAT_EQ (((float *) info.data)[x + width * (y + height * c)], expected);
+        }
+      }
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform, the output should be same with both values of the property.
+ * @details num-threads: multiple threads with the tiles larger than a tile.
+ *          acceleration: the result with orc and without orc.
+ */
+TEST (testTensorTransform, compareProperties)
+{
+  const struct {
+    const gchar *property;
+    const gchar *values[2];
+    const gchar *dimension;
+    const gchar *mode;
+    const gchar *option;
+  } cases[] = {
+    { "num-threads", { "1", "4" }, "3:320:240:1", "arithmetic",
+        "typecast:float32,per-channel:true@0,add:-127.5,div:127.5@1" },
+    { "num-threads", { "1", "4" }, "3:320:240:1", "arithmetic",
+        "typecast:float32,add:-127.5,div:127.5,transpose:1:2:0:3" },
+    { "num-threads", { "1", "4" }, "3:320:240:1", "transpose", "1:2:0:3" },
+    { "num-threads", { "1", "4" }, "3:320:240:1", "stand",
+        "default:float32,per-channel:true" },
+    { "num-threads", { "1", "4" }, "3:320:240:1", "clamp", "10:200" },
+    { "num-threads", { "1", "4" }, "3:320:240:1", "padding",
+        "left:1,right:2,top:1,bottom:2" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "arithmetic",
+        "typecast:int64,add:-100,mul:3" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "arithmetic",
+        "typecast:uint64,add:5,div:3" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "arithmetic",
+        "typecast:int16,add:-100,div:7" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "arithmetic",
+        "typecast:uint8,div:3" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "typecast", "int64" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "stand",
+        "default:float32" },
+    { "acceleration", { "false", "true" }, "3:160:120:1", "stand",
+        "dc-average:float64,per-channel:true" },
+  };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf[2];
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info, info2;
+  guint i, c, t;
+  gsize data_size;
+
+  for (c = 0; c < G_N_ELEMENTS (cases); c++) {
+    /* input tensor info */
+    gst_tensors_config_init (&config);
+    config.info.num_tensors = 1U;
+    config.info.info[0].type = _NNS_UINT8;
+    gst_tensor_parse_dimension (cases[c].dimension, config.info.info[0].dimension);
+    config.rate_n = 0;
+    config.rate_d = 1;
+    data_size = gst_tensors_info_get_size (&config.info, 0);
+
+    for (t = 0; t < 2; t++) {
+      h = gst_harness_new ("tensor_transform");
+
+      /* num-threads is applied when the element starts */
+      gst_element_set_state (h->element, GST_STATE_READY);
+      gst_util_set_object_arg (G_OBJECT (h->element), "mode", cases[c].mode);
+      g_object_set (h->element, "option", cases[c].option, NULL);
+      gst_util_set_object_arg (G_OBJECT (h->element), cases[c].property,
+          cases[c].values[t]);
+      gst_harness_play (h);
+      gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+      in_buf = gst_harness_create_buffer (h, data_size);
+      mem = gst_buffer_peek_memory (in_buf, 0);
+      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+      for (i = 0; i < data_size; i++)
+        ((uint8_t *) info.data)[i] = (uint8_t) (i * 7 + i / config.info.info[0].dimension[1]);
+      gst_memory_unmap (mem, &info);
+
+      EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+      out_buf[t] = gst_harness_pull (h);
+      ASSERT_TRUE (out_buf[t] != NULL);
+
+      gst_harness_teardown (h);
+    }
+
+    /* compare the result */
+    ASSERT_EQ (gst_buffer_get_size (out_buf[0]), gst_buffer_get_size (out_buf[1]));
+
+    mem = gst_buffer_peek_memory (out_buf[0], 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    mem = gst_buffer_peek_memory (out_buf[1], 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info2, GST_MAP_READ));
+
+    EXPECT_EQ (memcmp (info.data, info2.data, info.size), 0)
+        << cases[c].property << " " << cases[c].mode << " " << cases[c].option;
+
+    gst_memory_unmap (gst_buffer_peek_memory (out_buf[0], 0), &info);
+    gst_memory_unmap (gst_buffer_peek_memory (out_buf[1], 0), &info2);
+    gst_buffer_unref (out_buf[0]);
+    gst_buffer_unref (out_buf[1]);
+  }
+}
+
 /**
  * @brief Test for tensor_transform arithmetic (changing option string dynamically)
  */
@@ -2759,6 +2944,65 @@ TEST (testTensorAggregator, flushData)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_aggregator (sliding window, overlapped frames are shared)
+ */
+TEST (testTensorAggregator, slidingWindow)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *out1, *out2;
+  GstMapInfo map1, map2;
+  gint i, expected[3];
+  guint received;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_aggregator");
+
+  g_object_set (h->element, "frames-in", 1, "frames-out", 3, "frames-flush", 1,
+      "frames-dim", 0, NULL);
+
+  /* set input tensor info and pad caps */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push 40 frames, the ring is rewound several times */
+  for (i = 0; i < 40; i++)
+    _aggregator_test_push_buffer (h, &i, data_size);
+
+  received = _harness_wait_for_output_buffer (h, 38U);
+  EXPECT_EQ (received, 38U);
+
+  /* 1st and 2nd windows share the frames */
+  out1 = gst_harness_pull (h);
+  out2 = gst_harness_pull (h);
+  ASSERT_TRUE (gst_buffer_map (out1, &map1, GST_MAP_READ));
+  ASSERT_TRUE (gst_buffer_map (out2, &map2, GST_MAP_READ));
+  EXPECT_EQ (((gint *) map1.data)[0], 0);
+  EXPECT_EQ (((gint *) map2.data)[0], 1);
+  EXPECT_TRUE (map1.data + sizeof (gint) == map2.data);
+  gst_buffer_unmap (out1, &map1);
+  gst_buffer_unmap (out2, &map2);
+  gst_buffer_unref (out1);
+  gst_buffer_unref (out2);
+
+  for (i = 2; i < 38; i++) {
+    expected[0] = i;
+    expected[1] = i + 1;
+    expected[2] = i + 2;
+    _aggregator_test_check_output (h, expected, 3);
+  }
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_aggregator (supposed multi clients using tensor-meta)
  */
@@ -3672,6 +3916,134 @@ TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_converter (video preprocessing, resize and normalize to NCHW float tensor)
+ */
+TEST (testTensorConverter, videoPreprocess)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint8 *input;
+  gfloat *output;
+  guint x, y;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "video-preprocess",
+      "width:2,height:1,order:rgb,layout:nchw,type:float32,std:255,method:nearest",
+      NULL);
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=BGRx,width=4,height=2,framerate=0/1");
+
+  /* BGRx, B = 10 * y + x, G = B + 100, R = B + 200 */
+  in_buf = gst_harness_create_buffer (h, 4 * 4 * 2);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  input = (guint8 *) map.data;
+  for (y = 0; y < 2; y++) {
+    for (x = 0; x < 4; x++) {
+      input[(y * 4 + x) * 4] = 10 * y + x;
+      input[(y * 4 + x) * 4 + 1] = 100 + 10 * y + x;
+      input[(y * 4 + x) * 4 + 2] = 200 + 10 * y + x;
+      input[(y * 4 + x) * 4 + 3] = 0;
+    }
+  }
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (_harness_wait_for_output_buffer (h, 1U), 1U);
+
+  /* 2:1:3:1 float32, pixels (1,1) and (3,1) */
+  out_buf = gst_harness_pull (h);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 2 * 3 * sizeof (gfloat));
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  output = (gfloat *) map.data;
+  EXPECT_FLOAT_EQ (output[0], 211.0 / 255.0);
+  EXPECT_FLOAT_EQ (output[1], 213.0 / 255.0);
+  EXPECT_FLOAT_EQ (output[2], 111.0 / 255.0);
+  EXPECT_FLOAT_EQ (output[3], 113.0 / 255.0);
+  EXPECT_FLOAT_EQ (output[4], 11.0 / 255.0);
+  EXPECT_FLOAT_EQ (output[5], 13.0 / 255.0);
+  gst_memory_unmap (mem, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (video preprocessing, color order with stride padding)
+ */
+TEST (testTensorConverter, videoPreprocessStride)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint8 *input, *output;
+  guint i, x, y;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "video-preprocess", "order:bgr", NULL);
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=RGB,width=3,height=2,framerate=0/1");
+
+  /* RGB, width 3 has 3 bytes of padding in each row */
+  in_buf = gst_harness_create_buffer (h, 12 * 2);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  input = (guint8 *) map.data;
+  for (i = 0; i < 12 * 2; i++)
+    input[i] = i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (_harness_wait_for_output_buffer (h, 1U), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 3U * 3 * 2);
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  output = (guint8 *) map.data;
+  for (y = 0; y < 2; y++) {
+    for (x = 0; x < 3; x++) {
+      EXPECT_EQ (output[(y * 3 + x) * 3], y * 12 + x * 3 + 2);
+      EXPECT_EQ (output[(y * 3 + x) * 3 + 1], y * 12 + x * 3 + 1);
+      EXPECT_EQ (output[(y * 3 + x) * 3 + 2], y * 12 + x * 3);
+    }
+  }
+  gst_memory_unmap (mem, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (video preprocessing, invalid option)
+ */
+TEST (testTensorConverter, videoPreprocessInvalidOption_n)
+{
+  GstHarness *h;
+  gchar *str;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "video-preprocess", "width:0,layout:nchw", NULL);
+  g_object_get (h->element, "video-preprocess", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_set (h->element, "video-preprocess", "std:0", NULL);
+  g_object_get (h->element, "video-preprocess", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  gst_harness_teardown (h);
+}
+
 #ifdef HAVE_ORC
 #include "nnstreamer-orc.h"
 
@@ -7519,6 +7891,253 @@ TEST (testTensorCrop, cropTensor)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Internal function to check the resized regions (float32).
+ */
+static void
+_crop_test_compare_resized (crop_test_data_s *crop_test, const gchar *dimstr,
+    const gfloat *expected, guint num)
+{
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  tensor_dim dim;
+  gsize hsize;
+  guint i;
+  gfloat *resized;
+
+  out_buf = gst_harness_pull (crop_test->crop);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+  gst_tensor_meta_info_parse_header (&meta, map.data);
+  gst_tensor_parse_dimension (dimstr, dim);
+  EXPECT_EQ (meta.type, _NNS_FLOAT32);
+  for (i = 0; i < 4; i++)
+    EXPECT_EQ (meta.dimension[i], dim[i]);
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  EXPECT_EQ (map.size, hsize + sizeof (gfloat) * num);
+  EXPECT_EQ (gst_tensor_meta_info_get_data_size (&meta), sizeof (gfloat) * num);
+
+  resized = (gfloat *) (map.data + hsize);
+  for (i = 0; i < num; i++)
+    EXPECT_FLOAT_EQ (resized[i], expected[i]);
+
+  gst_memory_unmap (mem, &map);
+  gst_buffer_unref (out_buf);
+}
+
+/**
+ * @brief Test for tensor_crop (resize and pack the regions).
+ */
+TEST (testTensorCrop, cropResize)
+{
+  crop_test_data_s crop_test;
+  guint i;
+  gfloat *_data;
+  guint *_info;
+  gchar *str;
+  const gfloat expected1[] = { 18.5f, 20.5f, 16.0f, 17.0f };
+
+  _crop_test_init (&crop_test);
+  g_object_set (crop_test.crop->element, "resize", "2:1", NULL);
+  g_object_get (crop_test.crop->element, "resize", &str, NULL);
+  EXPECT_STREQ (str, "2:1");
+  g_free (str);
+
+  /* prepare test data */
+  crop_test.raw_info.type = _NNS_FLOAT32;
+
+  crop_test.raw_size = sizeof (gfloat) * 40U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (gfloat *) crop_test.raw_data;
+
+  /* 1 ch, value of (x, y) is (1 + x + 10 * y) */
+  for (i = 0; i < 40; i++)
+    _data[i] = (gfloat) (i + 1);
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 8U;
+  crop_test.info_num = 2U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* crop info [2, 1, 4, 2] [0, 0, 2, 4], resized to 2x1 */
+  _info[0] = 2U;
+  _info[1] = 1U;
+  _info[2] = 4U;
+  _info[3] = 2U;
+  _info[4] = 0U;
+  _info[5] = 0U;
+  _info[6] = 2U;
+  _info[7] = 4U;
+
+  gst_tensor_parse_dimension ("1:10:4:1", crop_test.raw_info.dimension);
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0)
+    _crop_test_compare_resized (&crop_test, "1:2:1:2", expected1, 4U);
+
+  /* resize options cannot be changed in playing state */
+  g_object_set (crop_test.crop->element, "resize", "4:4", NULL);
+  g_object_get (crop_test.crop->element, "resize", &str, NULL);
+  EXPECT_STREQ (str, "2:1");
+  g_free (str);
+
+  g_object_set (crop_test.crop->element, "resize-layout", "nchw", NULL);
+  g_object_get (crop_test.crop->element, "resize-layout", &str, NULL);
+  EXPECT_STREQ (str, "nhwc");
+  g_free (str);
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop (resize and pack the regions in nchw layout).
+ */
+TEST (testTensorCrop, cropResizeNchw)
+{
+  crop_test_data_s crop_test;
+  guint i;
+  gfloat *_data;
+  guint *_info;
+  gchar *str;
+  const gfloat expected[] = { 2.5f, 4.5f, 102.5f, 104.5f };
+
+  _crop_test_init (&crop_test);
+  g_object_set (crop_test.crop->element, "resize", "2:1", NULL);
+  g_object_set (crop_test.crop->element, "resize-layout", "nchw", NULL);
+  g_object_get (crop_test.crop->element, "resize-layout", &str, NULL);
+  EXPECT_STREQ (str, "nchw");
+  g_free (str);
+
+  /* 2 ch, value of (c, x, y) is (100 * c + x + 4 * y), packed in nchw layout */
+  crop_test.raw_info.type = _NNS_FLOAT32;
+
+  crop_test.raw_size = sizeof (gfloat) * 16U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (gfloat *) crop_test.raw_data;
+
+  for (i = 0; i < 16; i++)
+    _data[i] = (gfloat) (100 * (i % 2) + (i / 2));
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 4U;
+  crop_test.info_num = 1U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* crop info [0, 0, 4, 2], resized to 2x1 */
+  _info[0] = 0U;
+  _info[1] = 0U;
+  _info[2] = 4U;
+  _info[3] = 2U;
+
+  gst_tensor_parse_dimension ("2:4:2:1", crop_test.raw_info.dimension);
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0)
+    _crop_test_compare_resized (&crop_test, "2:1:2:1", expected, 4U);
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop (resize uint32 regions without losing precision).
+ */
+TEST (testTensorCrop, cropResizeUint32)
+{
+  crop_test_data_s crop_test;
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  gsize hsize;
+  guint *_data, *_info, *resized;
+
+  _crop_test_init (&crop_test);
+  g_object_set (crop_test.crop->element, "resize", "1:1", NULL);
+
+  /* the values cannot be represented in float */
+  crop_test.raw_info.type = _NNS_UINT32;
+
+  crop_test.raw_size = sizeof (guint) * 2U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (guint *) crop_test.raw_data;
+  _data[0] = 4000000001U;
+  _data[1] = 4000000003U;
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 4U;
+  crop_test.info_num = 1U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* crop info [0, 0, 2, 1], resized to 1x1 */
+  _info[0] = 0U;
+  _info[1] = 0U;
+  _info[2] = 2U;
+  _info[3] = 1U;
+
+  gst_tensor_parse_dimension ("1:2:1:1", crop_test.raw_info.dimension);
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0) {
+    out_buf = gst_harness_pull (crop_test.crop);
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+    gst_tensor_meta_info_parse_header (&meta, map.data);
+    EXPECT_EQ (meta.type, _NNS_UINT32);
+
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+    EXPECT_EQ (map.size, hsize + sizeof (guint));
+
+    resized = (guint *) (map.data + hsize);
+    EXPECT_EQ (resized[0], 4000000002U);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop (invalid resize property).
+ */
+TEST (testTensorCrop, invalidResize_n)
+{
+  GstHarness *h;
+  gchar *str;
+
+  h = gst_harness_new_with_padnames ("tensor_crop", NULL, "src");
+
+  g_object_set (h->element, "resize", "224", NULL);
+  g_object_get (h->element, "resize", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_set (h->element, "resize", "0:224", NULL);
+  g_object_get (h->element, "resize", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_set (h->element, "resize-layout", "invalid", NULL);
+  g_object_get (h->element, "resize-layout", &str, NULL);
+  EXPECT_STREQ (str, "nhwc");
+  g_free (str);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_crop, invalid property name.
  */
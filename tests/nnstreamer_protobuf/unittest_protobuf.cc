@@ -0,0 +1,328 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file        unittest_protobuf.cc
+ * @date        16 Oct 2026
+ * @brief       Unit test for protobuf subplugin of tensor converter and decoder
+ * @see         https://github.com/nnstreamer/nnstreamer
+ * @author      Gichan Jang <gichan2.jang@samsung.com>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_util.h>
+#include <string>
+#include "nnstreamer.pb.h"
+#include "nnstreamer_protobuf.h"
+
+#define TEST_NUM_TENSORS (2U)
+
+/**
+ * @brief Prepare the tensors config and data to be serialized.
+ */
+static void
+_prepare_tensors (GstTensorsConfig *config, GstTensorMemory *input)
+{
+  guint i, j;
+
+  gst_tensors_config_init (config);
+  config->rate_n = 30;
+  config->rate_d = 1;
+  config->info.num_tensors = TEST_NUM_TENSORS;
+
+  config->info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:4:2:1", config->info.info[0].dimension);
+  config->info.info[1].name = g_strdup ("2nd_tensor");
+  config->info.info[1].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("10:20", config->info.info[1].dimension);
+
+  for (i = 0; i < TEST_NUM_TENSORS; i++) {
+    input[i].size = gst_tensors_info_get_size (&config->info, i);
+    input[i].data = g_malloc (input[i].size);
+
+    for (j = 0; j < input[i].size; j++)
+      ((guint8 *) input[i].data)[j] = (guint8) (i * 31 + j);
+  }
+}
+
+/**
+ * @brief Free the tensors config and data.
+ */
+static void
+_free_tensors (GstTensorsConfig *config, GstTensorMemory *input)
+{
+  guint i;
+
+  for (i = 0; i < config->info.num_tensors; i++)
+    g_free (input[i].data);
+
+  gst_tensors_config_free (config);
+}
+
+/**
+ * @brief Serialize the tensors with the message of generated code.
+ */
+static std::string
+_serialize_message (const GstTensorsConfig *config, const GstTensorMemory *input,
+    guint num_tensor_field, guint num_tensors)
+{
+  nnstreamer::protobuf::Tensors tensors;
+  nnstreamer::protobuf::Tensors::frame_rate *fr;
+  GstTensorInfo *_info;
+  std::string serialized;
+  guint i, j;
+
+  tensors.set_num_tensor (num_tensor_field);
+  fr = tensors.mutable_fr ();
+  fr->set_rate_n (config->rate_n);
+  fr->set_rate_d (config->rate_d);
+
+  for (i = 0; i < num_tensors; i++) {
+    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
+    guint idx = i % config->info.num_tensors;
+
+    _info = gst_tensors_info_get_nth_info ((GstTensorsInfo *) &config->info, idx);
+
+    tensor->set_name (_info->name ? _info->name : "");
+    tensor->set_type ((nnstreamer::protobuf::Tensor::Tensor_type) _info->type);
+    for (j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
+      tensor->add_dimension (_info->dimension[j]);
+    tensor->set_data (input[idx].data, input[idx].size);
+  }
+
+  tensors.set_format ((nnstreamer::protobuf::Tensors::Tensor_format) config->info.format);
+
+  EXPECT_TRUE (tensors.SerializeToString (&serialized));
+  return serialized;
+}
+
+/**
+ * @brief Create a buffer with the copied data.
+ */
+static GstBuffer *
+_new_buffer (const void *data, gsize size)
+{
+  return gst_buffer_new_wrapped (_g_memdup (data, size), size);
+}
+
+/**
+ * @brief Check the converted tensors with the original config and data.
+ */
+static void
+_check_converted (GstBuffer *buf, const GstTensorsConfig *config,
+    const GstTensorsConfig *expected, const GstTensorMemory *input)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i;
+
+  ASSERT_TRUE (buf != NULL);
+  EXPECT_EQ (gst_buffer_n_memory (buf), expected->info.num_tensors);
+  EXPECT_EQ (config->rate_n, expected->rate_n);
+  EXPECT_EQ (config->rate_d, expected->rate_d);
+  EXPECT_TRUE (gst_tensors_info_is_equal (&config->info, &expected->info));
+  EXPECT_TRUE (config->info.info[0].name == NULL);
+  EXPECT_STREQ (config->info.info[1].name, "2nd_tensor");
+
+  for (i = 0; i < expected->info.num_tensors; i++) {
+    mem = gst_buffer_peek_memory (buf, i);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, input[i].size);
+    EXPECT_EQ (memcmp (map.data, input[i].data, input[i].size), 0);
+    gst_memory_unmap (mem, &map);
+  }
+}
+
+/**
+ * @brief Test the serialized tensors are same as the message of generated code.
+ */
+TEST (testProtobuf, decodeSameAsMessage)
+{
+  GstTensorsConfig config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *out_buf;
+  GstMapInfo map;
+  std::string expected;
+
+  _prepare_tensors (&config, input);
+  expected = _serialize_message (&config, input, TEST_NUM_TENSORS, TEST_NUM_TENSORS);
+
+  out_buf = gst_buffer_new ();
+  EXPECT_EQ (gst_tensor_decoder_protobuf (&config, input, out_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, expected.size ());
+  EXPECT_EQ (memcmp (map.data, expected.data (), MIN (map.size, expected.size ())), 0);
+  gst_buffer_unmap (out_buf, &map);
+
+  gst_buffer_unref (out_buf);
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Test the message of generated code is converted to the tensors.
+ */
+TEST (testProtobuf, convertMessage)
+{
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *in_buf, *out_buf;
+  std::string serialized;
+
+  _prepare_tensors (&config, input);
+  serialized = _serialize_message (&config, input, TEST_NUM_TENSORS, TEST_NUM_TENSORS);
+
+  gst_tensors_config_init (&check_config);
+  in_buf = _new_buffer (serialized.data (), serialized.size ());
+  out_buf = gst_tensor_converter_protobuf (in_buf, &check_config, NULL);
+
+  _check_converted (out_buf, &check_config, &config, input);
+
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_tensors_config_free (&check_config);
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Test the unknown fields in the message are skipped.
+ */
+TEST (testProtobuf, convertUnknownField)
+{
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *in_buf, *out_buf;
+  std::string serialized;
+  /* field 15 (varint 1), field 16 (length-delimited "abc"), field 17 (fixed32) and field 18 (fixed64) */
+  const guint8 unknown[] = { 0x78, 0x01, 0x82, 0x01, 0x03, 'a', 'b', 'c', 0x8d, 0x01,
+    0x01, 0x02, 0x03, 0x04, 0x91, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+  _prepare_tensors (&config, input);
+  serialized = _serialize_message (&config, input, TEST_NUM_TENSORS, TEST_NUM_TENSORS);
+  serialized.append ((const char *) unknown, sizeof (unknown));
+
+  gst_tensors_config_init (&check_config);
+  in_buf = _new_buffer (serialized.data (), serialized.size ());
+  out_buf = gst_tensor_converter_protobuf (in_buf, &check_config, NULL);
+
+  _check_converted (out_buf, &check_config, &config, input);
+
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_tensors_config_free (&check_config);
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Test the truncated message is not converted.
+ */
+TEST (testProtobuf, convertTruncated_n)
+{
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *in_buf, *out_buf;
+  std::string serialized;
+  const gsize cut[] = { 1, 8, 100 };
+  guint i;
+
+  _prepare_tensors (&config, input);
+  serialized = _serialize_message (&config, input, TEST_NUM_TENSORS, TEST_NUM_TENSORS);
+
+  for (i = 0; i < G_N_ELEMENTS (cut); i++) {
+    gst_tensors_config_init (&check_config);
+    in_buf = _new_buffer (serialized.data (), serialized.size () - cut[i]);
+    out_buf = gst_tensor_converter_protobuf (in_buf, &check_config, NULL);
+
+    EXPECT_TRUE (out_buf == NULL) << "truncated " << cut[i] << " bytes";
+
+    if (out_buf)
+      gst_buffer_unref (out_buf);
+    gst_buffer_unref (in_buf);
+    gst_tensors_config_free (&check_config);
+  }
+
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Test the message with larger num_tensor than the tensors is not converted.
+ */
+TEST (testProtobuf, convertInvalidNumTensor_n)
+{
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *in_buf, *out_buf;
+  std::string serialized;
+
+  _prepare_tensors (&config, input);
+  serialized = _serialize_message (&config, input, TEST_NUM_TENSORS + 1, TEST_NUM_TENSORS);
+
+  gst_tensors_config_init (&check_config);
+  in_buf = _new_buffer (serialized.data (), serialized.size ());
+  out_buf = gst_tensor_converter_protobuf (in_buf, &check_config, NULL);
+
+  EXPECT_TRUE (out_buf == NULL);
+
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_tensors_config_free (&check_config);
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Test the message with more tensors than NNS_TENSOR_SIZE_LIMIT is not converted.
+ */
+TEST (testProtobuf, convertTooManyTensors_n)
+{
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *in_buf, *out_buf;
+  std::string serialized;
+
+  _prepare_tensors (&config, input);
+  serialized = _serialize_message (
+      &config, input, NNS_TENSOR_SIZE_LIMIT + 1, NNS_TENSOR_SIZE_LIMIT + 1);
+
+  gst_tensors_config_init (&check_config);
+  in_buf = _new_buffer (serialized.data (), serialized.size ());
+  out_buf = gst_tensor_converter_protobuf (in_buf, &check_config, NULL);
+
+  EXPECT_TRUE (out_buf == NULL);
+
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_tensors_config_free (&check_config);
+  _free_tensors (&config, input);
+}
+
+/**
+ * @brief Main GTest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
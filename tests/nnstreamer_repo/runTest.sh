@@ -126,6 +126,68 @@ callCompareTest testsequence_8.golden testsequence04_8.log 4-8 "Compare 4-8" 1 0
 callCompareTest testsequence_9.golden testsequence04_9.log 4-9 "Compare 4-9" 1 0
 callCompareTest testsequence_10.golden testsequence04_10.log 4-10 "Compare 4-10" 1 0
 
+# Multiple buffers in the repository slot
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=testsequence_%1d.png index=0 caps=\"image/png,framerate=(fraction)3/1\" ! pngdec ! tensor_converter ! queue ! tensor_reposink silent=false slot-index=0 ring-size=4 tensor_reposrc silent=false slot-index=0 caps=\"other/tensor,dimension=(string)3:16:16:1,type=(string)uint8,framerate=(fraction)3/1\" ! multifilesink location=testsequence05_%1d.log" 5 0 0 $PERFORMANCE
+
+callCompareTest testsequence_1.golden testsequence05_1.log 5-1 "Compare 5-1" 1 0
+callCompareTest testsequence_2.golden testsequence05_2.log 5-2 "Compare 5-2" 1 0
+callCompareTest testsequence_3.golden testsequence05_3.log 5-3 "Compare 5-3" 1 0
+callCompareTest testsequence_4.golden testsequence05_4.log 5-4 "Compare 5-4" 1 0
+callCompareTest testsequence_5.golden testsequence05_5.log 5-5 "Compare 5-5" 1 0
+callCompareTest testsequence_6.golden testsequence05_6.log 5-6 "Compare 5-6" 1 0
+callCompareTest testsequence_7.golden testsequence05_7.log 5-7 "Compare 5-7" 1 0
+callCompareTest testsequence_8.golden testsequence05_8.log 5-8 "Compare 5-8" 1 0
+callCompareTest testsequence_9.golden testsequence05_9.log 5-9 "Compare 5-9" 1 0
+callCompareTest testsequence_10.golden testsequence05_10.log 5-10 "Compare 5-10" 1 0
+
+# Overwrite mode: tensor_reposink drops the oldest buffer instead of waiting for the slow tensor_reposrc.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=testsequence_%1d.png index=0 caps=\"image/png,framerate=(fraction)3/1\" ! pngdec ! tensor_converter ! queue ! tensor_reposink silent=false slot-index=0 ring-size=2 overwrite=true tensor_reposrc silent=false slot-index=0 caps=\"other/tensor,dimension=(string)3:16:16:1,type=(string)uint8,framerate=(fraction)3/1\" ! identity sleep-time=200000 ! multifilesink location=testsequence06_%1d.log" 6 0 0 $PERFORMANCE
+
+# The received buffers should be in order without duplication, and the last one should not be dropped.
+last=0
+num=0
+result=0
+for log in $(ls testsequence06_*.log | sed 's/testsequence06_\([0-9]*\).log/\1/' | sort -n); do
+    # skip the dummy buffer
+    if [ "$log" -eq 0 ]; then
+        continue
+    fi
+
+    found=0
+    for ((i = last + 1; i <= 10; i++)); do
+        if cmp -s testsequence_${i}.golden testsequence06_${log}.log; then
+            found=$i
+            break
+        fi
+    done
+
+    if [ "$found" -eq 0 ]; then
+        result=1
+        break
+    fi
+
+    last=$found
+    num=$((num + 1))
+done
+testResult $result 6-1 "Buffers in order with overwrite" 0 1
+
+[ "$last" -eq 10 ]
+testResult $? 6-2 "The last buffer with overwrite" 0 1
+
+[ "$num" -gt 0 ] && [ "$num" -lt 10 ]
+testResult $? 6-3 "Oldest buffers dropped with overwrite" 0 1
+
+# The statistics are notified at EOS.
+gst-launch-1.0 -v --gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=testsequence_%1d.png index=0 caps=\"image/png,framerate=\(fraction\)3/1\" ! pngdec ! tensor_converter ! queue ! tensor_reposink silent=false slot-index=0 ring-size=2 overwrite=true tensor_reposrc silent=false slot-index=0 caps=\"other/tensor,dimension=\(string\)3:16:16:1,type=\(string\)uint8,framerate=\(fraction\)3/1\" ! identity sleep-time=200000 ! fakesink > testsequence07.log 2>&1
+grep "stats = " testsequence07.log | grep -q "pushed=(uint)10"
+testResult $? 7-1 "Pushed buffers in stats" 0 1
+
+grep "stats = " testsequence07.log | grep -q "dropped=(uint)[1-9]"
+testResult $? 7-2 "Dropped buffers in stats" 0 1
+
+grep "stats = " testsequence07.log | grep -q "ring-size=(uint)2"
+testResult $? 7-3 "Ring size in stats" 0 1
+
 rm *.log *.bmp *.png *.golden *.raw *.dat
 
 report
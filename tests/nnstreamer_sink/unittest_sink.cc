@@ -121,6 +121,9 @@ typedef enum {
   TEST_TYPE_CUSTOM_MULTI, /**< pipeline with multiple custom filters */
   TEST_TYPE_CUSTOM_BUF_DROP, /**< pipeline to test buffer-drop in tensor_filter using custom filter */
   TEST_TYPE_CUSTOM_PASSTHROUGH, /**< pipeline to test custom passthrough without so file */
+  TEST_TYPE_CUSTOM_BATCH, /**< pipeline to test batched invoke with custom passthrough */
+  TEST_TYPE_CUSTOM_ASYNC, /**< pipeline to test asynchronous invoke with custom passthrough */
+  TEST_TYPE_CUSTOM_MULTI_INSTANCES, /**< pipeline to test multiple framework instances with custom passthrough */
   TEST_TYPE_NEGO_FAILED, /**< pipeline to test caps negotiation */
   TEST_TYPE_VIDEO_RGB_SPLIT, /**< pipeline to test tensor_split */
   TEST_TYPE_VIDEO_RGB_AGGR_1, /**< pipeline to test tensor_aggregator (change dimension index 3 : 1 > 10)*/
@@ -143,6 +146,7 @@ typedef enum {
   TEST_TYPE_ISSUE739_MERGE_PARALLEL_4, /**< pipeline to test Merge/Parallel case in #739 */
   TEST_TYPE_DECODER_PROPERTY, /**< pipeline to test get/set_property of decoder */
   TEST_CUSTOM_EASY_ICF_01, /**< pipeline to test easy-custom in code func */
+  TEST_CUSTOM_EASY_BATCH, /**< pipeline to test easy-custom batched invoke with max-batch-latency */
   TEST_TYPE_UNKNOWN /**< unknonwn */
 } TestType;
 
@@ -1012,6 +1016,27 @@ _setup_pipeline (TestOption &option)
           "tensor_converter ! tensor_filter framework=custom-passthrough ! tensor_sink name=test_sink",
           option.num_buffers, fps);
       break;
+    case TEST_TYPE_CUSTOM_BATCH:
+      /* video 160x120 RGB, passthrough custom filter with batched invoke */
+      str_pipeline = g_strdup_printf (
+          "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+          "tensor_converter ! tensor_filter framework=custom-passthrough batch-size=4 ! tensor_sink name=test_sink",
+          option.num_buffers, fps);
+      break;
+    case TEST_TYPE_CUSTOM_ASYNC:
+      /* video 160x120 RGB, passthrough custom filter with asynchronous invoke */
+      str_pipeline = g_strdup_printf (
+          "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+          "tensor_converter ! tensor_filter framework=custom-passthrough inflight-requests=2 ! tensor_sink name=test_sink",
+          option.num_buffers, fps);
+      break;
+    case TEST_TYPE_CUSTOM_MULTI_INSTANCES:
+      /* video 160x120 RGB, passthrough custom filter with 3 framework instances */
+      str_pipeline = g_strdup_printf (
+          "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+          "tensor_converter ! tensor_filter framework=custom-passthrough num-instances=3 ! tensor_sink name=test_sink",
+          option.num_buffers, fps);
+      break;
     case TEST_TYPE_NEGO_FAILED:
       /** caps negotiation failed */
       str_pipeline = g_strdup_printf ("videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
@@ -1206,6 +1231,13 @@ _setup_pipeline (TestOption &option)
           "tensor_filter framework=custom-easy model=safe_memcpy_10x10 ! "
           "tensor_sink name=test_sink");
       break;
+    case TEST_CUSTOM_EASY_BATCH:
+      str_pipeline = g_strdup_printf (
+          "appsrc name=appsrc caps=application/octet-stream ! "
+          "tensor_converter input-dim=1:10 input-type=uint8 ! "
+          "tensor_filter framework=custom-easy model=batch_memcpy_10x10 batch-size=4 max-batch-latency=50000 ! "
+          "tensor_sink name=test_sink");
+      break;
     default:
       goto error;
   }
@@ -3637,6 +3669,108 @@ TEST (tensorStreamTest, flexToStatic)
   _free_test_data (option);
 }
 
+/**
+ * @brief Test for the output memory pool of tensor_filter.
+ */
+TEST (tensorStreamTest, filterOutputPool)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  GstStructure *stats = NULL;
+  guint64 allocated = 0, reused = 0;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+  ASSERT_TRUE (filter != NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /* each output is either newly allocated or reused from the pool */
+  g_object_get (filter, "output-pool-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "allocated", &allocated));
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "reused", &reused));
+  EXPECT_EQ (allocated + reused, (guint64) num_buffers);
+  EXPECT_GT (reused, 0U);
+  gst_structure_free (stats);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for the invoke statistics of tensor_filter.
+ */
+TEST (tensorStreamTest, filterInvokeStats)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  const gchar *stages[] = { "prepare", "invoke", "finish" };
+  GstElement *filter;
+  GstStructure *stats = NULL;
+  guint64 count, p50, p95, p99, max;
+  gdouble avg;
+  guint i;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+  ASSERT_TRUE (filter != NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+
+  g_object_get (filter, "invoke-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (stages); i++) {
+    g_autofree gchar *f_count = g_strdup_printf ("%s-count", stages[i]);
+    g_autofree gchar *f_avg = g_strdup_printf ("%s-avg", stages[i]);
+    g_autofree gchar *f_p50 = g_strdup_printf ("%s-p50", stages[i]);
+    g_autofree gchar *f_p95 = g_strdup_printf ("%s-p95", stages[i]);
+    g_autofree gchar *f_p99 = g_strdup_printf ("%s-p99", stages[i]);
+    g_autofree gchar *f_max = g_strdup_printf ("%s-max", stages[i]);
+
+    EXPECT_TRUE (gst_structure_get_uint64 (stats, f_count, &count));
+    EXPECT_TRUE (gst_structure_get_double (stats, f_avg, &avg));
+    EXPECT_TRUE (gst_structure_get_uint64 (stats, f_p50, &p50));
+    EXPECT_TRUE (gst_structure_get_uint64 (stats, f_p95, &p95));
+    EXPECT_TRUE (gst_structure_get_uint64 (stats, f_p99, &p99));
+    EXPECT_TRUE (gst_structure_get_uint64 (stats, f_max, &max));
+
+    /* every frame passes all stages */
+    EXPECT_EQ (count, (guint64) num_buffers);
+    EXPECT_GE (avg, 0.0);
+    EXPECT_LE (avg, (gdouble) max);
+    EXPECT_LE (p50, p95);
+    EXPECT_LE (p95, p99);
+    EXPECT_LE (p99, max);
+  }
+
+  gst_structure_free (stats);
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
 /**
  * @brief Test for other/tensor, passthrough custom filter.
  */
@@ -4370,6 +4504,101 @@ test_custom_v1_getFWInfo (const GstTensorFilterFramework *self,
   return 0;
 }
 
+/**
+ * @brief The number of batched invoke calls and the frames (for batch test).
+ */
+static guint test_custom_batch_invoked = 0;
+static guint test_custom_batch_frames = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1, batched invoke).
+ */
+static int
+test_custom_v1_invoke_batch (const GstTensorFilterFramework *self,
+    GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  g_assert (prop->batch_size >= 1 && prop->batch_size <= 4);
+
+  test_custom_batch_invoked++;
+  test_custom_batch_frames += prop->batch_size;
+
+  return test_custom_v0_invoke (prop, &private_data, input, output);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1, batched invoke).
+ */
+static int
+test_custom_v1_getFWInfo_batch (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  test_custom_v1_getFWInfo (self, prop, private_data, fw_info);
+  fw_info->support_batch = 1;
+  return 0;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1, asynchronous invoke).
+ */
+static int
+test_custom_v1_invoke_async (const GstTensorFilterFramework *self,
+    GstTensorFilterProperties *prop, void *private_data, const GstTensorMemory *input,
+    GstTensorMemory *output, GstTensorFilterInvokeCallback done, void *user_data)
+{
+  int ret;
+
+  test_custom_batch_invoked++;
+  test_custom_batch_frames++;
+
+  ret = test_custom_v0_invoke (prop, &private_data, input, output);
+  done (user_data, ret);
+
+  return 0;
+}
+
+/**
+ * @brief The number of invoke calls and opened instances (for multi-instance test).
+ */
+static gint test_custom_instances_invoked = 0;
+static gint test_custom_instances_opened = 0;
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1, multiple instances).
+ */
+static int
+test_custom_v1_open_instance (const GstTensorFilterProperties *prop, void **private_data)
+{
+  g_atomic_int_inc (&test_custom_instances_opened);
+  *private_data = GINT_TO_POINTER (g_atomic_int_get (&test_custom_instances_opened));
+  return 0;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1, multiple instances).
+ */
+static void
+test_custom_v1_close_instance (const GstTensorFilterProperties *prop, void **private_data)
+{
+  g_atomic_int_add (&test_custom_instances_opened, -1);
+  *private_data = NULL;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1, multiple instances).
+ */
+static int
+test_custom_v1_invoke_instance (const GstTensorFilterFramework *self,
+    GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  g_assert (private_data != NULL);
+  g_atomic_int_inc (&test_custom_instances_invoked);
+
+  return test_custom_v0_invoke (prop, &private_data, input, output);
+}
+
 /**
  * @brief Invalid callback for GstTensorFilterFramework (v1).
  */
@@ -4669,6 +4898,258 @@ TEST (tensorStreamTest, subpluginV1Run)
   g_free (fw);
 }
 
+/**
+ * @brief Test for batched invoke with passthrough custom filter (v1).
+ */
+TEST (tensorStreamTest, subpluginV1BatchRun)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_BATCH };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke_batch;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo_batch;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_invoked = test_custom_batch_frames = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* 4 + 4 + 2 (pending frames at EOS) */
+  EXPECT_EQ (test_custom_batch_invoked, 3U);
+  EXPECT_EQ (test_custom_batch_frames, num_buffers);
+
+  /* check received buffers, each output is split into a frame */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /* check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for batched invoke fallback, the framework does not support batch (v1).
+ */
+TEST (tensorStreamTest, subpluginV1BatchFallback)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_BATCH };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke_batch;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_invoked = test_custom_batch_frames = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* invoked per frame */
+  EXPECT_EQ (test_custom_batch_invoked, num_buffers);
+  EXPECT_EQ (test_custom_batch_frames, num_buffers);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for asynchronous invoke with passthrough custom filter (v1).
+ */
+TEST (tensorStreamTest, subpluginV1AsyncRun)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_ASYNC };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke_batch;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_invoked = test_custom_batch_frames = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message, all in-flight frames should be pushed before eos */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* invoked per frame by the worker thread */
+  EXPECT_EQ (test_custom_batch_invoked, num_buffers);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /* check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for asynchronous invoke with the framework providing invokeAsync (v1).
+ */
+TEST (tensorStreamTest, subpluginV1AsyncNativeRun)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_ASYNC };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke;
+  fw->invokeAsync = test_custom_v1_invoke_async;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_invoked = test_custom_batch_frames = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* invokeAsync is called instead of invoke */
+  EXPECT_EQ (test_custom_batch_invoked, num_buffers);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for multiple framework instances with passthrough custom filter (v1).
+ */
+TEST (tensorStreamTest, subpluginV1MultiInstancesRun)
+{
+  const guint num_buffers = 20;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_MULTI_INSTANCES };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_custom_v1_open_instance;
+  fw->close = test_custom_v1_close_instance;
+  fw->invoke = test_custom_v1_invoke_instance;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_instances_invoked = test_custom_instances_opened = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /* 3 instances are opened while running */
+  EXPECT_EQ (g_atomic_int_get (&test_custom_instances_opened), 3);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* all instances are closed */
+  EXPECT_EQ (g_atomic_int_get (&test_custom_instances_opened), 0);
+  EXPECT_EQ (g_atomic_int_get (&test_custom_instances_invoked), (gint) num_buffers);
+
+  /* check received buffers and timestamp */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
 /**
  * @brief Test for plugin registration with invalid param (v1).
  */
@@ -5287,6 +5768,134 @@ TEST (tensorStreamTest, splitProperties1_n)
   _free_test_data (option);
 }
 
+/**
+ * @brief Data structure to check the segments of tensor_split.
+ */
+typedef struct {
+  guint received; /**< the number of received buffers */
+  GstMemory *parent; /**< the parent of output memory */
+  guint8 data[16]; /**< output data */
+  gsize size; /**< output size */
+} TestSplitSegment;
+
+/**
+ * @brief Callback for tensor sink signal, to get the segment of tensor_split.
+ */
+static void
+_split_segment_new_data_cb (GstElement *element, GstBuffer *buffer, gpointer user_data)
+{
+  TestSplitSegment *seg = (TestSplitSegment *) user_data;
+  GstMemory *mem;
+  GstMapInfo map;
+
+  if (gst_buffer_n_memory (buffer) != 1U)
+    return;
+
+  mem = gst_buffer_peek_memory (buffer, 0);
+  seg->parent = mem->parent;
+
+  if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+    seg->size = MIN (map.size, sizeof (seg->data));
+    memcpy (seg->data, map.data, seg->size);
+    gst_memory_unmap (mem, &map);
+  }
+
+  seg->received++;
+}
+
+/**
+ * @brief Test for tensor_split sharing the memory of incoming buffer.
+ * The segment in a memory is shared, the segment spanning the memories or in the no-share memory is copied.
+ */
+TEST (tensorStreamTest, splitShareMemory)
+{
+  GstElement *pipeline, *appsrc, *split, *sink;
+  GstBuffer *buffer;
+  GstMemory *mem[2];
+  GstMapInfo map;
+  TestSplitSegment seg[3];
+  const gsize offset[3] = { 0, 4, 12 };
+  const gsize size[3] = { 4, 8, 4 };
+  gchar *str;
+  guint i, j;
+
+  const gchar *str_pipeline =
+      "appsrc name=appsrc caps=other/tensors,num_tensors=1,format=static,dimensions=(string)16:1:1:1,types=(string)uint8,framerate=(fraction)0/1 ! "
+      "tensor_split name=split tensorseg=4:1:1:1,8:1:1:1,4:1:1:1 "
+      "split.src_0 ! tensor_sink name=sink0 async=false "
+      "split.src_1 ! tensor_sink name=sink1 async=false "
+      "split.src_2 ! tensor_sink name=sink2 async=false";
+
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  appsrc = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  ASSERT_TRUE (appsrc != NULL);
+
+  memset (seg, 0, sizeof (seg));
+  for (i = 0; i < 3; i++) {
+    gchar *name = g_strdup_printf ("sink%u", i);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    ASSERT_TRUE (sink != NULL);
+    g_signal_connect (sink, "new-data", (GCallback) _split_segment_new_data_cb, &seg[i]);
+    gst_object_unref (sink);
+    g_free (name);
+  }
+
+  /* 2 memories of 8 bytes, the second one cannot be shared */
+  buffer = gst_buffer_new ();
+  for (i = 0; i < 2; i++) {
+    mem[i] = gst_allocator_alloc (NULL, 8, NULL);
+    ASSERT_TRUE (gst_memory_map (mem[i], &map, GST_MAP_WRITE));
+    for (j = 0; j < 8; j++)
+      map.data[j] = (guint8) (i * 8 + j);
+    gst_memory_unmap (mem[i], &map);
+
+    gst_buffer_append_memory (buffer, gst_memory_ref (mem[i]));
+  }
+  GST_MINI_OBJECT_FLAG_SET (mem[1], GST_MEMORY_FLAG_NO_SHARE);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  /* tensorseg cannot be changed while processing */
+  split = gst_bin_get_by_name (GST_BIN (pipeline), "split");
+  ASSERT_TRUE (split != NULL);
+  g_object_set (split, "tensorseg", "8:1:1:1,8:1:1:1", NULL);
+  g_object_get (split, "tensorseg", &str, NULL);
+  EXPECT_TRUE (gst_tensor_dimension_string_is_equal (str, "4:1:1:1,8:1:1:1,4:1:1:1"));
+  g_free (str);
+  gst_object_unref (split);
+
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc), buffer), GST_FLOW_OK);
+  EXPECT_EQ (gst_app_src_end_of_stream (GST_APP_SRC (appsrc)), GST_FLOW_OK);
+
+  for (i = 0; i < TEST_TIMEOUT_LIMIT_MS / 10; i++) {
+    if (seg[0].received > 0 && seg[1].received > 0 && seg[2].received > 0)
+      break;
+    g_usleep (10000);
+  }
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  for (i = 0; i < 3; i++) {
+    EXPECT_EQ (seg[i].received, 1U);
+    ASSERT_EQ (seg[i].size, size[i]);
+    for (j = 0; j < size[i]; j++)
+      EXPECT_EQ (seg[i].data[j], (guint8) (offset[i] + j));
+  }
+
+  /* shared, spanning 2 memories and in the no-share memory */
+  EXPECT_TRUE (seg[0].parent == mem[0]);
+  EXPECT_TRUE (seg[1].parent != mem[0] && seg[1].parent != mem[1]);
+  EXPECT_TRUE (seg[2].parent != mem[0] && seg[2].parent != mem[1]);
+
+  gst_memory_unref (mem[0]);
+  gst_memory_unref (mem[1]);
+  gst_object_unref (appsrc);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Test for video stream with tensor_aggregator.
  */
@@ -6474,6 +7083,74 @@ TEST (tensorFilterCustomEasy, inCodeFunc01)
   /** @todo: Check the data at sink */
 }
 
+/**
+ * @brief The number of batched invoke calls and the frames (for custom-easy batch test).
+ */
+static guint cef_batch_invoked = 0;
+static guint cef_batch_frames = 0;
+
+/**
+ * @brief In-Code Test Function for custom-easy filter with batched invoke
+ */
+static int
+cef_func_batch_memcpy (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  if (in[0].size != 10U * prop->batch_size || out[0].size != in[0].size)
+    return -EINVAL;
+
+  cef_batch_invoked++;
+  cef_batch_frames += prop->batch_size;
+
+  memcpy (out[0].data, in[0].data, in[0].size);
+  return 0;
+}
+
+/**
+ * @brief Test custom-easy filter with batched invoke, the pending frames are invoked when max-batch-latency elapses.
+ */
+TEST (tensorFilterCustomEasy, batchLatencyFlush)
+{
+  int ret;
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_CUSTOM_EASY_BATCH };
+  GstTensorsInfo info;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:10:1:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_batch_register (
+      "batch_memcpy_10x10", cef_func_batch_memcpy, NULL, &info, &info);
+  ASSERT_EQ (ret, 0);
+
+  cef_batch_invoked = cef_batch_frames = 0;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+
+  /* push 2 frames without EOS, the batch (batch-size=4) is never filled */
+  _test_src_push_timer_cb (GINT_TO_POINTER (FALSE));
+  _test_src_push_timer_cb (GINT_TO_POINTER (FALSE));
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (2));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* the frames are invoked at once and split into per-frame buffers */
+  EXPECT_EQ (cef_batch_invoked, 1U);
+  EXPECT_EQ (cef_batch_frames, 2U);
+  EXPECT_EQ (g_test_data.received, 2U);
+  EXPECT_EQ (g_test_data.received_size, 10U);
+  EXPECT_NE (g_test_data.status, TEST_EOS);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  ret = NNS_custom_easy_unregister ("batch_memcpy_10x10");
+  ASSERT_EQ (ret, 0);
+}
+
 /**
  * @brief Test unregister custom_easy filter
  */
@@ -6614,6 +7291,127 @@ TEST (extraTensors, manualextratensors)
   g_free (str_pipeline);
 }
 
+/**
+ * @brief Internal function to build a buffer with @a num tensors of int32.
+ */
+static GstBuffer *
+_build_extra_tensors_buffer (guint num)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorInfo tinfo;
+  guint i;
+
+  gst_tensor_info_init (&tinfo);
+  tinfo.type = _NNS_INT32;
+  tinfo.dimension[0] = 1024;
+  tinfo.dimension[1] = 1;
+
+  buffer = gst_buffer_new ();
+
+  for (i = 0; i < num; i++) {
+    mem = gst_allocator_alloc (NULL, 1024 * sizeof (gint32), NULL);
+    if (gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      ((gint32 *) map.data)[0] = (gint32) i;
+      ((gint32 *) map.data)[1023] = (gint32) (i * 2);
+      gst_memory_unmap (mem, &map);
+    }
+
+    if (!gst_tensor_buffer_append_memory (buffer, mem, &tinfo)) {
+      gst_buffer_unref (buffer);
+      buffer = NULL;
+      break;
+    }
+  }
+
+  gst_tensor_info_free (&tinfo);
+  return buffer;
+}
+
+/**
+ * @brief Internal function to check the tensors in the buffer.
+ */
+static gboolean
+_check_extra_tensors_buffer (GstBuffer *buffer, guint num)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  gboolean matched = TRUE;
+  guint i;
+
+  if (gst_tensor_buffer_get_count (buffer) != num)
+    return FALSE;
+
+  for (i = 0; i < num && matched; i++) {
+    mem = gst_tensor_buffer_get_nth_memory (buffer, i);
+    if (!mem)
+      return FALSE;
+
+    if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+      matched = (map.size == 1024 * sizeof (gint32)
+                 && ((gint32 *) map.data)[0] == (gint32) i
+                 && ((gint32 *) map.data)[1023] == (gint32) (i * 2));
+      gst_memory_unmap (mem, &map);
+    } else {
+      matched = FALSE;
+    }
+
+    gst_memory_unref (mem);
+  }
+
+  return matched;
+}
+
+/**
+ * @brief Test for appending many extra tensors and accessing each of them.
+ */
+TEST (extraTensors, appendManyTensors)
+{
+  const guint nums[] = { 17, 64, 256 };
+  GstBuffer *buffer;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (nums); i++) {
+    buffer = _build_extra_tensors_buffer (nums[i]);
+    ASSERT_TRUE (buffer != NULL);
+    EXPECT_TRUE (_check_extra_tensors_buffer (buffer, nums[i]));
+
+    gst_buffer_unref (buffer);
+  }
+}
+
+/**
+ * @brief Test for appending extra tensor to the buffer which shares the memory.
+ */
+TEST (extraTensors, appendSharedTensors)
+{
+  GstBuffer *buffer, *copied;
+  GstMemory *mem;
+  GstTensorInfo tinfo;
+
+  buffer = _build_extra_tensors_buffer (20);
+  ASSERT_TRUE (buffer != NULL);
+
+  /* The copied buffer shares the extra memory, it should not be updated. */
+  copied = gst_buffer_copy (buffer);
+
+  gst_tensor_info_init (&tinfo);
+  tinfo.type = _NNS_INT32;
+  tinfo.dimension[0] = 1024;
+  tinfo.dimension[1] = 1;
+
+  mem = gst_allocator_alloc (NULL, 1024 * sizeof (gint32), NULL);
+  EXPECT_TRUE (gst_tensor_buffer_append_memory (copied, mem, &tinfo));
+  gst_tensor_info_free (&tinfo);
+
+  EXPECT_EQ (gst_tensor_buffer_get_count (copied), 21U);
+  EXPECT_TRUE (_check_extra_tensors_buffer (buffer, 20));
+
+  gst_buffer_unref (copied);
+  gst_buffer_unref (buffer);
+}
+
 /**
  * @brief Callback for tensor sink signal. Using gst_tensors_get_nth_memory API
  */
@@ -0,0 +1,139 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	bench_extra_tensors.c
+ * @date	16 Oct 2026
+ * @brief	Microbenchmark for the buffers with extra tensors.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	MyungJoo Ham <myungjoo.ham@samsung.com>
+ * @bug		No known bugs.
+ *
+ * This measures the elapsed time to build a buffer with N tensors using
+ * gst_tensor_buffer_append_memory() and to access all tensors using
+ * gst_tensor_buffer_get_nth_memory(). The tensors from the 17th are kept in
+ * the extra memory block. This uses the public APIs only, so the results of
+ * different versions of nnstreamer can be compared with the same binary.
+ *
+ * Usage: bench_extra_tensors [REPEAT] [TENSOR_SIZE]
+ */
+#include <glib.h>
+#include <gst/gst.h>
+#include <stdlib.h>
+#include <nnstreamer_plugin_api.h>
+
+/**
+ * @brief Build a buffer with @a num tensors of int32.
+ */
+static GstBuffer *
+build_buffer (guint num, guint elements, gint64 * elapsed)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorInfo info;
+  gint64 start;
+  guint i;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_INT32;
+  info.dimension[0] = elements;
+  info.dimension[1] = 1;
+
+  buffer = gst_buffer_new ();
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < num; i++) {
+    mem = gst_allocator_alloc (NULL, elements * sizeof (gint32), NULL);
+    if (gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      ((gint32 *) map.data)[0] = (gint32) i;
+      gst_memory_unmap (mem, &map);
+    }
+
+    if (!gst_tensor_buffer_append_memory (buffer, mem, &info)) {
+      g_printerr ("Failed to append %u'th tensor.\n", i);
+      gst_buffer_unref (buffer);
+      buffer = NULL;
+      break;
+    }
+  }
+
+  *elapsed += g_get_monotonic_time () - start;
+  gst_tensor_info_free (&info);
+  return buffer;
+}
+
+/**
+ * @brief Access all tensors in the buffer.
+ */
+static gboolean
+access_buffer (GstBuffer * buffer, guint num, gint64 * elapsed)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  gboolean matched = TRUE;
+  gint64 start;
+  guint i;
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < num && matched; i++) {
+    mem = gst_tensor_buffer_get_nth_memory (buffer, i);
+    if (!mem)
+      return FALSE;
+
+    if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+      matched = (((gint32 *) map.data)[0] == (gint32) i);
+      gst_memory_unmap (mem, &map);
+    }
+
+    gst_memory_unref (mem);
+  }
+
+  *elapsed += g_get_monotonic_time () - start;
+  return matched;
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  const guint nums[] = { 17, 64, 256 };
+  GstBuffer *buffer;
+  gint64 append_time, access_time;
+  guint repeat = 100, elements = 1024;
+  guint i, r;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1)
+    repeat = MAX (1, atoi (argv[1]));
+  if (argc > 2)
+    elements = MAX (1, atoi (argv[2]) / sizeof (gint32));
+
+  g_print ("%u bytes per tensor, average of %u runs\n",
+      (guint) (elements * sizeof (gint32)), repeat);
+  g_print ("%8s %12s %12s\n", "tensors", "append(us)", "access(us)");
+
+  for (i = 0; i < G_N_ELEMENTS (nums); i++) {
+    append_time = access_time = 0;
+
+    for (r = 0; r < repeat; r++) {
+      buffer = build_buffer (nums[i], elements, &append_time);
+      if (!buffer)
+        return 1;
+
+      if (!access_buffer (buffer, nums[i], &access_time))
+        g_printerr ("The tensors in the buffer are not matched.\n");
+
+      gst_buffer_unref (buffer);
+    }
+
+    g_print ("%8u %12" G_GINT64_FORMAT " %12" G_GINT64_FORMAT "\n", nums[i],
+        append_time / repeat, access_time / repeat);
+  }
+
+  return 0;
+}
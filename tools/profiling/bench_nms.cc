@@ -0,0 +1,182 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	bench_nms.cc
+ * @date	16 Oct 2026
+ * @brief	Microbenchmark for nms of tensor_decoder::bounding_boxes.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	MyungJoo Ham <myungjoo.ham@samsung.com>
+ * @bug		No known bugs.
+ *
+ * This compares the elapsed time of nms with the previous implementation
+ * (sort all candidates with g_array_sort and compare every pair) for the
+ * number of candidates of popular detection models.
+ *
+ * Usage: bench_nms [REPEAT]
+ */
+#include <glib.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tensordec-boundingbox.h"
+
+/**
+ * @brief Compare function of the previous implementation.
+ */
+static gint
+legacy_compare (gconstpointer _a, gconstpointer _b)
+{
+  const detectedObject *a = static_cast<const detectedObject *> (_a);
+  const detectedObject *b = static_cast<const detectedObject *> (_b);
+
+  return (a->prob > b->prob) ? -1 : ((a->prob == b->prob) ? 0 : 1);
+}
+
+/**
+ * @brief IoU of the previous implementation.
+ */
+static gfloat
+legacy_iou (detectedObject *a, detectedObject *b)
+{
+  int x1 = MAX (a->x, b->x);
+  int y1 = MAX (a->y, b->y);
+  int x2 = MIN (a->x + a->width, b->x + b->width);
+  int y2 = MIN (a->y + a->height, b->y + b->height);
+  int w = MAX (0, (x2 - x1 + 1));
+  int h = MAX (0, (y2 - y1 + 1));
+  float inter = w * h;
+  float areaA = a->width * a->height;
+  float areaB = b->width * b->height;
+  float o = inter / (areaA + areaB - inter);
+  return (o >= 0) ? o : 0;
+}
+
+/**
+ * @brief The previous implementation of nms.
+ */
+static void
+legacy_nms (GArray *results, gfloat threshold, gboolean class_aware)
+{
+  guint boxes_size;
+  guint i, j;
+
+  boxes_size = results->len;
+  if (boxes_size == 0U)
+    return;
+
+  g_array_sort (results, legacy_compare);
+
+  for (i = 0; i < boxes_size; i++) {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    if (a->valid == TRUE) {
+      for (j = i + 1; j < boxes_size; j++) {
+        detectedObject *b = &g_array_index (results, detectedObject, j);
+        if (b->valid == TRUE && (!class_aware || a->class_id == b->class_id)) {
+          if (legacy_iou (a, b) > threshold) {
+            b->valid = FALSE;
+          }
+        }
+      }
+    }
+  }
+
+  i = 0;
+  do {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+    if (a->valid == FALSE)
+      g_array_remove_index (results, i);
+    else
+      i++;
+  } while (i < results->len);
+}
+
+/**
+ * @brief Generate random candidates as a detection decoder does.
+ */
+static GArray *
+generate_candidates (guint num, guint size, guint num_labels, guint32 seed)
+{
+  GRand *rand = g_rand_new_with_seed (seed);
+  GArray *results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num);
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    detectedObject object;
+
+    object.valid = TRUE;
+    object.class_id = g_rand_int_range (rand, 0, num_labels);
+    object.x = g_rand_int_range (rand, 0, size);
+    object.y = g_rand_int_range (rand, 0, size);
+    object.width = g_rand_int_range (rand, 1, size / 4);
+    object.height = g_rand_int_range (rand, 1, size / 4);
+    object.prob = g_rand_double (rand);
+    object.tracking_id = 0;
+    g_array_append_val (results, object);
+  }
+
+  g_rand_free (rand);
+  return results;
+}
+
+/**
+ * @brief Run nms with both implementations and print the average elapsed time.
+ */
+static void
+run_benchmark (const gchar *name, guint num, guint size, guint num_labels,
+    gboolean class_aware, guint repeat)
+{
+  nmsOptions options = { 0.45f, class_aware, 0U };
+  gint64 legacy_time = 0, time = 0, start;
+  guint r;
+
+  for (r = 0; r < repeat; r++) {
+    GArray *legacy = generate_candidates (num, size, num_labels, r + 1);
+    GArray *results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num);
+
+    g_array_append_vals (results, legacy->data, legacy->len);
+
+    start = g_get_monotonic_time ();
+    legacy_nms (legacy, options.iou_threshold, class_aware);
+    legacy_time += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    nms (results, &options);
+    time += g_get_monotonic_time () - start;
+
+    if (results->len != legacy->len)
+      g_printerr ("%s: the number of results is different (%u, previous %u)\n",
+          name, results->len, legacy->len);
+
+    g_array_free (legacy, TRUE);
+    g_array_free (results, TRUE);
+  }
+
+  g_print ("%-14s %6u %-12s %12" G_GINT64_FORMAT " %12" G_GINT64_FORMAT " %8.1fx\n",
+      name, num, class_aware ? "class-aware" : "all classes",
+      legacy_time / repeat, time / repeat,
+      (time > 0) ? (gdouble) legacy_time / time : 0.0);
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  guint repeat = 10;
+
+  if (argc > 1)
+    repeat = MAX (1, atoi (argv[1]));
+
+  g_print ("%-14s %6s %-12s %12s %12s %9s\n", "model", "boxes", "nms",
+      "previous(us)", "current(us)", "speedup");
+
+  run_benchmark ("yolov5", 25200, 640, 80, FALSE, repeat);
+  run_benchmark ("yolov5", 25200, 640, 80, TRUE, repeat);
+  run_benchmark ("yolov8", 8400, 640, 80, FALSE, repeat);
+  run_benchmark ("yolov8", 8400, 640, 80, TRUE, repeat);
+  run_benchmark ("mobilenet-ssd", 1917, 300, 91, FALSE, repeat);
+  run_benchmark ("mobilenet-ssd", 1917, 300, 91, TRUE, repeat);
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#!/usr/bin/env bash
+##
+## SPDX-License-Identifier: LGPL-2.1-only
+##
+## @file bench_tensor_transform.sh
+## @brief Compare the throughput of tensor_transform modes with the number of threads.
+##
+## Usage: bench_tensor_transform.sh [NUM_BUFFERS] [WIDTH] [HEIGHT] [THREADS...]
+##        Default is 100 buffers of 3840x2160 RGB with 1, 2, 4 and 8 threads.
+##
+NUM_BUFFERS=${1:-100}
+WIDTH=${2:-3840}
+HEIGHT=${3:-2160}
+shift $(( $# < 3 ? $# : 3 ))
+THREADS="${*:-1 2 4 8}"
+
+GST_LAUNCH=${GST_LAUNCH:-gst-launch-1.0}
+
+declare -A OPTIONS=(
+    ["arithmetic"]="typecast:float32,add:-127.5,div:127.5"
+    ["transpose"]="1:2:0:3"
+    ["stand"]="default:float32"
+    ["clamp"]="10:200"
+    ["padding"]="left:2,right:2,top:2,bottom:2"
+)
+
+SRC="videotestsrc num-buffers=${NUM_BUFFERS} pattern=snow ! video/x-raw,format=RGB,width=${WIDTH},height=${HEIGHT},framerate=0/1 ! tensor_converter"
+
+## @brief Run the pipeline and print elapsed time in milliseconds.
+function run_pipeline {
+    local start end
+    start=$(date +%s%N)
+    ${GST_LAUNCH} -q ${SRC} ! $1 fakesink sync=false > /dev/null 2>&1 || return 1
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+## Time to generate the buffers, excluded from the result.
+BASE=$(run_pipeline "") || { echo "Failed to run the pipeline, check nnstreamer is installed."; exit 1; }
+
+echo "tensor_transform ${WIDTH}x${HEIGHT} RGB, ${NUM_BUFFERS} buffers (source ${BASE} ms excluded)"
+printf "%-12s" "mode"
+for t in ${THREADS}; do
+    printf "%14s" "${t} thread(s)"
+done
+printf "\n"
+
+for mode in arithmetic transpose stand clamp padding; do
+    printf "%-12s" "${mode}"
+    for t in ${THREADS}; do
+        elapsed=$(run_pipeline "tensor_transform mode=${mode} option=${OPTIONS[$mode]} num-threads=${t} !")
+        if [[ -z "${elapsed}" ]]; then
+            printf "%14s" "error"
+            continue
+        fi
+        elapsed=$(( elapsed - BASE ))
+        (( elapsed <= 0 )) && elapsed=1
+        printf "%10d fps" $(( NUM_BUFFERS * 1000 / elapsed ))
+    done
+    printf "\n"
+done